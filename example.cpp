@@ -23,21 +23,14 @@ int main()
         fs.seekg(0, std::ios::beg);
         fs.read(fileContents, fileSize);
 
-        //...then convert it to a Unicode buffer.
-        //Note that you should use the specified character set
-        //in the HTML file (usually UTF-8) when loading this file into a wchar_t buffer.
-        //Here we are using the standard mbstowcs() function which assumes the current
-        //system's character set; however, it is recommended to parse the character set
-        //from the HTML file (with parse_charset()) and use a
-        //system-dependent function (e.g., MultiByteToWideChar() on Win32)
-        //to properly convert the char buffer to Unicode using that character set.
-        wchar_t* convertedFileContents = new wchar_t[fileSize+1];
-        std::auto_ptr<wchar_t> deleteConvertedBuffer(convertedFileContents);
-        const size_t convertedFileSize = std::mbstowcs(convertedFileContents, fileContents, fileSize);
+        //...UTF-8 (the most common encoding for HTML) can be passed in as-is.
+        //For other character sets (see parse_charset()), use a system-dependent
+        //function (e.g., MultiByteToWideChar() on Win32) to convert the char buffer
+        //to Unicode and pass in that wchar_t buffer instead.
 
-        //convert the Unicode HTML data into raw text
+        //convert the UTF-8 HTML data into raw text
         lily_of_the_valley::html_extract_text htmlExtract;
-        htmlExtract(convertedFileContents, convertedFileSize, true, false);
+        htmlExtract(fileContents, fileSize, true, false);
         //The raw text from the file is now in a Unicode buffer.
         //This buffer can be accessed from get_filtered_text() and its length
         //from get_filtered_text_length(). Call these to copy the text into
@@ -0,0 +1,216 @@
+#include "batch_extract_text.h"
+#include "html_extract_text.h"
+#include "docx_extract_text.h"
+#include "odt_extract_text.h"
+#include "pptx_extract_text.h"
+#include "hhc_hhk_extract_text.h"
+#include "postscript_extract_text.h"
+#include "unicode_extract_text.h"
+
+namespace lily_of_the_valley
+    {
+    ///@brief A thread's set of extractors, which all write to the same (reused) buffer.
+    class batch_extract_text::worker
+        {
+    public:
+        worker() : m_text_length(0)
+            {
+            m_html.set_text_sink(&m_sink);
+            m_docx.set_text_sink(&m_sink);
+            m_odt.set_text_sink(&m_sink);
+            m_pptx.set_text_sink(&m_sink);
+            m_hhc_hhk.set_text_sink(&m_sink);
+            m_postscript.set_text_sink(&m_sink);
+            m_unicode.set_text_sink(&m_sink);
+            }
+        /**Extracts the text from a document.
+           @param document The document to extract the text from.
+           @returns The text, or NULL on failure. This is only valid until the next document is extracted.*/
+        const wchar_t* extract(const batch_document& document)
+            {
+            m_text_length = 0;
+            m_log.clear();
+            const extract_text* extractor = NULL;
+            const wchar_t* text = NULL;
+            try
+                {
+                switch (document.m_format)
+                    {
+                case html_document:
+                    text = m_html(document.m_text, document.m_length, true, false);
+                    extractor = &m_html;
+                    break;
+                case docx_document:
+                    text = m_docx(document.m_text, document.m_length);
+                    extractor = &m_docx;
+                    break;
+                case odt_document:
+                    text = m_odt(document.m_text, document.m_length);
+                    extractor = &m_odt;
+                    break;
+                case pptx_document:
+                    text = m_pptx(document.m_text, document.m_length);
+                    extractor = &m_pptx;
+                    break;
+                case hhc_hhk_document:
+                    text = m_hhc_hhk(document.m_text, document.m_length);
+                    extractor = &m_hhc_hhk;
+                    break;
+                case postscript_document:
+                    text = m_postscript(document.m_text, document.m_length);
+                    extractor = &m_postscript;
+                    break;
+                case unicode_document:
+                    text = m_unicode(document.m_text, document.m_length, is_little_endian_system());
+                    extractor = &m_unicode;
+                    break;
+                default:
+                    m_log = L"Unknown document format.";
+                    return NULL;
+                    };
+                }
+            catch (const postscript_extract_text::postscript_header_not_found&)
+                {
+                m_log = L"Postscript header not found.";
+                return NULL;
+                }
+            catch (const postscript_extract_text::postscript_version_not_supported&)
+                {
+                m_log = L"Postscript version not supported.";
+                return NULL;
+                }
+            m_log = extractor->get_log();
+            if (text != NULL)
+                { m_text_length = extractor->get_filtered_text_length(); }
+            return text;
+            }
+        ///@returns The length of the last extracted text.
+        size_t get_text_length() const
+            { return m_text_length; }
+        ///@returns The log from the last extracted document.
+        const std::wstring& get_log() const
+            { return m_log; }
+    private:
+        static bool is_little_endian_system()
+            {
+            const unsigned short probe = 1;
+            return (*reinterpret_cast<const unsigned char*>(&probe) == 1);
+            }
+        growable_text_sink m_sink;
+        html_extract_text m_html;
+        docx_extract_text m_docx;
+        odt_extract_text m_odt;
+        pptx_extract_text m_pptx;
+        hhc_hhk_extract_text m_hhc_hhk;
+        postscript_extract_text m_postscript;
+        unicode_extract_text m_unicode;
+        size_t m_text_length;
+        std::wstring m_log;
+        };
+
+    /**@brief Passes documents' text to a callback in the documents' order, no matter which order they finish in.
+    @details Whichever thread finishes the next document in line delivers it (and any documents after it that
+        are already waiting), while documents that finish early are copied until their turn.*/
+    class batch_extract_text::ordered_delivery
+        {
+    public:
+        ordered_delivery(const size_t document_count, result_callback callback, void* user_data) :
+            m_callback(callback), m_user_data(user_data), m_next_document(0), m_is_delivering(false),
+            m_waiting(document_count), m_is_waiting(document_count, false)
+            {}
+        /**Called when a document is finished.
+           @param index The index of the document.
+           @param text The document's text (or NULL on failure).
+           @param length The length of the text.
+           @param log The document's log.*/
+        void deliver(const size_t index, const wchar_t* text, const size_t length, const std::wstring& log)
+            {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (index != m_next_document || m_is_delivering)
+                {
+                batch_result& waiting = m_waiting[index];
+                waiting.m_succeeded = (text != NULL);
+                if (text != NULL)
+                    { waiting.m_text.assign(text, length); }
+                waiting.m_log = log;
+                m_is_waiting[index] = true;
+                return;
+                }
+            m_is_delivering = true;
+            lock.unlock();
+            m_callback(index, text, length, log, m_user_data);
+            lock.lock();
+            //deliver whatever was waiting on this document
+            while (++m_next_document < m_is_waiting.size() && m_is_waiting[m_next_document])
+                {
+                batch_result waiting;
+                std::swap(waiting, m_waiting[m_next_document]);
+                lock.unlock();
+                m_callback(m_next_document, waiting.m_succeeded ? waiting.m_text.c_str() : NULL,
+                           waiting.m_text.length(), waiting.m_log, m_user_data);
+                lock.lock();
+                }
+            m_is_delivering = false;
+            }
+    private:
+        result_callback m_callback;
+        void* m_user_data;
+        std::mutex m_mutex;
+        size_t m_next_document;
+        bool m_is_delivering;
+        std::vector<batch_result> m_waiting;
+        std::vector<bool> m_is_waiting;
+        };
+
+    //the log for a document whose extractor threw
+    static const wchar_t* const EXTRACTION_FAILED_MESSAGE = L"Unable to extract text from document.";
+
+    batch_extract_text::batch_extract_text(const size_t thread_count /*= 0*/) : m_workers(thread_count)
+        {}
+
+    batch_extract_text::~batch_extract_text()
+        {}
+
+    void batch_extract_text::operator()(const std::vector<batch_document>& documents, std::vector<batch_result>& results)
+        {
+        results.clear();
+        results.resize(documents.size());
+        std::vector<size_t> costs(documents.size());
+        for (size_t i = 0; i < documents.size(); ++i)
+            { costs[i] = documents[i].m_length; }
+        m_workers.run(costs, [&](worker& currentWorker, const size_t documentIndex)
+            {
+            const wchar_t* text = currentWorker.extract(documents[documentIndex]);
+            batch_result& result = results[documentIndex];
+            result.m_succeeded = (text != NULL);
+            if (text != NULL)
+                { result.m_text.assign(text, currentWorker.get_text_length()); }
+            result.m_log = currentWorker.get_log();
+            },
+            [&](const size_t documentIndex)
+            {
+            batch_result& result = results[documentIndex];
+            result.m_succeeded = false;
+            result.m_text.clear();
+            result.m_log = EXTRACTION_FAILED_MESSAGE;
+            });
+        }
+
+    void batch_extract_text::operator()(const std::vector<batch_document>& documents, result_callback callback, void* user_data)
+        {
+        assert(callback && "NULL callback passed to batch_extract_text.");
+        if (!callback)
+            { return; }
+        std::vector<size_t> costs(documents.size());
+        for (size_t i = 0; i < documents.size(); ++i)
+            { costs[i] = documents[i].m_length; }
+        ordered_delivery delivery(documents.size(), callback, user_data);
+        m_workers.run(costs, [&](worker& currentWorker, const size_t documentIndex)
+            {
+            const wchar_t* text = currentWorker.extract(documents[documentIndex]);
+            delivery.deliver(documentIndex, text, currentWorker.get_text_length(), currentWorker.get_log());
+            },
+            [&](const size_t documentIndex)
+            { delivery.deliver(documentIndex, NULL, 0, EXTRACTION_FAILED_MESSAGE); });
+        }
+    }
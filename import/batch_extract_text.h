@@ -0,0 +1,129 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __BATCH_EXTRACT_TEXT_H__
+#define __BATCH_EXTRACT_TEXT_H__
+
+#include <string>
+#include <vector>
+#include "../utilities/work_stealing_pool.h"
+
+namespace lily_of_the_valley
+    {
+    ///The formats that batch_extract_text can extract text from.
+    enum document_format
+        {
+        html_document,        ///< UTF-8 HTML (see html_extract_text).
+        docx_document,        ///< UTF-8 <em>document.xml</em> from a DOCX file (see docx_extract_text).
+        odt_document,         ///< UTF-8 <em>content.xml</em> from an ODT file (see odt_extract_text).
+        pptx_document,        ///< UTF-8 slide from a PPTX file (see pptx_extract_text).
+        hhc_hhk_document,     ///< UTF-8 HTML Workshop index or table of contents (see hhc_hhk_extract_text).
+        postscript_document,  ///< Postscript (see postscript_extract_text).
+        unicode_document      ///< 16-bit Unicode with a byte order mark (see unicode_extract_text).
+        };
+
+    ///@brief A document to extract text from with batch_extract_text.
+    struct batch_document
+        {
+        ///Constructor.
+        batch_document() : m_text(NULL), m_length(0), m_format(html_document) {}
+        /**Constructor.
+           @param text The document's content. This does not need to be NULL terminated, and the caller
+            must keep it alive until the batch is finished.
+           @param length The length (in bytes) of the document.
+           @param format The document's format.*/
+        batch_document(const char* text, const size_t length, const document_format format) :
+            m_text(text), m_length(length), m_format(format) {}
+        const char* m_text;
+        size_t m_length;
+        document_format m_format;
+        };
+
+    ///@brief The text extracted from a document by batch_extract_text.
+    struct batch_result
+        {
+        ///Constructor.
+        batch_result() : m_succeeded(false) {}
+        ///The extracted text.
+        std::wstring m_text;
+        ///A report of any issues found while extracting the text (see extract_text::get_log()).
+        std::wstring m_log;
+        ///Whether the text could be extracted (false for empty documents or ones that could not be parsed).
+        bool m_succeeded;
+        };
+
+    /**@brief Extracts the text from a set of documents (of any supported format) across multiple threads.
+    @details Each thread has one extractor for each format, and all of a thread's extractors write into the same
+        buffer, so extracting a document is mostly a matter of parsing it. The documents are scheduled
+        largest-first and idle threads take work from busy ones (see work_stealing_pool), so the threads
+        stay evenly loaded even when the sizes of the documents vary by orders of magnitude.
+        A document whose extractor fails (e.g., a Postscript file without a header) gets an empty,
+        unsuccessful result with the reason in its log; the rest of the batch is unaffected.
+
+        Markup formats use the recommended options (e.g., html_extract_text includes the outer text and does
+        not preserve spaces). To use other options, use the extractors directly.
+    @note Requires C++11 (for @c std::thread). A batch's documents must stay alive until operator() returns,
+        and only one batch should be running on an object at a time.
+    @par Example:
+    @code
+        std::vector<lily_of_the_valley::batch_document> documents;
+        documents.push_back(lily_of_the_valley::batch_document(page, pageLength, lily_of_the_valley::html_document));
+        documents.push_back(lily_of_the_valley::batch_document(documentXml, documentXmlLength, lily_of_the_valley::docx_document));
+
+        lily_of_the_valley::batch_extract_text batchExtract;
+        std::vector<lily_of_the_valley::batch_result> results;
+        batchExtract(documents, results);
+        //results[0].m_text is the text from the webpage, results[1].m_text is the text from the Word document
+    @endcode*/
+    class batch_extract_text
+        {
+    public:
+        /**The callback that receives each document's text.
+           @param index The index of the document (in the vector passed to operator()).
+           @param text The extracted text (which will be NULL on failure). This is only valid during the call.
+           @param length The length of the text.
+           @param log A report of any issues found while extracting the text.
+           @param user_data The data passed to operator().*/
+        typedef void (*result_callback)(const size_t index, const wchar_t* text, const size_t length,
+                                        const std::wstring& log, void* user_data);
+        /**Constructor.
+           @param thread_count The number of threads to use. If zero, then the number of cores on the system is used.*/
+        explicit batch_extract_text(const size_t thread_count = 0);
+        ///Destructor.
+        ~batch_extract_text();
+        /**Extracts the text from a set of documents.
+           @param documents The documents to extract the text from.
+           @param[out] results The text from each document (in the same order as @c documents).*/
+        void operator()(const std::vector<batch_document>& documents, std::vector<batch_result>& results);
+        /**Extracts the text from a set of documents, passing each one's text to a callback.
+           @details The callback is called in the same order as @c documents and never from two threads at once
+            (although not always from the same thread). A document's text is passed straight from the buffer
+            that it was extracted into, unless it finishes before the documents in front of it; only then is it
+            copied until its turn comes.
+           @param documents The documents to extract the text from.
+           @param callback The function to pass each document's text to. It should not throw.
+           @param user_data Data to pass to the callback (e.g., the object that it should write to).*/
+        void operator()(const std::vector<batch_document>& documents, result_callback callback, void* user_data);
+        ///@returns The number of threads that documents are extracted on.
+        size_t get_thread_count() const
+            { return m_workers.get_thread_count(); }
+    private:
+        class worker;
+        class ordered_delivery;
+        //each thread's extractors (and their shared buffer), which are kept between batches
+        worker_pool<worker> m_workers;
+        //disable copy construction
+        batch_extract_text(const batch_extract_text&);
+        void operator=(const batch_extract_text&);
+        };
+    }
+
+/** @}*/
+
+#endif //__BATCH_EXTRACT_TEXT_H__
@@ -18,9 +18,9 @@ namespace lily_of_the_valley
     @par Example:
     @code
         //Assuming that the contents of "document.xml" from a DOCX file is in a
-        //wchar_t* buffer named "fileContents" and "fileSize" is set to the size
-        //of this document.xml. Note that you should use the specified character set
-        //in the XML file (usually UTF-8) when loading this file into the wchar_t buffer.
+        //char* buffer named "fileContents" and "fileSize" is set to the size
+        //of this document.xml. document.xml is UTF-8, so it can be passed in as-is
+        //(a wchar_t* buffer that it has already been converted to is also accepted).
         lily_of_the_valley::docx_extract_text docxExtract;
         docxExtract(fileContents, fileSize);
 
@@ -33,7 +33,8 @@ namespace lily_of_the_valley
     class docx_extract_text : public html_extract_text
         {
     public:
-        docx_extract_text() : m_preserve_text_table_layout(false) {}
+        docx_extract_text() : m_preserve_text_table_layout(false),
+            m_inside_of_table_cell(false), m_is_in_text_section(false) {}
         /**Specifies how to import tables.
         @param preserve Set to true to import tables as tab-delimited cells of text.
         Set to false to simply import each cell as a separate paragraph, the tabbed structure of the rows may be lost.
@@ -42,12 +43,92 @@ namespace lily_of_the_valley
             { m_preserve_text_table_layout = preserve; }
         /**Main interface for extracting plain text from a DOCX stream.
         @param html_text The <em>document.xml</em> text to extract text from. <em>document.xml</em> should be extracted from a DOCX file (from the <em>word</em> folder).
-        DOCX files are zip files, which can be opened by a library such as <em>zlib</em>.
+        DOCX files are zip files, whose parts can be read with zip_package (or streamed straight into this extractor with extract_package_part()).
         @param text_length The length of the <em>document.xml</em> stream.
         @returns A pointer to the parsed text, or NULL upon failure.
         Call get_filtered_text_length() to get the length of the parsed text.*/
         const wchar_t* operator()(const wchar_t* html_text,
                                   const size_t text_length)
+            { return extract(html_text, text_length); }
+        /**Main interface for extracting plain text from a UTF-8 DOCX stream.
+        @param html_text The UTF-8 <em>document.xml</em> text to extract text from.
+        @param text_length The length (in bytes) of the <em>document.xml</em> stream.
+        @returns A pointer to the parsed text, or NULL upon failure.
+        Call get_filtered_text_length() to get the length of the parsed text.*/
+        const wchar_t* operator()(const char* html_text,
+                                  const size_t text_length)
+            { return extract(html_text, text_length); }
+
+        ///@brief The state that is carried from one segment of a <em>document.xml</em> to the next (see extract_segment()).
+        struct segment_state
+            {
+            ///Constructor (the state at the start of a document).
+            segment_state() : m_inside_of_table_cell(false), m_is_in_text_section(false) {}
+            ///@returns Whether two states are the same.
+            bool operator==(const segment_state& that) const
+                {
+                return (m_inside_of_table_cell == that.m_inside_of_table_cell &&
+                        m_is_in_text_section == that.m_is_in_text_section);
+                }
+            bool m_inside_of_table_cell;
+            bool m_is_in_text_section;
+            };
+        /**Extracts the text from a segment of a <em>document.xml</em>, as if the text in front of it
+           had already been read. Extracting the segments of a document one after another (passing each one's
+           end state to the next) gives the same text as extracting the whole document; this is how
+           docx_parallel_extract_text splits up a large document.
+        @param html_text The start of the segment. This should be the start of an element (or the text after one).
+        @param text_length The length of the segment.
+        @param start_state The state at the start of the segment (i.e., the end state of the segment before it).
+        @param is_final Whether the segment is the end of the document. If false, then an element (or a comment or
+            text run) that is cut off at the end of the segment is not read.
+        @param[out] end_state The state at the end of the segment.
+        @returns The number of characters (from @c html_text) that were read. If less than @c text_length, then
+            the segment was cut off in the middle of something and the rest of it should be extracted
+            along with the next segment.
+        @note The segment's text is available from get_filtered_text() afterwards.*/
+        size_t extract_segment(const wchar_t* html_text, const size_t text_length,
+                               const segment_state& start_state, const bool is_final, segment_state& end_state)
+            { return extract_segment_text(html_text, text_length, start_state, is_final, end_state); }
+        /**Extracts the text from a segment of a UTF-8 <em>document.xml</em>, as if the text in front of it
+           had already been read.
+        @param html_text The start of the segment.
+        @param text_length The length (in bytes) of the segment.
+        @param start_state The state at the start of the segment.
+        @param is_final Whether the segment is the end of the document.
+        @param[out] end_state The state at the end of the segment.
+        @returns The number of bytes (from @c html_text) that were read.*/
+        size_t extract_segment(const char* html_text, const size_t text_length,
+                               const segment_state& start_state, const bool is_final, segment_state& end_state)
+            { return extract_segment_text(html_text, text_length, start_state, is_final, end_state); }
+    protected:
+        /**Resets the table and text run state at the start of a stream.
+           @param preserve_spaces Not used, spaces are always preserved in this XML.*/
+        virtual void reset_stream_state(const bool /*preserve_spaces*/)
+            {
+            html_extract_text::reset_stream_state(true);
+            m_is_in_preformatted_text_block_stack = 1;//use "preserve spaces" logic in this XML
+            m_inside_of_table_cell = false;
+            m_is_in_text_section = false;
+            }
+        /**Parses the next part of a streamed <em>document.xml</em>.
+           @param start The start of the text to parse.
+           @param endSentinel The end of the text.
+           @param is_final Whether this is the end of the stream.
+           @returns Where parsing stopped.*/
+        virtual const wchar_t* parse_stream_chunk(const wchar_t* start, const wchar_t* endSentinel, const bool is_final)
+            { return parse(start, endSentinel, is_final); }
+        /**Parses the next part of a streamed UTF-8 <em>document.xml</em>.
+           @param start The start of the text to parse.
+           @param endSentinel The end of the text.
+           @param is_final Whether this is the end of the stream.
+           @returns Where parsing stopped.*/
+        virtual const char* parse_stream_chunk(const char* start, const char* endSentinel, const bool is_final)
+            { return parse(start, endSentinel, is_final); }
+    private:
+        template<typename T>
+        const wchar_t* extract(const T* html_text,
+                               const size_t text_length)
             {
             clear_log();
             if (html_text == NULL || html_text[0] == 0 || text_length == 0)
@@ -55,115 +136,204 @@ namespace lily_of_the_valley
                 set_filtered_text_length(0);
                 return NULL;
                 }
-            assert(text_length <= string_util::strlen(html_text) );
 
-            if (!allocate_text_buffer(text_length))
+            if (!begin_text())
                 {
                 set_filtered_text_length(0);
                 return NULL;
                 }
+            set_offset_source(html_text, text_length);
 
-            m_is_in_preformatted_text_block_stack = 1;//use "preserve spaces" logic in this XML
+            reset_stream_state(true);
+            /*only read up to the input budget, parsing it like a chunk of a stream
+              so that whatever is cut off at the end (e.g., half of an element) is left unread*/
+            const size_t readLength = get_input_budget_length(text_length);
+            parse(html_text, html_text+readLength, readLength == text_length);
+            if (readLength < text_length)
+                { exceed_budget(L"Input limit reached; the rest of the document was not read."); }
+            trim_to_budget_boundary();
+
+            return finalize_text();
+            }
+        template<typename T>
+        size_t extract_segment_text(const T* html_text, const size_t text_length,
+                                    const segment_state& start_state, const bool is_final, segment_state& end_state)
+            {
+            clear_log();
+            end_state = start_state;
+            if (!begin_text())
+                {
+                set_filtered_text_length(0);
+                return 0;
+                }
+            if (html_text == NULL || text_length == 0)
+                {
+                finalize_text();
+                return 0;
+                }
+            set_offset_source(html_text, text_length);
 
-            //find the first < and set up where we halt our searching
-            const wchar_t* start = string_util::strchr(html_text, common_lang_constants::LESS_THAN);
-            const wchar_t* end = NULL;
-            const wchar_t* const endSentinel = html_text+text_length;
+            reset_stream_state(true);
+            m_inside_of_table_cell = start_state.m_inside_of_table_cell;
+            m_is_in_text_section = start_state.m_is_in_text_section;
+            const T* const resumePosition = parse(html_text, html_text+text_length, is_final);
+            end_state.m_inside_of_table_cell = m_inside_of_table_cell;
+            end_state.m_is_in_text_section = m_is_in_text_section;
+
+            finalize_text();
+            return resumePosition-html_text;
+            }
+        /*Parses the elements (and the text runs between them) from text to endSentinel, picking up where the
+        last call left off. If is_final is false, then the text may be continued in another chunk, so an element
+        (or a comment or text run) that is cut off at endSentinel is not parsed. Returns where parsing stopped.*/
+        template<typename T>
+        const T* parse(const T* text, const T* const endSentinel, const bool is_final)
+            {
+            //a text run that was continued from the previous chunk
+            const T* start = string_util::strnchr<T>(text, common_lang_constants::LESS_THAN, endSentinel-text);
+            if (start != text)
+                {
+                if (!start)
+                    { return is_final ? endSentinel : text; }
+                if (m_is_in_text_section)
+                    { parse_raw_text(text, start-text); }
+                }
+            const T* end = NULL;
+            //where to pick up from in the next chunk
+            const T* resumePosition = endSentinel;
 
-            bool insideOfTableCell = false;
             while (start && (start < endSentinel))
                 {
-                const std::wstring currentTag = get_element_name(start+1);
+                //stop (and leave the rest of the text unread) if a budget has run out
+                if (!take_budget_step())
+                    { break; }
+                //make room for the newlines and tabs that an element can add
+                if (!reserve_text(2))
+                    { break; }
+                //when streaming, an element that is cut off is read once the rest of it is in
+                if (!is_final && !string_util::strnchr<T>(start+1, common_lang_constants::GREATER_THAN, endSentinel-(start+1)))
+                    {
+                    resumePosition = start;
+                    break;
+                    }
+                const basic_html_element_view<T> currentTag = read_element(start+1, endSentinel);
+                const markup_element currentTagId = classify_element(currentTag);
                 bool textSectionFound = false;
                 //if it's a comment then look for matching comment ending sequence
-                if (currentTag == L"!--")
+                if (currentTagId == xml_comment)
                     {
-                    end = string_util::strstr(start+1, L"-->");
+                    end = string_util::strnstr<T>(start+1, MARKUP_LITERAL(T, "-->"), endSentinel-(start+1));
                     if (!end)
-                        { break; }
+                        {
+                        resumePosition = start;
+                        break;
+                        }
                     end += 3;//-->
                     }
                 //if it's an instruction command then skip it
-                else if (currentTag == L"w:instrText")
+                else if (currentTagId == docx_instr_text)
                     {
-                    end = string_util::strstr(start+1, L"</w:instrText>");
+                    end = string_util::strnstr<T>(start+1, MARKUP_LITERAL(T, "</w:instrText>"), endSentinel-(start+1));
                     if (!end)
-                        { break; }
+                        {
+                        resumePosition = start;
+                        break;
+                        }
                     end += 14;
                     }
                 //if it's an offset command then skip it
-                else if (currentTag == L"wp:posOffset")
+                else if (currentTagId == docx_pos_offset)
                     {
-                    end = string_util::strstr(start+1, L"</wp:posOffset>");
+                    end = string_util::strnstr<T>(start+1, MARKUP_LITERAL(T, "</wp:posOffset>"), endSentinel-(start+1));
                     if (!end)
-                        { break; }
+                        {
+                        resumePosition = start;
+                        break;
+                        }
                     end += 15;
                     }
                 else
                     {
-                    //see if this should be treated as a new paragraph
-                    if (currentTag == L"w:p")
+                    switch (currentTagId)
                         {
+                    //see if this should be treated as a new paragraph
+                    case docx_p:
                         if (!m_preserve_text_table_layout ||
-                            (m_preserve_text_table_layout && !insideOfTableCell))
+                            (m_preserve_text_table_layout && !m_inside_of_table_cell))
                             {
                             add_character(L'\n');
                             add_character(L'\n');
                             }
-                        }
+                        break;
                     //if paragraph style indicates a list item
-                    else if (currentTag == L"w:pStyle")                    
+                    case docx_p_style:
                         {
-                        if (read_tag_as_string(start+1, L"w:val", 5, false) == L"ListParagraph")
+                        const std::pair<const T*, size_t> styleName = read_element_attribute(start+1, currentTag, MARKUP_LITERAL(T, "w:val"), 5);
+                        if (styleName.second == 13 && string_util::strncmp(styleName.first, MARKUP_LITERAL(T, "ListParagraph"), 13) == 0)
                             { add_character(L'\t'); }
                         }
+                        break;
                     //or a tab
-                    else if (currentTag == L"w:tab")                    
-                        { add_character(L'\t'); }
+                    case docx_tab:
+                        add_character(L'\t');
+                        break;
                     //hard breaks
-                    else if (currentTag == L"w:br" || currentTag == L"w:cr")                    
-                        { add_character(L'\n'); }
+                    case docx_br:
+                    case docx_cr:
+                        add_character(L'\n');
+                        break;
                     //or if it's aligned center or right
-                    else if (currentTag == L"w:jc")                    
+                    case docx_jc:
                         {
-                        std::wstring alignment = read_tag_as_string(start+1, L"w:val", 5, false);
-                        if (alignment == L"center" ||
-                            alignment == L"right" ||
-                            alignment == L"both" ||
-                            alignment == L"list-tab")
+                        const std::pair<const T*, size_t> alignment = read_element_attribute(start+1, currentTag, MARKUP_LITERAL(T, "w:val"), 5);
+                        if ((alignment.second == 6 && string_util::strncmp(alignment.first, MARKUP_LITERAL(T, "center"), 6) == 0) ||
+                            (alignment.second == 5 && string_util::strncmp(alignment.first, MARKUP_LITERAL(T, "right"), 5) == 0) ||
+                            (alignment.second == 4 && string_util::strncmp(alignment.first, MARKUP_LITERAL(T, "both"), 4) == 0) ||
+                            (alignment.second == 8 && string_util::strncmp(alignment.first, MARKUP_LITERAL(T, "list-tab"), 8) == 0))
                             { add_character(L'\t'); }
                         }
+                        break;
                     //or if it's indented
-                    else if (currentTag == L"w:ind")                    
+                    case docx_ind:
                         {
-                        std::wstring indentationString = read_tag_as_string(start+1, L"w:left", 6, false);
-                        if (!indentationString.empty())
+                        const std::pair<const T*, size_t> indentationString = read_element_attribute(start+1, currentTag, MARKUP_LITERAL(T, "w:left"), 6);
+                        if (indentationString.first && indentationString.second > 0)
                             {
-                            wchar_t* dummy = NULL;
-                            const double alignment = std::wcstod(indentationString.c_str(), &dummy);
+                            //the value is terminated by a quote or space, so it can be read from the stream directly
+                            T* dummy = NULL;
+                            const double alignment = string_util::strtod(indentationString.first, &dummy);
                             if (alignment > 0.0f)
                                 { add_character(L'\t'); }
                             }
                         }
+                        break;
                     //tab over table cell and newline for table rows
-                    else if (currentTag == L"w:tr")                    
-                        {
+                    case docx_tr:
                         add_character(L'\n');
                         add_character(L'\n');
-                        }
-                    else if (compare_element_case_sensitive(start+1, L"w:tc", 4, true) )                    
-                        {
+                        break;
+                    case docx_tc:
                         add_character(L'\t');
-                        insideOfTableCell = true;
+                        m_inside_of_table_cell = true;
+                        break;
+                    case docx_tc_end:
+                        m_inside_of_table_cell = false;
+                        break;
+                    //a text run (an empty, self-terminated one has nothing to read)
+                    case docx_t:
+                        textSectionFound = !currentTag.is_self_terminating();
+                        break;
+                    default:
+                        break;
                         }
-                    else if (compare_element_case_sensitive(start+1, L"/w:tc", 5) )                    
-                        { insideOfTableCell = false; }
-                    else if (compare_element_case_sensitive(start+1, L"w:t", 3) )  
-                        { textSectionFound = true; }
                     /*find the matching >, but watch out for an errant < also in case
-                    the previous < wasn't terminated properly*/
-                    end = string_util::strcspn_pointer<wchar_t>(start+1, L"<>", 2);
-                    if (!end)
+                    the previous < wasn't terminated properly. Reading the element already found its >
+                    (unless it skipped over a second < right after the first one).*/
+                    if (currentTag.get_close_tag() != NULL && start[1] != common_lang_constants::LESS_THAN)
+                        { end = currentTag.get_close_tag(); }
+                    else
+                        { end = start+1+string_util::strncspn<T>(start+1, endSentinel-(start+1), MARKUP_LITERAL(T, "<>"), 2); }
+                    if (end >= endSentinel)
                         { break; }
                     /*if the < tag that we started from is not terminated then feed that in as
                     text instead of treating it like a valid HTML tag.  Not common, but it happens.*/
@@ -181,18 +351,36 @@ namespace lily_of_the_valley
                         { ++end; }
                     }
                 //find the next starting tag
-                start = string_util::strchr(end, common_lang_constants::LESS_THAN);
+                m_is_in_text_section = textSectionFound;
+                start = string_util::strnchr<T>(end, common_lang_constants::LESS_THAN, endSentinel-end);
                 if (!start)
-                    { break; }
+                    {
+                    //the text after the last element may be continued in the next chunk
+                    resumePosition = end;
+                    break;
+                    }
                 //copy over the text between the tags
                 if (textSectionFound)
                     { parse_raw_text(end, start-end); }
                 }
 
-            return get_filtered_text();
+            return resumePosition;
+            }
+        /*Reads an attribute's value from an element, only looking as far as the element's own '>'.
+        An element that isn't terminated (i.e., another '<' comes first) has no attributes. Not looking
+        past the element means that the value doesn't depend on where a chunk (or segment) of the document ends.*/
+        template<typename T>
+        static std::pair<const T*, size_t> read_element_attribute(const T* text, const basic_html_element_view<T>& element,
+                                                                 const T* attribute, const size_t length)
+            {
+            if (element.get_close_tag() == NULL)
+                { return std::pair<const T*, size_t>(NULL,0); }
+            return read_tag(text, attribute, length, false, false, element.get_close_tag()+1);
             }
-    private:
         bool m_preserve_text_table_layout;
+        //the state that is carried from one chunk of a stream to the next
+        bool m_inside_of_table_cell;
+        bool m_is_in_text_section;
         };
     }
 
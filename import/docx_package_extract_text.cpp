@@ -0,0 +1,127 @@
+#include "docx_package_extract_text.h"
+
+namespace lily_of_the_valley
+    {
+    ///@brief A thread's part extractor, whose buffers are reused for each part that thread extracts.
+    class docx_package_extract_text::worker
+        {
+    public:
+        /**Extracts the text from a part.
+           @param package The package that the part is in.
+           @param part_name The path of the part.
+           @param preserve_table_layout Whether to import tables as tab-delimited cells of text.
+           @param[out] text The part's text.
+           @param[out] log The part's log.
+           @returns Whether the part could be read.*/
+        bool extract(const zip_package& package, const std::string& part_name, const bool preserve_table_layout,
+                     std::wstring& text, std::wstring& log)
+            {
+            text.clear();
+            log.clear();
+            m_docx.preserve_text_table_layout(preserve_table_layout);
+            const wchar_t* const partText = extract_package_part(package, part_name, m_docx, m_stream);
+            log = m_docx.get_log();
+            if (partText == NULL)
+                {
+                log += (log.empty() ? L"" : L"\n")+std::wstring(L"Unable to read part (it may be encrypted or corrupt).");
+                return false;
+                }
+            text.assign(partText, m_docx.get_filtered_text_length());
+            return true;
+            }
+    private:
+        docx_extract_text m_docx;
+        zip_entry_stream m_stream;
+        };
+
+    docx_package_extract_text::docx_package_extract_text(const size_t thread_count /*= 0*/) :
+        m_workers(thread_count), m_part_separator(L"\f"), m_preserve_text_table_layout(false)
+        {
+        m_part_markers[docx_header_part] = L"[Header]";
+        m_part_markers[docx_footer_part] = L"[Footer]";
+        m_part_markers[docx_footnotes_part] = L"[Footnotes]";
+        m_part_markers[docx_endnotes_part] = L"[Endnotes]";
+        m_part_markers[docx_comments_part] = L"[Comments]";
+        }
+
+    docx_package_extract_text::~docx_package_extract_text()
+        {}
+
+    const wchar_t* docx_package_extract_text::operator()(const zip_package& package)
+        {
+        clear_log();
+        log_unsupported_budget();
+        m_parts.clear();
+
+        //gather the parts, in the order that they will be written
+        if (package.find_entry("word/document.xml") != NULL)
+            { m_parts.push_back(docx_part("word/document.xml", docx_body_part)); }
+        const std::vector<std::string> headerNames = get_numbered_part_names(package, "word/header", ".xml");
+        for (size_t i = 0; i < headerNames.size(); ++i)
+            { m_parts.push_back(docx_part(headerNames[i], docx_header_part)); }
+        const std::vector<std::string> footerNames = get_numbered_part_names(package, "word/footer", ".xml");
+        for (size_t i = 0; i < footerNames.size(); ++i)
+            { m_parts.push_back(docx_part(footerNames[i], docx_footer_part)); }
+        if (package.find_entry("word/footnotes.xml") != NULL)
+            { m_parts.push_back(docx_part("word/footnotes.xml", docx_footnotes_part)); }
+        if (package.find_entry("word/endnotes.xml") != NULL)
+            { m_parts.push_back(docx_part("word/endnotes.xml", docx_endnotes_part)); }
+        if (package.find_entry("word/comments.xml") != NULL)
+            { m_parts.push_back(docx_part("word/comments.xml", docx_comments_part)); }
+        if (m_parts.empty())
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+
+        //extract the parts (largest first) into their own strings
+        m_part_text.resize(m_parts.size());
+        m_part_log.resize(m_parts.size());
+        m_is_part_read.assign(m_parts.size(), 0);
+        std::vector<size_t> costs(m_parts.size());
+        for (size_t i = 0; i < m_parts.size(); ++i)
+            { costs[i] = package.find_entry(m_parts[i].m_name)->m_uncompressed_size; }
+        m_workers.run(costs, [&](worker& partWorker, const size_t partIndex)
+            {
+            m_is_part_read[partIndex] = partWorker.extract(package, m_parts[partIndex].m_name,
+                m_preserve_text_table_layout, m_part_text[partIndex], m_part_log[partIndex]) ? 1 : 0;
+            },
+            [&](const size_t partIndex)
+            {
+            m_is_part_read[partIndex] = 0;
+            m_part_text[partIndex].clear();
+            m_part_log[partIndex] = L"Unable to extract text from part.";
+            });
+
+        //then put them together in order, leaving out the ones that couldn't be read
+        if (!begin_text())
+            {
+            set_filtered_text_length(0);
+            m_parts.clear();
+            return NULL;
+            }
+        std::vector<docx_part> writtenParts;
+        writtenParts.reserve(m_parts.size());
+        for (size_t i = 0; i < m_parts.size(); ++i)
+            {
+            if (!m_part_log[i].empty())
+                { log_message(to_wide_string(m_parts[i].m_name.c_str(), m_parts[i].m_name.length())+L": "+m_part_log[i]); }
+            if (!m_is_part_read[i])
+                { continue; }
+            if (!writtenParts.empty())
+                { add_characters(m_part_separator.c_str(), m_part_separator.length()); }
+            const std::wstring& marker = m_part_markers[m_parts[i].m_type];
+            if (!marker.empty())
+                {
+                add_characters(marker.c_str(), marker.length());
+                add_characters(L"\n", 1);
+                }
+            writtenParts.push_back(m_parts[i]);
+            writtenParts.back().m_offset = get_filtered_text_length();
+            writtenParts.back().m_length = m_part_text[i].length();
+            add_characters(m_part_text[i].c_str(), m_part_text[i].length());
+            }
+        m_parts.swap(writtenParts);
+        return finalize_text();
+        }
+    }
@@ -0,0 +1,151 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __DOCX_PACKAGE_EXTRACT_TEXT_H__
+#define __DOCX_PACKAGE_EXTRACT_TEXT_H__
+
+#include <string>
+#include <vector>
+#include "docx_extract_text.h"
+#include "package_extract_text.h"
+#include "../utilities/work_stealing_pool.h"
+
+namespace lily_of_the_valley
+    {
+    ///@brief The kinds of parts in a DOCX file that docx_package_extract_text reads, in the order that they are written.
+    enum docx_part_type
+        {
+        ///The main document (<em>word/document.xml</em>).
+        docx_body_part,
+        ///A header (<em>word/header[<b>NUMBER</b>].xml</em>).
+        docx_header_part,
+        ///A footer (<em>word/footer[<b>NUMBER</b>].xml</em>).
+        docx_footer_part,
+        ///The footnotes (<em>word/footnotes.xml</em>).
+        docx_footnotes_part,
+        ///The endnotes (<em>word/endnotes.xml</em>).
+        docx_endnotes_part,
+        ///The comments (<em>word/comments.xml</em>).
+        docx_comments_part,
+        ///The number of part types.
+        docx_part_type_count
+        };
+
+    ///@brief A part of a DOCX file that text was extracted from, and where its text is.
+    struct docx_part
+        {
+        ///Constructor.
+        docx_part() : m_type(docx_body_part), m_offset(0), m_length(0) {}
+        /**Constructor.
+           @param name The part's path inside of the package.
+           @param type The kind of part.*/
+        docx_part(const std::string& name, const docx_part_type type) :
+            m_name(name), m_type(type), m_offset(0), m_length(0) {}
+        std::string m_name;
+        docx_part_type m_type;
+        ///Where the part's text starts in the extracted text (after its marker).
+        size_t m_offset;
+        ///The length of the part's text.
+        size_t m_length;
+        };
+
+    /**@brief Class to extract text from all of the parts of a <b>Microsoft&reg; Word (2007+)</b> file:
+        its main document, headers, footers, footnotes, endnotes, and comments.
+    @details The parts are streamed out of the package (see extract_package_part()) and extracted across
+        multiple threads with docx_extract_text, and then their text is put together in this order (no matter
+        which part finishes first):
+        - The main document.
+        - The headers, then the footers (each by number).
+        - The footnotes, endnotes, and comments.
+
+        The parts are separated by a page break (a form feed, by default; see set_part_separator()), and each part
+        other than the main document starts with a marker line naming what it is (e.g., "[Footnotes]";
+        see set_part_marker()). Which parts were read, and where their text is, is available from get_parts().
+
+        A part that can't be read is logged (under its name) and left out, along with its marker and separator.
+    @note Requires C++11 (for @c std::thread). Call operator() for one file at a time;
+        to extract files from multiple threads, give each thread its own docx_package_extract_text.
+        Budgets (see set_budget()) are not supported by this class; use docx_extract_text for those.
+    @par Example:
+    @code
+        //Assuming that a DOCX file has been memory-mapped (or read) into a char* buffer
+        //named "fileContents" and "fileSize" is set to the size of the file.
+        lily_of_the_valley::zip_package package;
+        lily_of_the_valley::docx_package_extract_text docxExtract;
+        if (package.open(fileContents, fileSize) && docxExtract(package) != NULL)
+            {
+            std::wstring fileText(docxExtract.get_filtered_text(), docxExtract.get_filtered_text_length());
+            }
+    @endcode*/
+    class docx_package_extract_text : public extract_text
+        {
+    public:
+        /**Constructor.
+           @param thread_count The number of threads to use. If zero, then the number of cores on the system is used.*/
+        explicit docx_package_extract_text(const size_t thread_count = 0);
+        ///Destructor.
+        ~docx_package_extract_text();
+        /**Main interface for extracting plain text from a DOCX file.
+           @param package The open DOCX file.
+           @returns The text from the file's parts, or NULL if it has none of them (i.e., it isn't a DOCX file).
+            A part that can't be read (e.g., it is corrupt) is logged and left out.*/
+        const wchar_t* operator()(const zip_package& package);
+        /**Specifies how to import tables.
+        @param preserve Set to true to import tables as tab-delimited cells of text.
+            Set to false to simply import each cell as a separate paragraph (the default).*/
+        void preserve_text_table_layout(const bool preserve)
+            { m_preserve_text_table_layout = preserve; }
+        /**Sets the text written between parts.
+           @param separator The text to separate parts with. The default is a form feed ('\\f').*/
+        void set_part_separator(const std::wstring& separator)
+            { m_part_separator = separator; }
+        ///@returns The text written between parts.
+        const std::wstring& get_part_separator() const
+            { return m_part_separator; }
+        /**Sets the marker written on its own line at the start of a kind of part.
+           @param type The kind of part.
+           @param marker The marker, or an empty string to not write one. By default, the main document doesn't
+            have a marker and the other parts are "[Header]", "[Footer]", "[Footnotes]", "[Endnotes]", and "[Comments]".*/
+        void set_part_marker(const docx_part_type type, const std::wstring& marker)
+            {
+            if (type < docx_part_type_count)
+                { m_part_markers[type] = marker; }
+            }
+        /**@returns The marker written at the start of a kind of part.
+           @param type The kind of part.*/
+        const std::wstring& get_part_marker(const docx_part_type type) const
+            { return m_part_markers[(type < docx_part_type_count) ? type : docx_body_part]; }
+        ///@returns The parts that text was extracted from by the last call to operator(), in the order that they were written.
+        const std::vector<docx_part>& get_parts() const
+            { return m_parts; }
+        ///@returns The number of threads that parts are extracted on.
+        size_t get_thread_count() const
+            { return m_workers.get_thread_count(); }
+    private:
+        class worker;
+        //each thread's extractor and part stream, which are kept between files
+        worker_pool<worker> m_workers;
+        std::vector<docx_part> m_parts;
+        //each part's text (and log), before it is put together
+        std::vector<std::wstring> m_part_text;
+        std::vector<std::wstring> m_part_log;
+        //whether each part could be read (not a vector<bool>, because the threads write to it at the same time)
+        std::vector<char> m_is_part_read;
+        std::wstring m_part_separator;
+        std::wstring m_part_markers[docx_part_type_count];
+        bool m_preserve_text_table_layout;
+        //disable copy construction
+        docx_package_extract_text(const docx_package_extract_text&);
+        void operator=(const docx_package_extract_text&);
+        };
+    }
+
+/** @}*/
+
+#endif //__DOCX_PACKAGE_EXTRACT_TEXT_H__
@@ -0,0 +1,239 @@
+#include "docx_parallel_extract_text.h"
+
+namespace lily_of_the_valley
+    {
+    //how far back to look for a table cell in front of a place to split at
+    static const size_t TABLE_CELL_LOOKBEHIND = 64*1024;
+    //how many segments to make for each thread, so that a thread that finishes early can take on more
+    static const size_t SEGMENTS_PER_THREAD = 4;
+
+    /*Whether a place to split a document at is (probably) inside of a table cell, going by whether the
+      last table cell element in front of it is a start or an end. If this is wrong, then the segment
+      is extracted again, so this only needs to be right for well-formed documents.*/
+    template<typename T>
+    static bool is_inside_of_table_cell(const T* text, const T* const split_position)
+        {
+        const T* const lookBehindStart = (static_cast<size_t>(split_position-text) > TABLE_CELL_LOOKBEHIND) ?
+            split_position-TABLE_CELL_LOOKBEHIND : text;
+        const T* position = split_position;
+        while (position > lookBehindStart)
+            {
+            --position;
+            if (*position != common_lang_constants::LESS_THAN)
+                { continue; }
+            //only elements that are entirely in front of the split are looked at
+            const size_t available = split_position-position;
+            if (available >= 7 && string_util::strncmp(position, MARKUP_LITERAL(T, "</w:tc>"), 7) == 0)
+                { return false; }
+            //"<w:tc>" or "<w:tc " (but not "<w:tcPr>")
+            else if (available >= 6 && string_util::strncmp(position, MARKUP_LITERAL(T, "<w:tc"), 5) == 0 &&
+                (position[5] == common_lang_constants::GREATER_THAN || is_markup_space(position[5])))
+                { return true; }
+            }
+        return false;
+        }
+
+    /*Finds the first end of a paragraph or table (that isn't inside of a table cell) from position to end,
+      and returns where the text after it starts (or NULL if there isn't one).*/
+    template<typename T>
+    static const T* find_segment_boundary(const T* text, const T* position, const T* end)
+        {
+        while (position < end)
+            {
+            position = string_util::strnstr<T>(position, MARKUP_LITERAL(T, "</w:"), end-position);
+            if (position == NULL)
+                { return NULL; }
+            const T* boundary = NULL;
+            if (end-position >= 6 && string_util::strncmp(position, MARKUP_LITERAL(T, "</w:p>"), 6) == 0)
+                { boundary = position+6; }
+            else if (end-position >= 8 && string_util::strncmp(position, MARKUP_LITERAL(T, "</w:tbl>"), 8) == 0)
+                { boundary = position+8; }
+            if (boundary != NULL && !is_inside_of_table_cell(text, position))
+                { return boundary; }
+            position += 4;
+            }
+        return NULL;
+        }
+
+    ///@brief A thread's segment extractor, whose buffer is reused for each segment that thread extracts.
+    class docx_parallel_extract_text::worker
+        {
+    public:
+        /**Extracts the text from a segment.
+           @param text The start of the document.
+           @param seg The segment to extract (its state and length are read from it, and its results are written to it).
+           @param is_final Whether the segment is the end of the document.
+           @param preserve_table_layout Whether to import tables as tab-delimited cells of text.
+           @param copy_text Whether to copy the text into the segment. If false, then the text is left in
+            the extractor (see get_text()) until the next segment is extracted.*/
+        template<typename T>
+        void extract(const T* text, segment& seg, const bool is_final, const bool preserve_table_layout,
+                     const bool copy_text = true)
+            {
+            seg.m_text.clear();
+            seg.m_log.clear();
+            seg.m_end_state = seg.m_start_state;
+            seg.m_read_length = 0;
+            try
+                {
+                m_docx.preserve_text_table_layout(preserve_table_layout);
+                seg.m_read_length = m_docx.extract_segment(text+seg.m_start, seg.m_length,
+                                                            seg.m_start_state, is_final, seg.m_end_state);
+                //whatever is left at the end of the document was read the same way that it is when not split up
+                if (is_final)
+                    { seg.m_read_length = seg.m_length; }
+                //copy the text (rather than taking the extractor's buffer), so that the buffer is reused for the next segment
+                if (copy_text && m_docx.get_filtered_text() != NULL)
+                    { seg.m_text.assign(m_docx.get_filtered_text(), m_docx.get_filtered_text_length()); }
+                seg.m_log = m_docx.get_log();
+                }
+            catch (const std::exception&)
+                {
+                seg.m_text.clear();
+                seg.m_log = L"Unable to extract text from segment.";
+                }
+            }
+        ///@returns The extractor that the last segment was extracted with.
+        const docx_extract_text& get_text() const
+            { return m_docx; }
+    private:
+        docx_extract_text m_docx;
+        };
+
+    docx_parallel_extract_text::docx_parallel_extract_text(const size_t thread_count /*= 0*/) :
+        m_workers(thread_count), m_min_segment_size(1024*1024), m_segment_count(0),
+        m_reextracted_segment_count(0), m_preserve_text_table_layout(false)
+        {}
+
+    docx_parallel_extract_text::~docx_parallel_extract_text()
+        {}
+
+    const wchar_t* docx_parallel_extract_text::operator()(const wchar_t* html_text, const size_t text_length)
+        { return extract(html_text, text_length); }
+
+    const wchar_t* docx_parallel_extract_text::operator()(const char* html_text, const size_t text_length)
+        { return extract(html_text, text_length); }
+
+    template<typename T>
+    void docx_parallel_extract_text::split(const T* html_text, const size_t text_length)
+        {
+        m_segments.clear();
+        //with only one thread, splitting the document up would only add work
+        const size_t segmentCount = (get_thread_count() == 1) ? 1 : std::max<size_t>(1,
+            std::min(get_thread_count()*SEGMENTS_PER_THREAD, text_length/m_min_segment_size));
+        const size_t segmentSize = text_length/segmentCount;
+        const T* const textEnd = html_text+text_length;
+        const T* segmentStart = html_text;
+        for (size_t i = 1; i < segmentCount; ++i)
+            {
+            //split at the first end of a paragraph or table after the target, as long as it is before the next target
+            const T* const target = std::max(html_text+(i*segmentSize), segmentStart);
+            const T* const boundary = find_segment_boundary(html_text, target,
+                std::min(html_text+((i+1)*segmentSize), textEnd));
+            if (boundary == NULL || boundary >= textEnd)
+                { continue; }
+            segment seg;
+            seg.m_start = segmentStart-html_text;
+            seg.m_length = boundary-segmentStart;
+            seg.m_start_state.m_inside_of_table_cell = is_inside_of_table_cell(html_text, segmentStart);
+            m_segments.push_back(seg);
+            segmentStart = boundary;
+            }
+        segment seg;
+        seg.m_start = segmentStart-html_text;
+        seg.m_length = textEnd-segmentStart;
+        seg.m_start_state.m_inside_of_table_cell = is_inside_of_table_cell(html_text, segmentStart);
+        m_segments.push_back(seg);
+        //the start of the document is known for sure
+        m_segments.front().m_start_state = docx_extract_text::segment_state();
+        }
+
+    template<typename T>
+    const wchar_t* docx_parallel_extract_text::extract(const T* html_text, const size_t text_length)
+        {
+        clear_log();
+        log_unsupported_budget();
+        m_segment_count = m_reextracted_segment_count = 0;
+        if (html_text == NULL || html_text[0] == 0 || text_length == 0)
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+
+        //extract the segments (largest first) into their own strings
+        split(html_text, text_length);
+        m_segment_count = m_segments.size();
+        std::vector<size_t> costs(m_segments.size());
+        for (size_t i = 0; i < m_segments.size(); ++i)
+            { costs[i] = m_segments[i].m_length; }
+        const size_t lastSegment = m_segments.size()-1;
+        //a document that isn't split up is copied straight out of the extractor, rather than through a segment
+        if (m_segments.size() == 1)
+            {
+            m_workers.get_worker(0).extract(html_text, m_segments[0], true, m_preserve_text_table_layout, false);
+            const docx_extract_text& docx = m_workers.get_worker(0).get_text();
+            if (!begin_text() || !reserve_text(docx.get_filtered_text_length()))
+                {
+                set_filtered_text_length(0);
+                return NULL;
+                }
+            if (docx.get_filtered_text() != NULL)
+                { add_characters(docx.get_filtered_text(), docx.get_filtered_text_length()); }
+            add_segment(m_segments[0]);
+            return finalize_text();
+            }
+        m_workers.run(costs, [&](worker& segmentWorker, const size_t segmentIndex)
+            {
+            segmentWorker.extract(html_text, m_segments[segmentIndex],
+                                            (segmentIndex == lastSegment), m_preserve_text_table_layout);
+            });
+
+        /*then put them together in order, making sure that each segment started with the state that the
+          one in front of it ended with (and ended where the next one starts)*/
+        if (!begin_text())
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+        size_t textLength = 0;
+        for (size_t i = 0; i < m_segments.size(); ++i)
+            { textLength += m_segments[i].m_text.length(); }
+        //make room for all of the text up front (this is only a guess if segments need to be extracted again)
+        if (!reserve_text(textLength))
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+        docx_extract_text::segment_state state;
+        for (size_t i = 0; i < m_segments.size(); /*in loop*/)
+            {
+            segment& seg = m_segments[i];
+            size_t last = i;
+            if (!(seg.m_start_state == state))
+                {
+                seg.m_start_state = state;
+                m_workers.get_worker(0).extract(html_text, seg, (last == lastSegment), m_preserve_text_table_layout);
+                ++m_reextracted_segment_count;
+                }
+            //if the segment was cut off in the middle of something, then read it along with the next one
+            while (seg.m_read_length < seg.m_length && last < lastSegment)
+                {
+                ++last;
+                seg.m_length = (m_segments[last].m_start+m_segments[last].m_length)-seg.m_start;
+                m_workers.get_worker(0).extract(html_text, seg, (last == lastSegment), m_preserve_text_table_layout);
+                ++m_reextracted_segment_count;
+                }
+            add_segment(seg);
+            state = seg.m_end_state;
+            i = last+1;
+            }
+        return finalize_text();
+        }
+
+    void docx_parallel_extract_text::add_segment(const segment& seg)
+        {
+        add_characters(seg.m_text.c_str(), seg.m_text.length());
+        if (!seg.m_log.empty())
+            { log_message(seg.m_log); }
+        }
+    }
@@ -0,0 +1,124 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __DOCX_PARALLEL_EXTRACT_TEXT_H__
+#define __DOCX_PARALLEL_EXTRACT_TEXT_H__
+
+#include <string>
+#include <vector>
+#include "docx_extract_text.h"
+#include "../utilities/work_stealing_pool.h"
+
+namespace lily_of_the_valley
+    {
+    /**@brief Class to extract text from a very large <b>Microsoft&reg; Word (2007+)</b> <em>document.xml</em>
+        across multiple threads.
+    @details The document is split into segments at the ends of paragraphs and tables (<em>&lt;/w:p&gt;</em>
+        and <em>&lt;/w:tbl&gt;</em>) that are outside of table cells, the segments are extracted across multiple
+        threads with docx_extract_text::extract_segment(), and then their text is put together in order.
+
+        The text is the same as what docx_extract_text returns for the whole document. Each segment is extracted
+        assuming the state (e.g., whether it is inside of a table cell) that it starts with; after the segments are
+        extracted, each one's assumed state is checked against where the segment in front of it actually ended.
+        Elements' attributes are only read up to the element's own '>', so a segment's text depends only on
+        its starting state and how far into it was read (not on where the segment ends).
+        A segment that was split in the wrong place (e.g., in the middle of a comment in malformed XML) or that
+        assumed the wrong state is extracted again on the calling thread, so the text is always the same
+        (it is only slower in that case).
+
+        Documents smaller than two segments (see set_min_segment_size()) are extracted on the calling thread.
+    @note Requires C++11 (for @c std::thread). Call operator() for one <em>document.xml</em> at a time.
+        Offsets (see set_offset_map()) and budgets (see set_budget()) are not supported by this class;
+        use docx_extract_text for those.
+    @par Example:
+    @code
+        //Assuming that the contents of "document.xml" from a DOCX file is in a
+        //char* buffer named "fileContents" and "fileSize" is set to the size
+        //of this document.xml.
+        lily_of_the_valley::docx_parallel_extract_text docxExtract;
+        docxExtract(fileContents, fileSize);
+        std::wstring fileText(docxExtract.get_filtered_text(), docxExtract.get_filtered_text_length());
+    @endcode*/
+    class docx_parallel_extract_text : public extract_text
+        {
+    public:
+        /**Constructor.
+           @param thread_count The number of threads to use. If zero, then the number of cores on the system is used.*/
+        explicit docx_parallel_extract_text(const size_t thread_count = 0);
+        ///Destructor.
+        ~docx_parallel_extract_text();
+        /**Main interface for extracting plain text from a DOCX stream.
+        @param html_text The <em>document.xml</em> text to extract text from.
+        @param text_length The length of the <em>document.xml</em> stream.
+        @returns A pointer to the parsed text, or NULL upon failure.*/
+        const wchar_t* operator()(const wchar_t* html_text, const size_t text_length);
+        /**Main interface for extracting plain text from a UTF-8 DOCX stream.
+        @param html_text The UTF-8 <em>document.xml</em> text to extract text from.
+        @param text_length The length (in bytes) of the <em>document.xml</em> stream.
+        @returns A pointer to the parsed text, or NULL upon failure.*/
+        const wchar_t* operator()(const char* html_text, const size_t text_length);
+        /**Specifies how to import tables.
+        @param preserve Set to true to import tables as tab-delimited cells of text.
+            Set to false to simply import each cell as a separate paragraph (the default).*/
+        void preserve_text_table_layout(const bool preserve)
+            { m_preserve_text_table_layout = preserve; }
+        /**Sets the smallest segment that a document is split into (the default is 1MB).
+           @param length The segment size (in characters, or bytes for UTF-8 text).*/
+        void set_min_segment_size(const size_t length)
+            { m_min_segment_size = std::max<size_t>(length, 1); }
+        ///@returns The smallest segment that a document is split into.
+        size_t get_min_segment_size() const
+            { return m_min_segment_size; }
+        ///@returns The number of segments that the last document was split into.
+        size_t get_segment_count() const
+            { return m_segment_count; }
+        /**@returns The number of segments from the last document that had to be extracted again
+            (because they were split in the wrong place or assumed the wrong state).*/
+        size_t get_reextracted_segment_count() const
+            { return m_reextracted_segment_count; }
+        ///@returns The number of threads that segments are extracted on.
+        size_t get_thread_count() const
+            { return m_workers.get_thread_count(); }
+    private:
+        class worker;
+        ///@brief A segment's assumed state and its results.
+        struct segment
+            {
+            segment() : m_start(0), m_length(0), m_read_length(0) {}
+            size_t m_start;
+            size_t m_length;
+            docx_extract_text::segment_state m_start_state;
+            docx_extract_text::segment_state m_end_state;
+            size_t m_read_length;
+            std::wstring m_text;
+            std::wstring m_log;
+            };
+        template<typename T>
+        const wchar_t* extract(const T* html_text, const size_t text_length);
+        template<typename T>
+        void split(const T* html_text, const size_t text_length);
+        //puts a segment's (or a range of segments') results into the text
+        void add_segment(const segment& seg);
+
+        //each thread's segment extractor, which is kept between documents (the first one also re-extracts segments)
+        worker_pool<worker> m_workers;
+        std::vector<segment> m_segments;
+        size_t m_min_segment_size;
+        size_t m_segment_count;
+        size_t m_reextracted_segment_count;
+        bool m_preserve_text_table_layout;
+        //disable copy construction
+        docx_parallel_extract_text(const docx_parallel_extract_text&);
+        void operator=(const docx_parallel_extract_text&);
+        };
+    }
+
+/** @}*/
+
+#endif //__DOCX_PARALLEL_EXTRACT_TEXT_H__
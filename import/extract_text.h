@@ -11,28 +11,543 @@ it under the terms of the BSD License.
 #define __EXTRACT_TEXT_H__
 
 #include <exception>
+#include <new>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <cstring>
 #include "../indexing/string_util.h"
 
+/**@def EXTRACT_TEXT_HAS_MOVE_SEMANTICS
+    Defined if the compiler supports rvalue references, in which case the extractors are movable.*/
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+    #define EXTRACT_TEXT_HAS_MOVE_SEMANTICS
+#endif
+
 ///Namespace for text extracting classes.
 namespace lily_of_the_valley
     {
+    /**@brief Interface for where an extractor writes its text to.
+    @details Extractors write straight into the buffer that the sink hands them and only
+        call back into the sink when they need more room (or are finished). Room is asked for
+        ahead of time (often more than the text will end up needing), so that a sink that can
+        grow is grown in large steps. If a sink can't make that much room, then the text is
+        still written until a character that really doesn't fit comes along.
+        Pass a sink to extract_text::set_text_sink() to use it.*/
+    class text_sink
+        {
+    public:
+        ///Destructor.
+        virtual ~text_sink() {}
+        /**Called when an extractor starts writing a new block of text.
+           @param[out] buffer The buffer to start writing to. This can be NULL, in which case grow() will be called before anything is written.
+           @param[out] capacity The size of @c buffer.*/
+        virtual void begin(wchar_t*& buffer, size_t& capacity) = 0;
+        /**Called when the extractor needs more room to write to.
+           @param[in,out] buffer The buffer being written to. Set this to the buffer to continue writing to (which can be the same buffer).
+           @param[in,out] length The number of characters written to @c buffer. Set this to the number of those characters that
+            are still at the start of the (new) buffer (e.g., zero if they were handed off somewhere else).
+           @param[in,out] capacity The size of @c buffer. Set this to the size of the (new) buffer.
+           @param required The number of characters that must fit after the @c length characters still in the buffer.
+           @returns Whether the room could be made.*/
+        virtual bool grow(wchar_t*& buffer, size_t& length, size_t& capacity, const size_t required) = 0;
+        /**Called when the extractor is finished with the current block of text.
+           @param buffer The text still in the buffer (it will be NULL terminated).
+           @param length The length of the text.*/
+        virtual void end(const wchar_t* buffer, const size_t length)
+            {
+            (void)buffer;
+            (void)length;
+            }
+        };
+
+    /**@brief Sink that writes to a buffer that grows (by doubling) as needed.
+    @details This is the sink that extract_text uses by default. The buffer is reused between blocks of text.*/
+    class growable_text_sink : public text_sink
+        {
+    public:
+        ///Constructor.
+        growable_text_sink() : m_buffer(NULL), m_capacity(0) {}
+    #ifdef EXTRACT_TEXT_HAS_MOVE_SEMANTICS
+        ///Move constructor.
+        growable_text_sink(growable_text_sink&& that) : m_buffer(that.m_buffer), m_capacity(that.m_capacity)
+            {
+            that.m_buffer = NULL;
+            that.m_capacity = 0;
+            }
+        ///Move assignment.
+        growable_text_sink& operator=(growable_text_sink&& that)
+            {
+            if (this != &that)
+                {
+                delete [] m_buffer;
+                m_buffer = that.m_buffer;
+                m_capacity = that.m_capacity;
+                that.m_buffer = NULL;
+                that.m_capacity = 0;
+                }
+            return *this;
+            }
+    #endif
+        ///Destructor.
+        ~growable_text_sink()
+            { delete [] m_buffer; }
+        void begin(wchar_t*& buffer, size_t& capacity)
+            {
+            buffer = m_buffer;
+            capacity = m_capacity;
+            }
+        bool grow(wchar_t*& buffer, size_t& length, size_t& capacity, const size_t required)
+            {
+            const size_t newCapacity = std::max(std::max<size_t>(m_capacity*2, get_minimum_chunk_size()), length+required);
+            wchar_t* newBuffer = NULL;
+            try
+                { newBuffer = new wchar_t[newCapacity]; }
+            catch (const std::bad_alloc&)
+                { return false; }
+            //the text being written may not be in our buffer (e.g., if it was in a buffer that overflowed)
+            if (length > 0)
+                { std::wmemcpy(newBuffer, buffer, length); }
+            delete [] m_buffer;
+            buffer = m_buffer = newBuffer;
+            capacity = m_capacity = newCapacity;
+            return true;
+            }
+        /**Makes sure that the buffer can hold a number of characters without having to grow.
+           @param capacity The number of characters.
+           @returns False if the buffer could not be allocated.
+           @note Any text already in the buffer is not kept.*/
+        bool reserve(const size_t capacity)
+            {
+            if (capacity <= m_capacity)
+                { return true; }
+            wchar_t* newBuffer = NULL;
+            try
+                { newBuffer = new wchar_t[capacity]; }
+            catch (const std::bad_alloc&)
+                { return false; }
+            delete [] m_buffer;
+            m_buffer = newBuffer;
+            m_capacity = capacity;
+            return true;
+            }
+        /**Transfers ownership of the buffer to the caller (who must delete [] it).
+           A new buffer will be allocated the next time one is needed.
+           @returns The buffer (which may be NULL if one was never allocated).*/
+        wchar_t* release()
+            {
+            wchar_t* buffer = m_buffer;
+            m_buffer = NULL;
+            m_capacity = 0;
+            return buffer;
+            }
+        ///@returns The size of the buffer.
+        size_t get_capacity() const
+            { return m_capacity; }
+        ///@returns The smallest size that the buffer is grown to.
+        static size_t get_minimum_chunk_size()
+            { return 4*1024; }
+    private:
+        wchar_t* m_buffer;
+        size_t m_capacity;
+        //disable copy construction
+        growable_text_sink(const growable_text_sink&);
+        void operator=(const growable_text_sink&);
+        };
+
+    /**@brief Sink that writes to a fixed-size buffer provided by the caller.
+    @details If the text does not fit (including its NULL terminator), then extraction stops
+        at that point and a message is logged. The caller owns the buffer.*/
+    class fixed_text_sink : public text_sink
+        {
+    public:
+        /**Constructor.
+           @param buffer The buffer to write to.
+           @param size The size of @c buffer.*/
+        fixed_text_sink(wchar_t* buffer, const size_t size) : m_buffer(buffer), m_size(size) {}
+        void begin(wchar_t*& buffer, size_t& capacity)
+            {
+            buffer = m_buffer;
+            capacity = m_size;
+            }
+        bool grow(wchar_t*&, size_t&, size_t&, const size_t)
+            { return false; }
+    private:
+        wchar_t* m_buffer;
+        size_t m_size;
+        };
+
+    /**@brief Sink that writes into a @c std::wstring.
+    @details The string is cleared when an extractor starts and is sized to the text when it finishes.*/
+    class wstring_text_sink : public text_sink
+        {
+    public:
+        /**Constructor.
+           @param output The string to write to. It must outlive this sink.*/
+        explicit wstring_text_sink(std::wstring& output) : m_output(output) {}
+        void begin(wchar_t*& buffer, size_t& capacity)
+            {
+            m_output.clear();
+            buffer = NULL;
+            capacity = 0;
+            }
+        bool grow(wchar_t*& buffer, size_t& length, size_t& capacity, const size_t required)
+            {
+            try
+                {
+                m_output.resize(std::max(std::max<size_t>(m_output.length()*2, growable_text_sink::get_minimum_chunk_size()), length+required));
+                }
+            catch (const std::exception&)
+                { return false; }
+            buffer = &m_output[0];
+            capacity = m_output.length();
+            return true;
+            }
+        void end(const wchar_t*, const size_t length)
+            { m_output.resize(length); }
+    private:
+        std::wstring& m_output;
+        //disable assignment
+        void operator=(const wstring_text_sink&);
+        };
+
+    /**@brief Sink that hands the text to a callback, one chunk at a time.
+    @details The extractor only keeps a chunk of text in memory; when that is full, it is
+        passed to the callback (except for its last character) and the chunk is reused.
+        When the extractor finishes, the rest of the text is passed to the callback.
+    @note Because earlier text has been handed off, get_filtered_text() will only hold the last chunk.*/
+    class callback_text_sink : public text_sink
+        {
+    public:
+        /**The callback that receives the text.
+           @param text The chunk of text (which is not NULL terminated).
+           @param length The length of the chunk.
+           @param user_data The data passed to the sink's constructor.*/
+        typedef void (*text_callback)(const wchar_t* text, const size_t length, void* user_data);
+        /**Constructor.
+           @param callback The function to pass the text to.
+           @param user_data Data to pass to the callback (e.g., the object that it should write to).
+           @param chunk_size The number of characters to collect before passing them to the callback.*/
+        callback_text_sink(text_callback callback, void* user_data, const size_t chunk_size = 64*1024) :
+            m_callback(callback), m_user_data(user_data), m_chunk_size(chunk_size),
+            m_buffer(NULL), m_capacity(0)
+            { assert(callback && "NULL callback passed to callback_text_sink."); }
+        ///Destructor.
+        ~callback_text_sink()
+            { delete [] m_buffer; }
+        void begin(wchar_t*& buffer, size_t& capacity)
+            {
+            buffer = m_buffer;
+            capacity = m_capacity;
+            }
+        bool grow(wchar_t*& buffer, size_t& length, size_t& capacity, const size_t required)
+            {
+            //hand off everything but the last character, which is kept so that the extractor can still look back at it
+            if (length > 1)
+                {
+                m_callback(buffer, length-1, m_user_data);
+                buffer[0] = buffer[length-1];
+                length = 1;
+                }
+            if (m_capacity < length+required)
+                {
+                const size_t newCapacity = std::max(m_chunk_size, length+required);
+                wchar_t* newBuffer = NULL;
+                try
+                    { newBuffer = new wchar_t[newCapacity]; }
+                catch (const std::bad_alloc&)
+                    { return false; }
+                if (length > 0)
+                    { newBuffer[0] = buffer[0]; }
+                delete [] m_buffer;
+                m_buffer = newBuffer;
+                m_capacity = newCapacity;
+                }
+            buffer = m_buffer;
+            capacity = m_capacity;
+            return true;
+            }
+        void end(const wchar_t* buffer, const size_t length)
+            {
+            if (length > 0)
+                { m_callback(buffer, length, m_user_data); }
+            }
+    private:
+        text_callback m_callback;
+        void* m_user_data;
+        size_t m_chunk_size;
+        wchar_t* m_buffer;
+        size_t m_capacity;
+        //disable copy construction
+        callback_text_sink(const callback_text_sink&);
+        void operator=(const callback_text_sink&);
+        };
+
+    /**@brief Limits on how much work an extractor does on a single document.
+    @details When any of these run out, the extractor stops early and returns the text that it has extracted
+        so far, cut back to the end of its last paragraph (or word, if that would lose most of the text).
+        Call extract_text::is_budget_exceeded() afterwards to see if this happened.
+        This is useful when only the start of a document's text is needed (e.g., for a preview or
+        to detect its language), and to limit the time spent on pathological documents.
+        A limit of zero means that there is no limit.
+    @note There is no wall-clock (time) limit: the time spent on a document is limited by counting parsing steps
+        (m_max_steps) instead, which doesn't depend on the machine or its load, so a document's text is always
+        cut off in the same place.*/
+    struct extraction_budget
+        {
+        ///Constructor (with no limits).
+        extraction_budget() : m_max_output_length(0), m_max_input_length(0), m_max_steps(0) {}
+        ///The most characters of text to extract.
+        size_t m_max_output_length;
+        ///The most characters (or bytes, for UTF-8) of the document to read.
+        size_t m_max_input_length;
+        /**The most parsing steps to take, where each element (or run of text between elements) is a step.
+           For Postscript, each section of text is a step; Unicode streams are converted in one step, so this doesn't apply to them.*/
+        size_t m_max_steps;
+        };
+
+    /**@brief Records where each character of an extractor's text came from in the document that it was extracted from
+        (e.g., to highlight a search hit in the original HTML without parsing it again).
+    @details The map is a list of runs, where each run is a stretch of the text that was copied from a stretch of the
+        document. Text that is copied straight over (which is most of it) is recorded as one run per stretch, so the map
+        is usually a small fraction of the size of the text. Offsets into the document are in characters for wide
+        documents and bytes for UTF-8 ones.
+
+        Characters that the extractor wrote itself (e.g., the newlines between paragraphs) are not part of any run.
+        An entity (e.g., <tt>&amp;amp;</tt>) is recorded as its own run, which points to the start of the entity.
+    @par Example:
+    @code
+        lily_of_the_valley::text_offset_map offsets;
+        lily_of_the_valley::html_extract_text htmlExtract;
+        htmlExtract.set_offset_map(&offsets);
+        const wchar_t* text = htmlExtract(page, pageLength, true, false);
+        //where the search hit at hitPosition starts in page
+        const size_t hitStart = offsets.find_input_offset(hitPosition, page, pageLength);
+    @endcode*/
+    class text_offset_map
+        {
+    public:
+        ///@brief A stretch of the extracted text and where it came from.
+        struct run
+            {
+            ///Constructor.
+            run(const size_t output_offset, const size_t input_offset, const size_t length) :
+                m_output_offset(output_offset), m_input_offset(input_offset), m_length(length) {}
+            ///Where the run starts in the extracted text.
+            size_t m_output_offset;
+            ///Where the run starts in the document.
+            size_t m_input_offset;
+            ///The number of characters in the extracted text that the run covers.
+            size_t m_length;
+            };
+        ///Constructor.
+        text_offset_map() : m_last_input_end(0), m_is_last_run_copied(false) {}
+        ///Removes all of the runs.
+        void clear()
+            {
+            m_runs.clear();
+            m_is_last_run_copied = false;
+            }
+        ///@returns The runs, in the order of the extracted text.
+        const std::vector<run>& get_runs() const
+            { return m_runs; }
+        /**Finds where a character in the extracted text came from in a document that was copied straight over
+           character for character (i.e., a wide document, or one that is only ASCII).
+           @param output_offset The position in the extracted text.
+           @returns The position in the document. Characters that the extractor wrote itself are mapped to the
+            end of the text in front of them.*/
+        size_t find_input_offset(const size_t output_offset) const
+            {
+            const run* foundRun = find_run(output_offset);
+            if (foundRun == NULL)
+                { return 0; }
+            return foundRun->m_input_offset+std::min(output_offset-foundRun->m_output_offset, foundRun->m_length);
+            }
+        /**Finds where a character in the extracted text came from in a UTF-8 document.
+           @param output_offset The position in the extracted text.
+           @param input The document that the text was extracted from.
+           @param input_length The length (in bytes) of the document.
+           @returns The position (in bytes) in the document. Characters that the extractor wrote itself are mapped to the
+            end of the text in front of them.*/
+        size_t find_input_offset(const size_t output_offset, const char* input, const size_t input_length) const
+            {
+            const run* foundRun = find_run(output_offset);
+            if (foundRun == NULL || input == NULL)
+                { return 0; }
+            //walk through the run, one decoded character at a time
+            const char* position = input+std::min(foundRun->m_input_offset, input_length);
+            const char* const inputEnd = input+input_length;
+            size_t charactersLeft = std::min(output_offset-foundRun->m_output_offset, foundRun->m_length);
+            while (charactersLeft > 0 && position < inputEnd)
+                {
+                const size_t sequenceLength = utf8_sequence_length(position, inputEnd);
+                //characters beyond the Basic Multilingual Plane take up two slots when wchar_t is 16-bit
+                const size_t slots = (sizeof(wchar_t) == 2 && sequenceLength == 4) ? 2 : 1;
+                position += sequenceLength;
+                charactersLeft -= std::min(slots, charactersLeft);
+                }
+            return (position-input);
+            }
+        /**Adds a run of text that was copied from the document.
+           @param output_offset Where the run starts in the extracted text.
+           @param input_offset Where the run starts in the document.
+           @param length The number of characters that were written to the extracted text.
+           @param input_length The number of characters (or bytes) that were read from the document.
+           @param is_copied Whether the text was copied over character for character (as opposed to being decoded
+            from something like an entity). Runs that are copied and follow each other in both the text and
+            the document are merged into one.*/
+        void add(size_t output_offset, size_t input_offset, size_t length, const size_t input_length, const bool is_copied)
+            {
+            if (length == 0)
+                { return; }
+            if (!m_runs.empty())
+                {
+                run& lastRun = m_runs.back();
+                const size_t lastOutputEnd = lastRun.m_output_offset+lastRun.m_length;
+                //don't record text that is already covered (e.g., an entity that was copied over as-is)
+                if (output_offset < lastOutputEnd)
+                    {
+                    if (output_offset+length <= lastOutputEnd)
+                        { return; }
+                    const size_t overlap = lastOutputEnd-output_offset;
+                    output_offset += overlap;
+                    input_offset += overlap;
+                    length -= overlap;
+                    }
+                else if (is_copied && m_is_last_run_copied &&
+                    output_offset == lastOutputEnd && input_offset == m_last_input_end)
+                    {
+                    lastRun.m_length += length;
+                    m_last_input_end += input_length;
+                    return;
+                    }
+                }
+            m_runs.push_back(run(output_offset, input_offset, length));
+            m_last_input_end = input_offset+input_length;
+            m_is_last_run_copied = is_copied;
+            }
+        /**Removes anything recorded beyond a given length of the extracted text (e.g., when text is trimmed off).
+           @param output_length The new length of the extracted text.*/
+        void truncate(const size_t output_length)
+            {
+            while (!m_runs.empty() && m_runs.back().m_output_offset >= output_length)
+                { m_runs.pop_back(); }
+            if (!m_runs.empty() && m_runs.back().m_output_offset+m_runs.back().m_length > output_length)
+                { m_runs.back().m_length = output_length-m_runs.back().m_output_offset; }
+            m_is_last_run_copied = false;
+            }
+    private:
+        ///@returns The last run starting at or before an offset in the extracted text, or NULL if there isn't one.
+        const run* find_run(const size_t output_offset) const
+            {
+            size_t low = 0, high = m_runs.size();
+            while (low < high)
+                {
+                const size_t middle = low+(high-low)/2;
+                if (m_runs[middle].m_output_offset <= output_offset)
+                    { low = middle+1; }
+                else
+                    { high = middle; }
+                }
+            return (low > 0) ? &m_runs[low-1] : NULL;
+            }
+        /**@returns The number of bytes in the UTF-8 sequence at @c text, or 1 for an invalid one
+            (which the extractors decode as a single Latin-1 character; see extract_text::decode_utf8()).*/
+        static size_t utf8_sequence_length(const char* text, const char* textEnd)
+            {
+            const unsigned char leadByte = static_cast<unsigned char>(*text);
+            const size_t sequenceLength = (leadByte >= 0xC2 && leadByte <= 0xDF) ? 2 :
+                                          (leadByte >= 0xE0 && leadByte <= 0xEF) ? 3 :
+                                          (leadByte >= 0xF0 && leadByte <= 0xF4) ? 4 : 1;
+            if (sequenceLength == 1 || static_cast<size_t>(textEnd-text) < sequenceLength)
+                { return 1; }
+            unsigned int codePoint = leadByte & (0xFF >> (sequenceLength+1));
+            for (size_t i = 1; i < sequenceLength; ++i)
+                {
+                const unsigned char continuationByte = static_cast<unsigned char>(text[i]);
+                if ((continuationByte & 0xC0) != 0x80)
+                    { return 1; }
+                codePoint = (codePoint << 6) | (continuationByte & 0x3F);
+                }
+            if ((sequenceLength == 3 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF))) ||
+                (sequenceLength == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF)))
+                { return 1; }
+            return sequenceLength;
+            }
+        std::vector<run> m_runs;
+        //where the last run ends in the document and whether later text can be merged into it
+        size_t m_last_input_end;
+        bool m_is_last_run_copied;
+        };
+
     /**@brief Base class for text extraction (from marked-up formats).
        Derived classes will usually implement operator() to parse a formatted
-       buffer and then store the raw text in here.*/
+       buffer and then store the raw text in here.
+       @note By default, the text is written to an internal buffer that grows as needed.
+        Call set_text_sink() to write it somewhere else (e.g., a @c std::wstring or a callback).*/
     class extract_text
         {
     public:
         ///Default constructor.
         extract_text() : m_log_message_separator(L"\n"),
-                         m_owns_buffer(false), m_text_buffer_size(0),
+                         m_external_sink(NULL, 0), m_sink(&m_internal_sink), m_text_truncated(false),
+                         m_is_budget_exceeded(false), m_steps_taken(0),
+                         m_offset_map(NULL), m_source_start(NULL), m_source_end(NULL),
+                         m_source_character_size(1), m_source_offset(0), m_handed_off_length(0),
+                         m_text_buffer_size(0),
                          m_filtered_text_length(0), m_text_buffer(NULL) {}
-        ///Destructor.
-        virtual ~extract_text()
+    #ifdef EXTRACT_TEXT_HAS_MOVE_SEMANTICS
+        /**Move constructor. The extracted text (and the buffer holding it) is taken from @c that,
+           which is left as if it had just been constructed (including its budget and offset map).
+           Options of a derived class (e.g., html_extract_text::set_event_handler()) are copied, not reset.*/
+        extract_text(extract_text&& that) : m_log(std::move(that.m_log)),
+                         m_log_message_separator(std::move(that.m_log_message_separator)),
+                         m_internal_sink(std::move(that.m_internal_sink)), m_external_sink(that.m_external_sink),
+                         m_sink(&m_internal_sink), m_text_truncated(that.m_text_truncated),
+                         m_budget(that.m_budget), m_is_budget_exceeded(that.m_is_budget_exceeded),
+                         m_steps_taken(that.m_steps_taken),
+                         m_offset_map(that.m_offset_map), m_source_start(that.m_source_start),
+                         m_source_end(that.m_source_end), m_source_character_size(that.m_source_character_size),
+                         m_source_offset(that.m_source_offset), m_handed_off_length(that.m_handed_off_length),
+                         m_text_buffer_size(that.m_text_buffer_size),
+                         m_filtered_text_length(that.m_filtered_text_length), m_text_buffer(that.m_text_buffer)
             {
-            if (is_using_internal_buffer())
-                { delete [] m_text_buffer; }
-            m_text_buffer = NULL;
+            adopt_sink(that);
+            that.reset_after_move();
+            }
+        /**Move assignment. The extracted text (and the buffer holding it) is taken from @c that,
+           which is left as if it had just been constructed (including its budget and offset map).
+           Options of a derived class (e.g., html_extract_text::set_event_handler()) are copied, not reset.*/
+        extract_text& operator=(extract_text&& that)
+            {
+            if (this != &that)
+                {
+                m_log = std::move(that.m_log);
+                m_log_message_separator = std::move(that.m_log_message_separator);
+                m_internal_sink = std::move(that.m_internal_sink);
+                m_external_sink = that.m_external_sink;
+                m_text_truncated = that.m_text_truncated;
+                m_budget = that.m_budget;
+                m_is_budget_exceeded = that.m_is_budget_exceeded;
+                m_steps_taken = that.m_steps_taken;
+                m_offset_map = that.m_offset_map;
+                m_source_start = that.m_source_start;
+                m_source_end = that.m_source_end;
+                m_source_character_size = that.m_source_character_size;
+                m_source_offset = that.m_source_offset;
+                m_handed_off_length = that.m_handed_off_length;
+                m_text_buffer_size = that.m_text_buffer_size;
+                m_filtered_text_length = that.m_filtered_text_length;
+                m_text_buffer = that.m_text_buffer;
+                adopt_sink(that);
+                that.reset_after_move();
+                }
+            return *this;
             }
+    #endif
+        ///Destructor.
+        virtual ~extract_text()
+            { m_text_buffer = NULL; }
         ///@returns The text that has been extracted from the formatted stream.
         const wchar_t* get_filtered_text() const
             { return m_text_buffer; }
@@ -41,26 +556,96 @@ namespace lily_of_the_valley
             { return m_filtered_text_length; }
         /**Sets the writable buffer to the specified external buffer. This object will not own this buffer
            and will not delete it, caller must assume ownership of it.
-           @note If subsequent calls to allocate_text_buffer() requires a larger buffer,
+           @note If the text being extracted later does not fit in this buffer,
            then the object will stop using this buffer and switch to using an internal one.
            Call is_using_internal_buffer() to confirm which type of buffer is being used.
+           To have extraction stop when the buffer is full instead, pass a fixed_text_sink to set_text_sink().
            @param buffer The external buffer to write filtered text to.
            @param length The size of the external buffer.*/
         void set_writable_buffer(wchar_t* buffer, const size_t length)
             {
-            if (is_using_internal_buffer())
-                { delete [] m_text_buffer; }
-            m_text_buffer = buffer;
-            m_text_buffer_size = length;
-            m_owns_buffer = false;
+            m_external_sink = fixed_text_sink(buffer, length);
+            m_sink = &m_external_sink;
+            m_sink->begin(m_text_buffer, m_text_buffer_size);
             m_filtered_text_length = 0;
-            std::wmemset(m_text_buffer, 0, m_text_buffer_size);
+            if (m_text_buffer && m_text_buffer_size > 0)
+                { m_text_buffer[0] = 0; }
+            }
+        /**Sets where the extracted text is written to.
+           @param sink The sink to write to, or NULL to go back to using the internal buffer.
+            The caller owns the sink, which must outlive this object (or until another sink is set).*/
+        void set_text_sink(text_sink* sink)
+            {
+            m_sink = (sink != NULL) ? sink : &m_internal_sink;
+            m_text_buffer = NULL;
+            m_text_buffer_size = m_filtered_text_length = 0;
             }
+        /**Transfers ownership of the buffer holding the extracted text to the caller, so that it can be kept
+           without copying it. The next extraction will allocate a new buffer.
+           @param[out] length The length of the text.
+           @returns The extracted text (which the caller must delete [] when finished with it), or NULL if there isn't any text.
+            NULL is also returned if the text is not in the internal buffer (i.e., if it is in a buffer from
+            set_writable_buffer() or a sink from set_text_sink()), as the buffer is not this object's to give away.*/
+        wchar_t* release_text(size_t& length)
+            {
+            length = 0;
+            if (!is_using_internal_buffer())
+                { return NULL; }
+            length = m_filtered_text_length;
+            m_text_buffer = NULL;
+            m_text_buffer_size = m_filtered_text_length = 0;
+            return m_internal_sink.release();
+            }
+        /**Makes sure that the internal buffer can hold a number of characters, so that it will not need to
+           grow while extracting text of that size (e.g., to warm up an extractor that will be reused).
+           @param length The number of characters (not including the NULL terminator).
+           @returns False if the buffer could not be allocated.
+           @note This discards any text that has already been extracted into the internal buffer.*/
+        bool reserve_buffer(const size_t length)
+            {
+            if (m_sink == &m_internal_sink)
+                {
+                m_text_buffer = NULL;
+                m_text_buffer_size = m_filtered_text_length = 0;
+                }
+            return m_internal_sink.reserve(length+1);
+            }
+        ///@returns The number of characters that the internal buffer can hold (including the NULL terminator).
+        size_t get_buffer_capacity() const
+            { return m_internal_sink.get_capacity(); }
         /**@returns Whether an internal buffer owned by this object is storing the filtered text.
            This will return false if an external buffer specified by the caller is being used or
            if a buffer hasn't been allocated yet.*/
         bool is_using_internal_buffer() const
-            { return m_owns_buffer; }
+            { return (m_sink == &m_internal_sink && m_text_buffer != NULL); }
+        /**Sets limits on how much of each document is read and extracted (see extraction_budget).
+           @param budget The limits to use for each document.
+           @note This is honored by the single-document extractors (e.g., html_extract_text, docx_extract_text,
+            odt_extract_text, pptx_extract_text, hhc_hhk_extract_text, postscript_extract_text, and unicode_extract_text),
+            whether they are given the whole document or streamed.
+            It is not supported by the classes that put together the text from several documents or segments
+            (pptx_deck_extract_text, docx_package_extract_text, docx_parallel_extract_text, and html_parallel_extract_text)
+            or by html_strip_hyperlinks (whose output is HTML); these log a message if a budget is set, and otherwise ignore it.*/
+        void set_budget(const extraction_budget& budget)
+            { m_budget = budget; }
+        ///@returns The limits on how much of each document is read and extracted.
+        const extraction_budget& get_budget() const
+            { return m_budget; }
+        /**@returns Whether extraction of the last document stopped early because a limit from set_budget()
+            was reached (in which case, the text is only the start of the document's text).*/
+        bool is_budget_exceeded() const
+            { return m_is_budget_exceeded; }
+        /**Sets a map to record where each character of the extracted text came from in the document (see text_offset_map).
+           The map is cleared at the start of each document. Its offsets are into the document's whole text,
+           even if a sink has handed some of it off already (e.g., a callback_text_sink).
+           @param offset_map The map to record to, or NULL to stop recording (which is the default).
+            The caller owns the map, which must outlive this object (or until another map is set).
+           @note Only html_extract_text and the classes derived from it (e.g., docx_extract_text) currently record to this.*/
+        void set_offset_map(text_offset_map* offset_map)
+            { m_offset_map = offset_map; }
+        ///@returns The map that the extracted text's offsets are being recorded to, or NULL if they aren't.
+        text_offset_map* get_offset_map() const
+            { return m_offset_map; }
         ///@returns A report of any issues with the last read block.
         const std::wstring& get_log() const
             { return m_log; }
@@ -73,54 +658,229 @@ namespace lily_of_the_valley
  #ifndef __UNITTEST
     protected:
 #endif
-        /**Allocates (or resizes) the buffer to hold the parsed text. This must be
-           called before using add_character() or add_characters(). If the new size is smaller
-           than the current size, then the size remains the same.
-           @param text_length The new size of the buffer.
-           @returns False if allocation fails, true otherwise.*/
+        /**Starts a new block of parsed text. This must be called before using add_character() or add_characters().
+           @returns False if the output could not be set up, true otherwise.*/
+        bool begin_text()
+            {
+            m_filtered_text_length = 0;
+            m_text_truncated = false;
+            m_is_budget_exceeded = false;
+            m_steps_taken = 0;
+            m_source_start = m_source_end = NULL;
+            m_handed_off_length = 0;
+            if (m_offset_map != NULL)
+                { m_offset_map->clear(); }
+            m_sink->begin(m_text_buffer, m_text_buffer_size);
+            if (!reserve_text(0))
+                { return false; }
+            m_text_buffer[0] = 0;
+            return true;
+            }
+        /**Starts a new block of parsed text and makes room for the specified number of characters.
+           This must be called before using add_character() or add_characters().
+           @param text_length The (most) number of characters that will be written (see reserve_text()).
+           @returns False if nothing more can be written, true otherwise.*/
         bool allocate_text_buffer(const size_t text_length)
+            { return (begin_text() && reserve_text(text_length)); }
+        /**Makes room for the specified number of characters (plus a NULL terminator) after the parsed text,
+           so that adding a run of characters doesn't grow the buffer one step at a time.
+           @param length The (most) number of characters that will be added.
+           @returns False if nothing more can be written (in which case parsing should stop), true otherwise.
+           @note If the sink can't make all of the room (e.g., a fixed_text_sink that is only as large as
+            the text that will really be written), then this still succeeds, and the characters are checked
+            as they are added. The text is only cut off when one of them doesn't fit. To write to the buffer
+            directly (see get_writable_buffer()), call require_text() instead.*/
+        bool reserve_text(const size_t length)
+            {
+            return (m_text_buffer_size-m_filtered_text_length > length) ?
+                true : grow_text(length);
+            }
+        /**Makes sure that there is room for the specified number of characters (plus a NULL terminator)
+           after the parsed text, such as before writing to get_writable_buffer().
+           @param length The number of characters that will be added.
+           @returns False if the room could not be made (in which case the text is cut off where it is).*/
+        bool require_text(const size_t length)
             {
-            if (m_text_buffer_size < text_length+1)
+            if (reserve_text(length) && m_text_buffer_size-m_filtered_text_length > length)
+                { return true; }
+            truncate_text();
+            return false;
+            }
+        /**Finishes the block of parsed text, NULL terminating it and passing it to the sink.
+           @returns The parsed text.*/
+        const wchar_t* finalize_text()
+            {
+            if (m_text_buffer != NULL)
                 {
-                //reset filtered text from previous call
-                if (is_using_internal_buffer())
-                    { delete [] m_text_buffer; }
-                //whether the buffer hasn't be set yet or caller set it to an external buffer,
-                //we have ran out of room and need to create our own now and will own it.
-                m_owns_buffer = true;
-                try
-                    { m_text_buffer = new wchar_t[text_length+1]; }
-                catch (std::bad_alloc)
-                    {
-                    log_message(L"Unable to allocate memory for extracting text from file.");
-                    m_text_buffer_size = m_filtered_text_length = 0;
-                    m_text_buffer = NULL;
-                    return false;
-                    }
-                m_text_buffer_size = text_length+1;
+                m_text_buffer[m_filtered_text_length] = 0;
+                m_sink->end(m_text_buffer, m_filtered_text_length);
                 }
-            std::wmemset(m_text_buffer, 0, m_text_buffer_size);
-
-            m_filtered_text_length = 0;
-            return true;
+            return m_text_buffer;
             }
         /**Adds a character to the parsed buffer.
-           @param character The character to add.*/
+           @param character The character to add.
+           @note Call reserve_text() before adding a run of characters, so that the buffer
+            isn't grown for each one.*/
         void add_character(const wchar_t character)
             {
             assert(character !=0 && "NULL terminator passed to add_character()!");
-            if (character != 0)
-                { m_text_buffer[m_filtered_text_length++] = character; }
+            if (character == 0)
+                { return; }
+            //only happens if reserve_text() couldn't make all of the room that it was asked for
+            if (m_filtered_text_length+1 >= m_text_buffer_size &&
+                (!grow_text(1) || m_filtered_text_length+1 >= m_text_buffer_size))
+                {
+                truncate_text();
+                return;
+                }
+            m_text_buffer[m_filtered_text_length++] = character;
             }
         /**Adds a string to the parsed buffer.
            @param characters The string to add.
            @param length The length of the string to add.*/
         void add_characters(const wchar_t* characters, const size_t length)
             {
-            if (length == 0 || !characters)
+            if (length == 0 || !characters || !reserve_text(length))
                 { return ; }
-            string_util::strncpy(m_text_buffer+m_filtered_text_length, characters, length);
-            m_filtered_text_length += length;
+            //if the sink couldn't make all of the room, then copy what fits and cut the text off there
+            const size_t copyLength = std::min(length, m_text_buffer_size-m_filtered_text_length-1);
+            string_util::strncpy(m_text_buffer+m_filtered_text_length, characters, copyLength);
+            m_filtered_text_length += copyLength;
+            if (m_offset_map != NULL)
+                { map_copied_text(characters, m_filtered_text_length-copyLength, copyLength); }
+            if (copyLength < length)
+                { truncate_text(); }
+            }
+        /**Decodes and adds a UTF-8 string to the parsed buffer.
+           @param characters The UTF-8 string to add.
+           @param length The length (in bytes) of the string to add.
+           @note The buffer never needs more wchar_t slots than there are bytes being decoded, so
+            a buffer allocated to the length of the UTF-8 stream will always be large enough.
+            Bytes that are not part of a valid UTF-8 sequence are treated as Latin-1 characters.*/
+        void add_characters(const char* characters, const size_t length)
+            {
+            if (length == 0 || !characters || !reserve_text(length))
+                { return; }
+            const size_t outputStart = m_filtered_text_length;
+            const char* const charactersStart = characters;
+            const char* const charactersEnd = characters+length;
+            //if the sink couldn't make room for every byte, then decode it a character at a time (which checks for room)
+            if (m_text_buffer_size-m_filtered_text_length <= length)
+                {
+                while (characters < charactersEnd && !m_text_truncated)
+                    { add_code_point(decode_utf8(characters, charactersEnd)); }
+                if (m_offset_map != NULL)
+                    { map_copied_text(charactersStart, outputStart, characters-charactersStart); }
+                return;
+                }
+            wchar_t* output = m_text_buffer+m_filtered_text_length;
+            while (characters < charactersEnd)
+                {
+                //runs of ASCII (most of the text in markup) are widened eight bytes at a time
+                while (charactersEnd-characters >= 8 && is_ascii_block(characters))
+                    {
+                    for (size_t i = 0; i < 8; ++i)
+                        { output[i] = static_cast<unsigned char>(characters[i]); }
+                    output += 8;
+                    characters += 8;
+                    }
+                m_filtered_text_length = output-m_text_buffer;
+                if (characters >= charactersEnd)
+                    { break; }
+                //ASCII is copied straight over
+                if ((static_cast<unsigned char>(*characters) & 0x80) == 0)
+                    { m_text_buffer[m_filtered_text_length++] = static_cast<unsigned char>(*characters++); }
+                else
+                    { add_code_point(decode_utf8(characters, charactersEnd)); }
+                output = m_text_buffer+m_filtered_text_length;
+                }
+            if (m_offset_map != NULL)
+                { map_copied_text(charactersStart, outputStart, length); }
+            }
+        ///@returns Whether the next eight bytes of UTF-8 text are all ASCII.
+        static bool is_ascii_block(const char* characters)
+            {
+            unsigned char block[8];
+            std::memcpy(block, characters, 8);
+            return ((block[0] | block[1] | block[2] | block[3] |
+                     block[4] | block[5] | block[6] | block[7]) & 0x80) == 0;
+            }
+        /**Adds a unicode code point to the parsed buffer. If wchar_t is 16-bit, then
+           code points beyond the Basic Multilingual Plane are written as a surrogate pair.
+           @param code_point The code point to add.*/
+        void add_code_point(const unsigned int code_point)
+            {
+            if (sizeof(wchar_t) == 2 && code_point > 0xFFFF)
+                {
+                add_character(static_cast<wchar_t>(0xD800+((code_point-0x10000)>>10)));
+                add_character(static_cast<wchar_t>(0xDC00+((code_point-0x10000)&0x3FF)));
+                }
+            else
+                { add_character(static_cast<wchar_t>(code_point)); }
+            }
+        /**Decodes a character from a UTF-8 stream.
+           @param[in,out] text The position in the stream to decode from. This will be moved past the decoded character.
+           @param textEnd The end of the stream.
+           @returns The unicode code point. If the current byte does not start a valid UTF-8 sequence,
+            then it is returned as a Latin-1 character (and @c text is moved past only that byte).*/
+        static unsigned int decode_utf8(const char*& text, const char* textEnd)
+            {
+            const unsigned char leadByte = static_cast<unsigned char>(*text);
+            const size_t sequenceLength = (leadByte < 0x80) ? 1 :
+                                          (leadByte >= 0xC2 && leadByte <= 0xDF) ? 2 :
+                                          (leadByte >= 0xE0 && leadByte <= 0xEF) ? 3 :
+                                          (leadByte >= 0xF0 && leadByte <= 0xF4) ? 4 : 0;
+            if (sequenceLength <= 1 || static_cast<size_t>(textEnd-text) < sequenceLength)
+                {
+                ++text;
+                return leadByte;
+                }
+            unsigned int codePoint = leadByte & (0xFF >> (sequenceLength+1));
+            for (size_t i = 1; i < sequenceLength; ++i)
+                {
+                const unsigned char continuationByte = static_cast<unsigned char>(text[i]);
+                if ((continuationByte & 0xC0) != 0x80)
+                    {
+                    ++text;
+                    return leadByte;
+                    }
+                codePoint = (codePoint << 6) | (continuationByte & 0x3F);
+                }
+            //overlong encodings, surrogates, and values beyond the unicode range are invalid
+            if ((sequenceLength == 3 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF))) ||
+                (sequenceLength == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF)))
+                {
+                ++text;
+                return leadByte;
+                }
+            text += sequenceLength;
+            return codePoint;
+            }
+        /**@returns A wide string copy of a section of text (e.g., for log messages).
+           @param text The text to copy.
+           @param length The length of the text.*/
+        static std::wstring to_wide_string(const wchar_t* text, const size_t length)
+            { return std::wstring(text, length); }
+        /**@returns A wide string copy of a section of UTF-8 text (e.g., for log messages).
+           @param text The UTF-8 text to decode.
+           @param length The length (in bytes) of the text.*/
+        static std::wstring to_wide_string(const char* text, const size_t length)
+            {
+            std::wstring wideText;
+            wideText.reserve(length);
+            const char* const textEnd = text+length;
+            while (text < textEnd)
+                {
+                const unsigned int codePoint = decode_utf8(text, textEnd);
+                if (sizeof(wchar_t) == 2 && codePoint > 0xFFFF)
+                    {
+                    wideText += static_cast<wchar_t>(0xD800+((codePoint-0x10000)>>10));
+                    wideText += static_cast<wchar_t>(0xDC00+((codePoint-0x10000)&0x3FF));
+                    }
+                else
+                    { wideText += static_cast<wchar_t>(codePoint); }
+                }
+            return wideText;
             }
         /**@returns A writable copy of the text that has been extracted from the formatted stream.
            This should only be used under special circumstances where you need to directly write to the buffer;
@@ -137,6 +897,8 @@ namespace lily_of_the_valley
                 else
                     { break; }
                 }
+            if (m_offset_map != NULL)
+                { m_offset_map->truncate(m_handed_off_length+m_filtered_text_length); }
             }
         /**Sets the length of the parsed text.
         @note Any text added before this call
@@ -147,8 +909,132 @@ namespace lily_of_the_valley
         void set_filtered_text_length(const size_t length)
             {
             assert(length <= m_text_buffer_size && "Custom text length cannot be larger than the buffer.");
+            if (m_offset_map != NULL && length < m_filtered_text_length)
+                { m_offset_map->truncate(m_handed_off_length+length); }
             m_filtered_text_length = length;
             }
+        /**Sets the document that text is being extracted from, so that text copied from it can be recorded
+           in the offset map (see set_offset_map()). This should be called after begin_text().
+           @param text The document (or the part of it that is in memory, if it is being streamed).
+           @param length The length of @c text.
+           @param start_offset Where @c text starts in the whole document (if it is being streamed).*/
+        template<typename T>
+        void set_offset_source(const T* text, const size_t length, const size_t start_offset = 0)
+            {
+            m_source_start = reinterpret_cast<const char*>(text);
+            m_source_end = reinterpret_cast<const char*>(text+length);
+            m_source_character_size = sizeof(T);
+            m_source_offset = start_offset;
+            }
+        /**Records in the offset map that text was copied from the document character for character.
+           Text that add_characters() copies is recorded automatically, so this is only needed for text
+           written with add_character() (e.g., a newline that was replaced by a space).
+           @param source Where the text came from. Nothing is recorded if this is not in the document from set_offset_source().
+           @param output_start Where the text starts in the buffer (i.e., not counting text that the sink has handed off).
+           @param input_length How many characters (or bytes) of the document were copied.*/
+        template<typename T>
+        void map_copied_text(const T* source, const size_t output_start, const size_t input_length)
+            {
+            size_t inputOffset = 0;
+            if (m_offset_map != NULL && find_source_offset(source, sizeof(T), inputOffset))
+                {
+                m_offset_map->add(m_handed_off_length+output_start, inputOffset, m_filtered_text_length-output_start,
+                                  input_length, true);
+                }
+            }
+        /**Records in the offset map that text was decoded from something in the document (e.g., an entity).
+           @param source The start of what the text was decoded from.
+           @param output_start Where the decoded text starts in the buffer (not counting text that the sink has handed off).*/
+        template<typename T>
+        void map_decoded_text(const T* source, const size_t output_start)
+            {
+            size_t inputOffset = 0;
+            if (m_offset_map != NULL && find_source_offset(source, sizeof(T), inputOffset))
+                {
+                m_offset_map->add(m_handed_off_length+output_start, inputOffset,
+                                  m_filtered_text_length-output_start, 0, false);
+                }
+            }
+        /**@returns How much of a document (of @c text_length characters) can be read within the input budget.
+           If that is less than all of it, then call exceed_budget() once the part that can be read has been read.
+           @param text_length The length of the document.*/
+        size_t get_input_budget_length(const size_t text_length) const
+            {
+            return (m_budget.m_max_input_length > 0 && text_length > m_budget.m_max_input_length) ?
+                m_budget.m_max_input_length : text_length;
+            }
+        ///Logs that the budget (if one was set) isn't supported, for the classes that don't read it.
+        void log_unsupported_budget()
+            {
+            if (m_budget.m_max_output_length > 0 || m_budget.m_max_input_length > 0 || m_budget.m_max_steps > 0)
+                { log_message(L"Budgets are not supported by this extractor; the whole document was read."); }
+            }
+        /**Counts a parsing step against the budget.
+           @returns False if the budget's steps (or output) have run out, in which case parsing should stop.*/
+        bool take_budget_step()
+            {
+            if (m_is_budget_exceeded)
+                { return false; }
+            if (m_budget.m_max_steps > 0 && ++m_steps_taken > m_budget.m_max_steps)
+                {
+                exceed_budget(L"Parsing step limit reached; the rest of the document was not read.");
+                return false;
+                }
+            if (m_budget.m_max_output_length > 0 && m_filtered_text_length >= m_budget.m_max_output_length)
+                {
+                exceed_budget(L"Output limit reached; the rest of the document was not read.");
+                return false;
+                }
+            return true;
+            }
+        /**@returns How many more characters can be extracted before the output budget runs out
+            (or the largest possible size if there is no output limit).*/
+        size_t get_remaining_output_budget() const
+            {
+            if (m_budget.m_max_output_length == 0)
+                { return static_cast<size_t>(-1); }
+            return (m_filtered_text_length < m_budget.m_max_output_length) ?
+                m_budget.m_max_output_length-m_filtered_text_length : 0;
+            }
+        /**Records that a budget has run out (and why), so that the rest of the document will not be parsed.
+           @param reason The message to log.*/
+        void exceed_budget(const wchar_t* reason)
+            {
+            if (!m_is_budget_exceeded)
+                {
+                m_is_budget_exceeded = true;
+                log_message(reason);
+                }
+            }
+        /**If a budget ran out, cuts the parsed text back to the end of its last paragraph (i.e., newline), so that it
+           doesn't end in the middle of one. If that would lose more than half of the text, then it is cut back to the end
+           of the last word instead (or to nothing, if there isn't a whole word), since the word that the text was cut off
+           in may not be finished. Any trailing whitespace is then trimmed off.
+           @note Text that went over the output limit (e.g., newlines added after the last parsing step)
+            counts as running out of budget, so the text is never longer than the limit.*/
+        void trim_to_budget_boundary()
+            {
+            if (m_text_buffer == NULL)
+                { return; }
+            if (m_budget.m_max_output_length > 0 && m_filtered_text_length > m_budget.m_max_output_length)
+                {
+                exceed_budget(L"Output limit reached; the rest of the document was not read.");
+                m_filtered_text_length = m_budget.m_max_output_length;
+                }
+            if (!m_is_budget_exceeded)
+                { return; }
+            size_t boundary = m_filtered_text_length;
+            while (boundary > 0 && m_text_buffer[boundary-1] != L'\n')
+                { --boundary; }
+            if (boundary <= m_filtered_text_length/2)
+                {
+                boundary = m_filtered_text_length;
+                while (boundary > 0 && !std::iswspace(m_text_buffer[boundary-1]))
+                    { --boundary; }
+                }
+            set_filtered_text_length(boundary);
+            trim();
+            }
         ///Empties the log of any previous parsing issues.
         void clear_log()
             { m_log.clear(); }
@@ -162,16 +1048,110 @@ namespace lily_of_the_valley
                 { m_log.append(m_log_message_separator+message); }
             }
     private:
+    #ifdef EXTRACT_TEXT_HAS_MOVE_SEMANTICS
+        ///Points to the same kind of sink that another object (which is being moved from) was using.
+        void adopt_sink(const extract_text& that)
+            {
+            m_sink = (that.m_sink == &that.m_internal_sink) ? static_cast<text_sink*>(&m_internal_sink) :
+                     (that.m_sink == &that.m_external_sink) ? static_cast<text_sink*>(&m_external_sink) :
+                     that.m_sink;
+            }
+        ///Resets an object whose text has been moved to another one.
+        void reset_after_move()
+            {
+            m_log.clear();
+            m_log_message_separator = L"\n";
+            m_sink = &m_internal_sink;
+            m_external_sink = fixed_text_sink(NULL, 0);
+            m_text_truncated = false;
+            m_budget = extraction_budget();
+            m_is_budget_exceeded = false;
+            m_steps_taken = 0;
+            m_offset_map = NULL;
+            m_source_start = m_source_end = NULL;
+            m_source_character_size = 1;
+            m_source_offset = 0;
+            m_handed_off_length = 0;
+            m_text_buffer_size = m_filtered_text_length = 0;
+            m_text_buffer = NULL;
+            }
+    #endif
+        /**Finds where a pointer is in the document from set_offset_source().
+           @returns False if it isn't in the document.*/
+        bool find_source_offset(const void* source, const size_t character_size, size_t& offset) const
+            {
+            const char* const position = static_cast<const char*>(source);
+            if (character_size != m_source_character_size || position < m_source_start || position >= m_source_end)
+                { return false; }
+            offset = m_source_offset+(position-m_source_start)/m_source_character_size;
+            return true;
+            }
+        ///Makes room in the sink, switching over to the internal buffer if a buffer from set_writable_buffer() is full.
+        bool grow_text(const size_t length)
+            {
+            if (m_text_truncated)
+                { return false; }
+            if (grow_sink(length))
+                { return true; }
+            if (m_sink == &m_external_sink)
+                {
+                m_sink = &m_internal_sink;
+                if (grow_sink(length))
+                    { return true; }
+                }
+            /*the reservation may be more than the text will need (e.g., a whole run of text that has entities in it),
+              so as long as there is a buffer to write to, let the characters be checked as they are written*/
+            if (m_text_buffer != NULL && m_filtered_text_length < m_text_buffer_size)
+                { return true; }
+            truncate_text();
+            return false;
+            }
+        ///Asks the sink for more room, keeping track of how much of the text it hands off.
+        bool grow_sink(const size_t length)
+            {
+            const size_t previousLength = m_filtered_text_length;
+            if (!m_sink->grow(m_text_buffer, m_filtered_text_length, m_text_buffer_size, length+1))
+                { return false; }
+            m_handed_off_length += previousLength-m_filtered_text_length;
+            return true;
+            }
+        ///Stops anything else from being written, so that the text is cut off cleanly where it is.
+        void truncate_text()
+            {
+            if (m_text_truncated)
+                { return; }
+            log_message((m_sink == &m_internal_sink) ?
+                L"Unable to allocate memory for extracting text from file." :
+                L"Unable to write any more text to the output; the text has been truncated.");
+            m_text_truncated = true;
+            m_text_buffer_size = (m_text_buffer != NULL) ? m_filtered_text_length+1 : 0;
+            }
         std::wstring m_log;
         std::wstring m_log_message_separator;
-        //data
-        bool m_owns_buffer;
+        //where the text is written
+        growable_text_sink m_internal_sink;
+        fixed_text_sink m_external_sink;
+        text_sink* m_sink;
+        bool m_text_truncated;
+        //how much work to do on each document
+        extraction_budget m_budget;
+        bool m_is_budget_exceeded;
+        size_t m_steps_taken;
+        //where the text came from in the document (only recorded if there is a map to record it to)
+        text_offset_map* m_offset_map;
+        const char* m_source_start;
+        const char* m_source_end;
+        size_t m_source_character_size;
+        size_t m_source_offset;
+        //how much text the sink has taken out of the buffer (e.g., a callback_text_sink), which the offsets are recorded after
+        size_t m_handed_off_length;
+        //the buffer currently being written to (provided by the sink)
         size_t m_text_buffer_size;
         size_t m_filtered_text_length;
         wchar_t* m_text_buffer;
         //disable copy construction
-        extract_text(const extract_text&) {}
-        void operator=(const extract_text&) const {}
+        extract_text(const extract_text&);
+        void operator=(const extract_text&) const;
         };
     }
 
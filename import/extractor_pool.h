@@ -0,0 +1,174 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __EXTRACTOR_POOL_H__
+#define __EXTRACTOR_POOL_H__
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "extract_text.h"
+
+namespace lily_of_the_valley
+    {
+    /**@brief A thread-safe pool of reusable extractors (e.g., html_extract_text), for services that extract
+        text from many documents at once.
+    @details Extractors are handed out already "warmed up" (i.e., with their buffers allocated to a
+        given size), so extracting a typical document does not allocate anything. When a lease is
+        finished with, its extractor goes back into the pool with its buffer intact. To keep the text
+        without copying it, call extract_text::release_text() on the leased extractor; its buffer
+        will be reallocated when it is returned to the pool.
+    @note Requires C++11 (for @c std::mutex). An extractor is returned to the pool with its text sink
+        reset to the internal buffer (see extract_text::set_text_sink()) and its offset map and event handler
+        (see extract_text::set_offset_map() and html_extract_text::set_event_handler()) removed, since those
+        belong to the lease's caller. Any other options set on it
+        (e.g., docx_extract_text::preserve_text_table_layout()) are kept.
+    @par Example:
+    @code
+        //shared between all of the threads handling requests
+        lily_of_the_valley::extractor_pool<lily_of_the_valley::html_extract_text> htmlPool;
+
+        //in a request handler
+        lily_of_the_valley::extractor_pool<lily_of_the_valley::html_extract_text>::lease htmlExtract = htmlPool.acquire();
+        (*htmlExtract)(page, pageLength, true, false);
+        size_t length = 0;
+        std::unique_ptr<wchar_t[]> text(htmlExtract->release_text(length));
+        //the extractor goes back into the pool when htmlExtract goes out of scope
+    @endcode*/
+    template<typename extractor_type>
+    class extractor_pool
+        {
+    public:
+        /**@brief An extractor borrowed from the pool, which is returned to the pool when this is destroyed.
+        @note A lease must not outlive the pool that it came from.*/
+        class lease
+            {
+        public:
+            ///Constructor (creates an empty lease).
+            lease() : m_pool(NULL) {}
+            ///Move constructor.
+            lease(lease&& that) : m_pool(that.m_pool), m_extractor(std::move(that.m_extractor))
+                { that.m_pool = NULL; }
+            ///Move assignment.
+            lease& operator=(lease&& that)
+                {
+                if (this != &that)
+                    {
+                    give_back();
+                    m_pool = that.m_pool;
+                    m_extractor = std::move(that.m_extractor);
+                    that.m_pool = NULL;
+                    }
+                return *this;
+                }
+            ///Destructor, which returns the extractor to the pool.
+            ~lease()
+                { give_back(); }
+            ///@returns The leased extractor.
+            extractor_type* get() const
+                { return m_extractor.get(); }
+            ///@returns The leased extractor.
+            extractor_type& operator*() const
+                { return *m_extractor; }
+            ///@returns The leased extractor.
+            extractor_type* operator->() const
+                { return m_extractor.get(); }
+            ///@returns Whether this is holding an extractor.
+            explicit operator bool() const
+                { return (m_extractor.get() != NULL); }
+        private:
+            friend class extractor_pool;
+            lease(extractor_pool* pool, std::unique_ptr<extractor_type> extractor) :
+                m_pool(pool), m_extractor(std::move(extractor))
+                {}
+            void give_back()
+                {
+                if (m_pool && m_extractor)
+                    { m_pool->give_back(std::move(m_extractor)); }
+                m_pool = NULL;
+                }
+            lease(const lease&);
+            void operator=(const lease&);
+            extractor_pool* m_pool;
+            std::unique_ptr<extractor_type> m_extractor;
+            };
+        /**Constructor.
+           @param buffer_size The number of characters that each extractor's buffer is allocated to hold.
+            This should be about the size of the text extracted from a typical document.
+           @param max_idle_extractors The most extractors to keep in the pool while they are not being used.
+            Extractors returned to a full pool are deleted.*/
+        explicit extractor_pool(const size_t buffer_size = 64*1024, const size_t max_idle_extractors = 64) :
+            m_buffer_size(buffer_size), m_max_idle_extractors(max_idle_extractors)
+            {}
+        /**Creates extractors ahead of time, so that later calls to acquire() don't have to.
+           @param count The number of extractors that should be waiting in the pool.*/
+        void prewarm(const size_t count)
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (m_idle_extractors.size() < std::min(count, m_max_idle_extractors))
+                { m_idle_extractors.push_back(create()); }
+            }
+        /**Borrows an extractor from the pool (creating one if the pool is empty).
+           @returns The leased extractor, which goes back into the pool when the lease is destroyed.*/
+        lease acquire()
+            {
+                {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_idle_extractors.empty())
+                    {
+                    std::unique_ptr<extractor_type> extractor(std::move(m_idle_extractors.back()));
+                    m_idle_extractors.pop_back();
+                    return lease(this, std::move(extractor));
+                    }
+                }
+            return lease(this, create());
+            }
+        ///@returns The number of extractors waiting in the pool.
+        size_t get_idle_count() const
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_idle_extractors.size();
+            }
+    private:
+        std::unique_ptr<extractor_type> create() const
+            {
+            std::unique_ptr<extractor_type> extractor(new extractor_type);
+            extractor->reserve_buffer(m_buffer_size);
+            return extractor;
+            }
+        void give_back(std::unique_ptr<extractor_type> extractor)
+            {
+            //detach anything the lease's caller owns, as it may not outlive the lease
+            extractor->set_text_sink(NULL);
+            extractor->set_offset_map(NULL);
+            clear_event_handler(extractor.get(), 0);
+            //warm the buffer back up if its text was released
+            if (extractor->get_buffer_capacity() == 0)
+                { extractor->reserve_buffer(m_buffer_size); }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_idle_extractors.size() < m_max_idle_extractors)
+                { m_idle_extractors.push_back(std::move(extractor)); }
+            }
+        //only extractors with an event handler (i.e., html_extract_text and its derived classes) pick this overload
+        template<typename T>
+        static auto clear_event_handler(T* extractor, int) -> decltype(extractor->set_event_handler(NULL), void())
+            { extractor->set_event_handler(NULL); }
+        template<typename T>
+        static void clear_event_handler(T*, long)
+            {}
+        size_t m_buffer_size;
+        size_t m_max_idle_extractors;
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<extractor_type> > m_idle_extractors;
+        };
+    }
+
+/** @}*/
+
+#endif //__EXTRACTOR_POOL_H__
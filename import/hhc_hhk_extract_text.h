@@ -25,6 +25,19 @@ namespace lily_of_the_valley
         @returns A pointer to the parsed text, or NULL upon failure.*/
         const wchar_t* operator()(const wchar_t* html_text,
                                   const size_t text_length)
+            { return extract(html_text, text_length); }
+        /**Main interface for extracting plain text from a UTF-8 HTML Workshop index or
+        table of contents buffer.
+        @param html_text The UTF-8 HHK/HHC text to extract from.
+        @param text_length The length (in bytes) of the text.
+        @returns A pointer to the parsed text, or NULL upon failure.*/
+        const wchar_t* operator()(const char* html_text,
+                                  const size_t text_length)
+            { return extract(html_text, text_length); }
+    private:
+        template<typename T>
+        const wchar_t* extract(const T* html_text,
+                               const size_t text_length)
             {
             clear_log();
             if (html_text == NULL || html_text[0] == 0 || text_length == 0)
@@ -32,39 +45,52 @@ namespace lily_of_the_valley
                 set_filtered_text_length(0);
                 return NULL;
                 }
-            assert(text_length <= string_util::strlen(html_text) );
 
-            if (!allocate_text_buffer(text_length))
+            if (!begin_text())
                 {
                 set_filtered_text_length(0);
                 return NULL;
                 }
+            set_offset_source(html_text, text_length);
 
-            //find the first < and set up where we halt our searching
-            const wchar_t* start = string_util::strchr(html_text, common_lang_constants::LESS_THAN);
-            const wchar_t* endSentinel = html_text+text_length;
+            //find the first < and set up where we halt our searching (which is no further than the input budget)
+            const size_t readLength = get_input_budget_length(text_length);
+            const T* endSentinel = html_text+readLength;
+            const T* start = string_util::strnchr<T>(html_text, common_lang_constants::LESS_THAN, readLength);
 
             while (start && (start < endSentinel))
                 {
-                const std::wstring currentTag = get_element_name(start+1);
+                //stop (and leave the rest of the text unread) if a budget has run out
+                if (!take_budget_step())
+                    { break; }
+                const basic_html_element_view<T> currentTag = read_element(start+1, endSentinel);
+                //an element that the input budget cuts off is left unread
+                if (readLength < text_length && currentTag.get_close_tag() == NULL)
+                    { break; }
 
                 if (currentTag == L"param")
                     {
-                    if (read_tag_as_string(start+6/*skip over "<param"*/, L"name", 4, false) == L"Name")
+                    const std::pair<const T*, size_t> paramName = read_tag(start+6/*skip over "<param"*/, MARKUP_LITERAL(T, "name"), 4, false, false, endSentinel);
+                    if (paramName.second == 4 && string_util::strncmp(paramName.first, MARKUP_LITERAL(T, "Name"), 4) == 0)
                         {
-                        const std::wstring StrValue = read_tag_as_string(start+6/*skip over "<param"*/, L"value", 5, false, true);
-                        parse_raw_text(StrValue.c_str(), StrValue.length());
+                        const std::pair<const T*, size_t> paramValue = read_tag(start+6/*skip over "<param"*/, MARKUP_LITERAL(T, "value"), 5, false, true, endSentinel);
+                        parse_raw_text(paramValue.first, paramValue.second);
+                        if (!reserve_text(2))
+                            { break; }
                         add_character(L'\n');
                         add_character(L'\n');
                         }
                     }
                 //find the next starting tag
-                start = string_util::strchr(start+1, common_lang_constants::LESS_THAN);
+                start = string_util::strnchr<T>(start+1, common_lang_constants::LESS_THAN, endSentinel-(start+1));
                 if (!start)
                     { break; }
                 }
+            if (readLength < text_length)
+                { exceed_budget(L"Input limit reached; the rest of the document was not read."); }
+            trim_to_budget_boundary();
 
-            return get_filtered_text();
+            return finalize_text();
             }
         };
     }
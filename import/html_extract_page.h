@@ -0,0 +1,370 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __HTML_EXTRACT_PAGE_H__
+#define __HTML_EXTRACT_PAGE_H__
+
+#include <vector>
+#include <algorithm>
+#include "html_extract_text.h"
+
+namespace lily_of_the_valley
+    {
+    ///@brief A link found by html_extract_page.
+    struct html_page_link
+        {
+        ///Where a link was found.
+        enum link_type
+            {
+            anchor_link,     ///< The @c href of an @c a, @c link, or @c area element.
+            frame_link,      ///< The @c src of a @c frame or @c iframe element.
+            script_link,     ///< The @c src of a @c script element.
+            javascript_link, ///< A path to a file or page inside of a script.
+            redirect_link    ///< The URL of a @c meta refresh.
+            };
+        ///Constructor.
+        html_page_link(const std::wstring& url, const link_type type) : m_url(url), m_type(type) {}
+        ///The URL (resolved against the page's base URL, if there is one).
+        std::wstring m_url;
+        ///Where the link was found.
+        link_type m_type;
+        };
+
+    /**@brief Class to extract the text from an <b>HTML</b> stream, along with its links, images, base URL,
+        title, and charset, all in the same pass.
+    @details The elements are read by the same parser that extracts the text (see html_extract_text), so this
+        replaces running html_extract_text, html_utilities::html_hyperlink_parse, html_utilities::html_image_parse,
+        and html_extract_text::parse_charset() over the same page one after the other.
+
+        Links and images are resolved against the page's @c base element, or (if it doesn't have one) the URL
+        passed to set_page_url(). If there is neither, then they are returned as they appear in the page.
+        Entities in the links and title (e.g., <tt>&amp;amp;</tt>) are decoded.
+    @par Example:
+    @code
+        lily_of_the_valley::html_extract_page pageExtract;
+        pageExtract.set_page_url(L"http://www.example.com/news/index.html");
+        pageExtract(page, pageLength);
+        //the text is in get_filtered_text(), just like html_extract_text
+        std::wstring fileText(pageExtract.get_filtered_text(), pageExtract.get_filtered_text_length());
+        for (size_t i = 0; i < pageExtract.get_links().size(); ++i)
+            { crawlQueue.push_back(pageExtract.get_links()[i].m_url); }
+    @endcode*/
+    class html_extract_page : public html_extract_text
+        {
+    public:
+        ///Constructor.
+        html_extract_page() : m_is_title_read(false) {}
+        /**Sets the URL of the page, which relative links are resolved against if the page doesn't have a @c base element.
+           @param url The page's URL.*/
+        void set_page_url(const std::wstring& url)
+            { m_page_url = url; }
+        /**Main interface for extracting text (and links) from an HTML buffer.
+        @param html_text The HTML text to strip.
+        @param text_length The length of the HTML text.
+        @param include_outer_text Whether text outside of the first and last <> should be included.
+        @param preserve_spaces Whether embedded newlines should be included in the output.
+        @returns The plain text from the HTML stream.*/
+        const wchar_t* operator()(const wchar_t* html_text,
+                                  const size_t text_length,
+                                  const bool include_outer_text = true,
+                                  const bool preserve_spaces = false)
+            {
+            clear_page_info();
+            const wchar_t* text = html_extract_text::operator()(html_text, text_length, include_outer_text, preserve_spaces);
+            resolve_links();
+            return text;
+            }
+        /**Main interface for extracting text (and links) from a UTF-8 HTML buffer.
+        @param html_text The UTF-8 HTML text to strip.
+        @param text_length The length (in bytes) of the HTML text.
+        @param include_outer_text Whether text outside of the first and last <> should be included.
+        @param preserve_spaces Whether embedded newlines should be included in the output.
+        @returns The plain text from the HTML stream.*/
+        const wchar_t* operator()(const char* html_text,
+                                  const size_t text_length,
+                                  const bool include_outer_text = true,
+                                  const bool preserve_spaces = false)
+            {
+            clear_page_info();
+            const wchar_t* text = html_extract_text::operator()(html_text, text_length, include_outer_text, preserve_spaces);
+            resolve_links();
+            return text;
+            }
+        /**Starts extracting text (and links) from an HTML stream that will be passed in as a series of chunks.
+           Unlike html_extract_text::begin_stream(), this must be called before the first call to feed().
+           @param preserve_spaces Whether embedded newlines should be included in the output.*/
+        void begin_stream(const bool preserve_spaces = false)
+            {
+            clear_page_info();
+            html_extract_text::begin_stream(preserve_spaces);
+            }
+        /**Finishes extracting text (and links) from an HTML stream.
+           @returns The plain text from the HTML stream.*/
+        const wchar_t* finish()
+            {
+            const wchar_t* text = html_extract_text::finish();
+            resolve_links();
+            return text;
+            }
+        ///@returns The links (other than images) from the page, in the order that they appear.
+        const std::vector<html_page_link>& get_links() const
+            { return m_links; }
+        ///@returns The sources of the images in the page, in the order that they appear.
+        const std::vector<std::wstring>& get_images() const
+            { return m_images; }
+        ///@returns The @c href of the page's @c base element, or an empty string if it doesn't have one.
+        const std::wstring& get_base_url() const
+            { return m_base_url; }
+        ///@returns The page's title, or an empty string if it doesn't have one.
+        const std::wstring& get_title() const
+            { return m_title; }
+        /**@returns The charset from the page's @c meta elements (or its XML declaration),
+            or an empty string if it doesn't specify one.*/
+        const std::string& get_charset() const
+            { return m_charset; }
+    protected:
+        ///Collects the links (and the rest of the page's information) from a wide element.
+        void on_element(const markup_element element_id, const basic_html_element_view<wchar_t>& element)
+            { read_page_element(element_id, element); }
+        ///Collects the links (and the rest of the page's information) from a UTF-8 element.
+        void on_element(const markup_element element_id, const basic_html_element_view<char>& element)
+            { read_page_element(element_id, element); }
+        ///Collects the title and script links from a wide section.
+        void on_section_text(const markup_element section, const wchar_t* text, const size_t length, const bool is_complete)
+            { read_page_section(section, text, length, is_complete); }
+        ///Collects the title and script links from a UTF-8 section.
+        void on_section_text(const markup_element section, const char* text, const size_t length, const bool is_complete)
+            { read_page_section(section, text, length, is_complete); }
+    private:
+        void clear_page_info()
+            {
+            m_links.clear();
+            m_images.clear();
+            m_base_url.clear();
+            m_title.clear();
+            m_charset.clear();
+            m_section_text.clear();
+            m_is_title_read = false;
+            }
+        template<typename T>
+        void read_page_element(const markup_element element_id, const basic_html_element_view<T>& element)
+            {
+            switch (element_id)
+                {
+            case html_a:
+            case html_link:
+            case html_area:
+                add_link(read_attribute(element, MARKUP_LITERAL(T, "href"), 4), html_page_link::anchor_link);
+                break;
+            case html_frame:
+            case html_iframe:
+                add_link(read_attribute(element, MARKUP_LITERAL(T, "src"), 3), html_page_link::frame_link);
+                break;
+            case html_script:
+                add_link(read_attribute(element, MARKUP_LITERAL(T, "src"), 3), html_page_link::script_link);
+                break;
+            case html_img:
+                {
+                const std::wstring source = read_attribute(element, MARKUP_LITERAL(T, "src"), 3);
+                if (!source.empty())
+                    { m_images.push_back(source); }
+                }
+                break;
+            case html_base:
+                if (m_base_url.empty())
+                    { m_base_url = read_attribute(element, MARKUP_LITERAL(T, "href"), 4); }
+                break;
+            case html_meta:
+                read_meta(element);
+                break;
+            default:
+                //the encoding from an XML declaration (e.g., "<?xml version="1.0" encoding="UTF-8"?>")
+                if (m_charset.empty() && element.comparei(L"?xml", 4))
+                    { m_charset = to_narrow_string(read_attribute(element, MARKUP_LITERAL(T, "encoding"), 8)); }
+                break;
+                };
+            }
+        template<typename T>
+        void read_meta(const basic_html_element_view<T>& element)
+            {
+            //HTML5 style (e.g., <meta charset="utf-8">)
+            if (m_charset.empty())
+                { m_charset = to_narrow_string(read_attribute(element, MARKUP_LITERAL(T, "charset"), 7)); }
+            const std::wstring httpEquiv = read_attribute(element, MARKUP_LITERAL(T, "http-equiv"), 10);
+            if (httpEquiv.empty())
+                { return; }
+            //the refresh URL may be quoted inside of the content value, so read that up to its own closing quote
+            const std::wstring content = read_quoted_attribute(element, MARKUP_LITERAL(T, "content"), 7);
+            //e.g., <meta http-equiv="Content-Type" content="text/html; charset=utf-8">
+            if (string_util::stricmp(httpEquiv.c_str(), L"content-type") == 0)
+                {
+                const wchar_t* charset = string_util::strnistr<wchar_t>(content.c_str(), L"charset=", content.length());
+                if (charset != NULL && m_charset.empty())
+                    {
+                    charset += 8;
+                    const size_t charsetLength = string_util::strncspn<wchar_t>(charset,
+                        (content.c_str()+content.length())-charset, L" ;'\"", 4);
+                    m_charset = to_narrow_string(std::wstring(charset, charsetLength));
+                    }
+                }
+            //e.g., <meta http-equiv="refresh" content="5; url=http://www.example.com">
+            else if (string_util::stricmp(httpEquiv.c_str(), L"refresh") == 0)
+                {
+                const wchar_t* url = string_util::strnistr<wchar_t>(content.c_str(), L"url=", content.length());
+                if (url != NULL)
+                    {
+                    url += 4;
+                    const wchar_t* const contentEnd = content.c_str()+content.length();
+                    while (url < contentEnd && (std::iswspace(url[0]) || url[0] == common_lang_constants::APOSTROPHE))
+                        { ++url; }
+                    add_link(std::wstring(url, url+string_util::strncspn<wchar_t>(url, contentEnd-url, L"'\"", 2)),
+                             html_page_link::redirect_link);
+                    }
+                }
+            }
+        template<typename T>
+        void read_page_section(const markup_element section, const T* text, const size_t length, const bool is_complete)
+            {
+            if (section == html_title && m_is_title_read)
+                { return; }
+            if (section != html_title && section != html_script)
+                { return; }
+            //a section is only split up when streaming, so just use it as-is if it is all here
+            if (is_complete && m_section_text.empty())
+                { finish_section(section, to_wide_string(text, length)); }
+            else
+                {
+                m_section_text += to_wide_string(text, length);
+                if (is_complete)
+                    {
+                    finish_section(section, m_section_text);
+                    m_section_text.clear();
+                    }
+                }
+            }
+        void finish_section(const markup_element section, const std::wstring& text)
+            {
+            //the title is decoded the same way as the text (entities converted and whitespace collapsed)
+            if (section == html_title)
+                {
+                m_title = decode(text);
+                m_is_title_read = true;
+                }
+            //a script's links are anything quoted that looks like a path to a file
+            else
+                {
+                html_utilities::javascript_hyperlink_parse scriptParse(text.c_str(), text.length());
+                const wchar_t* link = NULL;
+                while ((link = scriptParse()) != NULL)
+                    {
+                    m_links.push_back(html_page_link(std::wstring(link, scriptParse.get_current_hyperlink_length()),
+                                                     html_page_link::javascript_link));
+                    }
+                }
+            }
+        ///@returns The (decoded) value of an attribute in an element, or an empty string if it isn't there.
+        template<typename T>
+        std::wstring read_attribute(const basic_html_element_view<T>& element, const T* attribute, const size_t length)
+            {
+            if (element.get_close_tag() == NULL)
+                { return std::wstring(); }
+            return decode_attribute(read_tag(element.get_name(), attribute, length, false, true,
+                                             element.get_close_tag()+1));
+            }
+        /**Same as read_attribute(), except that a quoted value is read up to the quote that opened it,
+           so that it can have the other kind of quote in it (e.g., <tt>content="5; url='next.html'"</tt>).*/
+        template<typename T>
+        std::wstring read_quoted_attribute(const basic_html_element_view<T>& element, const T* attribute, const size_t length)
+            {
+            if (element.get_close_tag() == NULL)
+                { return std::wstring(); }
+            std::pair<const T*, size_t> value = read_tag(element.get_name(), attribute, length, false, true,
+                                                         element.get_close_tag()+1);
+            if (value.first != NULL && value.first > element.get_name() &&
+                (value.first[-1] == common_lang_constants::DOUBLE_QUOTE ||
+                 value.first[-1] == common_lang_constants::APOSTROPHE))
+                {
+                const T quote = value.first[-1];
+                value.second = std::find(value.first, element.get_close_tag(), quote)-value.first;
+                }
+            return decode_attribute(value);
+            }
+        template<typename T>
+        std::wstring decode_attribute(const std::pair<const T*, size_t>& value)
+            {
+            if (value.first == NULL || value.second == 0)
+                { return std::wstring(); }
+            //only run it through the decoder if there is an entity in it
+            return (string_util::strnchr<T>(value.first, common_lang_constants::AMPERSAND, value.second) != NULL) ?
+                decode(to_wide_string(value.first, value.second)) : to_wide_string(value.first, value.second);
+            }
+        void add_link(const std::wstring& url, const html_page_link::link_type type)
+            {
+            if (!url.empty())
+                { m_links.push_back(html_page_link(url, type)); }
+            }
+        ///Resolves the links and images against the base URL (or the page's URL).
+        void resolve_links()
+            {
+            const std::wstring& rootUrl = m_base_url.empty() ? m_page_url : m_base_url;
+            if (rootUrl.empty())
+                { return; }
+            html_utilities::html_url_format formatUrl(rootUrl.c_str());
+            for (size_t i = 0; i < m_links.size(); ++i)
+                {
+                const wchar_t* url = formatUrl(m_links[i].m_url.c_str(), m_links[i].m_url.length(), false);
+                if (url != NULL)
+                    { m_links[i].m_url = url; }
+                }
+            for (size_t i = 0; i < m_images.size(); ++i)
+                {
+                const wchar_t* url = formatUrl(m_images[i].c_str(), m_images[i].length(), true);
+                if (url != NULL)
+                    { m_images[i] = url; }
+                }
+            }
+        ///@returns Text with its entities decoded and whitespace collapsed.
+        std::wstring decode(const std::wstring& text)
+            {
+            const wchar_t* decodedText = m_decoder(text.c_str(), text.length(), true, false);
+            if (decodedText == NULL)
+                { return std::wstring(); }
+            const wchar_t* textStart = decodedText;
+            const wchar_t* textEnd = decodedText+m_decoder.get_filtered_text_length();
+            while (textStart < textEnd && std::iswspace(textStart[0]))
+                { ++textStart; }
+            while (textEnd > textStart && std::iswspace(textEnd[-1]))
+                { --textEnd; }
+            return std::wstring(textStart, textEnd);
+            }
+        static std::string to_narrow_string(const std::wstring& text)
+            {
+            std::string narrowText(text.length(), ' ');
+            for (size_t i = 0; i < text.length(); ++i)
+                { narrowText[i] = (text[i] < 0x80) ? static_cast<char>(text[i]) : '?'; }
+            return narrowText;
+            }
+
+        std::wstring m_page_url;
+        std::vector<html_page_link> m_links;
+        std::vector<std::wstring> m_images;
+        std::wstring m_base_url;
+        std::wstring m_title;
+        std::string m_charset;
+        bool m_is_title_read;
+        //a script or title section that is being read in pieces (only when streaming)
+        std::wstring m_section_text;
+        //decodes the entities in titles and links
+        html_extract_text m_decoder;
+        };
+    }
+
+/** @}*/
+
+#endif //__HTML_EXTRACT_PAGE_H__
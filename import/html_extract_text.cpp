@@ -2,19 +2,21 @@
 
 namespace lily_of_the_valley
     {
-    std::wstring html_extract_text::read_tag_as_string(const wchar_t* text,
-            const wchar_t* tag, const size_t tagSize,
+    template<typename T>
+    std::basic_string<T> html_extract_text::read_tag_as_string(const T* text,
+            const T* tag, const size_t tagSize,
             const bool allowQuotedTags,
-            const bool allowSpacesInValue /*= false*/)
+            const bool allowSpacesInValue /*= false*/,
+            const T* endSentinel /*= NULL*/)
         {
         if (!text || !tag || tagSize == 0)
-            { return L""; }
-        assert((std::wcslen(tag) == tagSize) && "Invalid length passed to read_tag_as_string().");
-        std::pair<const wchar_t*, size_t> rt = read_tag(text, tag, tagSize, allowQuotedTags, allowSpacesInValue);
+            { return std::basic_string<T>(); }
+        assert((string_util::strlen(tag) == tagSize) && "Invalid length passed to read_tag_as_string().");
+        std::pair<const T*, size_t> rt = read_tag(text, tag, tagSize, allowQuotedTags, allowSpacesInValue, endSentinel);
         if (rt.first == NULL)
-            { return L""; }
+            { return std::basic_string<T>(); }
         else
-            { return std::wstring(rt.first,rt.second); }
+            { return std::basic_string<T>(rt.first,rt.second); }
         }
 
     const std::pair<const wchar_t*,std::wstring> html_extract_text::find_bookmark(const wchar_t* sectionStart,
@@ -23,7 +25,7 @@ namespace lily_of_the_valley
         const wchar_t* nextAnchor = find_element(sectionStart, sectionEnd, L"a", 1);
         if (nextAnchor)
             {
-            std::pair<const wchar_t*,size_t> bk = read_tag(nextAnchor, L"name", 4, false);
+            std::pair<const wchar_t*,size_t> bk = read_tag(nextAnchor, L"name", 4, false, false, sectionEnd);
             if (bk.first)
                 {
                 std::wstring bookMark(bk.first, bk.second);
@@ -69,171 +71,302 @@ namespace lily_of_the_valley
         return NULL;
         }
 
-    void html_extract_text::parse_raw_text(const wchar_t* text, size_t textSize)
+    /*Reads the number from a numeric HTML entity (e.g., the "174" from "&#174;" or the "AE" from "&#xAE;"),
+    stopping at the first character that is not a digit. Returns zero (which callers treat as invalid)
+    if there are no digits. As HTML5 specifies, zero, surrogates, and values beyond the unicode range
+    are read as the replacement character (U+FFFD).*/
+    template<typename T>
+    static unsigned int read_numeric_entity(const T* text, const T* textEnd, const bool isHex)
         {
+        //anything beyond the unicode range will be clamped to this to prevent overflowing
+        const unsigned int invalidValue = 0x110000;
+        const T* const digitsStart = text;
+        unsigned int value = 0;
+        if (isHex)
+            {
+            for (; text < textEnd; ++text)
+                {
+                //digits and letters are mapped to their values with unsigned wrap around, instead of range checks
+                unsigned int digit = static_cast<unsigned int>(*text)-common_lang_constants::NUMBER_0;
+                if (digit > 9)
+                    {
+                    digit = (static_cast<unsigned int>(*text)|0x20)-common_lang_constants::LOWER_A;
+                    if (digit > 5)
+                        { break; }
+                    digit += 10;
+                    }
+                value = std::min((value<<4)|digit, invalidValue);
+                }
+            }
+        else
+            {
+            for (; text < textEnd; ++text)
+                {
+                const unsigned int digit = static_cast<unsigned int>(*text)-common_lang_constants::NUMBER_0;
+                if (digit > 9)
+                    { break; }
+                value = std::min((value*10)+digit, invalidValue);
+                }
+            }
+        if (text == digitsStart)
+            { return 0; }
+        return (value == 0 || value == invalidValue || is_within<unsigned int>(value, 0xD800, 0xDFFF)) ? 0xFFFD : value;
+        }
+
+    /*When a stream is read in chunks, a UTF-8 character may be split between two chunks.
+    Returns the end of the text, moved back to the start of the last character if all of its bytes aren't here yet.*/
+    static const char* trim_partial_character(const char* text, const char* textEnd)
+        {
+        for (const char* leadByte = textEnd; leadByte > text && (textEnd-leadByte) < 4; )
+            {
+            --leadByte;
+            const unsigned char ch = static_cast<unsigned char>(*leadByte);
+            //skip back over continuation bytes
+            if ((ch & 0xC0) == 0x80)
+                { continue; }
+            //the same sequence lengths that extract_text::decode_utf8() expects
+            const size_t sequenceLength = (ch >= 0xC2 && ch <= 0xDF) ? 2 :
+                                          (ch >= 0xE0 && ch <= 0xEF) ? 3 :
+                                          (ch >= 0xF0 && ch <= 0xF4) ? 4 : 1;
+            return (static_cast<size_t>(textEnd-leadByte) < sequenceLength) ? leadByte : textEnd;
+            }
+        return textEnd;
+        }
+
+    //wide text is read as-is, so it can be split anywhere
+    static inline const wchar_t* trim_partial_character(const wchar_t*, const wchar_t* textEnd)
+        { return textEnd; }
+
+    /*Returns where text that may be continued in the next chunk of a stream can be split.
+    An entity is only known to be complete once one of the characters that can end it
+    (see parse_raw_text()) is read, so anything from the first '&' after the last of those is held back.
+    Likewise, "&amp;" is read along with the word after it (in case it is something like "&amp;le;"),
+    so it is held back until that word is finished.*/
+    template<typename T>
+    static const T* find_text_break(const T* text, const T* textEnd)
+        {
+        const T* textBreak = textEnd;
+        bool isEntityTerminated = false;
+        bool isWordTerminated = false;
+        for (const T* position = textEnd; position > text && !(isEntityTerminated && isWordTerminated); )
+            {
+            --position;
+            if (*position == common_lang_constants::AMPERSAND)
+                {
+                if (!isEntityTerminated)
+                    { textBreak = position; }
+                }
+            else if (*position == common_lang_constants::SEMICOLON)
+                {
+                if (!isWordTerminated && (position-text) >= 4 &&
+                    position[-4] == common_lang_constants::AMPERSAND &&
+                    (string_util::strncmp(position-3, MARKUP_LITERAL(T, "amp"), 3) == 0 ||
+                     string_util::strncmp(position-3, MARKUP_LITERAL(T, "AMP"), 3) == 0))
+                    {
+                    //an entity before this one may be ended by this ';', so it needs to be held back with it
+                    return find_text_break(text, position-4);
+                    }
+                isEntityTerminated = isWordTerminated = true;
+                }
+            else if (*position == common_lang_constants::LESS_THAN ||
+                *position == common_lang_constants::SPACE ||
+                *position == common_lang_constants::TAB ||
+                *position == L'\n' || *position == L'\r')
+                {
+                isEntityTerminated = true;
+                isWordTerminated = isWordTerminated || is_markup_space(*position);
+                }
+            else if (is_markup_space(*position))
+                { isWordTerminated = true; }
+            }
+        return trim_partial_character(text, textBreak);
+        }
+
+    template<typename T>
+    void html_extract_text::parse_raw_text(const T* text, size_t textSize)
+        {
+        //the characters to scan for
+        static const string_util::char_set_matcher<T> ENTITY_START_SET(MARKUP_LITERAL(T, "&"), 1);
+        static const string_util::char_set_matcher<T> ENTITY_START_OR_NEWLINE_SET(MARKUP_LITERAL(T, "\r\n&"), 3);
+        static const string_util::char_set_matcher<T> ENTITY_TERMINATOR_SET(MARKUP_LITERAL(T, ";< \t\n\r"), 6);
         size_t currentStartPosition = 0;
-        if (textSize > 0)
+        //decoding never makes the text longer, so this is all of the room that will be needed
+        if (textSize > 0 && reserve_text(textSize))
             {
+            //where the text that hasn't been sent to the event handler yet starts
+            size_t runStart = get_filtered_text_length();
             while (textSize > 0)
                 {
                 size_t index = 0;
                 //if preformatted then just look for ampersands
                 if (m_is_in_preformatted_text_block_stack > 0)
-                    { index = string_util::strncspn<wchar_t>(text+currentStartPosition, textSize, L"&", 1); }
+                    { index = string_util::strncspn<T>(text+currentStartPosition, textSize, ENTITY_START_SET); }
                 //otherwise, eat up crlfs and replace with spaces
                 else
-                    { index = string_util::strncspn<wchar_t>(text+currentStartPosition, textSize, L"\r\n&", 3); }
+                    { index = string_util::strncspn<T>(text+currentStartPosition, textSize, ENTITY_START_OR_NEWLINE_SET); }
                 index += currentStartPosition;//move the index to the position in the full valid string
                 if (index < textSize)
                     {
                     if (text[index] == common_lang_constants::AMPERSAND)
                         {
-                        const wchar_t* semicolon = string_util::strcspn_pointer<wchar_t>(text+index+1, L";< \t\n\r", 6);
-                        /*this should not happen in valid HTML, but in case there is an
-                        orphan & then skip it and look for the next item.*/
-                        if (semicolon == NULL ||
-                            (semicolon > text+textSize))
+                        /*The end of the text also ends the entity (the text does not need to be NULL terminated,
+                        so nothing past it is read). In that case, there is no terminating character to copy over.*/
+                        const T* const textEnd = text+textSize;
+                        const T* semicolon = text+index+1+
+                            string_util::strncspn<T>(text+index+1, textSize-(index+1), ENTITY_TERMINATOR_SET);
+                        const bool isTerminatorInText = (semicolon < textEnd);
+                        //copy over the proceeding text
+                        if (index > 0)
+                            { add_characters(text, index); }
+                        const size_t entityOutputStart = get_filtered_text_length();
+                        //whether an entity was decoded (as opposed to the text being copied over as-is)
+                        bool isDecoded = true;
+                        //an orphan & at the end of the text
+                        if (semicolon == text+index+1 && !isTerminatorInText)
                             {
-                            //copy over the proceeding text (up to the ampersand)
-                            if (index > 0)
-                                {
-                                add_characters(text, index);
-                                add_character(common_lang_constants::AMPERSAND);
-                                }
-                            //update indices into the raw HTML text
-                            if ((index+1) > textSize)
-                                { textSize = 0; }
-                            else
-                                { textSize -= index+1; }
-                            text += index+1;
-                            currentStartPosition = 0;
-                            continue;
+                            add_character(common_lang_constants::AMPERSAND);
+                            isDecoded = false;
                             }
-                        else
+                        //in case this is an unencoded ampersand then treat it as such
+                        else if (is_markup_space(text[index+1]))
                             {
-                            //copy over the proceeding text
-                            if (index > 0)
-                                { add_characters(text, index); }
-                            //in case this is an unencoded ampersand then treat it as such
-                            if (std::iswspace(text[index+1]))
-                                {
-                                add_character(common_lang_constants::AMPERSAND);
-                                add_character(common_lang_constants::SPACE);
-                                }
-                            //convert an encoded number to character
-                            else if (text[index+1] == common_lang_constants::POUND)
+                            add_character(common_lang_constants::AMPERSAND);
+                            add_character(common_lang_constants::SPACE);
+                            isDecoded = false;
+                            }
+                        //convert an encoded number to character
+                        else if (text[index+1] == common_lang_constants::POUND)
+                            {
+                            const bool isHex = (text+index+2 < textEnd) &&
+                                is_either<T>(text[index+2], common_lang_constants::LOWER_X, common_lang_constants::UPPER_X);
+                            //skip "&#x" or "&#"
+                            const unsigned int value = read_numeric_entity(text+index+(isHex ? 3 : 2), semicolon, isHex);
+                            if (value != 173)//soft hyphens should just be stripped out
                                 {
-                                const wchar_t value = is_either(text[index+2], common_lang_constants::LOWER_X, common_lang_constants::UPPER_X) ?
-                                    //if it is hex encoded
-                                    static_cast<wchar_t>(string_util::axtoi(text+index+3, (textSize-(index+3))))/*skip "&#x"*/ :
-                                    //else it is a plain numeric value
-                                    static_cast<wchar_t>(string_util::atoi(text+index+2));
-                                if (value != 173)//soft hyphens should just be stripped out
+                                //ligatures
+                                if (is_within<unsigned int>(value, 0xFB00, 0xFB06))
                                     {
-                                    //ligatures
-                                    if (is_within<wchar_t>(value, 0xFB00, 0xFB06))
-                                        {
-                                        switch (value)
-                                            {
-                                        case 0xFB00:
-                                            add_characters(L"ff",2);
-                                            break;
-                                        case 0xFB01:
-                                            add_characters(L"fi",2);
-                                            break;
-                                        case 0xFB02:
-                                            add_characters(L"fl",2);
-                                            break;
-                                        case 0xFB03:
-                                            add_characters(L"ffi",3);
-                                            break;
-                                        case 0xFB04:
-                                            add_characters(L"ffl",3);
-                                            break;
-                                        case 0xFB05:
-                                            add_characters(L"ft",2);
-                                            break;
-                                        case 0xFB06:
-                                            add_characters(L"st",2);
-                                            break;
-                                            };
-                                        }
-                                    else if (value != 0)
-                                        { add_character(value); }
-                                    //in case conversion failed to come up with a number (incorrect encoding in the HTML maybe)
-                                    else
+                                    switch (value)
                                         {
-                                        log_message(L"Invalid numeric HTML entity: "+std::wstring(text+index, (semicolon+1)-(text+index)));
-                                        add_characters(text+index, (semicolon+1)-(text+index));
-                                        }
+                                    case 0xFB00:
+                                        add_characters(L"ff",2);
+                                        break;
+                                    case 0xFB01:
+                                        add_characters(L"fi",2);
+                                        break;
+                                    case 0xFB02:
+                                        add_characters(L"fl",2);
+                                        break;
+                                    case 0xFB03:
+                                        add_characters(L"ffi",3);
+                                        break;
+                                    case 0xFB04:
+                                        add_characters(L"ffl",3);
+                                        break;
+                                    case 0xFB05:
+                                        add_characters(L"ft",2);
+                                        break;
+                                    case 0xFB06:
+                                        add_characters(L"st",2);
+                                        break;
+                                        };
+                                    }
+                                else if (value != 0)
+                                    { add_code_point(value); }
+                                //in case conversion failed to come up with a number (incorrect encoding in the HTML maybe)
+                                else
+                                    {
+                                    const size_t entityLength = (semicolon-(text+index)) + (isTerminatorInText ? 1 : 0);
+                                    log_message(L"Invalid numeric HTML entity: "+to_wide_string(text+index, entityLength));
+                                    add_characters(text+index, entityLength);
+                                    isDecoded = false;
                                     }
                                 }
-                            //look up named entities, such as "amp" or "nbsp"
-                            else
+                            }
+                        //look up named entities, such as "amp" or "nbsp"
+                        else
+                            {
+                            const html_utilities::html_entity* entity = HTML_TABLE_LOOKUP.find_entity(text+index+1, semicolon-(text+index+1));
+                            const unsigned int value = entity ? entity->m_code_point : common_lang_constants::QUESTION_MARK;
+                            if (value != 173)//soft hyphens should just be stripped out
                                 {
-                                const wchar_t value = HTML_TABLE_LOOKUP.find(text+index+1, semicolon-(text+index+1));
-                                if (value != 173)//soft hyphens should just be stripped out
+                                //Missing semicolon and not a valid entity?  Must be an unencoded ampersand with a letter right next to it, so just copy that over
+                                if (entity == NULL && (!isTerminatorInText || semicolon[0] != common_lang_constants::SEMICOLON))
                                     {
-                                    //Missing semicolon and not a valid entity?  Must be an unencoded ampersand with a letter right next to it, so just copy that over
-                                    if (value == common_lang_constants::QUESTION_MARK && semicolon[0] != common_lang_constants::SEMICOLON)
-                                        {
-                                        log_message(L"Unencoded ampersand or unknown HTML entity: "+std::wstring(text+index, semicolon-(text+index)));
-                                        add_characters(text+index, (semicolon-(text+index)+1) );
-                                        }
-                                    else
+                                    log_message(L"Unencoded ampersand or unknown HTML entity: "+to_wide_string(text+index, semicolon-(text+index)));
+                                    add_characters(text+index, (semicolon-(text+index)) + (isTerminatorInText ? 1 : 0));
+                                    isDecoded = false;
+                                    }
+                                else
+                                    {
+                                    //Check for something like "&amp;le;", which should really be "&le;".
+                                    //Workaround around it and log a warning.
+                                    bool leadingAmpersandEncodedCorrectly = true;
+                                    if (isTerminatorInText && semicolon[0] == common_lang_constants::SEMICOLON &&
+                                        value == common_lang_constants::AMPERSAND)
                                         {
-                                        //Check for something like "&amp;le;", which should really be "&le;".
-                                        //Workaround around it and log a warning.
-                                        bool leadingAmpersandEncodedCorrectly = true;
-                                        if (semicolon[0] == common_lang_constants::SEMICOLON &&
-                                            value == common_lang_constants::AMPERSAND)
+                                        const T* nextTerminator = semicolon+1;
+                                        while (nextTerminator < textEnd &&
+                                               !is_markup_space(*nextTerminator) && *nextTerminator != common_lang_constants::SEMICOLON)
+                                            { ++nextTerminator; }
+                                        if (nextTerminator < textEnd && *nextTerminator == common_lang_constants::SEMICOLON)
                                             {
-                                            const wchar_t* nextTerminator = semicolon+1;
-                                            while (!iswspace(*nextTerminator) && *nextTerminator != common_lang_constants::SEMICOLON &&
-                                                    nextTerminator < (text+textSize))
-                                                { ++nextTerminator; }
-                                            if (nextTerminator < (text+textSize) && *nextTerminator == common_lang_constants::SEMICOLON)
+                                            const html_utilities::html_entity* badlyEncodedEntity = HTML_TABLE_LOOKUP.find_entity(semicolon+1, nextTerminator-(semicolon+1));
+                                            if (badlyEncodedEntity != NULL)
                                                 {
-                                                const wchar_t badlyEncodedEntity = HTML_TABLE_LOOKUP.find(semicolon+1, nextTerminator-(semicolon+1));
-                                                if (badlyEncodedEntity != common_lang_constants::QUESTION_MARK)
-                                                    {
-                                                    log_message(L"Ampersand incorrectly encoded in HTML entity: "+std::wstring(text+index, (nextTerminator-(text+index))+1));
-                                                    leadingAmpersandEncodedCorrectly = false;
-                                                    semicolon = nextTerminator;
-                                                    add_character(badlyEncodedEntity);
-                                                    }
+                                                log_message(L"Ampersand incorrectly encoded in HTML entity: "+to_wide_string(text+index, (nextTerminator-(text+index))+1));
+                                                leadingAmpersandEncodedCorrectly = false;
+                                                semicolon = nextTerminator;
+                                                add_code_point(badlyEncodedEntity->m_code_point);
+                                                if (badlyEncodedEntity->m_second_code_point != 0)
+                                                    { add_code_point(badlyEncodedEntity->m_second_code_point); }
                                                 }
                                             }
-                                        //appears to be a correctly-formed entity
-                                        if (leadingAmpersandEncodedCorrectly)
+                                        }
+                                    //appears to be a correctly-formed entity
+                                    if (leadingAmpersandEncodedCorrectly)
+                                        {
+                                        add_code_point(value);
+                                        if (entity != NULL && entity->m_second_code_point != 0)
+                                            { add_code_point(entity->m_second_code_point); }
+                                        if (entity == NULL)
+                                            { log_message(L"Unknown HTML entity: "+to_wide_string(text+index, semicolon-(text+index))); }
+                                        //Entity not correctly terminated by a semicolon. Here we will copy over the converted entity and trailing character (a space or newline).
+                                        if (!isTerminatorInText || semicolon[0] != common_lang_constants::SEMICOLON)
                                             {
-                                            add_character(value);
-                                            if (value == common_lang_constants::QUESTION_MARK)
-                                                { log_message(L"Unknown HTML entity: "+std::wstring(text+index, semicolon-(text+index))); }
-                                            //Entity not correctly terminated by a semicolon. Here we will copy over the converted entity and trailing character (a space or newline).
-                                            if (semicolon[0] != common_lang_constants::SEMICOLON)
-                                                {
-                                                log_message(L"Missing semicolon on HTML entity: "+std::wstring(text+index, semicolon-(text+index)));
-                                                add_character(semicolon[0]);
-                                                }
+                                            log_message(L"Missing semicolon on HTML entity: "+to_wide_string(text+index, semicolon-(text+index)));
+                                            if (isTerminatorInText)
+                                                { add_characters(semicolon, 1); }
                                             }
                                         }
                                     }
                                 }
-                            //update indices into the raw HTML text
-                            if (static_cast<size_t>((semicolon+1)-(text)) > textSize)
-                                { textSize = 0; }
-                            else
-                                { textSize -= (semicolon+1)-(text); }
+                            }
+                        //whatever the entity was decoded to maps back to its '&'
+                        map_decoded_text(text+index, entityOutputStart);
+                        //send the text in front of the entity, and then the entity, as separate events
+                        if (isDecoded && m_event_handler != NULL)
+                            {
+                            report_text(runStart, entityOutputStart);
+                            report_entity(entityOutputStart);
+                            runStart = get_filtered_text_length();
+                            }
+                        //update indices into the raw HTML text
+                        if (!isTerminatorInText)
+                            { textSize = 0; }
+                        else
+                            {
+                            textSize -= (semicolon+1)-(text);
                             text = semicolon+1;
-                            currentStartPosition = 0;
                             }
+                        currentStartPosition = 0;
                         }
                     else
                         {
                         //copy over the proceeding text
                         add_characters(text, index);
                         add_character(common_lang_constants::SPACE);
+                        map_copied_text(text+index, get_filtered_text_length()-1, 1);
                         //update indices into the raw HTML text
                         if ((index+1) > textSize)
                             { textSize = 0; }
@@ -250,6 +383,7 @@ namespace lily_of_the_valley
 
             if (textSize > 0)
                 { add_characters(text, textSize); }
+            report_text(runStart, get_filtered_text_length());
             }
         }
 
@@ -365,16 +499,17 @@ namespace lily_of_the_valley
             { return charset; }
         }
 
-    const wchar_t* html_extract_text::stristr_not_quoted(
-            const wchar_t* string, const size_t stringSize,
-            const wchar_t* strSearch, const size_t strSearchSize)
+    template<typename T>
+    const T* html_extract_text::stristr_not_quoted(
+            const T* string, const size_t stringSize,
+            const T* strSearch, const size_t strSearchSize)
         {
         if (!string || !strSearch || stringSize == 0 || strSearchSize == 0)
             { return NULL; }
 
         bool is_inside_of_quotes = false;
         bool is_inside_of_single_quotes = false;
-        const wchar_t* const endSentinel = string+stringSize;
+        const T* const endSentinel = string+stringSize;
         while (string && (string+strSearchSize <= endSentinel))
             {
             //compare the characters one at a time
@@ -415,33 +550,37 @@ namespace lily_of_the_valley
         return NULL;
         }
 
-    std::pair<const wchar_t*, size_t> html_extract_text::read_tag(const wchar_t* text,
-            const wchar_t* tag, const size_t tagSize,
+    template<typename T>
+    std::pair<const T*, size_t> html_extract_text::read_tag(const T* text,
+            const T* tag, const size_t tagSize,
             const bool allowQuotedTags,
-            const bool allowSpacesInValue /*= false*/)
+            const bool allowSpacesInValue /*= false*/,
+            const T* endSentinel /*= NULL*/)
         {
         if (!text || !tag || tagSize == 0)
-            { return std::pair<const wchar_t*, size_t>(NULL,0); }
-        assert((std::wcslen(tag) == tagSize) && "Invalid length passed to read_tag().");
-        const wchar_t* foundTag = find_tag(text, tag, tagSize, allowQuotedTags);
-        const wchar_t* elementEnd = find_close_tag(text);
+            { return std::pair<const T*, size_t>(NULL,0); }
+        assert((string_util::strlen(tag) == tagSize) && "Invalid length passed to read_tag().");
+        const T* foundTag = find_tag(text, tag, tagSize, allowQuotedTags, endSentinel);
+        const T* elementEnd = find_close_tag(text, false, endSentinel);
         if (foundTag && elementEnd &&
             foundTag < elementEnd)
             {
             foundTag += tagSize;
-            const size_t startIndex = string_util::find_first_not_of(foundTag, (elementEnd-foundTag), L" =\"':", 5);
+            const size_t startIndex = string_util::find_first_not_of(foundTag, (elementEnd-foundTag), MARKUP_LITERAL(T, " =\"':"), 5);
             if (startIndex == static_cast<size_t>(elementEnd-foundTag))
-                { return std::pair<const wchar_t*, size_t>(NULL,0); }
+                { return std::pair<const T*, size_t>(NULL,0); }
             foundTag += startIndex;
-            const wchar_t* end = 
+            //the element's '>' is one of the terminators, so the value never goes past it
+            const size_t searchLength = (elementEnd+1)-foundTag;
+            const T* end = foundTag+(
                 (allowQuotedTags && allowSpacesInValue) ?
-                    string_util::strcspn_pointer(foundTag, L"\"'>;", 4) :
+                    string_util::strncspn<T>(foundTag, searchLength, MARKUP_LITERAL(T, "\"'>;"), 4) :
                 allowQuotedTags ?
-                    string_util::strcspn_pointer(foundTag, L" \"'>;", 5) :
+                    string_util::strncspn<T>(foundTag, searchLength, MARKUP_LITERAL(T, " \"'>;"), 5) :
                 allowSpacesInValue ?
-                    string_util::strcspn_pointer(foundTag, L"\"'>", 3) :
+                    string_util::strncspn<T>(foundTag, searchLength, MARKUP_LITERAL(T, "\"'>"), 3) :
                 //not allowing spaces and the tag is not inside of quotes (like a style section)
-                    string_util::strcspn_pointer(foundTag, L" \"'>", 4);
+                    string_util::strncspn<T>(foundTag, searchLength, MARKUP_LITERAL(T, " \"'>"), 4));
             if (end && (end <= elementEnd))
                 {
                 //If at the end of the element, trim off any trailing spaces or a terminating '/'.
@@ -451,45 +590,47 @@ namespace lily_of_the_valley
                     {
                     while (end-1 > foundTag)
                         {
-                        if (is_either<wchar_t>(*(end-1), L'/', L' '))
+                        if (is_either<T>(*(end-1), common_lang_constants::FORWARD_SLASH, common_lang_constants::SPACE))
                             { --end; }
                         else
                             { break; }
                         }
                     }
-                return std::pair<const wchar_t*, size_t>(foundTag, (end-foundTag));
+                return std::pair<const T*, size_t>(foundTag, (end-foundTag));
                 }
             else
-                { return std::pair<const wchar_t*, size_t>(NULL,0); }
+                { return std::pair<const T*, size_t>(NULL,0); }
             }
         else
-            { return std::pair<const wchar_t*, size_t>(NULL,0); }
+            { return std::pair<const T*, size_t>(NULL,0); }
         }
 
-    const wchar_t* html_extract_text::find_tag(const wchar_t* text,
-            const wchar_t* tag, const size_t tagSize,
-            const bool allowQuotedTags)
+    template<typename T>
+    const T* html_extract_text::find_tag(const T* text,
+            const T* tag, const size_t tagSize,
+            const bool allowQuotedTags,
+            const T* endSentinel /*= NULL*/)
         {
         if (!text || !tag || tagSize == 0)
             { return NULL; }
-        const wchar_t* foundTag = text;
-        const wchar_t* const elementEnd = find_close_tag(text);
+        const T* foundTag = text;
+        const T* const elementEnd = find_close_tag(text, false, endSentinel);
         if (!elementEnd)
             { return NULL; }
         while (foundTag)
             {
             foundTag = allowQuotedTags ?
-                string_util::strnistr<wchar_t>(foundTag, tag, (elementEnd-foundTag))
+                string_util::strnistr<T>(foundTag, tag, (elementEnd-foundTag))
                 : stristr_not_quoted(foundTag, (elementEnd-foundTag), tag, tagSize);
             if (!foundTag || (foundTag > elementEnd))
                 { return NULL; }
             if (foundTag == text)
                 { return foundTag; }
-            else if (allowQuotedTags && is_either<wchar_t>(foundTag[-1], L'\'', L'\"'))
+            else if (allowQuotedTags && is_either<T>(foundTag[-1], common_lang_constants::APOSTROPHE, common_lang_constants::DOUBLE_QUOTE))
                 { return foundTag; }
             //this tag should not be count if it is really just part of a bigger tag (e.g., "color" will
             //not count if what we are really on is "bgcolor")
-            else if (std::iswspace(foundTag[-1]) || (foundTag[-1] == common_lang_constants::SEMICOLON))
+            else if (is_markup_space(foundTag[-1]) || (foundTag[-1] == common_lang_constants::SEMICOLON))
                 { return foundTag; }
             foundTag += tagSize;
             }
@@ -500,13 +641,129 @@ namespace lily_of_the_valley
                                                  const size_t text_length,
                                                  const bool include_outer_text /*= true*/,
                                                  const bool preserve_spaces /*= false*/)
+        { return extract(html_text, text_length, include_outer_text, preserve_spaces); }
+
+    const wchar_t* html_extract_text::operator()(const char* html_text,
+                                                 const size_t text_length,
+                                                 const bool include_outer_text /*= true*/,
+                                                 const bool preserve_spaces /*= false*/)
+        { return extract(html_text, text_length, include_outer_text, preserve_spaces); }
+
+    void html_extract_text::begin_stream(const bool preserve_spaces /*= false*/)
+        {
+        //reset any state variables
+        clear_log();
+        reset_stream_state(preserve_spaces);
+        m_stream_buffer.clear();
+        m_utf8_stream_buffer.clear();
+        m_streamed_length = 0;
+        m_is_streaming = begin_text();
+        }
+
+    void html_extract_text::reset_stream_state(const bool preserve_spaces)
+        {
+        m_is_in_preformatted_text_block_stack = preserve_spaces ? 1 : 0;
+        m_parse_state = plain_text_parse_state;
+        m_open_section = unknown_element;
+        m_is_symbol_font_section = false;
+        m_element_scan_length = 0;
+        }
+
+    const wchar_t* html_extract_text::parse_stream_chunk(const wchar_t* start, const wchar_t* endSentinel, const bool is_final)
+        { return parse_html_stream_chunk(start, endSentinel, is_final); }
+
+    const char* html_extract_text::parse_stream_chunk(const char* start, const char* endSentinel, const bool is_final)
+        { return parse_html_stream_chunk(start, endSentinel, is_final); }
+
+    template<typename T>
+    const T* html_extract_text::parse_html_stream_chunk(const T* start, const T* const endSentinel, const bool is_final)
+        {
+        const T* const end = parse_markup(start, endSentinel, is_final);
+        //get any text lingering after the last >
+        if (is_final && end && end < endSentinel)
+            { parse_raw_text(end, endSentinel-end); }
+        return end;
+        }
+
+    void html_extract_text::feed(const wchar_t* html_chunk, const size_t chunk_length)
+        { feed_stream(m_stream_buffer, html_chunk, chunk_length); }
+
+    void html_extract_text::feed(const char* html_chunk, const size_t chunk_length)
+        { feed_stream(m_utf8_stream_buffer, html_chunk, chunk_length); }
+
+    const wchar_t* html_extract_text::finish()
+        {
+        if (!m_is_streaming)
+            {
+            begin_stream();
+            if (!m_is_streaming)
+                {
+                set_filtered_text_length(0);
+                return NULL;
+                }
+            }
+        //if a budget ran out, then whatever is left in the stream is not read
+        if (is_budget_exceeded())
+            {
+            m_utf8_stream_buffer.clear();
+            m_stream_buffer.clear();
+            }
+        else if (m_utf8_stream_buffer.length())
+            { finish_stream(m_utf8_stream_buffer); }
+        else
+            { finish_stream(m_stream_buffer); }
+        //(a budget may also run out while reading the end of the stream)
+        trim_to_budget_boundary();
+        m_is_streaming = false;
+        return finalize_text();
+        }
+
+    template<typename T>
+    void html_extract_text::feed_stream(std::basic_string<T>& stream_buffer,
+                                        const T* html_chunk, const size_t chunk_length)
+        {
+        if (!m_is_streaming)
+            {
+            begin_stream();
+            if (!m_is_streaming)
+                { return; }
+            }
+        if (html_chunk == NULL || chunk_length == 0 || is_budget_exceeded())
+            { return; }
+        //only read up to the input budget
+        size_t readLength = chunk_length;
+        const size_t maxInputLength = get_budget().m_max_input_length;
+        const bool isInputClipped = (maxInputLength > 0 && m_streamed_length+chunk_length > maxInputLength);
+        if (isInputClipped)
+            { readLength = maxInputLength-m_streamed_length; }
+        m_streamed_length += readLength;
+        stream_buffer.append(html_chunk, readLength);
+        const T* const bufferStart = stream_buffer.c_str();
+        //the buffer holds the end of what has been streamed so far
+        set_offset_source(bufferStart, stream_buffer.length(), m_streamed_length-stream_buffer.length());
+        const T* const parsedEnd = parse_stream_chunk(bufferStart, bufferStart+stream_buffer.length(), false);
+        //hold onto whatever couldn't be parsed yet, the rest of it will be in the next chunk
+        stream_buffer.erase(0, parsedEnd ? static_cast<size_t>(parsedEnd-bufferStart) : stream_buffer.length());
+        if (isInputClipped)
+            { exceed_budget(L"Input limit reached; the rest of the document was not read."); }
+        }
+
+    template<typename T>
+    void html_extract_text::finish_stream(std::basic_string<T>& stream_buffer)
+        {
+        const T* const bufferStart = stream_buffer.c_str();
+        const T* const endSentinel = bufferStart+stream_buffer.length();
+        set_offset_source(bufferStart, stream_buffer.length(), m_streamed_length-stream_buffer.length());
+        parse_stream_chunk(bufferStart, endSentinel, true);
+        stream_buffer.clear();
+        }
+
+    template<typename T>
+    const wchar_t* html_extract_text::extract(const T* html_text,
+                                              const size_t text_length,
+                                              const bool include_outer_text,
+                                              const bool preserve_spaces)
         {
-        static const std::wstring HTML_STYLE_END(L"</style>");
-        static const std::wstring HTML_SCRIPT(L"script");
-        static const std::wstring HTML_SCRIPT_END(L"</script>");
-        static const std::wstring HTML_NOSCRIPT_END(L"</noscript>");
-        static const std::wstring HTML_TITLE_END(L"</title>");
-        static const std::wstring HTML_COMMENT_END(L"-->");
         //reset any state variables
         clear_log();
         m_is_in_preformatted_text_block_stack = preserve_spaces ? 1 : 0;
@@ -517,98 +774,366 @@ namespace lily_of_the_valley
             set_filtered_text_length(0);
             return NULL;
             }
-        NON_UNIT_TEST_ASSERT(text_length <= string_util::strlen(html_text) );
 
-        if (!allocate_text_buffer(text_length))
+        if (!begin_text())
             {
             set_filtered_text_length(0);
             return NULL;
             }
+        set_offset_source(html_text, text_length);
+
+        /*If only reading part of the text, then parse it like a chunk of a stream. That way,
+        whatever is cut off at the end (e.g., half of an element) is left unread.*/
+        const size_t maxInputLength = get_budget().m_max_input_length;
+        const bool isInputClipped = (maxInputLength > 0 && text_length > maxInputLength);
+        const T* const endSentinel = html_text+(isInputClipped ? maxInputLength : text_length);
 
         //find the first <. If not found then just parse this as encoded HTML text
-        const wchar_t* start = string_util::strchr(html_text, common_lang_constants::LESS_THAN);
+        const T* start = string_util::strnchr<T>(html_text, common_lang_constants::LESS_THAN, endSentinel-html_text);
         if (!start)
             {
             if (include_outer_text)
-                { parse_raw_text(html_text, text_length); }
+                {
+                const T* const textEnd = isInputClipped ? find_text_break(html_text, endSentinel) : endSentinel;
+                parse_raw_text(html_text, limit_to_output_budget(html_text, textEnd)-html_text);
+                }
             }
         //if there is text outside of the starting < section then just decode it
         else if (start > html_text && include_outer_text)
             {
-            parse_raw_text(html_text, std::min<size_t>((start-html_text), text_length));
+            parse_raw_text(html_text, limit_to_output_budget(html_text, start)-html_text);
             }
-        const wchar_t* end = NULL;
 
-        const wchar_t* const endSentinel = html_text+text_length;
+        m_parse_state = element_parse_state;
+        m_open_section = unknown_element;
+        m_element_scan_length = 0;
+        const T* const end = parse_markup(start, endSentinel, !isInputClipped);
+
+        if (isInputClipped)
+            { exceed_budget(L"Input limit reached; the rest of the document was not read."); }
+        //get any text lingering after the last >
+        else if (end && end < endSentinel && include_outer_text && !is_budget_exceeded())
+            {
+            parse_raw_text(end, limit_to_output_budget(end, endSentinel)-end);
+            }
+        trim_to_budget_boundary();
+
+        return finalize_text();
+        }
+
+    size_t html_extract_text::extract_segment(const wchar_t* html_text, const size_t text_length,
+                                              const bool include_outer_text, const segment_state& start_state,
+                                              const bool is_final, segment_state& end_state)
+        { return extract_segment_text(html_text, text_length, include_outer_text, start_state, is_final, end_state); }
+
+    size_t html_extract_text::extract_segment(const char* html_text, const size_t text_length,
+                                              const bool include_outer_text, const segment_state& start_state,
+                                              const bool is_final, segment_state& end_state)
+        { return extract_segment_text(html_text, text_length, include_outer_text, start_state, is_final, end_state); }
+
+    template<typename T>
+    size_t html_extract_text::extract_segment_text(const T* html_text, const size_t text_length,
+                                                   const bool include_outer_text, const segment_state& start_state,
+                                                   const bool is_final, segment_state& end_state)
+        {
+        clear_log();
+        end_state = start_state;
+        if (!begin_text())
+            {
+            set_filtered_text_length(0);
+            return 0;
+            }
+        if (html_text == NULL || text_length == 0)
+            {
+            finalize_text();
+            return 0;
+            }
+        set_offset_source(html_text, text_length);
+
+        m_is_in_preformatted_text_block_stack = start_state.m_preformatted_depth;
+        m_parse_state = start_state.m_parse_state;
+        m_open_section = start_state.m_open_section;
+        m_is_symbol_font_section = start_state.m_is_symbol_font_section;
+        m_element_scan_length = 0;
+        const T* const endSentinel = html_text+text_length;
+        const T* start = html_text;
+        //the text in front of the first < is handled the same way that operator() does
+        if (start_state.m_is_document_start)
+            {
+            start = string_util::strnchr<T>(html_text, common_lang_constants::LESS_THAN, text_length);
+            if (!start)
+                {
+                //wait for the rest of the document to see if there is an element after this
+                if (!is_final)
+                    {
+                    finalize_text();
+                    return 0;
+                    }
+                if (include_outer_text)
+                    { parse_raw_text(html_text, text_length); }
+                }
+            else if (start > html_text && include_outer_text)
+                { parse_raw_text(html_text, start-html_text); }
+            m_parse_state = element_parse_state;
+            m_open_section = unknown_element;
+            }
+        const T* const end = parse_markup(start, endSentinel, is_final);
+        //get any text lingering after the last >
+        if (is_final && end && end < endSentinel && include_outer_text)
+            { parse_raw_text(end, endSentinel-end); }
+
+        end_state.m_preformatted_depth = m_is_in_preformatted_text_block_stack;
+        end_state.m_parse_state = m_parse_state;
+        end_state.m_open_section = m_open_section;
+        end_state.m_is_symbol_font_section = m_is_symbol_font_section;
+        end_state.m_is_document_start = false;
+
+        finalize_text();
+        return (is_final || end == NULL) ? text_length : static_cast<size_t>(end-html_text);
+        }
+
+    template<typename T>
+    const T* html_extract_text::limit_to_output_budget(const T* start, const T* end)
+        {
+        //a character of input never becomes more than one character of text (other than a
+        //code point needing a surrogate pair, which will just be trimmed off later)
+        const size_t remainingOutput = get_remaining_output_budget();
+        if (static_cast<size_t>(end-start) <= remainingOutput)
+            { return end; }
+        exceed_budget(L"Output limit reached; the rest of the document was not read.");
+        //don't cut an entity (or a character) in half, which would copy over the part of it that was read as-is
+        return find_text_break(start, start+remainingOutput);
+        }
+
+    template<typename T>
+    const T* html_extract_text::parse_markup(const T* start, const T* const endSentinel, const bool is_final)
+        {
         while (start && (start < endSentinel))
             {
-            const size_t remainingTextLength = (endSentinel-start);
-            const std::wstring currentElement = get_element_name(start+1, false);
-            bool isSymbolFontSection = false;
-            //if it's a comment then look for matching comment ending sequence
-            if (remainingTextLength >= 4 && start[0] == common_lang_constants::LESS_THAN &&
-                start[1] == L'!' && start[2] == L'-' && start[3] == L'-')
+            //stop (and leave the rest of the text unread) if a budget has run out
+            if (!take_budget_step())
+                { return NULL; }
+            //inside of a comment, script, noscript, style, title, or CDATA section, so look for where it ends
+            if (m_parse_state == section_parse_state)
                 {
-                end = string_util::strstr(start, HTML_COMMENT_END.c_str());
+                const T* const sectionEnd = (m_open_section == html_script) ? MARKUP_LITERAL(T, "</script>") :
+                    (m_open_section == html_noscript) ? MARKUP_LITERAL(T, "</noscript>") :
+                    (m_open_section == html_style) ? MARKUP_LITERAL(T, "</style>") :
+                    (m_open_section == html_title) ? MARKUP_LITERAL(T, "</title>") :
+                    (m_open_section == xml_cdata) ? MARKUP_LITERAL(T, "]]>") : MARKUP_LITERAL(T, "-->");
+                const size_t sectionEndLength = string_util::strlen(sectionEnd);
+                const T* end = is_either(m_open_section, xml_comment, xml_cdata) ?
+                    string_util::strnstr<T>(start, sectionEnd, endSentinel-start) :
+                    string_util::strnistr<T>(start, sectionEnd, endSentinel-start);
+                const bool isSkippedSection = !is_either(m_open_section, xml_comment, xml_cdata);
                 if (!end)
-                    { break; }
-                end += HTML_COMMENT_END.length();
+                    {
+                    if (is_final)
+                        {
+                        /*an unterminated CDATA section is copied over as it is, the same as one that ends
+                          (a stream can't know which one it is until it ends, so its chunks are copied over as they come in)*/
+                        if (m_open_section == xml_cdata)
+                            { add_reported_characters(start, endSentinel-start); }
+                        else if (isSkippedSection)
+                            { on_section_text(m_open_section, start, endSentinel-start, true); }
+                        return NULL;
+                        }
+                    //the end of the section may be split between this chunk and the next one
+                    const T* sectionBreak = std::max(start, endSentinel-(sectionEndLength-1));
+                    if (m_open_section == xml_cdata)
+                        {
+                        sectionBreak = trim_partial_character(start, sectionBreak);
+                        add_reported_characters(start, sectionBreak-start);
+                        }
+                    else if (isSkippedSection && sectionBreak > start)
+                        {
+                        sectionBreak = trim_partial_character(start, sectionBreak);
+                        on_section_text(m_open_section, start, sectionBreak-start, false);
+                        }
+                    return sectionBreak;
+                    }
+                //CDATA ends with its "]]>" being read as an element (see below)
+                if (m_open_section == xml_cdata)
+                    {
+                    add_reported_characters(start, end-start);
+                    start = end;
+                    m_parse_state = element_parse_state;
+                    }
+                else
+                    {
+                    if (isSkippedSection)
+                        { on_section_text(m_open_section, start, end-start, true); }
+                    start = end+sectionEndLength;
+                    m_parse_state = text_parse_state;
+                    }
+                m_open_section = unknown_element;
+                continue;
                 }
-            //if it's a script (e.g., javascript) then skip it
-            else if ((currentElement.length() == 6 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_S,common_lang_constants::UPPER_S) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_C,common_lang_constants::UPPER_C) &&
-                is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_R,common_lang_constants::UPPER_R) && is_either<wchar_t>(currentElement[3],common_lang_constants::LOWER_I,common_lang_constants::UPPER_I) &&
-                is_either<wchar_t>(currentElement[4],common_lang_constants::LOWER_P,common_lang_constants::UPPER_P) && is_either<wchar_t>(currentElement[5],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T)))
+            //inside of text that isn't after an element (i.e., before the first element or after a stray '<')
+            else if (m_parse_state == plain_text_parse_state)
                 {
-                end = string_util::stristr<wchar_t>(start, HTML_SCRIPT_END.c_str());
+                const T* end = string_util::strnchr<T>(start, common_lang_constants::LESS_THAN, endSentinel-start);
                 if (!end)
-                    { break; }
-                end += HTML_SCRIPT_END.length();
+                    {
+                    if (is_final)
+                        { return start; }
+                    //the rest of this text may be in the next chunk, so only read up to where it can be safely split
+                    end = find_text_break(start, endSentinel);
+                    parse_raw_text(start, limit_to_output_budget(start, end)-start);
+                    return end;
+                    }
+                parse_raw_text(start, limit_to_output_budget(start, end)-start);
+                start = end;
+                m_parse_state = element_parse_state;
+                continue;
                 }
-            //if it's a noscript (i.e., alternative text for when scripting is not available) then skip it
-            else if ((currentElement.length() == 8 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_N,common_lang_constants::UPPER_N) &&
-                is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_O,common_lang_constants::UPPER_O) && is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_S,common_lang_constants::UPPER_S) && is_either<wchar_t>(currentElement[3],common_lang_constants::LOWER_C,common_lang_constants::UPPER_C) &&
-                is_either<wchar_t>(currentElement[4],common_lang_constants::LOWER_R,common_lang_constants::UPPER_R) && is_either<wchar_t>(currentElement[5],common_lang_constants::LOWER_I,common_lang_constants::UPPER_I) &&
-                is_either<wchar_t>(currentElement[6],common_lang_constants::LOWER_P,common_lang_constants::UPPER_P) && is_either<wchar_t>(currentElement[7],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T)))
+            //inside of the text after an element
+            else if (m_parse_state == text_parse_state)
                 {
-                end = string_util::stristr<wchar_t>(start, HTML_NOSCRIPT_END.c_str());
-                if (!end)
-                    { break; }
-                end += HTML_NOSCRIPT_END.length();
+                const T* const end = start;
+                //find the next starting tag
+                start = string_util::strnchr<T>(end, common_lang_constants::LESS_THAN, endSentinel-end);
+                if (!start)
+                    {
+                    /*Text after the last element isn't converted as a Symbol font section, so if this is
+                    one then wait until we know whether it is the last text. Otherwise, the rest of this text
+                    may be in the next chunk, so only read up to where it can be safely split.*/
+                    if (is_final || m_is_symbol_font_section)
+                        { return end; }
+                    start = find_text_break(end, endSentinel);
+                    }
+                /*only read as much of the text as will fit in the output budget (if it is cut off, then
+                  what is read is still converted below, the same as if all of it fit)*/
+                const T* const limitedStart = limit_to_output_budget(end, start);
+                //make room for the text first, so that the sink won't hand off what we
+                //may need to read back for a Symbol font section
+                if (!reserve_text(limitedStart-end))
+                    { return NULL; }
+                const size_t previousLength = get_filtered_text_length();
+                //copy over the text between the tags (if it needs to be converted, then its events are sent after that)
+                m_is_holding_text_events = m_is_symbol_font_section;
+                parse_raw_text(end, limitedStart-end);
+                m_is_holding_text_events = false;
+                /*Old HTML used to use "Symbol" font to show various math/Greek symbols (instead of proper entities).
+                So if the current block of text is using the font "Symbol", then we will convert
+                it to the expected symbol.*/
+                if (m_is_symbol_font_section)
+                    {
+                    const std::wstring copiedOverText = convert_symbol_font_section(std::wstring(get_filtered_text()+previousLength, (get_filtered_text_length()-previousLength)) );
+                    //each character is converted to one other character, so overwrite them in place
+                    //(which leaves where they came from in the offset map as it was)
+                    std::copy(copiedOverText.begin(), copiedOverText.end(), get_writable_buffer()+previousLength);
+                    report_text(previousLength, get_filtered_text_length());
+                    if (copiedOverText.length())
+                        { log_message(L"Symbol font used for the following: \""+copiedOverText+L"\""); }
+                    }
+                //the output budget ran out in this text
+                if (limitedStart < start)
+                    { return NULL; }
+                /*if the next tag isn't in this chunk yet (or isn't all here to be checked below), then wait for the next one.
+                  A tag that is shorter than "</pre>" but is all here (i.e., it is closed) can't be one, so it doesn't need to wait.*/
+                if (start >= endSentinel || start[0] != common_lang_constants::LESS_THAN ||
+                    (!is_final && (endSentinel-start) < 6 &&
+                     string_util::strnchr<T>(start, common_lang_constants::GREATER_THAN, endSentinel-start) == NULL))
+                    { return start; }
+                //after parsing this section, see if this is the end of a preformatted area
+                if ((endSentinel-start) >= 6 &&
+                    string_util::strnicmp<T>(start, MARKUP_LITERAL(T, "</pre>"), 6) == 0)
+                    {
+                    if (m_is_in_preformatted_text_block_stack > 0)
+                        { --m_is_in_preformatted_text_block_stack; }
+                    if (m_event_handler != NULL)
+                        { m_event_handler->on_block_end(html_pre_end); }
+                    }
+                m_parse_state = element_parse_state;
+                continue;
+                }
+
+            //make room for the newlines and tabs that an element can add
+            if (!reserve_text(2))
+                { return NULL; }
+            const size_t remainingTextLength = (endSentinel-start);
+            //comments and CDATA sections are read like the other sections, so they don't need to be all in this chunk
+            const bool isComment = (remainingTextLength >= 4 && start[0] == common_lang_constants::LESS_THAN &&
+                start[1] == L'!' && start[2] == L'-' && start[3] == L'-');
+            const bool isCDataSection = (remainingTextLength >= 9 && start[1] == L'!' &&
+                start[2] == L'[' && is_either<T>(start[3], common_lang_constants::LOWER_C, common_lang_constants::UPPER_C) &&
+                is_either<T>(start[4], common_lang_constants::LOWER_D, common_lang_constants::UPPER_D) &&
+                is_either<T>(start[5], common_lang_constants::LOWER_A, common_lang_constants::UPPER_A) &&
+                is_either<T>(start[6], common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) &&
+                is_either<T>(start[7], common_lang_constants::LOWER_A, common_lang_constants::UPPER_A) &&
+                start[8] == L'[');
+            /*if the element isn't all in this chunk, then wait for the next one. Note that the checks
+            below won't read past the '<' or '>' that ends the element, so they will see the same thing
+            that they would if the entire stream were available.*/
+            if (!is_final && !isComment && !isCDataSection)
+                {
+                /*the element's end is looked for where read_element() looks for it (i.e., after a second '<' in front
+                  of its name), and after what was already looked through when the last chunk was waiting on it*/
+                const T* const scanStart = std::max<const T*>(start+m_element_scan_length,
+                    (remainingTextLength >= 2 && start[1] == common_lang_constants::LESS_THAN) ? start+2 : start+1);
+                if (string_util::strncspn<T>(scanStart, endSentinel-scanStart, MARKUP_LITERAL(T, "<>"), 2) == static_cast<size_t>(endSentinel-scanStart))
+                    {
+                    m_element_scan_length = remainingTextLength;
+                    return start;
+                    }
                 }
-            //if it's style command section then skip it
-            else if ((currentElement.length() == 5 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_S,common_lang_constants::UPPER_S) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) &&
-                is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_Y,common_lang_constants::UPPER_Y) && is_either<wchar_t>(currentElement[3],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) &&
-                is_either<wchar_t>(currentElement[4],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E)))
+            m_element_scan_length = 0;
+            m_is_symbol_font_section = false;
+            //if it's a comment then look for matching comment ending sequence
+            if (isComment)
                 {
-                end = string_util::stristr<wchar_t>(start, HTML_STYLE_END.c_str());
-                if (!end)
-                    { break; }
-                end += HTML_STYLE_END.length();
+                m_open_section = xml_comment;
+                m_parse_state = section_parse_state;
+                continue;
                 }
-            //if it's a title then look for matching title ending sequence
-            else if ((currentElement.length() == 5 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_I,common_lang_constants::UPPER_I) &&
-                is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) && is_either<wchar_t>(currentElement[3],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) &&
-                is_either<wchar_t>(currentElement[4],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E)))
+            //read in CDATA date blocks as they appear (no HTML conversation happens here)
+            else if (isCDataSection)
                 {
-                end = string_util::stristr<wchar_t>(start, HTML_TITLE_END.c_str());
-                if (!end)
-                    { break; }
-                end += HTML_TITLE_END.length();
+                start += 9;
+                m_open_section = xml_cdata;
+                m_parse_state = section_parse_state;
+                continue;
+                }
+            const basic_html_element_view<T> currentElement = read_element(start+1, endSentinel, false);
+            const markup_element currentElementId = classify_element(currentElement);
+            const T* end = NULL;
+            //if it's a script, noscript, style, or title section then skip it
+            if (is_either(currentElementId, html_script, html_noscript) ||
+                     is_either(currentElementId, html_style, html_title))
+                {
+                //the section's content starts after the element (if it is properly terminated)
+                if (currentElement.get_close_tag() != NULL)
+                    {
+                    on_element(currentElementId, currentElement);
+                    start = currentElement.get_close_tag()+1;
+                    }
+                m_open_section = currentElementId;
+                m_parse_state = section_parse_state;
+                continue;
                 }
             //stray < (i.e., < wasn't encoded) should be treated as such, instead of a tag
-            else if ((remainingTextLength >= 2 && start[0] == common_lang_constants::LESS_THAN && std::iswspace(start[1])) ||
+            else if ((remainingTextLength >= 2 && start[0] == common_lang_constants::LESS_THAN && is_markup_space(start[1])) ||
                 (remainingTextLength >= 7 && start[0] == common_lang_constants::LESS_THAN &&
-                start[1] == common_lang_constants::AMPERSAND && is_either<wchar_t>(start[2], common_lang_constants::LOWER_N, common_lang_constants::UPPER_N) &&
-                is_either<wchar_t>(start[3], common_lang_constants::LOWER_B, common_lang_constants::UPPER_B) &&
-                is_either<wchar_t>(start[4], common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) &&
-                is_either<wchar_t>(start[5], common_lang_constants::LOWER_P, common_lang_constants::UPPER_P) &&
+                start[1] == common_lang_constants::AMPERSAND && is_either<T>(start[2], common_lang_constants::LOWER_N, common_lang_constants::UPPER_N) &&
+                is_either<T>(start[3], common_lang_constants::LOWER_B, common_lang_constants::UPPER_B) &&
+                is_either<T>(start[4], common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) &&
+                is_either<T>(start[5], common_lang_constants::LOWER_P, common_lang_constants::UPPER_P) &&
                 start[6] == common_lang_constants::COLON))
                 {
-                end = string_util::strchr(start+1, common_lang_constants::LESS_THAN);
+                end = string_util::strnchr<T>(start+1, common_lang_constants::LESS_THAN, remainingTextLength-1);
                 if (!end)
                     {
-                    parse_raw_text(start, endSentinel-start);
-                    break;
+                    if (is_final)
+                        {
+                        parse_raw_text(start, endSentinel-start);
+                        return NULL;
+                        }
+                    //the rest of this text may be in the next chunk, so read it as plain text
+                    parse_raw_text(start, 1);
+                    ++start;
+                    m_parse_state = plain_text_parse_state;
+                    continue;
                     }
                 /*copy over the text from the unterminated < to the currently found
                 < (that we will start from in the next loop*/
@@ -617,107 +1142,90 @@ namespace lily_of_the_valley
                 start = end;
                 continue;
                 }
-            //read in CDATA date blocks as they appear (no HTML conversation happens here)
-            else if (currentElement.length() >= 8 && start[1] == L'!' &&
-                start[2] == L'[' && is_either<wchar_t>(start[3], common_lang_constants::LOWER_C, common_lang_constants::UPPER_C) &&
-                is_either<wchar_t>(start[4], common_lang_constants::LOWER_D, common_lang_constants::UPPER_D) &&
-                is_either<wchar_t>(start[5], common_lang_constants::LOWER_A, common_lang_constants::UPPER_A) &&
-                is_either<wchar_t>(start[6], common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) &&
-                is_either<wchar_t>(start[7], common_lang_constants::LOWER_A, common_lang_constants::UPPER_A) &&
-                start[8] == L'[')
-                {
-                start += 9;
-                end = string_util::strstr(start, L"]]>");
-                if (!end || end > endSentinel)
-                    {
-                    ++m_is_in_preformatted_text_block_stack;//preserve newline formatting
-                    parse_raw_text(start, endSentinel-start);
-                    --m_is_in_preformatted_text_block_stack;
-                    break;
-                    }
-                add_characters(start, end-start);
-                start = end;
-                end += 2;
-                continue;
-                }
             else
                 {
                 //Symbol font section (we will need to do some special formatting later). First, special logic for "font" element...
-                if ((currentElement.length() == 4 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_F,common_lang_constants::UPPER_F) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_O,common_lang_constants::UPPER_O) && 
-                    is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_N,common_lang_constants::UPPER_N) && is_either<wchar_t>(currentElement[3],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T)))
+                if (currentElementId == html_font)
                     {
-                    if (string_util::strnicmp(read_tag(start+1, L"face", 4, false, true).first, L"Symbol", 6) == 0 ||
-                        string_util::strnicmp(read_tag(start+1, L"font-family", 11, true, true).first, L"Symbol", 6) == 0)
-                        { isSymbolFontSection = true; }
+                    if (string_util::strnicmp(read_tag(start+1, MARKUP_LITERAL(T, "face"), 4, false, true, endSentinel).first, MARKUP_LITERAL(T, "Symbol"), 6) == 0 ||
+                        string_util::strnicmp(read_tag(start+1, MARKUP_LITERAL(T, "font-family"), 11, true, true, endSentinel).first, MARKUP_LITERAL(T, "Symbol"), 6) == 0)
+                        { m_is_symbol_font_section = true; }
                     }
                 //...then any other element
                 else
                     {
-                    if (string_util::strnicmp(read_tag(start+1, L"font-family", 11, true, true).first, L"Symbol", 6) == 0)
-                        { isSymbolFontSection = true; }
+                    if (string_util::strnicmp(read_tag(start+1, MARKUP_LITERAL(T, "font-family"), 11, true, true, endSentinel).first, MARKUP_LITERAL(T, "Symbol"), 6) == 0)
+                        { m_is_symbol_font_section = true; }
                     }
+                if (m_event_handler != NULL)
+                    { report_element(currentElementId, currentElement); }
+                switch (currentElementId)
+                    {
                 //See if this is a preformatted section, where CRLFs should be preserved
-                if ((currentElement.length() == 3 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_P,common_lang_constants::UPPER_P) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_R,common_lang_constants::UPPER_R) && is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E)))
-                    { ++m_is_in_preformatted_text_block_stack; }
+                case html_pre:
+                    ++m_is_in_preformatted_text_block_stack;
+                    break;
                 //see if this should be treated as a new paragraph because it is a break, paragraph, list item, or table row
-                else if ((currentElement.length() == 1 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_P,common_lang_constants::UPPER_P)) ||
-                    (currentElement.length() == 5 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_A,common_lang_constants::UPPER_A) && is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_B,common_lang_constants::UPPER_B) && is_either<wchar_t>(currentElement[3],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) && is_either<wchar_t>(currentElement[4],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E)) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_R,common_lang_constants::UPPER_R)) ||
-                    (currentElement.length() == 3 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_D,common_lang_constants::UPPER_D) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_I,common_lang_constants::UPPER_I) && is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_V,common_lang_constants::UPPER_V)) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_O,common_lang_constants::UPPER_O) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L)) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_U,common_lang_constants::UPPER_U) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L)) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && currentElement[1] == common_lang_constants::NUMBER_1) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && currentElement[1] == common_lang_constants::NUMBER_2) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && currentElement[1] == common_lang_constants::NUMBER_3) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && currentElement[1] == common_lang_constants::NUMBER_4) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && currentElement[1] == common_lang_constants::NUMBER_5) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && currentElement[1] == common_lang_constants::NUMBER_6) ||
-                    (currentElement.length() == 6 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_S,common_lang_constants::UPPER_S) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E) && is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) && is_either<wchar_t>(currentElement[3],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E) && is_either<wchar_t>(currentElement[4],common_lang_constants::LOWER_C,common_lang_constants::UPPER_C) && is_either<wchar_t>(currentElement[5],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T)) ||
-                    (currentElement.length() == 6 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_O,common_lang_constants::UPPER_O) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_P,common_lang_constants::UPPER_P) && is_either<wchar_t>(currentElement[2],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) && is_either<wchar_t>(currentElement[3],common_lang_constants::LOWER_I,common_lang_constants::UPPER_I) && is_either<wchar_t>(currentElement[4],common_lang_constants::LOWER_O,common_lang_constants::UPPER_O) && is_either<wchar_t>(currentElement[5],common_lang_constants::LOWER_N,common_lang_constants::UPPER_N)) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_D,common_lang_constants::UPPER_D) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T)) ||
-                    (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_R,common_lang_constants::UPPER_R)) )                    
-                    {
+                case html_p:
+                case html_table:
+                case html_hr:
+                case html_div:
+                case html_ol:
+                case html_ul:
+                case html_h1:
+                case html_h2:
+                case html_h3:
+                case html_h4:
+                case html_h5:
+                case html_h6:
+                case html_select:
+                case html_option:
+                case html_dt:
+                case html_tr:
                     add_character(L'\n');
                     add_character(L'\n');
-                    }
-                else if (compare_element(start+1, L"br", 2, true) )
-                    { add_character(L'\n'); }
-                //or end of a section that is like a paragraph
-                else if (remainingTextLength >= 3 && start[0] == common_lang_constants::LESS_THAN && start[1] == common_lang_constants::FORWARD_SLASH)
-                    {
-                    if ((remainingTextLength >= 8 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) && is_either<wchar_t>(start[3],common_lang_constants::LOWER_A,common_lang_constants::UPPER_A) && is_either<wchar_t>(start[4],common_lang_constants::LOWER_B,common_lang_constants::UPPER_B) && is_either<wchar_t>(start[5],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) && is_either<wchar_t>(start[6],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E) && start[7] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 4 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_P,common_lang_constants::UPPER_P) && start[3] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && start[3] == common_lang_constants::NUMBER_1 && start[4] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && start[3] == common_lang_constants::NUMBER_2 && start[4] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && start[3] == common_lang_constants::NUMBER_3 && start[4] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && start[3] == common_lang_constants::NUMBER_4 && start[4] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && start[3] == common_lang_constants::NUMBER_5 && start[4] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_H,common_lang_constants::UPPER_H) && start[3] == common_lang_constants::NUMBER_6 && start[4] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 6 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_D,common_lang_constants::UPPER_D) && is_either<wchar_t>(start[3],common_lang_constants::LOWER_I,common_lang_constants::UPPER_I) && is_either<wchar_t>(start[4],common_lang_constants::LOWER_V,common_lang_constants::UPPER_V) && start[5] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_D,common_lang_constants::UPPER_D) && is_either<wchar_t>(start[3],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) && start[4] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 9 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_S,common_lang_constants::UPPER_S) && is_either<wchar_t>(start[3],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E) && is_either<wchar_t>(start[4],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) && is_either<wchar_t>(start[5],common_lang_constants::LOWER_E,common_lang_constants::UPPER_E) && is_either<wchar_t>(start[6],common_lang_constants::LOWER_C,common_lang_constants::UPPER_C) && is_either<wchar_t>(start[7],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) && start[8] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_O,common_lang_constants::UPPER_O) && is_either<wchar_t>(start[3],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) && start[4] == common_lang_constants::GREATER_THAN) ||
-                        (remainingTextLength >= 5 && is_either<wchar_t>(start[2],common_lang_constants::LOWER_U,common_lang_constants::UPPER_U) && is_either<wchar_t>(start[3],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) && start[4] == common_lang_constants::GREATER_THAN))                    
+                    break;
+                case html_br:
+                    add_character(L'\n');
+                    break;
+                //or end of a section that is like a paragraph (only if immediately closed, e.g., "</p>")
+                case html_p_end:
+                case html_table_end:
+                case html_h1_end:
+                case html_h2_end:
+                case html_h3_end:
+                case html_h4_end:
+                case html_h5_end:
+                case html_h6_end:
+                case html_div_end:
+                case html_dl_end:
+                case html_select_end:
+                case html_ol_end:
+                case html_ul_end:
+                    if (currentElement.get_close_tag() == currentElement.get_name()+currentElement.get_name_length())
                         {
                         add_character(L'\n');
                         add_character(L'\n');
                         }
-                    }
-                else if ((currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_L,common_lang_constants::UPPER_L) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_I,common_lang_constants::UPPER_I)) ||
-                        (currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_D,common_lang_constants::UPPER_D) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_D,common_lang_constants::UPPER_D)) )
-                    {
+                    break;
+                case html_li:
+                case html_dd:
                     add_character(L'\n');
                     add_character(L'\t');
-                    }
+                    break;
                 //or tab over table cell
-                else if ((currentElement.length() == 2 && is_either<wchar_t>(currentElement[0],common_lang_constants::LOWER_T,common_lang_constants::UPPER_T) && is_either<wchar_t>(currentElement[1],common_lang_constants::LOWER_D,common_lang_constants::UPPER_D)) )                    
-                    { add_character(L'\t'); }
-                end = find_close_tag(start+1, true);
+                case html_td:
+                    add_character(L'\t');
+                    break;
+                default:
+                    break;
+                    }
+                end = currentElement.get_close_tag();
                 if (!end)
                     {
                     //no close tag? read to the next open tag then and read this section in below
-                    if ((end = string_util::strchr(start+1, common_lang_constants::LESS_THAN)) == NULL)
-                        { break; }
+                    if ((end = string_util::strnchr<T>(start+1, common_lang_constants::LESS_THAN, remainingTextLength-1)) == NULL)
+                        { return NULL; }
                     }
                 /*if the < tag that we started from is not terminated then feed that in as
                 text instead of treating it like a valid HTML tag.  Not common, but it happens.*/
@@ -732,49 +1240,103 @@ namespace lily_of_the_valley
                     }
                 //more normal behavior, where tag is properly terminated
                 else
-                    { ++end; }
-                }
-            //find the next starting tag
-            start = string_util::strchr(end, common_lang_constants::LESS_THAN);
-            if (!start || start >= endSentinel)
-                { break; }
-            const size_t previousLength = get_filtered_text_length();
-            //copy over the text between the tags
-            parse_raw_text(end, start-end);
-            /*Old HTML used to use "Symbol" font to show various math/Greek symbols (instead of proper entities).
-            So if the current block of text is using the font "Symbol", then we will convert
-            it to the expected symbol.*/
-            if (isSymbolFontSection)
-                {
-                const std::wstring copiedOverText = convert_symbol_font_section(std::wstring(get_filtered_text()+previousLength, (get_filtered_text_length()-previousLength)) );
-                set_filtered_text_length(previousLength);
-                add_characters(copiedOverText.c_str(), copiedOverText.length());
-                if (copiedOverText.length())
-                    { log_message(L"Symbol font used for the following: \""+copiedOverText+L"\""); }
-                }
-            //after parsing this section, see if this is the end of a preformatted area
-            if (string_util::strnicmp<wchar_t>(start, L"</pre>", 6) == 0)                    
-                {
-                if (m_is_in_preformatted_text_block_stack > 0)
-                    { --m_is_in_preformatted_text_block_stack; }
+                    {
+                    on_element(currentElementId, currentElement);
+                    ++end;
+                    }
                 }
+            //read the text after the element next
+            start = end;
+            m_parse_state = text_parse_state;
             }
-
-        //get any text lingering after the last >
-        if (end && end < endSentinel && include_outer_text)
+        return start;
+        }
+    template<typename T>
+    void html_extract_text::report_element(const markup_element element_id, const basic_html_element_view<T>& element)
+        {
+        switch (element_id)
             {
-            parse_raw_text(end, endSentinel-end);
-            }
-
-        return get_filtered_text();
+        case html_p:
+        case html_table:
+        case html_div:
+        case html_ol:
+        case html_ul:
+        case html_dl:
+        case html_select:
+        case html_pre:
+            m_event_handler->on_block_start(element_id);
+            break;
+        case html_p_end:
+        case html_table_end:
+        case html_div_end:
+        case html_dl_end:
+        case html_select_end:
+        case html_ol_end:
+        case html_ul_end:
+            m_event_handler->on_block_end(element_id);
+            break;
+        case html_h1:
+        case html_h2:
+        case html_h3:
+        case html_h4:
+        case html_h5:
+        case html_h6:
+            m_event_handler->on_heading_start(element_id-html_h1+1);
+            break;
+        case html_h1_end:
+        case html_h2_end:
+        case html_h3_end:
+        case html_h4_end:
+        case html_h5_end:
+        case html_h6_end:
+            m_event_handler->on_heading_end(element_id-html_h1_end+1);
+            break;
+        case html_li:
+        case html_dd:
+        case html_dt:
+        case html_option:
+            m_event_handler->on_list_item();
+            break;
+        case html_hr:
+            m_event_handler->on_horizontal_rule();
+            break;
+        case html_tr:
+            m_event_handler->on_table_row();
+            break;
+        case html_td:
+            m_event_handler->on_table_cell();
+            break;
+        case html_br:
+            m_event_handler->on_line_break();
+            break;
+        case html_a:
+            if (element.get_close_tag() != NULL)
+                {
+                const std::pair<const T*, size_t> href =
+                    read_tag(element.get_name(), MARKUP_LITERAL(T, "href"), 4, false, true, element.get_close_tag()+1);
+                if (href.first != NULL && href.second > 0)
+                    {
+                    const std::wstring url = to_wide_string(href.first, href.second);
+                    m_event_handler->on_link(url.c_str(), url.length());
+                    }
+                }
+            break;
+        default:
+            break;
+            };
         }
-    bool html_extract_text::compare_element(const wchar_t* text, const wchar_t* element,
+    template<typename T>
+    bool html_extract_text::compare_element(const T* text, const T* element,
                                             const size_t element_size,
-                                            const bool accept_self_terminating_elements /*= false*/)
+                                            const bool accept_self_terminating_elements /*= false*/,
+                                            const T* endSentinel /*= NULL*/)
         {
         if (!text || !element || element_size == 0)
             { return false; }
-        assert((std::wcslen(element) == element_size) && "Invalid length passed to compare_element().");
+        //the element's name and the character after it must be in the stream
+        if (endSentinel && (text >= endSentinel || static_cast<size_t>(endSentinel-text) <= element_size))
+            { return false; }
+        assert((string_util::strlen(element) == element_size) && "Invalid length passed to compare_element().");
         //first see if the element matches the text (e.g., "br" or "br/" [if accepting self terminating element])
         if (string_util::strnicmp(text, element, element_size) == 0)
             {
@@ -795,18 +1357,18 @@ namespace lily_of_the_valley
             else if (accept_self_terminating_elements)
                 {
                 return (*text == common_lang_constants::FORWARD_SLASH ||
-                        std::iswspace(*text));
+                        is_markup_space(*text));
                 }
             //if we aren't allowing "/>" and we are on a space, then just make sure
             //it isn't self terminated.
-            else if (std::iswspace(*text))
+            else if (is_markup_space(*text))
                 {
-                const wchar_t* closeTag = find_close_tag(text);
+                const T* closeTag = find_close_tag(text, false, endSentinel);
                 if (!closeTag)
                     { return false; }
                 --closeTag;
                 while (closeTag > text &&
-                    std::iswspace(*closeTag))
+                    is_markup_space(*closeTag))
                     { --closeTag; }
                 return (*closeTag != common_lang_constants::FORWARD_SLASH);
                 }
@@ -816,13 +1378,18 @@ namespace lily_of_the_valley
         else
             { return false; }
         }
-    bool html_extract_text::compare_element_case_sensitive(const wchar_t* text, const wchar_t* element,
+    template<typename T>
+    bool html_extract_text::compare_element_case_sensitive(const T* text, const T* element,
                                                            const size_t element_size,
-                                                           const bool accept_self_terminating_elements /*= false*/)
+                                                           const bool accept_self_terminating_elements /*= false*/,
+                                                           const T* endSentinel /*= NULL*/)
         {
         if (!text || !element || element_size == 0)
             { return false; }
-        assert((std::wcslen(element) == element_size) && "Invalid length passed to compare_element().");
+        //the element's name and the character after it must be in the stream
+        if (endSentinel && (text >= endSentinel || static_cast<size_t>(endSentinel-text) <= element_size))
+            { return false; }
+        assert((string_util::strlen(element) == element_size) && "Invalid length passed to compare_element().");
         //first see if the element matches the text (e.g., "br" or "br/" [if accepting self terminating element])
         if (string_util::strncmp(text, element, element_size) == 0)
             {
@@ -843,18 +1410,18 @@ namespace lily_of_the_valley
             else if (accept_self_terminating_elements)
                 {
                 return (*text == common_lang_constants::FORWARD_SLASH ||
-                        std::iswspace(*text));
+                        is_markup_space(*text));
                 }
             //if we aren't allowing "/>" and we are on a space, then just make sure
             //it isn't self terminated.
-            else if (std::iswspace(*text))
+            else if (is_markup_space(*text))
                 {
-                const wchar_t* closeTag = find_close_tag(text);
+                const T* closeTag = find_close_tag(text, false, endSentinel);
                 if (!closeTag)
                     { return false; }
                 --closeTag;
                 while (closeTag > text &&
-                    std::iswspace(*closeTag))
+                    is_markup_space(*closeTag))
                     { --closeTag; }
                 return (*closeTag != common_lang_constants::FORWARD_SLASH);
                 }
@@ -865,74 +1432,315 @@ namespace lily_of_the_valley
             { return false; }
         }
     std::wstring html_extract_text::get_element_name(const wchar_t* text,
-                                                 const bool accept_self_terminating_elements /*= true*/)
+                                                 const bool accept_self_terminating_elements /*= true*/,
+                                                 const wchar_t* endSentinel /*= NULL*/)
         {
         if (text == NULL)
             { return std::wstring(L""); }
-        const wchar_t* start = text;
+        const html_element_view element = read_element<wchar_t>(text, endSentinel, accept_self_terminating_elements);
+        return std::wstring(element.get_name(), element.get_name_length());
+        }
+    template<typename T>
+    basic_html_element_view<T> html_extract_text::read_element(const T* text,
+                                                      const T* endSentinel,
+                                                      const bool accept_self_terminating_elements /*= true*/)
+        {
+        if (text == NULL || (endSentinel && text >= endSentinel))
+            { return basic_html_element_view<T>(); }
+        const T* nameEnd = text;
         for (;;)
             {
-            if (text[0] == 0 ||
-                std::iswspace(text[0]) ||
-                text[0] == common_lang_constants::GREATER_THAN)
+            //letters (the bulk of a name) are past all of the characters that can end one
+            if ((!endSentinel || nameEnd < endSentinel) &&
+                nameEnd[0] > common_lang_constants::GREATER_THAN && nameEnd[0] < 0x7F)
+                {
+                ++nameEnd;
+                continue;
+                }
+            if ((endSentinel && nameEnd >= endSentinel) ||
+                nameEnd[0] == 0 ||
+                is_markup_space(nameEnd[0]) ||
+                nameEnd[0] == common_lang_constants::GREATER_THAN)
                 { break; }
             else if (accept_self_terminating_elements &&
-                text[0] == common_lang_constants::FORWARD_SLASH &&
-                text[1] == common_lang_constants::GREATER_THAN)
+                nameEnd[0] == common_lang_constants::FORWARD_SLASH &&
+                (!endSentinel || nameEnd+1 < endSentinel) &&
+                nameEnd[1] == common_lang_constants::GREATER_THAN)
                 { break; }
-            ++text;
+            ++nameEnd;
+            }
+        /*find the terminating >, but fail if a < is found first (which means that this element
+        is not properly terminated). Note that the name itself is scanned for a < also (other than
+        a leading one, which is skipped the same way that find_close_tag() does).*/
+        const T* tagEnd = (text[0] == common_lang_constants::LESS_THAN) ? text+1 : text;
+        if (endSentinel)
+            {
+            //the matcher also stops on a NULL terminator, the same as the unbounded loop below
+            static const string_util::char_set_matcher<T> TAG_BOUNDARY_SET(MARKUP_LITERAL(T, "<>"), 2);
+            tagEnd += TAG_BOUNDARY_SET.find(tagEnd, endSentinel-tagEnd);
+            }
+        else
+            {
+            while (tagEnd[0] != 0 &&
+                tagEnd[0] != common_lang_constants::LESS_THAN &&
+                tagEnd[0] != common_lang_constants::GREATER_THAN)
+                { ++tagEnd; }
             }
-        return std::wstring(start, text-start);
+        const T* const closeTag = ((!endSentinel || tagEnd < endSentinel) &&
+            tagEnd[0] == common_lang_constants::GREATER_THAN) ? tagEnd : NULL;
+        //if not terminated, then the attributes are whatever is up to the next < (or the end of the stream)
+        return basic_html_element_view<T>(text, nameEnd-text,
+                                 nameEnd, (tagEnd > nameEnd) ? tagEnd-nameEnd : 0,
+                                 closeTag);
         }
-    const wchar_t* html_extract_text::find_close_tag(const wchar_t* text, const bool fail_on_overlapping_open_symbol /*= false*/)
+    template<typename T>
+    markup_element html_extract_text::classify_element(const T* name, const size_t length)
         {
-        if (text == NULL)
+        if (name == NULL || length == 0)
+            { return unknown_element; }
+        //"<br/>" is commonly written without a space in front of the '/'
+        if (length > 2 && name[2] == common_lang_constants::FORWARD_SLASH &&
+            string_util::strnicmp(name, MARKUP_LITERAL(T, "br"), 2) == 0)
+            { return html_br; }
+        /*Narrow down the candidates by the name's length and first character, which leaves
+        (at most) a couple of full comparisons to do. HTML is compared case insensitively,
+        XML (e.g., WordprocessingML and DrawingML, which start with 'w' and 'a') case sensitively.*/
+        switch (length)
+            {
+        case 1:
+            return is_either<T>(name[0], common_lang_constants::LOWER_P, common_lang_constants::UPPER_P) ? html_p :
+                is_either<T>(name[0], common_lang_constants::LOWER_A, common_lang_constants::UPPER_A) ? html_a :
+                unknown_element;
+        case 2:
+            switch (name[0])
+                {
+            case common_lang_constants::LOWER_H:
+            case common_lang_constants::UPPER_H:
+                if (is_within<T>(name[1], common_lang_constants::NUMBER_1, common_lang_constants::NUMBER_6))
+                    { return static_cast<markup_element>(html_h1+(name[1]-common_lang_constants::NUMBER_1)); }
+                return is_either<T>(name[1], common_lang_constants::LOWER_R, common_lang_constants::UPPER_R) ?
+                    html_hr : unknown_element;
+            case common_lang_constants::LOWER_O:
+            case common_lang_constants::UPPER_O:
+                return is_either<T>(name[1], common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) ?
+                    html_ol : unknown_element;
+            case common_lang_constants::LOWER_U:
+            case common_lang_constants::UPPER_U:
+                return is_either<T>(name[1], common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) ?
+                    html_ul : unknown_element;
+            case common_lang_constants::LOWER_D:
+            case common_lang_constants::UPPER_D:
+                return is_either<T>(name[1], common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) ? html_dt :
+                    is_either<T>(name[1], common_lang_constants::LOWER_D, common_lang_constants::UPPER_D) ? html_dd :
+                    is_either<T>(name[1], common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) ? html_dl :
+                    unknown_element;
+            case common_lang_constants::LOWER_T:
+            case common_lang_constants::UPPER_T:
+                return is_either<T>(name[1], common_lang_constants::LOWER_R, common_lang_constants::UPPER_R) ? html_tr :
+                    is_either<T>(name[1], common_lang_constants::LOWER_D, common_lang_constants::UPPER_D) ? html_td :
+                    unknown_element;
+            case common_lang_constants::LOWER_L:
+            case common_lang_constants::UPPER_L:
+                return is_either<T>(name[1], common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ?
+                    html_li : unknown_element;
+            case common_lang_constants::LOWER_B:
+            case common_lang_constants::UPPER_B:
+                return is_either<T>(name[1], common_lang_constants::LOWER_R, common_lang_constants::UPPER_R) ?
+                    html_br : unknown_element;
+            case common_lang_constants::FORWARD_SLASH:
+                return is_either<T>(name[1], common_lang_constants::LOWER_P, common_lang_constants::UPPER_P) ?
+                    html_p_end : unknown_element;
+            default:
+                return unknown_element;
+                }
+        case 3:
+            switch (name[0])
+                {
+            case common_lang_constants::LOWER_P:
+            case common_lang_constants::UPPER_P:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "pre"), 3) == 0) ? html_pre : unknown_element;
+            case common_lang_constants::LOWER_D:
+            case common_lang_constants::UPPER_D:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "div"), 3) == 0) ? html_div : unknown_element;
+            case common_lang_constants::LOWER_I:
+            case common_lang_constants::UPPER_I:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "img"), 3) == 0) ? html_img : unknown_element;
+            case common_lang_constants::LOWER_A:
+                return (string_util::strncmp(name, MARKUP_LITERAL(T, "a:p"), 3) == 0) ? pptx_p :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "a:r"), 3) == 0) ? pptx_r :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "a:t"), 3) == 0) ? pptx_t :
+                    unknown_element;
+            case common_lang_constants::LOWER_W:
+                return (string_util::strncmp(name, MARKUP_LITERAL(T, "w:p"), 3) == 0) ? docx_p :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "w:t"), 3) == 0) ? docx_t :
+                    unknown_element;
+            case common_lang_constants::EXCLAMATION_MARK:
+                return (string_util::strncmp(name, MARKUP_LITERAL(T, "!--"), 3) == 0) ? xml_comment : unknown_element;
+            case common_lang_constants::FORWARD_SLASH:
+                if (is_either<T>(name[1], common_lang_constants::LOWER_H, common_lang_constants::UPPER_H) &&
+                    is_within<T>(name[2], common_lang_constants::NUMBER_1, common_lang_constants::NUMBER_6))
+                    { return static_cast<markup_element>(html_h1_end+(name[2]-common_lang_constants::NUMBER_1)); }
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "/ol"), 3) == 0) ? html_ol_end :
+                    (string_util::strnicmp(name, MARKUP_LITERAL(T, "/ul"), 3) == 0) ? html_ul_end :
+                    (string_util::strnicmp(name, MARKUP_LITERAL(T, "/dl"), 3) == 0) ? html_dl_end :
+                    unknown_element;
+            default:
+                return unknown_element;
+                }
+        case 4:
+            switch (name[0])
+                {
+            case common_lang_constants::LOWER_F:
+            case common_lang_constants::UPPER_F:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "font"), 4) == 0) ? html_font : unknown_element;
+            case common_lang_constants::LOWER_L:
+            case common_lang_constants::UPPER_L:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "link"), 4) == 0) ? html_link : unknown_element;
+            case common_lang_constants::LOWER_A:
+            case common_lang_constants::UPPER_A:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "area"), 4) == 0) ? html_area :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "a:br"), 4) == 0) ? pptx_br :
+                    unknown_element;
+            case common_lang_constants::LOWER_B:
+            case common_lang_constants::UPPER_B:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "base"), 4) == 0) ? html_base : unknown_element;
+            case common_lang_constants::LOWER_M:
+            case common_lang_constants::UPPER_M:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "meta"), 4) == 0) ? html_meta : unknown_element;
+            case common_lang_constants::LOWER_W:
+                if (name[1] != common_lang_constants::COLON)
+                    { return unknown_element; }
+                return (string_util::strncmp(name+2, MARKUP_LITERAL(T, "br"), 2) == 0) ? docx_br :
+                    (string_util::strncmp(name+2, MARKUP_LITERAL(T, "cr"), 2) == 0) ? docx_cr :
+                    (string_util::strncmp(name+2, MARKUP_LITERAL(T, "jc"), 2) == 0) ? docx_jc :
+                    (string_util::strncmp(name+2, MARKUP_LITERAL(T, "tr"), 2) == 0) ? docx_tr :
+                    (string_util::strncmp(name+2, MARKUP_LITERAL(T, "tc"), 2) == 0) ? docx_tc :
+                    unknown_element;
+            case common_lang_constants::FORWARD_SLASH:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "/div"), 4) == 0) ? html_div_end :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "/a:p"), 4) == 0) ? pptx_p_end :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "/a:r"), 4) == 0) ? pptx_r_end :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "/a:t"), 4) == 0) ? pptx_t_end :
+                    unknown_element;
+            default:
+                return unknown_element;
+                }
+        case 5:
+            switch (name[0])
+                {
+            case common_lang_constants::LOWER_S:
+            case common_lang_constants::UPPER_S:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "style"), 5) == 0) ? html_style : unknown_element;
+            case common_lang_constants::LOWER_T:
+            case common_lang_constants::UPPER_T:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "title"), 5) == 0) ? html_title :
+                    (string_util::strnicmp(name, MARKUP_LITERAL(T, "table"), 5) == 0) ? html_table :
+                    unknown_element;
+            case common_lang_constants::LOWER_F:
+            case common_lang_constants::UPPER_F:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "frame"), 5) == 0) ? html_frame : unknown_element;
+            case common_lang_constants::LOWER_W:
+                return (string_util::strncmp(name, MARKUP_LITERAL(T, "w:tab"), 5) == 0) ? docx_tab :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "w:ind"), 5) == 0) ? docx_ind :
+                    unknown_element;
+            case common_lang_constants::LOWER_A:
+                return (string_util::strncmp(name, MARKUP_LITERAL(T, "a:pPr"), 5) == 0) ? pptx_p_pr : unknown_element;
+            case common_lang_constants::FORWARD_SLASH:
+                return (string_util::strncmp(name, MARKUP_LITERAL(T, "/w:tc"), 5) == 0) ? docx_tc_end : unknown_element;
+            default:
+                return unknown_element;
+                }
+        case 6:
+            switch (name[0])
+                {
+            case common_lang_constants::LOWER_S:
+            case common_lang_constants::UPPER_S:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "script"), 6) == 0) ? html_script :
+                    (string_util::strnicmp(name, MARKUP_LITERAL(T, "select"), 6) == 0) ? html_select :
+                    unknown_element;
+            case common_lang_constants::LOWER_O:
+            case common_lang_constants::UPPER_O:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "option"), 6) == 0) ? html_option : unknown_element;
+            case common_lang_constants::LOWER_I:
+            case common_lang_constants::UPPER_I:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "iframe"), 6) == 0) ? html_iframe : unknown_element;
+            case common_lang_constants::FORWARD_SLASH:
+                return (string_util::strnicmp(name, MARKUP_LITERAL(T, "/table"), 6) == 0) ? html_table_end :
+                    (string_util::strncmp(name, MARKUP_LITERAL(T, "/a:pPr"), 6) == 0) ? pptx_p_pr_end :
+                    unknown_element;
+            default:
+                return unknown_element;
+                }
+        case 7:
+            return (string_util::strnicmp(name, MARKUP_LITERAL(T, "/select"), 7) == 0) ? html_select_end : unknown_element;
+        case 8:
+            return (string_util::strnicmp(name, MARKUP_LITERAL(T, "noscript"), 8) == 0) ? html_noscript :
+                (string_util::strncmp(name, MARKUP_LITERAL(T, "w:pStyle"), 8) == 0) ? docx_p_style :
+                (string_util::strncmp(name, MARKUP_LITERAL(T, "a:buNone"), 8) == 0) ? pptx_bu_none :
+                unknown_element;
+        case 11:
+            return (string_util::strncmp(name, MARKUP_LITERAL(T, "w:instrText"), 11) == 0) ? docx_instr_text : unknown_element;
+        case 12:
+            return (string_util::strncmp(name, MARKUP_LITERAL(T, "wp:posOffset"), 12) == 0) ? docx_pos_offset : unknown_element;
+        default:
+            return unknown_element;
+            }
+        }
+    template<typename T>
+    const T* html_extract_text::find_close_tag(const T* text, const bool fail_on_overlapping_open_symbol /*= false*/,
+                                               const T* endSentinel /*= NULL*/)
+        {
+        if (text == NULL || (endSentinel && text >= endSentinel))
             { return NULL; }
         //if we are at the beginning of an open statement, skip the opening < so that we can correctly
         //look for the next opening <
         else if (text[0] == common_lang_constants::LESS_THAN)
             { ++text; }
-        return string_util::find_matching_close_tag(text, common_lang_constants::LESS_THAN, common_lang_constants::GREATER_THAN, fail_on_overlapping_open_symbol);
+        return string_util::find_matching_close_tag<T>(text, endSentinel, common_lang_constants::LESS_THAN, common_lang_constants::GREATER_THAN, fail_on_overlapping_open_symbol);
         }
-    const wchar_t* html_extract_text::find_element(const wchar_t* sectionStart,
-                                           const wchar_t* sectionEnd,
-                                           const wchar_t* elementTag,
+    template<typename T>
+    const T* html_extract_text::find_element(const T* sectionStart,
+                                           const T* sectionEnd,
+                                           const T* elementTag,
                                            const size_t elementTagLength,
                                            const bool accept_self_terminating_elements /*= true*/)
         {
         if (sectionStart == NULL || sectionEnd == NULL || elementTag == NULL || elementTagLength == 0)
             { return NULL; }
-        assert((std::wcslen(elementTag) == elementTagLength) && "Invalid length passed to find_element().");
+        assert((string_util::strlen(elementTag) == elementTagLength) && "Invalid length passed to find_element().");
         while (sectionStart && sectionStart+elementTagLength < sectionEnd)
             {
-            sectionStart = string_util::strchr(sectionStart, common_lang_constants::LESS_THAN);
+            sectionStart = string_util::strnchr<T>(sectionStart, common_lang_constants::LESS_THAN, sectionEnd-sectionStart);
             if (sectionStart == NULL || sectionStart+elementTagLength > sectionEnd)
                 { return NULL; }
-            else if (compare_element(sectionStart+1, elementTag, elementTagLength, accept_self_terminating_elements))
+            else if (compare_element(sectionStart+1, elementTag, elementTagLength, accept_self_terminating_elements, sectionEnd))
                 { return sectionStart; }
             else
                 { sectionStart += 1/*skip the '<' and search for the next one*/; }
             }
         return NULL;
         }
-    const wchar_t* html_extract_text::find_closing_element(const wchar_t* sectionStart,
-                                           const wchar_t* sectionEnd,
-                                           const wchar_t* elementTag,
+    template<typename T>
+    const T* html_extract_text::find_closing_element(const T* sectionStart,
+                                           const T* sectionEnd,
+                                           const T* elementTag,
                                            const size_t elementTagLength)
         {
         if (sectionStart == NULL || sectionEnd == NULL || elementTag == NULL || elementTagLength == 0)
             { return NULL; }
-        assert((std::wcslen(elementTag) == elementTagLength) && "Invalid length passed to find_closing_element().");
-        const wchar_t* start = string_util::strchr(sectionStart, common_lang_constants::LESS_THAN);
+        assert((string_util::strlen(elementTag) == elementTagLength) && "Invalid length passed to find_closing_element().");
+        if (sectionStart >= sectionEnd)
+            { return NULL; }
+        const T* start = string_util::strnchr<T>(sectionStart, common_lang_constants::LESS_THAN, sectionEnd-sectionStart);
         if (start == NULL || start+elementTagLength > sectionEnd)
             { return NULL; }
         ++start;//skip '<'
         //if we are on an opening element by the same name, then skip it so that we won't
         //count it again in the stack logic below
-        if (compare_element(start, elementTag, elementTagLength, true))
+        if (compare_element(start, elementTag, elementTagLength, true, sectionEnd))
             { sectionStart = start+elementTagLength; }
         //else if we are on the closing element already then just return that.
-        else if (start[0] == '/' && compare_element(start+1, elementTag, elementTagLength, true))
+        else if (start < sectionEnd && start[0] == '/' && compare_element(start+1, elementTag, elementTagLength, true, sectionEnd))
             { return --start; }
 
         //Do a search for the matching close tag. That means
@@ -940,25 +1748,44 @@ namespace lily_of_the_valley
         //go the correct closing one.
         long stackSize = 1;
 
-        start = string_util::strchr(sectionStart, common_lang_constants::LESS_THAN);
+        start = (sectionStart < sectionEnd) ?
+            string_util::strnchr<T>(sectionStart, common_lang_constants::LESS_THAN, sectionEnd-sectionStart) : NULL;
         while (start && start+elementTagLength+1 < sectionEnd)
             {
             //if a closing element if found, then decrease the stack
-            if (start[1] == L'/' && compare_element(start+2, elementTag, elementTagLength, true))
+            if (start[1] == L'/' && compare_element(start+2, elementTag, elementTagLength, true, sectionEnd))
                 { --stackSize; }
             //if a new opening element by the same name, then add that to the stack so that its
             //respective closing element will be skipped.
-            else if (compare_element(start+1, elementTag, elementTagLength, true))
+            else if (compare_element(start+1, elementTag, elementTagLength, true, sectionEnd))
                 { ++stackSize; }
             if (stackSize == 0)
                 { return start; }
-            start = string_util::strchr(start+1, common_lang_constants::LESS_THAN);
+            start = string_util::strnchr<T>(start+1, common_lang_constants::LESS_THAN, sectionEnd-(start+1));
             }
         return NULL;
         }
 
     const html_utilities::symbol_font_table html_extract_text::SYMBOL_FONT_TABLE;
     const html_utilities::html_entity_table html_extract_text::HTML_TABLE_LOOKUP;
+
+    //the markup helpers are available for wide and UTF-8 text
+#define HTML_EXTRACT_TEXT_INSTANTIATE(T) \
+    template std::basic_string<T> html_extract_text::read_tag_as_string<T>(const T*, const T*, const size_t, const bool, const bool, const T*); \
+    template const T* html_extract_text::stristr_not_quoted<T>(const T*, const size_t, const T*, const size_t); \
+    template std::pair<const T*, size_t> html_extract_text::read_tag<T>(const T*, const T*, const size_t, const bool, const bool, const T*); \
+    template const T* html_extract_text::find_tag<T>(const T*, const T*, const size_t, const bool, const T*); \
+    template bool html_extract_text::compare_element<T>(const T*, const T*, const size_t, const bool, const T*); \
+    template bool html_extract_text::compare_element_case_sensitive<T>(const T*, const T*, const size_t, const bool, const T*); \
+    template basic_html_element_view<T> html_extract_text::read_element<T>(const T*, const T*, const bool); \
+    template markup_element html_extract_text::classify_element<T>(const T*, const size_t); \
+    template const T* html_extract_text::find_close_tag<T>(const T*, const bool, const T*); \
+    template const T* html_extract_text::find_element<T>(const T*, const T*, const T*, const size_t, const bool); \
+    template const T* html_extract_text::find_closing_element<T>(const T*, const T*, const T*, const size_t); \
+    template void html_extract_text::parse_raw_text<T>(const T*, size_t);
+    HTML_EXTRACT_TEXT_INSTANTIATE(char)
+    HTML_EXTRACT_TEXT_INSTANTIATE(wchar_t)
+#undef HTML_EXTRACT_TEXT_INSTANTIATE
     }
 
 namespace html_utilities
@@ -968,10 +1795,10 @@ namespace html_utilities
         {
         if (html_text == NULL || html_text[0] == 0 || text_length == 0)
             { return NULL; }
-        NON_UNIT_TEST_ASSERT(text_length <= string_util::strlen(html_text) );
 
-        if (!allocate_text_buffer(text_length))
+        if (!begin_text())
             { return NULL; }
+        log_unsupported_budget();
 
         const wchar_t* const endSentinel = html_text+text_length;
         const wchar_t* currentPos = html_text, *lastEnd = html_text;
@@ -985,14 +1812,14 @@ namespace html_utilities
                 break;
                 }
             //if this is actually a bookmark, then we need to start over (looking for the next <a>).
-            if (lily_of_the_valley::html_extract_text::find_tag(currentPos, L"name", 4, false))
+            if (lily_of_the_valley::html_extract_text::find_tag(currentPos, L"name", 4, false, endSentinel))
                 {
                 currentPos += 2;
                 continue;
                 }
             //next <a> found, so copy over all of the text before it, then move over to the end of this element.
             add_characters(lastEnd, currentPos-lastEnd);
-            currentPos = lily_of_the_valley::html_extract_text::find_close_tag(currentPos);
+            currentPos = lily_of_the_valley::html_extract_text::find_close_tag(currentPos, false, endSentinel);
             if (!currentPos || currentPos >= endSentinel)
                 { break; }
             lastEnd = currentPos+1;
@@ -1003,12 +1830,12 @@ namespace html_utilities
                 { break; }
             add_characters(lastEnd, currentPos-lastEnd);
             //finally, find the close of this </a>, move to that, and start over again looking for the next <a>
-            currentPos = lily_of_the_valley::html_extract_text::find_close_tag(currentPos);
+            currentPos = lily_of_the_valley::html_extract_text::find_close_tag(currentPos, false, endSentinel);
             if (!currentPos || currentPos >= endSentinel)
                 { break; }
             lastEnd = currentPos+1;
             }
-        return get_filtered_text();
+        return finalize_text();
         }
 
     symbol_font_table::symbol_font_table()
@@ -1158,284 +1985,2208 @@ namespace html_utilities
         return pos->second;
         }
 
-    html_entity_table::html_entity_table()
+    /*The HTML5 named entities (without their trailing semicolons), sorted by name (ordinally)
+    so that they can be binary searched. Being a POD array, this is built by the compiler
+    and requires no construction at start-up.*/
+    static const html_entity HTML_ENTITIES[] =
         {
-        m_table.insert(std::make_pair(std::wstring(L"apos"), common_lang_constants::APOSTROPHE) );//not standard, but common
-        m_table.insert(std::make_pair(std::wstring(L"gt"), common_lang_constants::GREATER_THAN) );
-        m_table.insert(std::make_pair(std::wstring(L"lt"), common_lang_constants::LESS_THAN) );
-        m_table.insert(std::make_pair(std::wstring(L"amp"), common_lang_constants::AMPERSAND) );
-        m_table.insert(std::make_pair(std::wstring(L"quot"), common_lang_constants::DOUBLE_QUOTE) );
-        m_table.insert(std::make_pair(std::wstring(L"nbsp"), common_lang_constants::SPACE) );
-        m_table.insert(std::make_pair(std::wstring(L"iexcl"), 161) );
-        m_table.insert(std::make_pair(std::wstring(L"cent"), 162) );
-        m_table.insert(std::make_pair(std::wstring(L"pound"), 163) );
-        m_table.insert(std::make_pair(std::wstring(L"curren"), 164) );
-        m_table.insert(std::make_pair(std::wstring(L"yen"), 165) );
-        m_table.insert(std::make_pair(std::wstring(L"brvbar"), 166) );
-        m_table.insert(std::make_pair(std::wstring(L"sect"), 167) );
-        m_table.insert(std::make_pair(std::wstring(L"uml"), 168) );
-        m_table.insert(std::make_pair(std::wstring(L"copy"), 169) );
-        m_table.insert(std::make_pair(std::wstring(L"ordf"), 170) );
-        m_table.insert(std::make_pair(std::wstring(L"laquo"), 171) );
-        m_table.insert(std::make_pair(std::wstring(L"not"), 172) );
-        m_table.insert(std::make_pair(std::wstring(L"shy"), 173) );
-        m_table.insert(std::make_pair(std::wstring(L"reg"), 174) );
-        m_table.insert(std::make_pair(std::wstring(L"macr"), 175) );
-        m_table.insert(std::make_pair(std::wstring(L"deg"), 176) );
-        m_table.insert(std::make_pair(std::wstring(L"plusmn"), 177) );
-        m_table.insert(std::make_pair(std::wstring(L"sup2"), 178) );
-        m_table.insert(std::make_pair(std::wstring(L"sup3"), 179) );
-        m_table.insert(std::make_pair(std::wstring(L"acute"), 180) );
-        m_table.insert(std::make_pair(std::wstring(L"micro"), 181) );
-        m_table.insert(std::make_pair(std::wstring(L"para"), 182) );
-        m_table.insert(std::make_pair(std::wstring(L"middot"), 183) );
-        m_table.insert(std::make_pair(std::wstring(L"mcedilicro"), 184) );
-        m_table.insert(std::make_pair(std::wstring(L"sup1"), 185) );
-        m_table.insert(std::make_pair(std::wstring(L"ordm"), 186) );
-        m_table.insert(std::make_pair(std::wstring(L"raquo"), 187) );
-        m_table.insert(std::make_pair(std::wstring(L"frac14"), 188) );
-        m_table.insert(std::make_pair(std::wstring(L"texfrac12t"), 189) );
-        m_table.insert(std::make_pair(std::wstring(L"frac34"), 190) );
-        m_table.insert(std::make_pair(std::wstring(L"iquest"), 191) );
-        m_table.insert(std::make_pair(std::wstring(L"Agrave"), 192) );
-        m_table.insert(std::make_pair(std::wstring(L"Aacute"), 193) );
-        m_table.insert(std::make_pair(std::wstring(L"Acirc"), 194) );
-        m_table.insert(std::make_pair(std::wstring(L"Atilde"), 195) );
-        m_table.insert(std::make_pair(std::wstring(L"Auml"), 196) );
-        m_table.insert(std::make_pair(std::wstring(L"Aring"), 197) );
-        m_table.insert(std::make_pair(std::wstring(L"AElig"), 198) );
-        m_table.insert(std::make_pair(std::wstring(L"Ccedil"), 199) );
-        m_table.insert(std::make_pair(std::wstring(L"Egrave"), 200) );
-        m_table.insert(std::make_pair(std::wstring(L"Eacute"), 201) );
-        m_table.insert(std::make_pair(std::wstring(L"Ecirc"), 202) );
-        m_table.insert(std::make_pair(std::wstring(L"Euml"), 203) );
-        m_table.insert(std::make_pair(std::wstring(L"Igrave"), 204) );
-        m_table.insert(std::make_pair(std::wstring(L"Iacute"), 205) );
-        m_table.insert(std::make_pair(std::wstring(L"Icirc"), 206) );
-        m_table.insert(std::make_pair(std::wstring(L"Iuml"), 207) );
-        m_table.insert(std::make_pair(std::wstring(L"ETH"), 208) );
-        m_table.insert(std::make_pair(std::wstring(L"Ntilde"), 209) );
-        m_table.insert(std::make_pair(std::wstring(L"Ograve"), 210) );
-        m_table.insert(std::make_pair(std::wstring(L"Oacute"), 211) );
-        m_table.insert(std::make_pair(std::wstring(L"Ocirc"), 212) );
-        m_table.insert(std::make_pair(std::wstring(L"Otilde"), 213) );
-        m_table.insert(std::make_pair(std::wstring(L"Ouml"), 214) );
-        m_table.insert(std::make_pair(std::wstring(L"Oslash"), 216) );
-        m_table.insert(std::make_pair(std::wstring(L"times"), 215) );
-        m_table.insert(std::make_pair(std::wstring(L"Ugrave"), 217) );
-        m_table.insert(std::make_pair(std::wstring(L"Uacute"), 218) );
-        m_table.insert(std::make_pair(std::wstring(L"Ucirc"), 219) );
-        m_table.insert(std::make_pair(std::wstring(L"Uuml"), 220) );
-        m_table.insert(std::make_pair(std::wstring(L"Yacute"), 221) );
-        m_table.insert(std::make_pair(std::wstring(L"THORN"), 222) );
-        m_table.insert(std::make_pair(std::wstring(L"szlig"), 223) );
-        m_table.insert(std::make_pair(std::wstring(L"agrave"), 224) );
-        m_table.insert(std::make_pair(std::wstring(L"aacute"), 225) );
-        m_table.insert(std::make_pair(std::wstring(L"acirc"), 226) );
-        m_table.insert(std::make_pair(std::wstring(L"atilde"), 227) );
-        m_table.insert(std::make_pair(std::wstring(L"auml"), 228) );
-        m_table.insert(std::make_pair(std::wstring(L"aring"), 229) );
-        m_table.insert(std::make_pair(std::wstring(L"aelig"), 230) );
-        m_table.insert(std::make_pair(std::wstring(L"ccedil"), 231) );
-        m_table.insert(std::make_pair(std::wstring(L"egrave"), 232) );
-        m_table.insert(std::make_pair(std::wstring(L"eacute"), 233) );
-        m_table.insert(std::make_pair(std::wstring(L"ecirc"), 234) );
-        m_table.insert(std::make_pair(std::wstring(L"euml"), 235) );
-        m_table.insert(std::make_pair(std::wstring(L"igrave"), 236) );
-        m_table.insert(std::make_pair(std::wstring(L"iacute"), 237) );
-        m_table.insert(std::make_pair(std::wstring(L"icirc"), 238) );
-        m_table.insert(std::make_pair(std::wstring(L"iuml"), 239) );
-        m_table.insert(std::make_pair(std::wstring(L"eth"), 240) );
-        m_table.insert(std::make_pair(std::wstring(L"ntilde"), 241) );
-        m_table.insert(std::make_pair(std::wstring(L"ograve"), 242) );
-        m_table.insert(std::make_pair(std::wstring(L"oacute"), 243) );
-        m_table.insert(std::make_pair(std::wstring(L"ocirc"), 244) );
-        m_table.insert(std::make_pair(std::wstring(L"otilde"), 245) );
-        m_table.insert(std::make_pair(std::wstring(L"ouml"), 246) );
-        m_table.insert(std::make_pair(std::wstring(L"divide"), 247) );
-        m_table.insert(std::make_pair(std::wstring(L"oslash"), 248) );
-        m_table.insert(std::make_pair(std::wstring(L"ugrave"), 249) );
-        m_table.insert(std::make_pair(std::wstring(L"uacute"), 250) );
-        m_table.insert(std::make_pair(std::wstring(L"ucirc"), 251) );
-        m_table.insert(std::make_pair(std::wstring(L"uuml"), 252) );
-        m_table.insert(std::make_pair(std::wstring(L"yacute"), 253) );
-        m_table.insert(std::make_pair(std::wstring(L"thorn"), 254) );
-        m_table.insert(std::make_pair(std::wstring(L"yuml"), 255) );
-        m_table.insert(std::make_pair(std::wstring(L"fnof"), 402) );
-        m_table.insert(std::make_pair(std::wstring(L"Alpha"), 913) );
-        m_table.insert(std::make_pair(std::wstring(L"Beta"), 914) );
-        m_table.insert(std::make_pair(std::wstring(L"Gamma"), 915) );
-        m_table.insert(std::make_pair(std::wstring(L"Delta"), 916) );
-        m_table.insert(std::make_pair(std::wstring(L"Epsilon"), 917) );
-        m_table.insert(std::make_pair(std::wstring(L"Zeta"), 918) );
-        m_table.insert(std::make_pair(std::wstring(L"Eta"), 919) );
-        m_table.insert(std::make_pair(std::wstring(L"Theta"), 920) );
-        m_table.insert(std::make_pair(std::wstring(L"Iota"), 921) );
-        m_table.insert(std::make_pair(std::wstring(L"Kappa"), 922) );
-        m_table.insert(std::make_pair(std::wstring(L"Lambda"), 923) );
-        m_table.insert(std::make_pair(std::wstring(L"Mu"), 924) );
-        m_table.insert(std::make_pair(std::wstring(L"Nu"), 925) );
-        m_table.insert(std::make_pair(std::wstring(L"Xi"), 926) );
-        m_table.insert(std::make_pair(std::wstring(L"Omicron"), 927) );
-        m_table.insert(std::make_pair(std::wstring(L"Pi"), 928) );
-        m_table.insert(std::make_pair(std::wstring(L"Rho"), 929) );
-        m_table.insert(std::make_pair(std::wstring(L"Sigma"), 931) );
-        m_table.insert(std::make_pair(std::wstring(L"Tau"), 932) );
-        m_table.insert(std::make_pair(std::wstring(L"Upsilon"), 933) );
-        m_table.insert(std::make_pair(std::wstring(L"Phi"), 934) );
-        m_table.insert(std::make_pair(std::wstring(L"Chi"), 935) );
-        m_table.insert(std::make_pair(std::wstring(L"Psi"), 936) );
-        m_table.insert(std::make_pair(std::wstring(L"Omega"), 937) );
-        m_table.insert(std::make_pair(std::wstring(L"alpha"), 945) );
-        m_table.insert(std::make_pair(std::wstring(L"beta"), 946) );
-        m_table.insert(std::make_pair(std::wstring(L"gamma"), 947) );
-        m_table.insert(std::make_pair(std::wstring(L"delta"), 948) );
-        m_table.insert(std::make_pair(std::wstring(L"epsilon"), 949) );
-        m_table.insert(std::make_pair(std::wstring(L"zeta"), 950) );
-        m_table.insert(std::make_pair(std::wstring(L"eta"), 951) );
-        m_table.insert(std::make_pair(std::wstring(L"theta"), 952) );
-        m_table.insert(std::make_pair(std::wstring(L"iota"), 953) );
-        m_table.insert(std::make_pair(std::wstring(L"kappa"), 954) );
-        m_table.insert(std::make_pair(std::wstring(L"lambda"), 955) );
-        m_table.insert(std::make_pair(std::wstring(L"mu"), 956) );
-        m_table.insert(std::make_pair(std::wstring(L"nu"), 957) );
-        m_table.insert(std::make_pair(std::wstring(L"xi"), 958) );
-        m_table.insert(std::make_pair(std::wstring(L"omicron"), 959) );
-        m_table.insert(std::make_pair(std::wstring(L"pi"), 960) );
-        m_table.insert(std::make_pair(std::wstring(L"rho"), 961) );
-        m_table.insert(std::make_pair(std::wstring(L"sigmaf"), 962) );
-        m_table.insert(std::make_pair(std::wstring(L"sigma"), 963) );
-        m_table.insert(std::make_pair(std::wstring(L"tau"), 964) );
-        m_table.insert(std::make_pair(std::wstring(L"upsilon"), 965) );
-        m_table.insert(std::make_pair(std::wstring(L"phi"), 966) );
-        m_table.insert(std::make_pair(std::wstring(L"chi"), 967) );
-        m_table.insert(std::make_pair(std::wstring(L"psi"), 968) );
-        m_table.insert(std::make_pair(std::wstring(L"omega"), 969) );
-        m_table.insert(std::make_pair(std::wstring(L"thetasym"), 977) );
-        m_table.insert(std::make_pair(std::wstring(L"upsih"), 978) );
-        m_table.insert(std::make_pair(std::wstring(L"piv"), 982) );
-        m_table.insert(std::make_pair(std::wstring(L"bull"), 8226) );
-        m_table.insert(std::make_pair(std::wstring(L"hellip"), 8230) );
-        m_table.insert(std::make_pair(std::wstring(L"prime"), 8242) );
-        m_table.insert(std::make_pair(std::wstring(L"Prime"), 8243) );
-        m_table.insert(std::make_pair(std::wstring(L"oline"), 8254) );
-        m_table.insert(std::make_pair(std::wstring(L"frasl"), 8260) );
-        m_table.insert(std::make_pair(std::wstring(L"weierp"), 8472) );
-        m_table.insert(std::make_pair(std::wstring(L"image"), 8465) );
-        m_table.insert(std::make_pair(std::wstring(L"real"), 8476) );
-        m_table.insert(std::make_pair(std::wstring(L"trade"), 8482) );
-        m_table.insert(std::make_pair(std::wstring(L"alefsym"), 8501) );
-        m_table.insert(std::make_pair(std::wstring(L"larr"), 8592) );
-        m_table.insert(std::make_pair(std::wstring(L"uarr"), 8593) );
-        m_table.insert(std::make_pair(std::wstring(L"rarr"), 8594) );
-        m_table.insert(std::make_pair(std::wstring(L"darr"), 8595) );
-        m_table.insert(std::make_pair(std::wstring(L"harr"), 8596) );
-        m_table.insert(std::make_pair(std::wstring(L"crarr"), 8629) );
-        m_table.insert(std::make_pair(std::wstring(L"lArr"), 8656) );
-        m_table.insert(std::make_pair(std::wstring(L"uArr"), 8657) );
-        m_table.insert(std::make_pair(std::wstring(L"rArr"), 8658) );
-        m_table.insert(std::make_pair(std::wstring(L"dArr"), 8659) );
-        m_table.insert(std::make_pair(std::wstring(L"hArr"), 8660) );
-        m_table.insert(std::make_pair(std::wstring(L"forall"), 8704) );
-        m_table.insert(std::make_pair(std::wstring(L"part"), 8706) );
-        m_table.insert(std::make_pair(std::wstring(L"exist"), 8707) );
-        m_table.insert(std::make_pair(std::wstring(L"empty"), 8709) );
-        m_table.insert(std::make_pair(std::wstring(L"nabla"), 8711) );
-        m_table.insert(std::make_pair(std::wstring(L"isin"), 8712) );
-        m_table.insert(std::make_pair(std::wstring(L"notin"), 8713) );
-        m_table.insert(std::make_pair(std::wstring(L"ni"), 8715) );
-        m_table.insert(std::make_pair(std::wstring(L"prod"), 8719) );
-        m_table.insert(std::make_pair(std::wstring(L"sum"), 8721) );
-        m_table.insert(std::make_pair(std::wstring(L"minus"), 8722) );
-        m_table.insert(std::make_pair(std::wstring(L"lowast"), 8727) );
-        m_table.insert(std::make_pair(std::wstring(L"radic"), 8730) );
-        m_table.insert(std::make_pair(std::wstring(L"prop"), 8733) );
-        m_table.insert(std::make_pair(std::wstring(L"infin"), 8734) );
-        m_table.insert(std::make_pair(std::wstring(L"ang"), 8736) );
-        m_table.insert(std::make_pair(std::wstring(L"and"), 8743) );
-        m_table.insert(std::make_pair(std::wstring(L"or"), 8744) );
-        m_table.insert(std::make_pair(std::wstring(L"cap"), 8745) );
-        m_table.insert(std::make_pair(std::wstring(L"cup"), 8746) );
-        m_table.insert(std::make_pair(std::wstring(L"int"), 8747) );
-        m_table.insert(std::make_pair(std::wstring(L"there4"), 8756) );
-        m_table.insert(std::make_pair(std::wstring(L"sim"), 8764) );
-        m_table.insert(std::make_pair(std::wstring(L"cong"), 8773) );
-        m_table.insert(std::make_pair(std::wstring(L"asymp"), 8776) );
-        m_table.insert(std::make_pair(std::wstring(L"ne"), 8800) );
-        m_table.insert(std::make_pair(std::wstring(L"equiv"), 8801) );
-        m_table.insert(std::make_pair(std::wstring(L"le"), 8804) );
-        m_table.insert(std::make_pair(std::wstring(L"ge"), 8805) );
-        m_table.insert(std::make_pair(std::wstring(L"sub"), 8834) );
-        m_table.insert(std::make_pair(std::wstring(L"sup"), 8835) );
-        m_table.insert(std::make_pair(std::wstring(L"nsub"), 8836) );
-        m_table.insert(std::make_pair(std::wstring(L"sube"), 8838) );
-        m_table.insert(std::make_pair(std::wstring(L"supe"), 8839) );
-        m_table.insert(std::make_pair(std::wstring(L"oplus"), 8853) );
-        m_table.insert(std::make_pair(std::wstring(L"otimes"), 8855) );
-        m_table.insert(std::make_pair(std::wstring(L"perp"), 8869) );
-        m_table.insert(std::make_pair(std::wstring(L"sdot"), 8901) );
-        m_table.insert(std::make_pair(std::wstring(L"lceil"), 8968) );
-        m_table.insert(std::make_pair(std::wstring(L"rceil"), 8969) );
-        m_table.insert(std::make_pair(std::wstring(L"lfloor"), 8970) );
-        m_table.insert(std::make_pair(std::wstring(L"rfloor"), 8971) );
-        m_table.insert(std::make_pair(std::wstring(L"lang"), 9001) );
-        m_table.insert(std::make_pair(std::wstring(L"rang"), 9002) );
-        m_table.insert(std::make_pair(std::wstring(L"loz"), 9674) );
-        m_table.insert(std::make_pair(std::wstring(L"spades"), 9824) );
-        m_table.insert(std::make_pair(std::wstring(L"clubs"), 9827) );
-        m_table.insert(std::make_pair(std::wstring(L"hearts"), 9829) );
-        m_table.insert(std::make_pair(std::wstring(L"diams"), 9830) );
-        m_table.insert(std::make_pair(std::wstring(L"OElig"), 338) );
-        m_table.insert(std::make_pair(std::wstring(L"oelig"), 339) );
-        m_table.insert(std::make_pair(std::wstring(L"Scaron"), 352) );
-        m_table.insert(std::make_pair(std::wstring(L"scaron"), 353) );
-        m_table.insert(std::make_pair(std::wstring(L"Yuml"), 376) );
-        m_table.insert(std::make_pair(std::wstring(L"circ"), 710) );
-        m_table.insert(std::make_pair(std::wstring(L"tilde"), 732) );
-        m_table.insert(std::make_pair(std::wstring(L"ensp"), 8194) );
-        m_table.insert(std::make_pair(std::wstring(L"emsp"), 8195) );
-        m_table.insert(std::make_pair(std::wstring(L"thinsp"), 8201) );
-        m_table.insert(std::make_pair(std::wstring(L"zwnj"), 8204) );
-        m_table.insert(std::make_pair(std::wstring(L"zwj"), 8205) );
-        m_table.insert(std::make_pair(std::wstring(L"lrm"), 8206) );
-        m_table.insert(std::make_pair(std::wstring(L"rlm"), 8207) );
-        m_table.insert(std::make_pair(std::wstring(L"ndash"), 8211) );
-        m_table.insert(std::make_pair(std::wstring(L"mdash"), 8212) );
-        m_table.insert(std::make_pair(std::wstring(L"lsquo"), 8216) );
-        m_table.insert(std::make_pair(std::wstring(L"rsquo"), 8217) );
-        m_table.insert(std::make_pair(std::wstring(L"sbquo"), 8218) );
-        m_table.insert(std::make_pair(std::wstring(L"ldquo"), 8220) );
-        m_table.insert(std::make_pair(std::wstring(L"rdquo"), 8221) );
-        m_table.insert(std::make_pair(std::wstring(L"bdquo"), 8222) );
-        m_table.insert(std::make_pair(std::wstring(L"dagger"), 8224) );
-        m_table.insert(std::make_pair(std::wstring(L"Dagger"), 8225) );
-        m_table.insert(std::make_pair(std::wstring(L"permil"), 8240) );
-        m_table.insert(std::make_pair(std::wstring(L"lsaquo"), 8249) );
-        m_table.insert(std::make_pair(std::wstring(L"rsaquo"), 8250) );
-        m_table.insert(std::make_pair(std::wstring(L"euro"), 8364) );
+        { L"AElig", 5, 0x00C6, 0x0000 },
+        { L"AMP", 3, 0x0026, 0x0000 },
+        { L"Aacute", 6, 0x00C1, 0x0000 },
+        { L"Abreve", 6, 0x0102, 0x0000 },
+        { L"Acirc", 5, 0x00C2, 0x0000 },
+        { L"Acy", 3, 0x0410, 0x0000 },
+        { L"Afr", 3, 0x1D504, 0x0000 },
+        { L"Agrave", 6, 0x00C0, 0x0000 },
+        { L"Alpha", 5, 0x0391, 0x0000 },
+        { L"Amacr", 5, 0x0100, 0x0000 },
+        { L"And", 3, 0x2A53, 0x0000 },
+        { L"Aogon", 5, 0x0104, 0x0000 },
+        { L"Aopf", 4, 0x1D538, 0x0000 },
+        { L"ApplyFunction", 13, 0x2061, 0x0000 },
+        { L"Aring", 5, 0x00C5, 0x0000 },
+        { L"Ascr", 4, 0x1D49C, 0x0000 },
+        { L"Assign", 6, 0x2254, 0x0000 },
+        { L"Atilde", 6, 0x00C3, 0x0000 },
+        { L"Auml", 4, 0x00C4, 0x0000 },
+        { L"Backslash", 9, 0x2216, 0x0000 },
+        { L"Barv", 4, 0x2AE7, 0x0000 },
+        { L"Barwed", 6, 0x2306, 0x0000 },
+        { L"Bcy", 3, 0x0411, 0x0000 },
+        { L"Because", 7, 0x2235, 0x0000 },
+        { L"Bernoullis", 10, 0x212C, 0x0000 },
+        { L"Beta", 4, 0x0392, 0x0000 },
+        { L"Bfr", 3, 0x1D505, 0x0000 },
+        { L"Bopf", 4, 0x1D539, 0x0000 },
+        { L"Breve", 5, 0x02D8, 0x0000 },
+        { L"Bscr", 4, 0x212C, 0x0000 },
+        { L"Bumpeq", 6, 0x224E, 0x0000 },
+        { L"CHcy", 4, 0x0427, 0x0000 },
+        { L"COPY", 4, 0x00A9, 0x0000 },
+        { L"Cacute", 6, 0x0106, 0x0000 },
+        { L"Cap", 3, 0x22D2, 0x0000 },
+        { L"CapitalDifferentialD", 20, 0x2145, 0x0000 },
+        { L"Cayleys", 7, 0x212D, 0x0000 },
+        { L"Ccaron", 6, 0x010C, 0x0000 },
+        { L"Ccedil", 6, 0x00C7, 0x0000 },
+        { L"Ccirc", 5, 0x0108, 0x0000 },
+        { L"Cconint", 7, 0x2230, 0x0000 },
+        { L"Cdot", 4, 0x010A, 0x0000 },
+        { L"Cedilla", 7, 0x00B8, 0x0000 },
+        { L"CenterDot", 9, 0x00B7, 0x0000 },
+        { L"Cfr", 3, 0x212D, 0x0000 },
+        { L"Chi", 3, 0x03A7, 0x0000 },
+        { L"CircleDot", 9, 0x2299, 0x0000 },
+        { L"CircleMinus", 11, 0x2296, 0x0000 },
+        { L"CirclePlus", 10, 0x2295, 0x0000 },
+        { L"CircleTimes", 11, 0x2297, 0x0000 },
+        { L"ClockwiseContourIntegral", 24, 0x2232, 0x0000 },
+        { L"CloseCurlyDoubleQuote", 21, 0x201D, 0x0000 },
+        { L"CloseCurlyQuote", 15, 0x2019, 0x0000 },
+        { L"Colon", 5, 0x2237, 0x0000 },
+        { L"Colone", 6, 0x2A74, 0x0000 },
+        { L"Congruent", 9, 0x2261, 0x0000 },
+        { L"Conint", 6, 0x222F, 0x0000 },
+        { L"ContourIntegral", 15, 0x222E, 0x0000 },
+        { L"Copf", 4, 0x2102, 0x0000 },
+        { L"Coproduct", 9, 0x2210, 0x0000 },
+        { L"CounterClockwiseContourIntegral", 31, 0x2233, 0x0000 },
+        { L"Cross", 5, 0x2A2F, 0x0000 },
+        { L"Cscr", 4, 0x1D49E, 0x0000 },
+        { L"Cup", 3, 0x22D3, 0x0000 },
+        { L"CupCap", 6, 0x224D, 0x0000 },
+        { L"DD", 2, 0x2145, 0x0000 },
+        { L"DDotrahd", 8, 0x2911, 0x0000 },
+        { L"DJcy", 4, 0x0402, 0x0000 },
+        { L"DScy", 4, 0x0405, 0x0000 },
+        { L"DZcy", 4, 0x040F, 0x0000 },
+        { L"Dagger", 6, 0x2021, 0x0000 },
+        { L"Darr", 4, 0x21A1, 0x0000 },
+        { L"Dashv", 5, 0x2AE4, 0x0000 },
+        { L"Dcaron", 6, 0x010E, 0x0000 },
+        { L"Dcy", 3, 0x0414, 0x0000 },
+        { L"Del", 3, 0x2207, 0x0000 },
+        { L"Delta", 5, 0x0394, 0x0000 },
+        { L"Dfr", 3, 0x1D507, 0x0000 },
+        { L"DiacriticalAcute", 16, 0x00B4, 0x0000 },
+        { L"DiacriticalDot", 14, 0x02D9, 0x0000 },
+        { L"DiacriticalDoubleAcute", 22, 0x02DD, 0x0000 },
+        { L"DiacriticalGrave", 16, 0x0060, 0x0000 },
+        { L"DiacriticalTilde", 16, 0x02DC, 0x0000 },
+        { L"Diamond", 7, 0x22C4, 0x0000 },
+        { L"DifferentialD", 13, 0x2146, 0x0000 },
+        { L"Dopf", 4, 0x1D53B, 0x0000 },
+        { L"Dot", 3, 0x00A8, 0x0000 },
+        { L"DotDot", 6, 0x20DC, 0x0000 },
+        { L"DotEqual", 8, 0x2250, 0x0000 },
+        { L"DoubleContourIntegral", 21, 0x222F, 0x0000 },
+        { L"DoubleDot", 9, 0x00A8, 0x0000 },
+        { L"DoubleDownArrow", 15, 0x21D3, 0x0000 },
+        { L"DoubleLeftArrow", 15, 0x21D0, 0x0000 },
+        { L"DoubleLeftRightArrow", 20, 0x21D4, 0x0000 },
+        { L"DoubleLeftTee", 13, 0x2AE4, 0x0000 },
+        { L"DoubleLongLeftArrow", 19, 0x27F8, 0x0000 },
+        { L"DoubleLongLeftRightArrow", 24, 0x27FA, 0x0000 },
+        { L"DoubleLongRightArrow", 20, 0x27F9, 0x0000 },
+        { L"DoubleRightArrow", 16, 0x21D2, 0x0000 },
+        { L"DoubleRightTee", 14, 0x22A8, 0x0000 },
+        { L"DoubleUpArrow", 13, 0x21D1, 0x0000 },
+        { L"DoubleUpDownArrow", 17, 0x21D5, 0x0000 },
+        { L"DoubleVerticalBar", 17, 0x2225, 0x0000 },
+        { L"DownArrow", 9, 0x2193, 0x0000 },
+        { L"DownArrowBar", 12, 0x2913, 0x0000 },
+        { L"DownArrowUpArrow", 16, 0x21F5, 0x0000 },
+        { L"DownBreve", 9, 0x0311, 0x0000 },
+        { L"DownLeftRightVector", 19, 0x2950, 0x0000 },
+        { L"DownLeftTeeVector", 17, 0x295E, 0x0000 },
+        { L"DownLeftVector", 14, 0x21BD, 0x0000 },
+        { L"DownLeftVectorBar", 17, 0x2956, 0x0000 },
+        { L"DownRightTeeVector", 18, 0x295F, 0x0000 },
+        { L"DownRightVector", 15, 0x21C1, 0x0000 },
+        { L"DownRightVectorBar", 18, 0x2957, 0x0000 },
+        { L"DownTee", 7, 0x22A4, 0x0000 },
+        { L"DownTeeArrow", 12, 0x21A7, 0x0000 },
+        { L"Downarrow", 9, 0x21D3, 0x0000 },
+        { L"Dscr", 4, 0x1D49F, 0x0000 },
+        { L"Dstrok", 6, 0x0110, 0x0000 },
+        { L"ENG", 3, 0x014A, 0x0000 },
+        { L"ETH", 3, 0x00D0, 0x0000 },
+        { L"Eacute", 6, 0x00C9, 0x0000 },
+        { L"Ecaron", 6, 0x011A, 0x0000 },
+        { L"Ecirc", 5, 0x00CA, 0x0000 },
+        { L"Ecy", 3, 0x042D, 0x0000 },
+        { L"Edot", 4, 0x0116, 0x0000 },
+        { L"Efr", 3, 0x1D508, 0x0000 },
+        { L"Egrave", 6, 0x00C8, 0x0000 },
+        { L"Element", 7, 0x2208, 0x0000 },
+        { L"Emacr", 5, 0x0112, 0x0000 },
+        { L"EmptySmallSquare", 16, 0x25FB, 0x0000 },
+        { L"EmptyVerySmallSquare", 20, 0x25AB, 0x0000 },
+        { L"Eogon", 5, 0x0118, 0x0000 },
+        { L"Eopf", 4, 0x1D53C, 0x0000 },
+        { L"Epsilon", 7, 0x0395, 0x0000 },
+        { L"Equal", 5, 0x2A75, 0x0000 },
+        { L"EqualTilde", 10, 0x2242, 0x0000 },
+        { L"Equilibrium", 11, 0x21CC, 0x0000 },
+        { L"Escr", 4, 0x2130, 0x0000 },
+        { L"Esim", 4, 0x2A73, 0x0000 },
+        { L"Eta", 3, 0x0397, 0x0000 },
+        { L"Euml", 4, 0x00CB, 0x0000 },
+        { L"Exists", 6, 0x2203, 0x0000 },
+        { L"ExponentialE", 12, 0x2147, 0x0000 },
+        { L"Fcy", 3, 0x0424, 0x0000 },
+        { L"Ffr", 3, 0x1D509, 0x0000 },
+        { L"FilledSmallSquare", 17, 0x25FC, 0x0000 },
+        { L"FilledVerySmallSquare", 21, 0x25AA, 0x0000 },
+        { L"Fopf", 4, 0x1D53D, 0x0000 },
+        { L"ForAll", 6, 0x2200, 0x0000 },
+        { L"Fouriertrf", 10, 0x2131, 0x0000 },
+        { L"Fscr", 4, 0x2131, 0x0000 },
+        { L"GJcy", 4, 0x0403, 0x0000 },
+        { L"GT", 2, 0x003E, 0x0000 },
+        { L"Gamma", 5, 0x0393, 0x0000 },
+        { L"Gammad", 6, 0x03DC, 0x0000 },
+        { L"Gbreve", 6, 0x011E, 0x0000 },
+        { L"Gcedil", 6, 0x0122, 0x0000 },
+        { L"Gcirc", 5, 0x011C, 0x0000 },
+        { L"Gcy", 3, 0x0413, 0x0000 },
+        { L"Gdot", 4, 0x0120, 0x0000 },
+        { L"Gfr", 3, 0x1D50A, 0x0000 },
+        { L"Gg", 2, 0x22D9, 0x0000 },
+        { L"Gopf", 4, 0x1D53E, 0x0000 },
+        { L"GreaterEqual", 12, 0x2265, 0x0000 },
+        { L"GreaterEqualLess", 16, 0x22DB, 0x0000 },
+        { L"GreaterFullEqual", 16, 0x2267, 0x0000 },
+        { L"GreaterGreater", 14, 0x2AA2, 0x0000 },
+        { L"GreaterLess", 11, 0x2277, 0x0000 },
+        { L"GreaterSlantEqual", 17, 0x2A7E, 0x0000 },
+        { L"GreaterTilde", 12, 0x2273, 0x0000 },
+        { L"Gscr", 4, 0x1D4A2, 0x0000 },
+        { L"Gt", 2, 0x226B, 0x0000 },
+        { L"HARDcy", 6, 0x042A, 0x0000 },
+        { L"Hacek", 5, 0x02C7, 0x0000 },
+        { L"Hat", 3, 0x005E, 0x0000 },
+        { L"Hcirc", 5, 0x0124, 0x0000 },
+        { L"Hfr", 3, 0x210C, 0x0000 },
+        { L"HilbertSpace", 12, 0x210B, 0x0000 },
+        { L"Hopf", 4, 0x210D, 0x0000 },
+        { L"HorizontalLine", 14, 0x2500, 0x0000 },
+        { L"Hscr", 4, 0x210B, 0x0000 },
+        { L"Hstrok", 6, 0x0126, 0x0000 },
+        { L"HumpDownHump", 12, 0x224E, 0x0000 },
+        { L"HumpEqual", 9, 0x224F, 0x0000 },
+        { L"IEcy", 4, 0x0415, 0x0000 },
+        { L"IJlig", 5, 0x0132, 0x0000 },
+        { L"IOcy", 4, 0x0401, 0x0000 },
+        { L"Iacute", 6, 0x00CD, 0x0000 },
+        { L"Icirc", 5, 0x00CE, 0x0000 },
+        { L"Icy", 3, 0x0418, 0x0000 },
+        { L"Idot", 4, 0x0130, 0x0000 },
+        { L"Ifr", 3, 0x2111, 0x0000 },
+        { L"Igrave", 6, 0x00CC, 0x0000 },
+        { L"Im", 2, 0x2111, 0x0000 },
+        { L"Imacr", 5, 0x012A, 0x0000 },
+        { L"ImaginaryI", 10, 0x2148, 0x0000 },
+        { L"Implies", 7, 0x21D2, 0x0000 },
+        { L"Int", 3, 0x222C, 0x0000 },
+        { L"Integral", 8, 0x222B, 0x0000 },
+        { L"Intersection", 12, 0x22C2, 0x0000 },
+        { L"InvisibleComma", 14, 0x2063, 0x0000 },
+        { L"InvisibleTimes", 14, 0x2062, 0x0000 },
+        { L"Iogon", 5, 0x012E, 0x0000 },
+        { L"Iopf", 4, 0x1D540, 0x0000 },
+        { L"Iota", 4, 0x0399, 0x0000 },
+        { L"Iscr", 4, 0x2110, 0x0000 },
+        { L"Itilde", 6, 0x0128, 0x0000 },
+        { L"Iukcy", 5, 0x0406, 0x0000 },
+        { L"Iuml", 4, 0x00CF, 0x0000 },
+        { L"Jcirc", 5, 0x0134, 0x0000 },
+        { L"Jcy", 3, 0x0419, 0x0000 },
+        { L"Jfr", 3, 0x1D50D, 0x0000 },
+        { L"Jopf", 4, 0x1D541, 0x0000 },
+        { L"Jscr", 4, 0x1D4A5, 0x0000 },
+        { L"Jsercy", 6, 0x0408, 0x0000 },
+        { L"Jukcy", 5, 0x0404, 0x0000 },
+        { L"KHcy", 4, 0x0425, 0x0000 },
+        { L"KJcy", 4, 0x040C, 0x0000 },
+        { L"Kappa", 5, 0x039A, 0x0000 },
+        { L"Kcedil", 6, 0x0136, 0x0000 },
+        { L"Kcy", 3, 0x041A, 0x0000 },
+        { L"Kfr", 3, 0x1D50E, 0x0000 },
+        { L"Kopf", 4, 0x1D542, 0x0000 },
+        { L"Kscr", 4, 0x1D4A6, 0x0000 },
+        { L"LJcy", 4, 0x0409, 0x0000 },
+        { L"LT", 2, 0x003C, 0x0000 },
+        { L"Lacute", 6, 0x0139, 0x0000 },
+        { L"Lambda", 6, 0x039B, 0x0000 },
+        { L"Lang", 4, 0x27EA, 0x0000 },
+        { L"Laplacetrf", 10, 0x2112, 0x0000 },
+        { L"Larr", 4, 0x219E, 0x0000 },
+        { L"Lcaron", 6, 0x013D, 0x0000 },
+        { L"Lcedil", 6, 0x013B, 0x0000 },
+        { L"Lcy", 3, 0x041B, 0x0000 },
+        { L"LeftAngleBracket", 16, 0x27E8, 0x0000 },
+        { L"LeftArrow", 9, 0x2190, 0x0000 },
+        { L"LeftArrowBar", 12, 0x21E4, 0x0000 },
+        { L"LeftArrowRightArrow", 19, 0x21C6, 0x0000 },
+        { L"LeftCeiling", 11, 0x2308, 0x0000 },
+        { L"LeftDoubleBracket", 17, 0x27E6, 0x0000 },
+        { L"LeftDownTeeVector", 17, 0x2961, 0x0000 },
+        { L"LeftDownVector", 14, 0x21C3, 0x0000 },
+        { L"LeftDownVectorBar", 17, 0x2959, 0x0000 },
+        { L"LeftFloor", 9, 0x230A, 0x0000 },
+        { L"LeftRightArrow", 14, 0x2194, 0x0000 },
+        { L"LeftRightVector", 15, 0x294E, 0x0000 },
+        { L"LeftTee", 7, 0x22A3, 0x0000 },
+        { L"LeftTeeArrow", 12, 0x21A4, 0x0000 },
+        { L"LeftTeeVector", 13, 0x295A, 0x0000 },
+        { L"LeftTriangle", 12, 0x22B2, 0x0000 },
+        { L"LeftTriangleBar", 15, 0x29CF, 0x0000 },
+        { L"LeftTriangleEqual", 17, 0x22B4, 0x0000 },
+        { L"LeftUpDownVector", 16, 0x2951, 0x0000 },
+        { L"LeftUpTeeVector", 15, 0x2960, 0x0000 },
+        { L"LeftUpVector", 12, 0x21BF, 0x0000 },
+        { L"LeftUpVectorBar", 15, 0x2958, 0x0000 },
+        { L"LeftVector", 10, 0x21BC, 0x0000 },
+        { L"LeftVectorBar", 13, 0x2952, 0x0000 },
+        { L"Leftarrow", 9, 0x21D0, 0x0000 },
+        { L"Leftrightarrow", 14, 0x21D4, 0x0000 },
+        { L"LessEqualGreater", 16, 0x22DA, 0x0000 },
+        { L"LessFullEqual", 13, 0x2266, 0x0000 },
+        { L"LessGreater", 11, 0x2276, 0x0000 },
+        { L"LessLess", 8, 0x2AA1, 0x0000 },
+        { L"LessSlantEqual", 14, 0x2A7D, 0x0000 },
+        { L"LessTilde", 9, 0x2272, 0x0000 },
+        { L"Lfr", 3, 0x1D50F, 0x0000 },
+        { L"Ll", 2, 0x22D8, 0x0000 },
+        { L"Lleftarrow", 10, 0x21DA, 0x0000 },
+        { L"Lmidot", 6, 0x013F, 0x0000 },
+        { L"LongLeftArrow", 13, 0x27F5, 0x0000 },
+        { L"LongLeftRightArrow", 18, 0x27F7, 0x0000 },
+        { L"LongRightArrow", 14, 0x27F6, 0x0000 },
+        { L"Longleftarrow", 13, 0x27F8, 0x0000 },
+        { L"Longleftrightarrow", 18, 0x27FA, 0x0000 },
+        { L"Longrightarrow", 14, 0x27F9, 0x0000 },
+        { L"Lopf", 4, 0x1D543, 0x0000 },
+        { L"LowerLeftArrow", 14, 0x2199, 0x0000 },
+        { L"LowerRightArrow", 15, 0x2198, 0x0000 },
+        { L"Lscr", 4, 0x2112, 0x0000 },
+        { L"Lsh", 3, 0x21B0, 0x0000 },
+        { L"Lstrok", 6, 0x0141, 0x0000 },
+        { L"Lt", 2, 0x226A, 0x0000 },
+        { L"Map", 3, 0x2905, 0x0000 },
+        { L"Mcy", 3, 0x041C, 0x0000 },
+        { L"MediumSpace", 11, 0x205F, 0x0000 },
+        { L"Mellintrf", 9, 0x2133, 0x0000 },
+        { L"Mfr", 3, 0x1D510, 0x0000 },
+        { L"MinusPlus", 9, 0x2213, 0x0000 },
+        { L"Mopf", 4, 0x1D544, 0x0000 },
+        { L"Mscr", 4, 0x2133, 0x0000 },
+        { L"Mu", 2, 0x039C, 0x0000 },
+        { L"NJcy", 4, 0x040A, 0x0000 },
+        { L"Nacute", 6, 0x0143, 0x0000 },
+        { L"Ncaron", 6, 0x0147, 0x0000 },
+        { L"Ncedil", 6, 0x0145, 0x0000 },
+        { L"Ncy", 3, 0x041D, 0x0000 },
+        { L"NegativeMediumSpace", 19, 0x200B, 0x0000 },
+        { L"NegativeThickSpace", 18, 0x200B, 0x0000 },
+        { L"NegativeThinSpace", 17, 0x200B, 0x0000 },
+        { L"NegativeVeryThinSpace", 21, 0x200B, 0x0000 },
+        { L"NestedGreaterGreater", 20, 0x226B, 0x0000 },
+        { L"NestedLessLess", 14, 0x226A, 0x0000 },
+        { L"NewLine", 7, 0x000A, 0x0000 },
+        { L"Nfr", 3, 0x1D511, 0x0000 },
+        { L"NoBreak", 7, 0x2060, 0x0000 },
+        { L"NonBreakingSpace", 16, 0x00A0, 0x0000 },
+        { L"Nopf", 4, 0x2115, 0x0000 },
+        { L"Not", 3, 0x2AEC, 0x0000 },
+        { L"NotCongruent", 12, 0x2262, 0x0000 },
+        { L"NotCupCap", 9, 0x226D, 0x0000 },
+        { L"NotDoubleVerticalBar", 20, 0x2226, 0x0000 },
+        { L"NotElement", 10, 0x2209, 0x0000 },
+        { L"NotEqual", 8, 0x2260, 0x0000 },
+        { L"NotEqualTilde", 13, 0x2242, 0x0338 },
+        { L"NotExists", 9, 0x2204, 0x0000 },
+        { L"NotGreater", 10, 0x226F, 0x0000 },
+        { L"NotGreaterEqual", 15, 0x2271, 0x0000 },
+        { L"NotGreaterFullEqual", 19, 0x2267, 0x0338 },
+        { L"NotGreaterGreater", 17, 0x226B, 0x0338 },
+        { L"NotGreaterLess", 14, 0x2279, 0x0000 },
+        { L"NotGreaterSlantEqual", 20, 0x2A7E, 0x0338 },
+        { L"NotGreaterTilde", 15, 0x2275, 0x0000 },
+        { L"NotHumpDownHump", 15, 0x224E, 0x0338 },
+        { L"NotHumpEqual", 12, 0x224F, 0x0338 },
+        { L"NotLeftTriangle", 15, 0x22EA, 0x0000 },
+        { L"NotLeftTriangleBar", 18, 0x29CF, 0x0338 },
+        { L"NotLeftTriangleEqual", 20, 0x22EC, 0x0000 },
+        { L"NotLess", 7, 0x226E, 0x0000 },
+        { L"NotLessEqual", 12, 0x2270, 0x0000 },
+        { L"NotLessGreater", 14, 0x2278, 0x0000 },
+        { L"NotLessLess", 11, 0x226A, 0x0338 },
+        { L"NotLessSlantEqual", 17, 0x2A7D, 0x0338 },
+        { L"NotLessTilde", 12, 0x2274, 0x0000 },
+        { L"NotNestedGreaterGreater", 23, 0x2AA2, 0x0338 },
+        { L"NotNestedLessLess", 17, 0x2AA1, 0x0338 },
+        { L"NotPrecedes", 11, 0x2280, 0x0000 },
+        { L"NotPrecedesEqual", 16, 0x2AAF, 0x0338 },
+        { L"NotPrecedesSlantEqual", 21, 0x22E0, 0x0000 },
+        { L"NotReverseElement", 17, 0x220C, 0x0000 },
+        { L"NotRightTriangle", 16, 0x22EB, 0x0000 },
+        { L"NotRightTriangleBar", 19, 0x29D0, 0x0338 },
+        { L"NotRightTriangleEqual", 21, 0x22ED, 0x0000 },
+        { L"NotSquareSubset", 15, 0x228F, 0x0338 },
+        { L"NotSquareSubsetEqual", 20, 0x22E2, 0x0000 },
+        { L"NotSquareSuperset", 17, 0x2290, 0x0338 },
+        { L"NotSquareSupersetEqual", 22, 0x22E3, 0x0000 },
+        { L"NotSubset", 9, 0x2282, 0x20D2 },
+        { L"NotSubsetEqual", 14, 0x2288, 0x0000 },
+        { L"NotSucceeds", 11, 0x2281, 0x0000 },
+        { L"NotSucceedsEqual", 16, 0x2AB0, 0x0338 },
+        { L"NotSucceedsSlantEqual", 21, 0x22E1, 0x0000 },
+        { L"NotSucceedsTilde", 16, 0x227F, 0x0338 },
+        { L"NotSuperset", 11, 0x2283, 0x20D2 },
+        { L"NotSupersetEqual", 16, 0x2289, 0x0000 },
+        { L"NotTilde", 8, 0x2241, 0x0000 },
+        { L"NotTildeEqual", 13, 0x2244, 0x0000 },
+        { L"NotTildeFullEqual", 17, 0x2247, 0x0000 },
+        { L"NotTildeTilde", 13, 0x2249, 0x0000 },
+        { L"NotVerticalBar", 14, 0x2224, 0x0000 },
+        { L"Nscr", 4, 0x1D4A9, 0x0000 },
+        { L"Ntilde", 6, 0x00D1, 0x0000 },
+        { L"Nu", 2, 0x039D, 0x0000 },
+        { L"OElig", 5, 0x0152, 0x0000 },
+        { L"Oacute", 6, 0x00D3, 0x0000 },
+        { L"Ocirc", 5, 0x00D4, 0x0000 },
+        { L"Ocy", 3, 0x041E, 0x0000 },
+        { L"Odblac", 6, 0x0150, 0x0000 },
+        { L"Ofr", 3, 0x1D512, 0x0000 },
+        { L"Ograve", 6, 0x00D2, 0x0000 },
+        { L"Omacr", 5, 0x014C, 0x0000 },
+        { L"Omega", 5, 0x03A9, 0x0000 },
+        { L"Omicron", 7, 0x039F, 0x0000 },
+        { L"Oopf", 4, 0x1D546, 0x0000 },
+        { L"OpenCurlyDoubleQuote", 20, 0x201C, 0x0000 },
+        { L"OpenCurlyQuote", 14, 0x2018, 0x0000 },
+        { L"Or", 2, 0x2A54, 0x0000 },
+        { L"Oscr", 4, 0x1D4AA, 0x0000 },
+        { L"Oslash", 6, 0x00D8, 0x0000 },
+        { L"Otilde", 6, 0x00D5, 0x0000 },
+        { L"Otimes", 6, 0x2A37, 0x0000 },
+        { L"Ouml", 4, 0x00D6, 0x0000 },
+        { L"OverBar", 7, 0x203E, 0x0000 },
+        { L"OverBrace", 9, 0x23DE, 0x0000 },
+        { L"OverBracket", 11, 0x23B4, 0x0000 },
+        { L"OverParenthesis", 15, 0x23DC, 0x0000 },
+        { L"PartialD", 8, 0x2202, 0x0000 },
+        { L"Pcy", 3, 0x041F, 0x0000 },
+        { L"Pfr", 3, 0x1D513, 0x0000 },
+        { L"Phi", 3, 0x03A6, 0x0000 },
+        { L"Pi", 2, 0x03A0, 0x0000 },
+        { L"PlusMinus", 9, 0x00B1, 0x0000 },
+        { L"Poincareplane", 13, 0x210C, 0x0000 },
+        { L"Popf", 4, 0x2119, 0x0000 },
+        { L"Pr", 2, 0x2ABB, 0x0000 },
+        { L"Precedes", 8, 0x227A, 0x0000 },
+        { L"PrecedesEqual", 13, 0x2AAF, 0x0000 },
+        { L"PrecedesSlantEqual", 18, 0x227C, 0x0000 },
+        { L"PrecedesTilde", 13, 0x227E, 0x0000 },
+        { L"Prime", 5, 0x2033, 0x0000 },
+        { L"Product", 7, 0x220F, 0x0000 },
+        { L"Proportion", 10, 0x2237, 0x0000 },
+        { L"Proportional", 12, 0x221D, 0x0000 },
+        { L"Pscr", 4, 0x1D4AB, 0x0000 },
+        { L"Psi", 3, 0x03A8, 0x0000 },
+        { L"QUOT", 4, 0x0022, 0x0000 },
+        { L"Qfr", 3, 0x1D514, 0x0000 },
+        { L"Qopf", 4, 0x211A, 0x0000 },
+        { L"Qscr", 4, 0x1D4AC, 0x0000 },
+        { L"RBarr", 5, 0x2910, 0x0000 },
+        { L"REG", 3, 0x00AE, 0x0000 },
+        { L"Racute", 6, 0x0154, 0x0000 },
+        { L"Rang", 4, 0x27EB, 0x0000 },
+        { L"Rarr", 4, 0x21A0, 0x0000 },
+        { L"Rarrtl", 6, 0x2916, 0x0000 },
+        { L"Rcaron", 6, 0x0158, 0x0000 },
+        { L"Rcedil", 6, 0x0156, 0x0000 },
+        { L"Rcy", 3, 0x0420, 0x0000 },
+        { L"Re", 2, 0x211C, 0x0000 },
+        { L"ReverseElement", 14, 0x220B, 0x0000 },
+        { L"ReverseEquilibrium", 18, 0x21CB, 0x0000 },
+        { L"ReverseUpEquilibrium", 20, 0x296F, 0x0000 },
+        { L"Rfr", 3, 0x211C, 0x0000 },
+        { L"Rho", 3, 0x03A1, 0x0000 },
+        { L"RightAngleBracket", 17, 0x27E9, 0x0000 },
+        { L"RightArrow", 10, 0x2192, 0x0000 },
+        { L"RightArrowBar", 13, 0x21E5, 0x0000 },
+        { L"RightArrowLeftArrow", 19, 0x21C4, 0x0000 },
+        { L"RightCeiling", 12, 0x2309, 0x0000 },
+        { L"RightDoubleBracket", 18, 0x27E7, 0x0000 },
+        { L"RightDownTeeVector", 18, 0x295D, 0x0000 },
+        { L"RightDownVector", 15, 0x21C2, 0x0000 },
+        { L"RightDownVectorBar", 18, 0x2955, 0x0000 },
+        { L"RightFloor", 10, 0x230B, 0x0000 },
+        { L"RightTee", 8, 0x22A2, 0x0000 },
+        { L"RightTeeArrow", 13, 0x21A6, 0x0000 },
+        { L"RightTeeVector", 14, 0x295B, 0x0000 },
+        { L"RightTriangle", 13, 0x22B3, 0x0000 },
+        { L"RightTriangleBar", 16, 0x29D0, 0x0000 },
+        { L"RightTriangleEqual", 18, 0x22B5, 0x0000 },
+        { L"RightUpDownVector", 17, 0x294F, 0x0000 },
+        { L"RightUpTeeVector", 16, 0x295C, 0x0000 },
+        { L"RightUpVector", 13, 0x21BE, 0x0000 },
+        { L"RightUpVectorBar", 16, 0x2954, 0x0000 },
+        { L"RightVector", 11, 0x21C0, 0x0000 },
+        { L"RightVectorBar", 14, 0x2953, 0x0000 },
+        { L"Rightarrow", 10, 0x21D2, 0x0000 },
+        { L"Ropf", 4, 0x211D, 0x0000 },
+        { L"RoundImplies", 12, 0x2970, 0x0000 },
+        { L"Rrightarrow", 11, 0x21DB, 0x0000 },
+        { L"Rscr", 4, 0x211B, 0x0000 },
+        { L"Rsh", 3, 0x21B1, 0x0000 },
+        { L"RuleDelayed", 11, 0x29F4, 0x0000 },
+        { L"SHCHcy", 6, 0x0429, 0x0000 },
+        { L"SHcy", 4, 0x0428, 0x0000 },
+        { L"SOFTcy", 6, 0x042C, 0x0000 },
+        { L"Sacute", 6, 0x015A, 0x0000 },
+        { L"Sc", 2, 0x2ABC, 0x0000 },
+        { L"Scaron", 6, 0x0160, 0x0000 },
+        { L"Scedil", 6, 0x015E, 0x0000 },
+        { L"Scirc", 5, 0x015C, 0x0000 },
+        { L"Scy", 3, 0x0421, 0x0000 },
+        { L"Sfr", 3, 0x1D516, 0x0000 },
+        { L"ShortDownArrow", 14, 0x2193, 0x0000 },
+        { L"ShortLeftArrow", 14, 0x2190, 0x0000 },
+        { L"ShortRightArrow", 15, 0x2192, 0x0000 },
+        { L"ShortUpArrow", 12, 0x2191, 0x0000 },
+        { L"Sigma", 5, 0x03A3, 0x0000 },
+        { L"SmallCircle", 11, 0x2218, 0x0000 },
+        { L"Sopf", 4, 0x1D54A, 0x0000 },
+        { L"Sqrt", 4, 0x221A, 0x0000 },
+        { L"Square", 6, 0x25A1, 0x0000 },
+        { L"SquareIntersection", 18, 0x2293, 0x0000 },
+        { L"SquareSubset", 12, 0x228F, 0x0000 },
+        { L"SquareSubsetEqual", 17, 0x2291, 0x0000 },
+        { L"SquareSuperset", 14, 0x2290, 0x0000 },
+        { L"SquareSupersetEqual", 19, 0x2292, 0x0000 },
+        { L"SquareUnion", 11, 0x2294, 0x0000 },
+        { L"Sscr", 4, 0x1D4AE, 0x0000 },
+        { L"Star", 4, 0x22C6, 0x0000 },
+        { L"Sub", 3, 0x22D0, 0x0000 },
+        { L"Subset", 6, 0x22D0, 0x0000 },
+        { L"SubsetEqual", 11, 0x2286, 0x0000 },
+        { L"Succeeds", 8, 0x227B, 0x0000 },
+        { L"SucceedsEqual", 13, 0x2AB0, 0x0000 },
+        { L"SucceedsSlantEqual", 18, 0x227D, 0x0000 },
+        { L"SucceedsTilde", 13, 0x227F, 0x0000 },
+        { L"SuchThat", 8, 0x220B, 0x0000 },
+        { L"Sum", 3, 0x2211, 0x0000 },
+        { L"Sup", 3, 0x22D1, 0x0000 },
+        { L"Superset", 8, 0x2283, 0x0000 },
+        { L"SupersetEqual", 13, 0x2287, 0x0000 },
+        { L"Supset", 6, 0x22D1, 0x0000 },
+        { L"THORN", 5, 0x00DE, 0x0000 },
+        { L"TRADE", 5, 0x2122, 0x0000 },
+        { L"TSHcy", 5, 0x040B, 0x0000 },
+        { L"TScy", 4, 0x0426, 0x0000 },
+        { L"Tab", 3, 0x0009, 0x0000 },
+        { L"Tau", 3, 0x03A4, 0x0000 },
+        { L"Tcaron", 6, 0x0164, 0x0000 },
+        { L"Tcedil", 6, 0x0162, 0x0000 },
+        { L"Tcy", 3, 0x0422, 0x0000 },
+        { L"Tfr", 3, 0x1D517, 0x0000 },
+        { L"Therefore", 9, 0x2234, 0x0000 },
+        { L"Theta", 5, 0x0398, 0x0000 },
+        { L"ThickSpace", 10, 0x205F, 0x200A },
+        { L"ThinSpace", 9, 0x2009, 0x0000 },
+        { L"Tilde", 5, 0x223C, 0x0000 },
+        { L"TildeEqual", 10, 0x2243, 0x0000 },
+        { L"TildeFullEqual", 14, 0x2245, 0x0000 },
+        { L"TildeTilde", 10, 0x2248, 0x0000 },
+        { L"Topf", 4, 0x1D54B, 0x0000 },
+        { L"TripleDot", 9, 0x20DB, 0x0000 },
+        { L"Tscr", 4, 0x1D4AF, 0x0000 },
+        { L"Tstrok", 6, 0x0166, 0x0000 },
+        { L"Uacute", 6, 0x00DA, 0x0000 },
+        { L"Uarr", 4, 0x219F, 0x0000 },
+        { L"Uarrocir", 8, 0x2949, 0x0000 },
+        { L"Ubrcy", 5, 0x040E, 0x0000 },
+        { L"Ubreve", 6, 0x016C, 0x0000 },
+        { L"Ucirc", 5, 0x00DB, 0x0000 },
+        { L"Ucy", 3, 0x0423, 0x0000 },
+        { L"Udblac", 6, 0x0170, 0x0000 },
+        { L"Ufr", 3, 0x1D518, 0x0000 },
+        { L"Ugrave", 6, 0x00D9, 0x0000 },
+        { L"Umacr", 5, 0x016A, 0x0000 },
+        { L"UnderBar", 8, 0x005F, 0x0000 },
+        { L"UnderBrace", 10, 0x23DF, 0x0000 },
+        { L"UnderBracket", 12, 0x23B5, 0x0000 },
+        { L"UnderParenthesis", 16, 0x23DD, 0x0000 },
+        { L"Union", 5, 0x22C3, 0x0000 },
+        { L"UnionPlus", 9, 0x228E, 0x0000 },
+        { L"Uogon", 5, 0x0172, 0x0000 },
+        { L"Uopf", 4, 0x1D54C, 0x0000 },
+        { L"UpArrow", 7, 0x2191, 0x0000 },
+        { L"UpArrowBar", 10, 0x2912, 0x0000 },
+        { L"UpArrowDownArrow", 16, 0x21C5, 0x0000 },
+        { L"UpDownArrow", 11, 0x2195, 0x0000 },
+        { L"UpEquilibrium", 13, 0x296E, 0x0000 },
+        { L"UpTee", 5, 0x22A5, 0x0000 },
+        { L"UpTeeArrow", 10, 0x21A5, 0x0000 },
+        { L"Uparrow", 7, 0x21D1, 0x0000 },
+        { L"Updownarrow", 11, 0x21D5, 0x0000 },
+        { L"UpperLeftArrow", 14, 0x2196, 0x0000 },
+        { L"UpperRightArrow", 15, 0x2197, 0x0000 },
+        { L"Upsi", 4, 0x03D2, 0x0000 },
+        { L"Upsilon", 7, 0x03A5, 0x0000 },
+        { L"Uring", 5, 0x016E, 0x0000 },
+        { L"Uscr", 4, 0x1D4B0, 0x0000 },
+        { L"Utilde", 6, 0x0168, 0x0000 },
+        { L"Uuml", 4, 0x00DC, 0x0000 },
+        { L"VDash", 5, 0x22AB, 0x0000 },
+        { L"Vbar", 4, 0x2AEB, 0x0000 },
+        { L"Vcy", 3, 0x0412, 0x0000 },
+        { L"Vdash", 5, 0x22A9, 0x0000 },
+        { L"Vdashl", 6, 0x2AE6, 0x0000 },
+        { L"Vee", 3, 0x22C1, 0x0000 },
+        { L"Verbar", 6, 0x2016, 0x0000 },
+        { L"Vert", 4, 0x2016, 0x0000 },
+        { L"VerticalBar", 11, 0x2223, 0x0000 },
+        { L"VerticalLine", 12, 0x007C, 0x0000 },
+        { L"VerticalSeparator", 17, 0x2758, 0x0000 },
+        { L"VerticalTilde", 13, 0x2240, 0x0000 },
+        { L"VeryThinSpace", 13, 0x200A, 0x0000 },
+        { L"Vfr", 3, 0x1D519, 0x0000 },
+        { L"Vopf", 4, 0x1D54D, 0x0000 },
+        { L"Vscr", 4, 0x1D4B1, 0x0000 },
+        { L"Vvdash", 6, 0x22AA, 0x0000 },
+        { L"Wcirc", 5, 0x0174, 0x0000 },
+        { L"Wedge", 5, 0x22C0, 0x0000 },
+        { L"Wfr", 3, 0x1D51A, 0x0000 },
+        { L"Wopf", 4, 0x1D54E, 0x0000 },
+        { L"Wscr", 4, 0x1D4B2, 0x0000 },
+        { L"Xfr", 3, 0x1D51B, 0x0000 },
+        { L"Xi", 2, 0x039E, 0x0000 },
+        { L"Xopf", 4, 0x1D54F, 0x0000 },
+        { L"Xscr", 4, 0x1D4B3, 0x0000 },
+        { L"YAcy", 4, 0x042F, 0x0000 },
+        { L"YIcy", 4, 0x0407, 0x0000 },
+        { L"YUcy", 4, 0x042E, 0x0000 },
+        { L"Yacute", 6, 0x00DD, 0x0000 },
+        { L"Ycirc", 5, 0x0176, 0x0000 },
+        { L"Ycy", 3, 0x042B, 0x0000 },
+        { L"Yfr", 3, 0x1D51C, 0x0000 },
+        { L"Yopf", 4, 0x1D550, 0x0000 },
+        { L"Yscr", 4, 0x1D4B4, 0x0000 },
+        { L"Yuml", 4, 0x0178, 0x0000 },
+        { L"ZHcy", 4, 0x0416, 0x0000 },
+        { L"Zacute", 6, 0x0179, 0x0000 },
+        { L"Zcaron", 6, 0x017D, 0x0000 },
+        { L"Zcy", 3, 0x0417, 0x0000 },
+        { L"Zdot", 4, 0x017B, 0x0000 },
+        { L"ZeroWidthSpace", 14, 0x200B, 0x0000 },
+        { L"Zeta", 4, 0x0396, 0x0000 },
+        { L"Zfr", 3, 0x2128, 0x0000 },
+        { L"Zopf", 4, 0x2124, 0x0000 },
+        { L"Zscr", 4, 0x1D4B5, 0x0000 },
+        { L"aacute", 6, 0x00E1, 0x0000 },
+        { L"abreve", 6, 0x0103, 0x0000 },
+        { L"ac", 2, 0x223E, 0x0000 },
+        { L"acE", 3, 0x223E, 0x0333 },
+        { L"acd", 3, 0x223F, 0x0000 },
+        { L"acirc", 5, 0x00E2, 0x0000 },
+        { L"acute", 5, 0x00B4, 0x0000 },
+        { L"acy", 3, 0x0430, 0x0000 },
+        { L"aelig", 5, 0x00E6, 0x0000 },
+        { L"af", 2, 0x2061, 0x0000 },
+        { L"afr", 3, 0x1D51E, 0x0000 },
+        { L"agrave", 6, 0x00E0, 0x0000 },
+        { L"alefsym", 7, 0x2135, 0x0000 },
+        { L"aleph", 5, 0x2135, 0x0000 },
+        { L"alpha", 5, 0x03B1, 0x0000 },
+        { L"amacr", 5, 0x0101, 0x0000 },
+        { L"amalg", 5, 0x2A3F, 0x0000 },
+        { L"amp", 3, 0x0026, 0x0000 },
+        { L"and", 3, 0x2227, 0x0000 },
+        { L"andand", 6, 0x2A55, 0x0000 },
+        { L"andd", 4, 0x2A5C, 0x0000 },
+        { L"andslope", 8, 0x2A58, 0x0000 },
+        { L"andv", 4, 0x2A5A, 0x0000 },
+        { L"ang", 3, 0x2220, 0x0000 },
+        { L"ange", 4, 0x29A4, 0x0000 },
+        { L"angle", 5, 0x2220, 0x0000 },
+        { L"angmsd", 6, 0x2221, 0x0000 },
+        { L"angmsdaa", 8, 0x29A8, 0x0000 },
+        { L"angmsdab", 8, 0x29A9, 0x0000 },
+        { L"angmsdac", 8, 0x29AA, 0x0000 },
+        { L"angmsdad", 8, 0x29AB, 0x0000 },
+        { L"angmsdae", 8, 0x29AC, 0x0000 },
+        { L"angmsdaf", 8, 0x29AD, 0x0000 },
+        { L"angmsdag", 8, 0x29AE, 0x0000 },
+        { L"angmsdah", 8, 0x29AF, 0x0000 },
+        { L"angrt", 5, 0x221F, 0x0000 },
+        { L"angrtvb", 7, 0x22BE, 0x0000 },
+        { L"angrtvbd", 8, 0x299D, 0x0000 },
+        { L"angsph", 6, 0x2222, 0x0000 },
+        { L"angst", 5, 0x00C5, 0x0000 },
+        { L"angzarr", 7, 0x237C, 0x0000 },
+        { L"aogon", 5, 0x0105, 0x0000 },
+        { L"aopf", 4, 0x1D552, 0x0000 },
+        { L"ap", 2, 0x2248, 0x0000 },
+        { L"apE", 3, 0x2A70, 0x0000 },
+        { L"apacir", 6, 0x2A6F, 0x0000 },
+        { L"ape", 3, 0x224A, 0x0000 },
+        { L"apid", 4, 0x224B, 0x0000 },
+        { L"apos", 4, 0x0027, 0x0000 },
+        { L"approx", 6, 0x2248, 0x0000 },
+        { L"approxeq", 8, 0x224A, 0x0000 },
+        { L"aring", 5, 0x00E5, 0x0000 },
+        { L"ascr", 4, 0x1D4B6, 0x0000 },
+        { L"ast", 3, 0x002A, 0x0000 },
+        { L"asymp", 5, 0x2248, 0x0000 },
+        { L"asympeq", 7, 0x224D, 0x0000 },
+        { L"atilde", 6, 0x00E3, 0x0000 },
+        { L"auml", 4, 0x00E4, 0x0000 },
+        { L"awconint", 8, 0x2233, 0x0000 },
+        { L"awint", 5, 0x2A11, 0x0000 },
+        { L"bNot", 4, 0x2AED, 0x0000 },
+        { L"backcong", 8, 0x224C, 0x0000 },
+        { L"backepsilon", 11, 0x03F6, 0x0000 },
+        { L"backprime", 9, 0x2035, 0x0000 },
+        { L"backsim", 7, 0x223D, 0x0000 },
+        { L"backsimeq", 9, 0x22CD, 0x0000 },
+        { L"barvee", 6, 0x22BD, 0x0000 },
+        { L"barwed", 6, 0x2305, 0x0000 },
+        { L"barwedge", 8, 0x2305, 0x0000 },
+        { L"bbrk", 4, 0x23B5, 0x0000 },
+        { L"bbrktbrk", 8, 0x23B6, 0x0000 },
+        { L"bcong", 5, 0x224C, 0x0000 },
+        { L"bcy", 3, 0x0431, 0x0000 },
+        { L"bdquo", 5, 0x201E, 0x0000 },
+        { L"becaus", 6, 0x2235, 0x0000 },
+        { L"because", 7, 0x2235, 0x0000 },
+        { L"bemptyv", 7, 0x29B0, 0x0000 },
+        { L"bepsi", 5, 0x03F6, 0x0000 },
+        { L"bernou", 6, 0x212C, 0x0000 },
+        { L"beta", 4, 0x03B2, 0x0000 },
+        { L"beth", 4, 0x2136, 0x0000 },
+        { L"between", 7, 0x226C, 0x0000 },
+        { L"bfr", 3, 0x1D51F, 0x0000 },
+        { L"bigcap", 6, 0x22C2, 0x0000 },
+        { L"bigcirc", 7, 0x25EF, 0x0000 },
+        { L"bigcup", 6, 0x22C3, 0x0000 },
+        { L"bigodot", 7, 0x2A00, 0x0000 },
+        { L"bigoplus", 8, 0x2A01, 0x0000 },
+        { L"bigotimes", 9, 0x2A02, 0x0000 },
+        { L"bigsqcup", 8, 0x2A06, 0x0000 },
+        { L"bigstar", 7, 0x2605, 0x0000 },
+        { L"bigtriangledown", 15, 0x25BD, 0x0000 },
+        { L"bigtriangleup", 13, 0x25B3, 0x0000 },
+        { L"biguplus", 8, 0x2A04, 0x0000 },
+        { L"bigvee", 6, 0x22C1, 0x0000 },
+        { L"bigwedge", 8, 0x22C0, 0x0000 },
+        { L"bkarow", 6, 0x290D, 0x0000 },
+        { L"blacklozenge", 12, 0x29EB, 0x0000 },
+        { L"blacksquare", 11, 0x25AA, 0x0000 },
+        { L"blacktriangle", 13, 0x25B4, 0x0000 },
+        { L"blacktriangledown", 17, 0x25BE, 0x0000 },
+        { L"blacktriangleleft", 17, 0x25C2, 0x0000 },
+        { L"blacktriangleright", 18, 0x25B8, 0x0000 },
+        { L"blank", 5, 0x2423, 0x0000 },
+        { L"blk12", 5, 0x2592, 0x0000 },
+        { L"blk14", 5, 0x2591, 0x0000 },
+        { L"blk34", 5, 0x2593, 0x0000 },
+        { L"block", 5, 0x2588, 0x0000 },
+        { L"bne", 3, 0x003D, 0x20E5 },
+        { L"bnequiv", 7, 0x2261, 0x20E5 },
+        { L"bnot", 4, 0x2310, 0x0000 },
+        { L"bopf", 4, 0x1D553, 0x0000 },
+        { L"bot", 3, 0x22A5, 0x0000 },
+        { L"bottom", 6, 0x22A5, 0x0000 },
+        { L"bowtie", 6, 0x22C8, 0x0000 },
+        { L"boxDL", 5, 0x2557, 0x0000 },
+        { L"boxDR", 5, 0x2554, 0x0000 },
+        { L"boxDl", 5, 0x2556, 0x0000 },
+        { L"boxDr", 5, 0x2553, 0x0000 },
+        { L"boxH", 4, 0x2550, 0x0000 },
+        { L"boxHD", 5, 0x2566, 0x0000 },
+        { L"boxHU", 5, 0x2569, 0x0000 },
+        { L"boxHd", 5, 0x2564, 0x0000 },
+        { L"boxHu", 5, 0x2567, 0x0000 },
+        { L"boxUL", 5, 0x255D, 0x0000 },
+        { L"boxUR", 5, 0x255A, 0x0000 },
+        { L"boxUl", 5, 0x255C, 0x0000 },
+        { L"boxUr", 5, 0x2559, 0x0000 },
+        { L"boxV", 4, 0x2551, 0x0000 },
+        { L"boxVH", 5, 0x256C, 0x0000 },
+        { L"boxVL", 5, 0x2563, 0x0000 },
+        { L"boxVR", 5, 0x2560, 0x0000 },
+        { L"boxVh", 5, 0x256B, 0x0000 },
+        { L"boxVl", 5, 0x2562, 0x0000 },
+        { L"boxVr", 5, 0x255F, 0x0000 },
+        { L"boxbox", 6, 0x29C9, 0x0000 },
+        { L"boxdL", 5, 0x2555, 0x0000 },
+        { L"boxdR", 5, 0x2552, 0x0000 },
+        { L"boxdl", 5, 0x2510, 0x0000 },
+        { L"boxdr", 5, 0x250C, 0x0000 },
+        { L"boxh", 4, 0x2500, 0x0000 },
+        { L"boxhD", 5, 0x2565, 0x0000 },
+        { L"boxhU", 5, 0x2568, 0x0000 },
+        { L"boxhd", 5, 0x252C, 0x0000 },
+        { L"boxhu", 5, 0x2534, 0x0000 },
+        { L"boxminus", 8, 0x229F, 0x0000 },
+        { L"boxplus", 7, 0x229E, 0x0000 },
+        { L"boxtimes", 8, 0x22A0, 0x0000 },
+        { L"boxuL", 5, 0x255B, 0x0000 },
+        { L"boxuR", 5, 0x2558, 0x0000 },
+        { L"boxul", 5, 0x2518, 0x0000 },
+        { L"boxur", 5, 0x2514, 0x0000 },
+        { L"boxv", 4, 0x2502, 0x0000 },
+        { L"boxvH", 5, 0x256A, 0x0000 },
+        { L"boxvL", 5, 0x2561, 0x0000 },
+        { L"boxvR", 5, 0x255E, 0x0000 },
+        { L"boxvh", 5, 0x253C, 0x0000 },
+        { L"boxvl", 5, 0x2524, 0x0000 },
+        { L"boxvr", 5, 0x251C, 0x0000 },
+        { L"bprime", 6, 0x2035, 0x0000 },
+        { L"breve", 5, 0x02D8, 0x0000 },
+        { L"brvbar", 6, 0x00A6, 0x0000 },
+        { L"bscr", 4, 0x1D4B7, 0x0000 },
+        { L"bsemi", 5, 0x204F, 0x0000 },
+        { L"bsim", 4, 0x223D, 0x0000 },
+        { L"bsime", 5, 0x22CD, 0x0000 },
+        { L"bsol", 4, 0x005C, 0x0000 },
+        { L"bsolb", 5, 0x29C5, 0x0000 },
+        { L"bsolhsub", 8, 0x27C8, 0x0000 },
+        { L"bull", 4, 0x2022, 0x0000 },
+        { L"bullet", 6, 0x2022, 0x0000 },
+        { L"bump", 4, 0x224E, 0x0000 },
+        { L"bumpE", 5, 0x2AAE, 0x0000 },
+        { L"bumpe", 5, 0x224F, 0x0000 },
+        { L"bumpeq", 6, 0x224F, 0x0000 },
+        { L"cacute", 6, 0x0107, 0x0000 },
+        { L"cap", 3, 0x2229, 0x0000 },
+        { L"capand", 6, 0x2A44, 0x0000 },
+        { L"capbrcup", 8, 0x2A49, 0x0000 },
+        { L"capcap", 6, 0x2A4B, 0x0000 },
+        { L"capcup", 6, 0x2A47, 0x0000 },
+        { L"capdot", 6, 0x2A40, 0x0000 },
+        { L"caps", 4, 0x2229, 0xFE00 },
+        { L"caret", 5, 0x2041, 0x0000 },
+        { L"caron", 5, 0x02C7, 0x0000 },
+        { L"ccaps", 5, 0x2A4D, 0x0000 },
+        { L"ccaron", 6, 0x010D, 0x0000 },
+        { L"ccedil", 6, 0x00E7, 0x0000 },
+        { L"ccirc", 5, 0x0109, 0x0000 },
+        { L"ccups", 5, 0x2A4C, 0x0000 },
+        { L"ccupssm", 7, 0x2A50, 0x0000 },
+        { L"cdot", 4, 0x010B, 0x0000 },
+        { L"cedil", 5, 0x00B8, 0x0000 },
+        { L"cemptyv", 7, 0x29B2, 0x0000 },
+        { L"cent", 4, 0x00A2, 0x0000 },
+        { L"centerdot", 9, 0x00B7, 0x0000 },
+        { L"cfr", 3, 0x1D520, 0x0000 },
+        { L"chcy", 4, 0x0447, 0x0000 },
+        { L"check", 5, 0x2713, 0x0000 },
+        { L"checkmark", 9, 0x2713, 0x0000 },
+        { L"chi", 3, 0x03C7, 0x0000 },
+        { L"cir", 3, 0x25CB, 0x0000 },
+        { L"cirE", 4, 0x29C3, 0x0000 },
+        { L"circ", 4, 0x02C6, 0x0000 },
+        { L"circeq", 6, 0x2257, 0x0000 },
+        { L"circlearrowleft", 15, 0x21BA, 0x0000 },
+        { L"circlearrowright", 16, 0x21BB, 0x0000 },
+        { L"circledR", 8, 0x00AE, 0x0000 },
+        { L"circledS", 8, 0x24C8, 0x0000 },
+        { L"circledast", 10, 0x229B, 0x0000 },
+        { L"circledcirc", 11, 0x229A, 0x0000 },
+        { L"circleddash", 11, 0x229D, 0x0000 },
+        { L"cire", 4, 0x2257, 0x0000 },
+        { L"cirfnint", 8, 0x2A10, 0x0000 },
+        { L"cirmid", 6, 0x2AEF, 0x0000 },
+        { L"cirscir", 7, 0x29C2, 0x0000 },
+        { L"clubs", 5, 0x2663, 0x0000 },
+        { L"clubsuit", 8, 0x2663, 0x0000 },
+        { L"colon", 5, 0x003A, 0x0000 },
+        { L"colone", 6, 0x2254, 0x0000 },
+        { L"coloneq", 7, 0x2254, 0x0000 },
+        { L"comma", 5, 0x002C, 0x0000 },
+        { L"commat", 6, 0x0040, 0x0000 },
+        { L"comp", 4, 0x2201, 0x0000 },
+        { L"compfn", 6, 0x2218, 0x0000 },
+        { L"complement", 10, 0x2201, 0x0000 },
+        { L"complexes", 9, 0x2102, 0x0000 },
+        { L"cong", 4, 0x2245, 0x0000 },
+        { L"congdot", 7, 0x2A6D, 0x0000 },
+        { L"conint", 6, 0x222E, 0x0000 },
+        { L"copf", 4, 0x1D554, 0x0000 },
+        { L"coprod", 6, 0x2210, 0x0000 },
+        { L"copy", 4, 0x00A9, 0x0000 },
+        { L"copysr", 6, 0x2117, 0x0000 },
+        { L"crarr", 5, 0x21B5, 0x0000 },
+        { L"cross", 5, 0x2717, 0x0000 },
+        { L"cscr", 4, 0x1D4B8, 0x0000 },
+        { L"csub", 4, 0x2ACF, 0x0000 },
+        { L"csube", 5, 0x2AD1, 0x0000 },
+        { L"csup", 4, 0x2AD0, 0x0000 },
+        { L"csupe", 5, 0x2AD2, 0x0000 },
+        { L"ctdot", 5, 0x22EF, 0x0000 },
+        { L"cudarrl", 7, 0x2938, 0x0000 },
+        { L"cudarrr", 7, 0x2935, 0x0000 },
+        { L"cuepr", 5, 0x22DE, 0x0000 },
+        { L"cuesc", 5, 0x22DF, 0x0000 },
+        { L"cularr", 6, 0x21B6, 0x0000 },
+        { L"cularrp", 7, 0x293D, 0x0000 },
+        { L"cup", 3, 0x222A, 0x0000 },
+        { L"cupbrcap", 8, 0x2A48, 0x0000 },
+        { L"cupcap", 6, 0x2A46, 0x0000 },
+        { L"cupcup", 6, 0x2A4A, 0x0000 },
+        { L"cupdot", 6, 0x228D, 0x0000 },
+        { L"cupor", 5, 0x2A45, 0x0000 },
+        { L"cups", 4, 0x222A, 0xFE00 },
+        { L"curarr", 6, 0x21B7, 0x0000 },
+        { L"curarrm", 7, 0x293C, 0x0000 },
+        { L"curlyeqprec", 11, 0x22DE, 0x0000 },
+        { L"curlyeqsucc", 11, 0x22DF, 0x0000 },
+        { L"curlyvee", 8, 0x22CE, 0x0000 },
+        { L"curlywedge", 10, 0x22CF, 0x0000 },
+        { L"curren", 6, 0x00A4, 0x0000 },
+        { L"curvearrowleft", 14, 0x21B6, 0x0000 },
+        { L"curvearrowright", 15, 0x21B7, 0x0000 },
+        { L"cuvee", 5, 0x22CE, 0x0000 },
+        { L"cuwed", 5, 0x22CF, 0x0000 },
+        { L"cwconint", 8, 0x2232, 0x0000 },
+        { L"cwint", 5, 0x2231, 0x0000 },
+        { L"cylcty", 6, 0x232D, 0x0000 },
+        { L"dArr", 4, 0x21D3, 0x0000 },
+        { L"dHar", 4, 0x2965, 0x0000 },
+        { L"dagger", 6, 0x2020, 0x0000 },
+        { L"daleth", 6, 0x2138, 0x0000 },
+        { L"darr", 4, 0x2193, 0x0000 },
+        { L"dash", 4, 0x2010, 0x0000 },
+        { L"dashv", 5, 0x22A3, 0x0000 },
+        { L"dbkarow", 7, 0x290F, 0x0000 },
+        { L"dblac", 5, 0x02DD, 0x0000 },
+        { L"dcaron", 6, 0x010F, 0x0000 },
+        { L"dcy", 3, 0x0434, 0x0000 },
+        { L"dd", 2, 0x2146, 0x0000 },
+        { L"ddagger", 7, 0x2021, 0x0000 },
+        { L"ddarr", 5, 0x21CA, 0x0000 },
+        { L"ddotseq", 7, 0x2A77, 0x0000 },
+        { L"deg", 3, 0x00B0, 0x0000 },
+        { L"delta", 5, 0x03B4, 0x0000 },
+        { L"demptyv", 7, 0x29B1, 0x0000 },
+        { L"dfisht", 6, 0x297F, 0x0000 },
+        { L"dfr", 3, 0x1D521, 0x0000 },
+        { L"dharl", 5, 0x21C3, 0x0000 },
+        { L"dharr", 5, 0x21C2, 0x0000 },
+        { L"diam", 4, 0x22C4, 0x0000 },
+        { L"diamond", 7, 0x22C4, 0x0000 },
+        { L"diamondsuit", 11, 0x2666, 0x0000 },
+        { L"diams", 5, 0x2666, 0x0000 },
+        { L"die", 3, 0x00A8, 0x0000 },
+        { L"digamma", 7, 0x03DD, 0x0000 },
+        { L"disin", 5, 0x22F2, 0x0000 },
+        { L"div", 3, 0x00F7, 0x0000 },
+        { L"divide", 6, 0x00F7, 0x0000 },
+        { L"divideontimes", 13, 0x22C7, 0x0000 },
+        { L"divonx", 6, 0x22C7, 0x0000 },
+        { L"djcy", 4, 0x0452, 0x0000 },
+        { L"dlcorn", 6, 0x231E, 0x0000 },
+        { L"dlcrop", 6, 0x230D, 0x0000 },
+        { L"dollar", 6, 0x0024, 0x0000 },
+        { L"dopf", 4, 0x1D555, 0x0000 },
+        { L"dot", 3, 0x02D9, 0x0000 },
+        { L"doteq", 5, 0x2250, 0x0000 },
+        { L"doteqdot", 8, 0x2251, 0x0000 },
+        { L"dotminus", 8, 0x2238, 0x0000 },
+        { L"dotplus", 7, 0x2214, 0x0000 },
+        { L"dotsquare", 9, 0x22A1, 0x0000 },
+        { L"doublebarwedge", 14, 0x2306, 0x0000 },
+        { L"downarrow", 9, 0x2193, 0x0000 },
+        { L"downdownarrows", 14, 0x21CA, 0x0000 },
+        { L"downharpoonleft", 15, 0x21C3, 0x0000 },
+        { L"downharpoonright", 16, 0x21C2, 0x0000 },
+        { L"drbkarow", 8, 0x2910, 0x0000 },
+        { L"drcorn", 6, 0x231F, 0x0000 },
+        { L"drcrop", 6, 0x230C, 0x0000 },
+        { L"dscr", 4, 0x1D4B9, 0x0000 },
+        { L"dscy", 4, 0x0455, 0x0000 },
+        { L"dsol", 4, 0x29F6, 0x0000 },
+        { L"dstrok", 6, 0x0111, 0x0000 },
+        { L"dtdot", 5, 0x22F1, 0x0000 },
+        { L"dtri", 4, 0x25BF, 0x0000 },
+        { L"dtrif", 5, 0x25BE, 0x0000 },
+        { L"duarr", 5, 0x21F5, 0x0000 },
+        { L"duhar", 5, 0x296F, 0x0000 },
+        { L"dwangle", 7, 0x29A6, 0x0000 },
+        { L"dzcy", 4, 0x045F, 0x0000 },
+        { L"dzigrarr", 8, 0x27FF, 0x0000 },
+        { L"eDDot", 5, 0x2A77, 0x0000 },
+        { L"eDot", 4, 0x2251, 0x0000 },
+        { L"eacute", 6, 0x00E9, 0x0000 },
+        { L"easter", 6, 0x2A6E, 0x0000 },
+        { L"ecaron", 6, 0x011B, 0x0000 },
+        { L"ecir", 4, 0x2256, 0x0000 },
+        { L"ecirc", 5, 0x00EA, 0x0000 },
+        { L"ecolon", 6, 0x2255, 0x0000 },
+        { L"ecy", 3, 0x044D, 0x0000 },
+        { L"edot", 4, 0x0117, 0x0000 },
+        { L"ee", 2, 0x2147, 0x0000 },
+        { L"efDot", 5, 0x2252, 0x0000 },
+        { L"efr", 3, 0x1D522, 0x0000 },
+        { L"eg", 2, 0x2A9A, 0x0000 },
+        { L"egrave", 6, 0x00E8, 0x0000 },
+        { L"egs", 3, 0x2A96, 0x0000 },
+        { L"egsdot", 6, 0x2A98, 0x0000 },
+        { L"el", 2, 0x2A99, 0x0000 },
+        { L"elinters", 8, 0x23E7, 0x0000 },
+        { L"ell", 3, 0x2113, 0x0000 },
+        { L"els", 3, 0x2A95, 0x0000 },
+        { L"elsdot", 6, 0x2A97, 0x0000 },
+        { L"emacr", 5, 0x0113, 0x0000 },
+        { L"empty", 5, 0x2205, 0x0000 },
+        { L"emptyset", 8, 0x2205, 0x0000 },
+        { L"emptyv", 6, 0x2205, 0x0000 },
+        { L"emsp", 4, 0x2003, 0x0000 },
+        { L"emsp13", 6, 0x2004, 0x0000 },
+        { L"emsp14", 6, 0x2005, 0x0000 },
+        { L"eng", 3, 0x014B, 0x0000 },
+        { L"ensp", 4, 0x2002, 0x0000 },
+        { L"eogon", 5, 0x0119, 0x0000 },
+        { L"eopf", 4, 0x1D556, 0x0000 },
+        { L"epar", 4, 0x22D5, 0x0000 },
+        { L"eparsl", 6, 0x29E3, 0x0000 },
+        { L"eplus", 5, 0x2A71, 0x0000 },
+        { L"epsi", 4, 0x03B5, 0x0000 },
+        { L"epsilon", 7, 0x03B5, 0x0000 },
+        { L"epsiv", 5, 0x03F5, 0x0000 },
+        { L"eqcirc", 6, 0x2256, 0x0000 },
+        { L"eqcolon", 7, 0x2255, 0x0000 },
+        { L"eqsim", 5, 0x2242, 0x0000 },
+        { L"eqslantgtr", 10, 0x2A96, 0x0000 },
+        { L"eqslantless", 11, 0x2A95, 0x0000 },
+        { L"equals", 6, 0x003D, 0x0000 },
+        { L"equest", 6, 0x225F, 0x0000 },
+        { L"equiv", 5, 0x2261, 0x0000 },
+        { L"equivDD", 7, 0x2A78, 0x0000 },
+        { L"eqvparsl", 8, 0x29E5, 0x0000 },
+        { L"erDot", 5, 0x2253, 0x0000 },
+        { L"erarr", 5, 0x2971, 0x0000 },
+        { L"escr", 4, 0x212F, 0x0000 },
+        { L"esdot", 5, 0x2250, 0x0000 },
+        { L"esim", 4, 0x2242, 0x0000 },
+        { L"eta", 3, 0x03B7, 0x0000 },
+        { L"eth", 3, 0x00F0, 0x0000 },
+        { L"euml", 4, 0x00EB, 0x0000 },
+        { L"euro", 4, 0x20AC, 0x0000 },
+        { L"excl", 4, 0x0021, 0x0000 },
+        { L"exist", 5, 0x2203, 0x0000 },
+        { L"expectation", 11, 0x2130, 0x0000 },
+        { L"exponentiale", 12, 0x2147, 0x0000 },
+        { L"fallingdotseq", 13, 0x2252, 0x0000 },
+        { L"fcy", 3, 0x0444, 0x0000 },
+        { L"female", 6, 0x2640, 0x0000 },
+        { L"ffilig", 6, 0xFB03, 0x0000 },
+        { L"fflig", 5, 0xFB00, 0x0000 },
+        { L"ffllig", 6, 0xFB04, 0x0000 },
+        { L"ffr", 3, 0x1D523, 0x0000 },
+        { L"filig", 5, 0xFB01, 0x0000 },
+        { L"fjlig", 5, 0x0066, 0x006A },
+        { L"flat", 4, 0x266D, 0x0000 },
+        { L"fllig", 5, 0xFB02, 0x0000 },
+        { L"fltns", 5, 0x25B1, 0x0000 },
+        { L"fnof", 4, 0x0192, 0x0000 },
+        { L"fopf", 4, 0x1D557, 0x0000 },
+        { L"forall", 6, 0x2200, 0x0000 },
+        { L"fork", 4, 0x22D4, 0x0000 },
+        { L"forkv", 5, 0x2AD9, 0x0000 },
+        { L"fpartint", 8, 0x2A0D, 0x0000 },
+        { L"frac12", 6, 0x00BD, 0x0000 },
+        { L"frac13", 6, 0x2153, 0x0000 },
+        { L"frac14", 6, 0x00BC, 0x0000 },
+        { L"frac15", 6, 0x2155, 0x0000 },
+        { L"frac16", 6, 0x2159, 0x0000 },
+        { L"frac18", 6, 0x215B, 0x0000 },
+        { L"frac23", 6, 0x2154, 0x0000 },
+        { L"frac25", 6, 0x2156, 0x0000 },
+        { L"frac34", 6, 0x00BE, 0x0000 },
+        { L"frac35", 6, 0x2157, 0x0000 },
+        { L"frac38", 6, 0x215C, 0x0000 },
+        { L"frac45", 6, 0x2158, 0x0000 },
+        { L"frac56", 6, 0x215A, 0x0000 },
+        { L"frac58", 6, 0x215D, 0x0000 },
+        { L"frac78", 6, 0x215E, 0x0000 },
+        { L"frasl", 5, 0x2044, 0x0000 },
+        { L"frown", 5, 0x2322, 0x0000 },
+        { L"fscr", 4, 0x1D4BB, 0x0000 },
+        { L"gE", 2, 0x2267, 0x0000 },
+        { L"gEl", 3, 0x2A8C, 0x0000 },
+        { L"gacute", 6, 0x01F5, 0x0000 },
+        { L"gamma", 5, 0x03B3, 0x0000 },
+        { L"gammad", 6, 0x03DD, 0x0000 },
+        { L"gap", 3, 0x2A86, 0x0000 },
+        { L"gbreve", 6, 0x011F, 0x0000 },
+        { L"gcirc", 5, 0x011D, 0x0000 },
+        { L"gcy", 3, 0x0433, 0x0000 },
+        { L"gdot", 4, 0x0121, 0x0000 },
+        { L"ge", 2, 0x2265, 0x0000 },
+        { L"gel", 3, 0x22DB, 0x0000 },
+        { L"geq", 3, 0x2265, 0x0000 },
+        { L"geqq", 4, 0x2267, 0x0000 },
+        { L"geqslant", 8, 0x2A7E, 0x0000 },
+        { L"ges", 3, 0x2A7E, 0x0000 },
+        { L"gescc", 5, 0x2AA9, 0x0000 },
+        { L"gesdot", 6, 0x2A80, 0x0000 },
+        { L"gesdoto", 7, 0x2A82, 0x0000 },
+        { L"gesdotol", 8, 0x2A84, 0x0000 },
+        { L"gesl", 4, 0x22DB, 0xFE00 },
+        { L"gesles", 6, 0x2A94, 0x0000 },
+        { L"gfr", 3, 0x1D524, 0x0000 },
+        { L"gg", 2, 0x226B, 0x0000 },
+        { L"ggg", 3, 0x22D9, 0x0000 },
+        { L"gimel", 5, 0x2137, 0x0000 },
+        { L"gjcy", 4, 0x0453, 0x0000 },
+        { L"gl", 2, 0x2277, 0x0000 },
+        { L"glE", 3, 0x2A92, 0x0000 },
+        { L"gla", 3, 0x2AA5, 0x0000 },
+        { L"glj", 3, 0x2AA4, 0x0000 },
+        { L"gnE", 3, 0x2269, 0x0000 },
+        { L"gnap", 4, 0x2A8A, 0x0000 },
+        { L"gnapprox", 8, 0x2A8A, 0x0000 },
+        { L"gne", 3, 0x2A88, 0x0000 },
+        { L"gneq", 4, 0x2A88, 0x0000 },
+        { L"gneqq", 5, 0x2269, 0x0000 },
+        { L"gnsim", 5, 0x22E7, 0x0000 },
+        { L"gopf", 4, 0x1D558, 0x0000 },
+        { L"grave", 5, 0x0060, 0x0000 },
+        { L"gscr", 4, 0x210A, 0x0000 },
+        { L"gsim", 4, 0x2273, 0x0000 },
+        { L"gsime", 5, 0x2A8E, 0x0000 },
+        { L"gsiml", 5, 0x2A90, 0x0000 },
+        { L"gt", 2, 0x003E, 0x0000 },
+        { L"gtcc", 4, 0x2AA7, 0x0000 },
+        { L"gtcir", 5, 0x2A7A, 0x0000 },
+        { L"gtdot", 5, 0x22D7, 0x0000 },
+        { L"gtlPar", 6, 0x2995, 0x0000 },
+        { L"gtquest", 7, 0x2A7C, 0x0000 },
+        { L"gtrapprox", 9, 0x2A86, 0x0000 },
+        { L"gtrarr", 6, 0x2978, 0x0000 },
+        { L"gtrdot", 6, 0x22D7, 0x0000 },
+        { L"gtreqless", 9, 0x22DB, 0x0000 },
+        { L"gtreqqless", 10, 0x2A8C, 0x0000 },
+        { L"gtrless", 7, 0x2277, 0x0000 },
+        { L"gtrsim", 6, 0x2273, 0x0000 },
+        { L"gvertneqq", 9, 0x2269, 0xFE00 },
+        { L"gvnE", 4, 0x2269, 0xFE00 },
+        { L"hArr", 4, 0x21D4, 0x0000 },
+        { L"hairsp", 6, 0x200A, 0x0000 },
+        { L"half", 4, 0x00BD, 0x0000 },
+        { L"hamilt", 6, 0x210B, 0x0000 },
+        { L"hardcy", 6, 0x044A, 0x0000 },
+        { L"harr", 4, 0x2194, 0x0000 },
+        { L"harrcir", 7, 0x2948, 0x0000 },
+        { L"harrw", 5, 0x21AD, 0x0000 },
+        { L"hbar", 4, 0x210F, 0x0000 },
+        { L"hcirc", 5, 0x0125, 0x0000 },
+        { L"hearts", 6, 0x2665, 0x0000 },
+        { L"heartsuit", 9, 0x2665, 0x0000 },
+        { L"hellip", 6, 0x2026, 0x0000 },
+        { L"hercon", 6, 0x22B9, 0x0000 },
+        { L"hfr", 3, 0x1D525, 0x0000 },
+        { L"hksearow", 8, 0x2925, 0x0000 },
+        { L"hkswarow", 8, 0x2926, 0x0000 },
+        { L"hoarr", 5, 0x21FF, 0x0000 },
+        { L"homtht", 6, 0x223B, 0x0000 },
+        { L"hookleftarrow", 13, 0x21A9, 0x0000 },
+        { L"hookrightarrow", 14, 0x21AA, 0x0000 },
+        { L"hopf", 4, 0x1D559, 0x0000 },
+        { L"horbar", 6, 0x2015, 0x0000 },
+        { L"hscr", 4, 0x1D4BD, 0x0000 },
+        { L"hslash", 6, 0x210F, 0x0000 },
+        { L"hstrok", 6, 0x0127, 0x0000 },
+        { L"hybull", 6, 0x2043, 0x0000 },
+        { L"hyphen", 6, 0x2010, 0x0000 },
+        { L"iacute", 6, 0x00ED, 0x0000 },
+        { L"ic", 2, 0x2063, 0x0000 },
+        { L"icirc", 5, 0x00EE, 0x0000 },
+        { L"icy", 3, 0x0438, 0x0000 },
+        { L"iecy", 4, 0x0435, 0x0000 },
+        { L"iexcl", 5, 0x00A1, 0x0000 },
+        { L"iff", 3, 0x21D4, 0x0000 },
+        { L"ifr", 3, 0x1D526, 0x0000 },
+        { L"igrave", 6, 0x00EC, 0x0000 },
+        { L"ii", 2, 0x2148, 0x0000 },
+        { L"iiiint", 6, 0x2A0C, 0x0000 },
+        { L"iiint", 5, 0x222D, 0x0000 },
+        { L"iinfin", 6, 0x29DC, 0x0000 },
+        { L"iiota", 5, 0x2129, 0x0000 },
+        { L"ijlig", 5, 0x0133, 0x0000 },
+        { L"imacr", 5, 0x012B, 0x0000 },
+        { L"image", 5, 0x2111, 0x0000 },
+        { L"imagline", 8, 0x2110, 0x0000 },
+        { L"imagpart", 8, 0x2111, 0x0000 },
+        { L"imath", 5, 0x0131, 0x0000 },
+        { L"imof", 4, 0x22B7, 0x0000 },
+        { L"imped", 5, 0x01B5, 0x0000 },
+        { L"in", 2, 0x2208, 0x0000 },
+        { L"incare", 6, 0x2105, 0x0000 },
+        { L"infin", 5, 0x221E, 0x0000 },
+        { L"infintie", 8, 0x29DD, 0x0000 },
+        { L"inodot", 6, 0x0131, 0x0000 },
+        { L"int", 3, 0x222B, 0x0000 },
+        { L"intcal", 6, 0x22BA, 0x0000 },
+        { L"integers", 8, 0x2124, 0x0000 },
+        { L"intercal", 8, 0x22BA, 0x0000 },
+        { L"intlarhk", 8, 0x2A17, 0x0000 },
+        { L"intprod", 7, 0x2A3C, 0x0000 },
+        { L"iocy", 4, 0x0451, 0x0000 },
+        { L"iogon", 5, 0x012F, 0x0000 },
+        { L"iopf", 4, 0x1D55A, 0x0000 },
+        { L"iota", 4, 0x03B9, 0x0000 },
+        { L"iprod", 5, 0x2A3C, 0x0000 },
+        { L"iquest", 6, 0x00BF, 0x0000 },
+        { L"iscr", 4, 0x1D4BE, 0x0000 },
+        { L"isin", 4, 0x2208, 0x0000 },
+        { L"isinE", 5, 0x22F9, 0x0000 },
+        { L"isindot", 7, 0x22F5, 0x0000 },
+        { L"isins", 5, 0x22F4, 0x0000 },
+        { L"isinsv", 6, 0x22F3, 0x0000 },
+        { L"isinv", 5, 0x2208, 0x0000 },
+        { L"it", 2, 0x2062, 0x0000 },
+        { L"itilde", 6, 0x0129, 0x0000 },
+        { L"iukcy", 5, 0x0456, 0x0000 },
+        { L"iuml", 4, 0x00EF, 0x0000 },
+        { L"jcirc", 5, 0x0135, 0x0000 },
+        { L"jcy", 3, 0x0439, 0x0000 },
+        { L"jfr", 3, 0x1D527, 0x0000 },
+        { L"jmath", 5, 0x0237, 0x0000 },
+        { L"jopf", 4, 0x1D55B, 0x0000 },
+        { L"jscr", 4, 0x1D4BF, 0x0000 },
+        { L"jsercy", 6, 0x0458, 0x0000 },
+        { L"jukcy", 5, 0x0454, 0x0000 },
+        { L"kappa", 5, 0x03BA, 0x0000 },
+        { L"kappav", 6, 0x03F0, 0x0000 },
+        { L"kcedil", 6, 0x0137, 0x0000 },
+        { L"kcy", 3, 0x043A, 0x0000 },
+        { L"kfr", 3, 0x1D528, 0x0000 },
+        { L"kgreen", 6, 0x0138, 0x0000 },
+        { L"khcy", 4, 0x0445, 0x0000 },
+        { L"kjcy", 4, 0x045C, 0x0000 },
+        { L"kopf", 4, 0x1D55C, 0x0000 },
+        { L"kscr", 4, 0x1D4C0, 0x0000 },
+        { L"lAarr", 5, 0x21DA, 0x0000 },
+        { L"lArr", 4, 0x21D0, 0x0000 },
+        { L"lAtail", 6, 0x291B, 0x0000 },
+        { L"lBarr", 5, 0x290E, 0x0000 },
+        { L"lE", 2, 0x2266, 0x0000 },
+        { L"lEg", 3, 0x2A8B, 0x0000 },
+        { L"lHar", 4, 0x2962, 0x0000 },
+        { L"lacute", 6, 0x013A, 0x0000 },
+        { L"laemptyv", 8, 0x29B4, 0x0000 },
+        { L"lagran", 6, 0x2112, 0x0000 },
+        { L"lambda", 6, 0x03BB, 0x0000 },
+        { L"lang", 4, 0x27E8, 0x0000 },
+        { L"langd", 5, 0x2991, 0x0000 },
+        { L"langle", 6, 0x27E8, 0x0000 },
+        { L"lap", 3, 0x2A85, 0x0000 },
+        { L"laquo", 5, 0x00AB, 0x0000 },
+        { L"larr", 4, 0x2190, 0x0000 },
+        { L"larrb", 5, 0x21E4, 0x0000 },
+        { L"larrbfs", 7, 0x291F, 0x0000 },
+        { L"larrfs", 6, 0x291D, 0x0000 },
+        { L"larrhk", 6, 0x21A9, 0x0000 },
+        { L"larrlp", 6, 0x21AB, 0x0000 },
+        { L"larrpl", 6, 0x2939, 0x0000 },
+        { L"larrsim", 7, 0x2973, 0x0000 },
+        { L"larrtl", 6, 0x21A2, 0x0000 },
+        { L"lat", 3, 0x2AAB, 0x0000 },
+        { L"latail", 6, 0x2919, 0x0000 },
+        { L"late", 4, 0x2AAD, 0x0000 },
+        { L"lates", 5, 0x2AAD, 0xFE00 },
+        { L"lbarr", 5, 0x290C, 0x0000 },
+        { L"lbbrk", 5, 0x2772, 0x0000 },
+        { L"lbrace", 6, 0x007B, 0x0000 },
+        { L"lbrack", 6, 0x005B, 0x0000 },
+        { L"lbrke", 5, 0x298B, 0x0000 },
+        { L"lbrksld", 7, 0x298F, 0x0000 },
+        { L"lbrkslu", 7, 0x298D, 0x0000 },
+        { L"lcaron", 6, 0x013E, 0x0000 },
+        { L"lcedil", 6, 0x013C, 0x0000 },
+        { L"lceil", 5, 0x2308, 0x0000 },
+        { L"lcub", 4, 0x007B, 0x0000 },
+        { L"lcy", 3, 0x043B, 0x0000 },
+        { L"ldca", 4, 0x2936, 0x0000 },
+        { L"ldquo", 5, 0x201C, 0x0000 },
+        { L"ldquor", 6, 0x201E, 0x0000 },
+        { L"ldrdhar", 7, 0x2967, 0x0000 },
+        { L"ldrushar", 8, 0x294B, 0x0000 },
+        { L"ldsh", 4, 0x21B2, 0x0000 },
+        { L"le", 2, 0x2264, 0x0000 },
+        { L"leftarrow", 9, 0x2190, 0x0000 },
+        { L"leftarrowtail", 13, 0x21A2, 0x0000 },
+        { L"leftharpoondown", 15, 0x21BD, 0x0000 },
+        { L"leftharpoonup", 13, 0x21BC, 0x0000 },
+        { L"leftleftarrows", 14, 0x21C7, 0x0000 },
+        { L"leftrightarrow", 14, 0x2194, 0x0000 },
+        { L"leftrightarrows", 15, 0x21C6, 0x0000 },
+        { L"leftrightharpoons", 17, 0x21CB, 0x0000 },
+        { L"leftrightsquigarrow", 19, 0x21AD, 0x0000 },
+        { L"leftthreetimes", 14, 0x22CB, 0x0000 },
+        { L"leg", 3, 0x22DA, 0x0000 },
+        { L"leq", 3, 0x2264, 0x0000 },
+        { L"leqq", 4, 0x2266, 0x0000 },
+        { L"leqslant", 8, 0x2A7D, 0x0000 },
+        { L"les", 3, 0x2A7D, 0x0000 },
+        { L"lescc", 5, 0x2AA8, 0x0000 },
+        { L"lesdot", 6, 0x2A7F, 0x0000 },
+        { L"lesdoto", 7, 0x2A81, 0x0000 },
+        { L"lesdotor", 8, 0x2A83, 0x0000 },
+        { L"lesg", 4, 0x22DA, 0xFE00 },
+        { L"lesges", 6, 0x2A93, 0x0000 },
+        { L"lessapprox", 10, 0x2A85, 0x0000 },
+        { L"lessdot", 7, 0x22D6, 0x0000 },
+        { L"lesseqgtr", 9, 0x22DA, 0x0000 },
+        { L"lesseqqgtr", 10, 0x2A8B, 0x0000 },
+        { L"lessgtr", 7, 0x2276, 0x0000 },
+        { L"lesssim", 7, 0x2272, 0x0000 },
+        { L"lfisht", 6, 0x297C, 0x0000 },
+        { L"lfloor", 6, 0x230A, 0x0000 },
+        { L"lfr", 3, 0x1D529, 0x0000 },
+        { L"lg", 2, 0x2276, 0x0000 },
+        { L"lgE", 3, 0x2A91, 0x0000 },
+        { L"lhard", 5, 0x21BD, 0x0000 },
+        { L"lharu", 5, 0x21BC, 0x0000 },
+        { L"lharul", 6, 0x296A, 0x0000 },
+        { L"lhblk", 5, 0x2584, 0x0000 },
+        { L"ljcy", 4, 0x0459, 0x0000 },
+        { L"ll", 2, 0x226A, 0x0000 },
+        { L"llarr", 5, 0x21C7, 0x0000 },
+        { L"llcorner", 8, 0x231E, 0x0000 },
+        { L"llhard", 6, 0x296B, 0x0000 },
+        { L"lltri", 5, 0x25FA, 0x0000 },
+        { L"lmidot", 6, 0x0140, 0x0000 },
+        { L"lmoust", 6, 0x23B0, 0x0000 },
+        { L"lmoustache", 10, 0x23B0, 0x0000 },
+        { L"lnE", 3, 0x2268, 0x0000 },
+        { L"lnap", 4, 0x2A89, 0x0000 },
+        { L"lnapprox", 8, 0x2A89, 0x0000 },
+        { L"lne", 3, 0x2A87, 0x0000 },
+        { L"lneq", 4, 0x2A87, 0x0000 },
+        { L"lneqq", 5, 0x2268, 0x0000 },
+        { L"lnsim", 5, 0x22E6, 0x0000 },
+        { L"loang", 5, 0x27EC, 0x0000 },
+        { L"loarr", 5, 0x21FD, 0x0000 },
+        { L"lobrk", 5, 0x27E6, 0x0000 },
+        { L"longleftarrow", 13, 0x27F5, 0x0000 },
+        { L"longleftrightarrow", 18, 0x27F7, 0x0000 },
+        { L"longmapsto", 10, 0x27FC, 0x0000 },
+        { L"longrightarrow", 14, 0x27F6, 0x0000 },
+        { L"looparrowleft", 13, 0x21AB, 0x0000 },
+        { L"looparrowright", 14, 0x21AC, 0x0000 },
+        { L"lopar", 5, 0x2985, 0x0000 },
+        { L"lopf", 4, 0x1D55D, 0x0000 },
+        { L"loplus", 6, 0x2A2D, 0x0000 },
+        { L"lotimes", 7, 0x2A34, 0x0000 },
+        { L"lowast", 6, 0x2217, 0x0000 },
+        { L"lowbar", 6, 0x005F, 0x0000 },
+        { L"loz", 3, 0x25CA, 0x0000 },
+        { L"lozenge", 7, 0x25CA, 0x0000 },
+        { L"lozf", 4, 0x29EB, 0x0000 },
+        { L"lpar", 4, 0x0028, 0x0000 },
+        { L"lparlt", 6, 0x2993, 0x0000 },
+        { L"lrarr", 5, 0x21C6, 0x0000 },
+        { L"lrcorner", 8, 0x231F, 0x0000 },
+        { L"lrhar", 5, 0x21CB, 0x0000 },
+        { L"lrhard", 6, 0x296D, 0x0000 },
+        { L"lrm", 3, 0x200E, 0x0000 },
+        { L"lrtri", 5, 0x22BF, 0x0000 },
+        { L"lsaquo", 6, 0x2039, 0x0000 },
+        { L"lscr", 4, 0x1D4C1, 0x0000 },
+        { L"lsh", 3, 0x21B0, 0x0000 },
+        { L"lsim", 4, 0x2272, 0x0000 },
+        { L"lsime", 5, 0x2A8D, 0x0000 },
+        { L"lsimg", 5, 0x2A8F, 0x0000 },
+        { L"lsqb", 4, 0x005B, 0x0000 },
+        { L"lsquo", 5, 0x2018, 0x0000 },
+        { L"lsquor", 6, 0x201A, 0x0000 },
+        { L"lstrok", 6, 0x0142, 0x0000 },
+        { L"lt", 2, 0x003C, 0x0000 },
+        { L"ltcc", 4, 0x2AA6, 0x0000 },
+        { L"ltcir", 5, 0x2A79, 0x0000 },
+        { L"ltdot", 5, 0x22D6, 0x0000 },
+        { L"lthree", 6, 0x22CB, 0x0000 },
+        { L"ltimes", 6, 0x22C9, 0x0000 },
+        { L"ltlarr", 6, 0x2976, 0x0000 },
+        { L"ltquest", 7, 0x2A7B, 0x0000 },
+        { L"ltrPar", 6, 0x2996, 0x0000 },
+        { L"ltri", 4, 0x25C3, 0x0000 },
+        { L"ltrie", 5, 0x22B4, 0x0000 },
+        { L"ltrif", 5, 0x25C2, 0x0000 },
+        { L"lurdshar", 8, 0x294A, 0x0000 },
+        { L"luruhar", 7, 0x2966, 0x0000 },
+        { L"lvertneqq", 9, 0x2268, 0xFE00 },
+        { L"lvnE", 4, 0x2268, 0xFE00 },
+        { L"mDDot", 5, 0x223A, 0x0000 },
+        { L"macr", 4, 0x00AF, 0x0000 },
+        { L"male", 4, 0x2642, 0x0000 },
+        { L"malt", 4, 0x2720, 0x0000 },
+        { L"maltese", 7, 0x2720, 0x0000 },
+        { L"map", 3, 0x21A6, 0x0000 },
+        { L"mapsto", 6, 0x21A6, 0x0000 },
+        { L"mapstodown", 10, 0x21A7, 0x0000 },
+        { L"mapstoleft", 10, 0x21A4, 0x0000 },
+        { L"mapstoup", 8, 0x21A5, 0x0000 },
+        { L"marker", 6, 0x25AE, 0x0000 },
+        { L"mcomma", 6, 0x2A29, 0x0000 },
+        { L"mcy", 3, 0x043C, 0x0000 },
+        { L"mdash", 5, 0x2014, 0x0000 },
+        { L"measuredangle", 13, 0x2221, 0x0000 },
+        { L"mfr", 3, 0x1D52A, 0x0000 },
+        { L"mho", 3, 0x2127, 0x0000 },
+        { L"micro", 5, 0x00B5, 0x0000 },
+        { L"mid", 3, 0x2223, 0x0000 },
+        { L"midast", 6, 0x002A, 0x0000 },
+        { L"midcir", 6, 0x2AF0, 0x0000 },
+        { L"middot", 6, 0x00B7, 0x0000 },
+        { L"minus", 5, 0x2212, 0x0000 },
+        { L"minusb", 6, 0x229F, 0x0000 },
+        { L"minusd", 6, 0x2238, 0x0000 },
+        { L"minusdu", 7, 0x2A2A, 0x0000 },
+        { L"mlcp", 4, 0x2ADB, 0x0000 },
+        { L"mldr", 4, 0x2026, 0x0000 },
+        { L"mnplus", 6, 0x2213, 0x0000 },
+        { L"models", 6, 0x22A7, 0x0000 },
+        { L"mopf", 4, 0x1D55E, 0x0000 },
+        { L"mp", 2, 0x2213, 0x0000 },
+        { L"mscr", 4, 0x1D4C2, 0x0000 },
+        { L"mstpos", 6, 0x223E, 0x0000 },
+        { L"mu", 2, 0x03BC, 0x0000 },
+        { L"multimap", 8, 0x22B8, 0x0000 },
+        { L"mumap", 5, 0x22B8, 0x0000 },
+        { L"nGg", 3, 0x22D9, 0x0338 },
+        { L"nGt", 3, 0x226B, 0x20D2 },
+        { L"nGtv", 4, 0x226B, 0x0338 },
+        { L"nLeftarrow", 10, 0x21CD, 0x0000 },
+        { L"nLeftrightarrow", 15, 0x21CE, 0x0000 },
+        { L"nLl", 3, 0x22D8, 0x0338 },
+        { L"nLt", 3, 0x226A, 0x20D2 },
+        { L"nLtv", 4, 0x226A, 0x0338 },
+        { L"nRightarrow", 11, 0x21CF, 0x0000 },
+        { L"nVDash", 6, 0x22AF, 0x0000 },
+        { L"nVdash", 6, 0x22AE, 0x0000 },
+        { L"nabla", 5, 0x2207, 0x0000 },
+        { L"nacute", 6, 0x0144, 0x0000 },
+        { L"nang", 4, 0x2220, 0x20D2 },
+        { L"nap", 3, 0x2249, 0x0000 },
+        { L"napE", 4, 0x2A70, 0x0338 },
+        { L"napid", 5, 0x224B, 0x0338 },
+        { L"napos", 5, 0x0149, 0x0000 },
+        { L"napprox", 7, 0x2249, 0x0000 },
+        { L"natur", 5, 0x266E, 0x0000 },
+        { L"natural", 7, 0x266E, 0x0000 },
+        { L"naturals", 8, 0x2115, 0x0000 },
+        { L"nbsp", 4, 0x0020, 0x0000 },//converted to a regular space so that words are split properly
+        { L"nbump", 5, 0x224E, 0x0338 },
+        { L"nbumpe", 6, 0x224F, 0x0338 },
+        { L"ncap", 4, 0x2A43, 0x0000 },
+        { L"ncaron", 6, 0x0148, 0x0000 },
+        { L"ncedil", 6, 0x0146, 0x0000 },
+        { L"ncong", 5, 0x2247, 0x0000 },
+        { L"ncongdot", 8, 0x2A6D, 0x0338 },
+        { L"ncup", 4, 0x2A42, 0x0000 },
+        { L"ncy", 3, 0x043D, 0x0000 },
+        { L"ndash", 5, 0x2013, 0x0000 },
+        { L"ne", 2, 0x2260, 0x0000 },
+        { L"neArr", 5, 0x21D7, 0x0000 },
+        { L"nearhk", 6, 0x2924, 0x0000 },
+        { L"nearr", 5, 0x2197, 0x0000 },
+        { L"nearrow", 7, 0x2197, 0x0000 },
+        { L"nedot", 5, 0x2250, 0x0338 },
+        { L"nequiv", 6, 0x2262, 0x0000 },
+        { L"nesear", 6, 0x2928, 0x0000 },
+        { L"nesim", 5, 0x2242, 0x0338 },
+        { L"nexist", 6, 0x2204, 0x0000 },
+        { L"nexists", 7, 0x2204, 0x0000 },
+        { L"nfr", 3, 0x1D52B, 0x0000 },
+        { L"ngE", 3, 0x2267, 0x0338 },
+        { L"nge", 3, 0x2271, 0x0000 },
+        { L"ngeq", 4, 0x2271, 0x0000 },
+        { L"ngeqq", 5, 0x2267, 0x0338 },
+        { L"ngeqslant", 9, 0x2A7E, 0x0338 },
+        { L"nges", 4, 0x2A7E, 0x0338 },
+        { L"ngsim", 5, 0x2275, 0x0000 },
+        { L"ngt", 3, 0x226F, 0x0000 },
+        { L"ngtr", 4, 0x226F, 0x0000 },
+        { L"nhArr", 5, 0x21CE, 0x0000 },
+        { L"nharr", 5, 0x21AE, 0x0000 },
+        { L"nhpar", 5, 0x2AF2, 0x0000 },
+        { L"ni", 2, 0x220B, 0x0000 },
+        { L"nis", 3, 0x22FC, 0x0000 },
+        { L"nisd", 4, 0x22FA, 0x0000 },
+        { L"niv", 3, 0x220B, 0x0000 },
+        { L"njcy", 4, 0x045A, 0x0000 },
+        { L"nlArr", 5, 0x21CD, 0x0000 },
+        { L"nlE", 3, 0x2266, 0x0338 },
+        { L"nlarr", 5, 0x219A, 0x0000 },
+        { L"nldr", 4, 0x2025, 0x0000 },
+        { L"nle", 3, 0x2270, 0x0000 },
+        { L"nleftarrow", 10, 0x219A, 0x0000 },
+        { L"nleftrightarrow", 15, 0x21AE, 0x0000 },
+        { L"nleq", 4, 0x2270, 0x0000 },
+        { L"nleqq", 5, 0x2266, 0x0338 },
+        { L"nleqslant", 9, 0x2A7D, 0x0338 },
+        { L"nles", 4, 0x2A7D, 0x0338 },
+        { L"nless", 5, 0x226E, 0x0000 },
+        { L"nlsim", 5, 0x2274, 0x0000 },
+        { L"nlt", 3, 0x226E, 0x0000 },
+        { L"nltri", 5, 0x22EA, 0x0000 },
+        { L"nltrie", 6, 0x22EC, 0x0000 },
+        { L"nmid", 4, 0x2224, 0x0000 },
+        { L"nopf", 4, 0x1D55F, 0x0000 },
+        { L"not", 3, 0x00AC, 0x0000 },
+        { L"notin", 5, 0x2209, 0x0000 },
+        { L"notinE", 6, 0x22F9, 0x0338 },
+        { L"notindot", 8, 0x22F5, 0x0338 },
+        { L"notinva", 7, 0x2209, 0x0000 },
+        { L"notinvb", 7, 0x22F7, 0x0000 },
+        { L"notinvc", 7, 0x22F6, 0x0000 },
+        { L"notni", 5, 0x220C, 0x0000 },
+        { L"notniva", 7, 0x220C, 0x0000 },
+        { L"notnivb", 7, 0x22FE, 0x0000 },
+        { L"notnivc", 7, 0x22FD, 0x0000 },
+        { L"npar", 4, 0x2226, 0x0000 },
+        { L"nparallel", 9, 0x2226, 0x0000 },
+        { L"nparsl", 6, 0x2AFD, 0x20E5 },
+        { L"npart", 5, 0x2202, 0x0338 },
+        { L"npolint", 7, 0x2A14, 0x0000 },
+        { L"npr", 3, 0x2280, 0x0000 },
+        { L"nprcue", 6, 0x22E0, 0x0000 },
+        { L"npre", 4, 0x2AAF, 0x0338 },
+        { L"nprec", 5, 0x2280, 0x0000 },
+        { L"npreceq", 7, 0x2AAF, 0x0338 },
+        { L"nrArr", 5, 0x21CF, 0x0000 },
+        { L"nrarr", 5, 0x219B, 0x0000 },
+        { L"nrarrc", 6, 0x2933, 0x0338 },
+        { L"nrarrw", 6, 0x219D, 0x0338 },
+        { L"nrightarrow", 11, 0x219B, 0x0000 },
+        { L"nrtri", 5, 0x22EB, 0x0000 },
+        { L"nrtrie", 6, 0x22ED, 0x0000 },
+        { L"nsc", 3, 0x2281, 0x0000 },
+        { L"nsccue", 6, 0x22E1, 0x0000 },
+        { L"nsce", 4, 0x2AB0, 0x0338 },
+        { L"nscr", 4, 0x1D4C3, 0x0000 },
+        { L"nshortmid", 9, 0x2224, 0x0000 },
+        { L"nshortparallel", 14, 0x2226, 0x0000 },
+        { L"nsim", 4, 0x2241, 0x0000 },
+        { L"nsime", 5, 0x2244, 0x0000 },
+        { L"nsimeq", 6, 0x2244, 0x0000 },
+        { L"nsmid", 5, 0x2224, 0x0000 },
+        { L"nspar", 5, 0x2226, 0x0000 },
+        { L"nsqsube", 7, 0x22E2, 0x0000 },
+        { L"nsqsupe", 7, 0x22E3, 0x0000 },
+        { L"nsub", 4, 0x2284, 0x0000 },
+        { L"nsubE", 5, 0x2AC5, 0x0338 },
+        { L"nsube", 5, 0x2288, 0x0000 },
+        { L"nsubset", 7, 0x2282, 0x20D2 },
+        { L"nsubseteq", 9, 0x2288, 0x0000 },
+        { L"nsubseteqq", 10, 0x2AC5, 0x0338 },
+        { L"nsucc", 5, 0x2281, 0x0000 },
+        { L"nsucceq", 7, 0x2AB0, 0x0338 },
+        { L"nsup", 4, 0x2285, 0x0000 },
+        { L"nsupE", 5, 0x2AC6, 0x0338 },
+        { L"nsupe", 5, 0x2289, 0x0000 },
+        { L"nsupset", 7, 0x2283, 0x20D2 },
+        { L"nsupseteq", 9, 0x2289, 0x0000 },
+        { L"nsupseteqq", 10, 0x2AC6, 0x0338 },
+        { L"ntgl", 4, 0x2279, 0x0000 },
+        { L"ntilde", 6, 0x00F1, 0x0000 },
+        { L"ntlg", 4, 0x2278, 0x0000 },
+        { L"ntriangleleft", 13, 0x22EA, 0x0000 },
+        { L"ntrianglelefteq", 15, 0x22EC, 0x0000 },
+        { L"ntriangleright", 14, 0x22EB, 0x0000 },
+        { L"ntrianglerighteq", 16, 0x22ED, 0x0000 },
+        { L"nu", 2, 0x03BD, 0x0000 },
+        { L"num", 3, 0x0023, 0x0000 },
+        { L"numero", 6, 0x2116, 0x0000 },
+        { L"numsp", 5, 0x2007, 0x0000 },
+        { L"nvDash", 6, 0x22AD, 0x0000 },
+        { L"nvHarr", 6, 0x2904, 0x0000 },
+        { L"nvap", 4, 0x224D, 0x20D2 },
+        { L"nvdash", 6, 0x22AC, 0x0000 },
+        { L"nvge", 4, 0x2265, 0x20D2 },
+        { L"nvgt", 4, 0x003E, 0x20D2 },
+        { L"nvinfin", 7, 0x29DE, 0x0000 },
+        { L"nvlArr", 6, 0x2902, 0x0000 },
+        { L"nvle", 4, 0x2264, 0x20D2 },
+        { L"nvlt", 4, 0x003C, 0x20D2 },
+        { L"nvltrie", 7, 0x22B4, 0x20D2 },
+        { L"nvrArr", 6, 0x2903, 0x0000 },
+        { L"nvrtrie", 7, 0x22B5, 0x20D2 },
+        { L"nvsim", 5, 0x223C, 0x20D2 },
+        { L"nwArr", 5, 0x21D6, 0x0000 },
+        { L"nwarhk", 6, 0x2923, 0x0000 },
+        { L"nwarr", 5, 0x2196, 0x0000 },
+        { L"nwarrow", 7, 0x2196, 0x0000 },
+        { L"nwnear", 6, 0x2927, 0x0000 },
+        { L"oS", 2, 0x24C8, 0x0000 },
+        { L"oacute", 6, 0x00F3, 0x0000 },
+        { L"oast", 4, 0x229B, 0x0000 },
+        { L"ocir", 4, 0x229A, 0x0000 },
+        { L"ocirc", 5, 0x00F4, 0x0000 },
+        { L"ocy", 3, 0x043E, 0x0000 },
+        { L"odash", 5, 0x229D, 0x0000 },
+        { L"odblac", 6, 0x0151, 0x0000 },
+        { L"odiv", 4, 0x2A38, 0x0000 },
+        { L"odot", 4, 0x2299, 0x0000 },
+        { L"odsold", 6, 0x29BC, 0x0000 },
+        { L"oelig", 5, 0x0153, 0x0000 },
+        { L"ofcir", 5, 0x29BF, 0x0000 },
+        { L"ofr", 3, 0x1D52C, 0x0000 },
+        { L"ogon", 4, 0x02DB, 0x0000 },
+        { L"ograve", 6, 0x00F2, 0x0000 },
+        { L"ogt", 3, 0x29C1, 0x0000 },
+        { L"ohbar", 5, 0x29B5, 0x0000 },
+        { L"ohm", 3, 0x03A9, 0x0000 },
+        { L"oint", 4, 0x222E, 0x0000 },
+        { L"olarr", 5, 0x21BA, 0x0000 },
+        { L"olcir", 5, 0x29BE, 0x0000 },
+        { L"olcross", 7, 0x29BB, 0x0000 },
+        { L"oline", 5, 0x203E, 0x0000 },
+        { L"olt", 3, 0x29C0, 0x0000 },
+        { L"omacr", 5, 0x014D, 0x0000 },
+        { L"omega", 5, 0x03C9, 0x0000 },
+        { L"omicron", 7, 0x03BF, 0x0000 },
+        { L"omid", 4, 0x29B6, 0x0000 },
+        { L"ominus", 6, 0x2296, 0x0000 },
+        { L"oopf", 4, 0x1D560, 0x0000 },
+        { L"opar", 4, 0x29B7, 0x0000 },
+        { L"operp", 5, 0x29B9, 0x0000 },
+        { L"oplus", 5, 0x2295, 0x0000 },
+        { L"or", 2, 0x2228, 0x0000 },
+        { L"orarr", 5, 0x21BB, 0x0000 },
+        { L"ord", 3, 0x2A5D, 0x0000 },
+        { L"order", 5, 0x2134, 0x0000 },
+        { L"orderof", 7, 0x2134, 0x0000 },
+        { L"ordf", 4, 0x00AA, 0x0000 },
+        { L"ordm", 4, 0x00BA, 0x0000 },
+        { L"origof", 6, 0x22B6, 0x0000 },
+        { L"oror", 4, 0x2A56, 0x0000 },
+        { L"orslope", 7, 0x2A57, 0x0000 },
+        { L"orv", 3, 0x2A5B, 0x0000 },
+        { L"oscr", 4, 0x2134, 0x0000 },
+        { L"oslash", 6, 0x00F8, 0x0000 },
+        { L"osol", 4, 0x2298, 0x0000 },
+        { L"otilde", 6, 0x00F5, 0x0000 },
+        { L"otimes", 6, 0x2297, 0x0000 },
+        { L"otimesas", 8, 0x2A36, 0x0000 },
+        { L"ouml", 4, 0x00F6, 0x0000 },
+        { L"ovbar", 5, 0x233D, 0x0000 },
+        { L"par", 3, 0x2225, 0x0000 },
+        { L"para", 4, 0x00B6, 0x0000 },
+        { L"parallel", 8, 0x2225, 0x0000 },
+        { L"parsim", 6, 0x2AF3, 0x0000 },
+        { L"parsl", 5, 0x2AFD, 0x0000 },
+        { L"part", 4, 0x2202, 0x0000 },
+        { L"pcy", 3, 0x043F, 0x0000 },
+        { L"percnt", 6, 0x0025, 0x0000 },
+        { L"period", 6, 0x002E, 0x0000 },
+        { L"permil", 6, 0x2030, 0x0000 },
+        { L"perp", 4, 0x22A5, 0x0000 },
+        { L"pertenk", 7, 0x2031, 0x0000 },
+        { L"pfr", 3, 0x1D52D, 0x0000 },
+        { L"phi", 3, 0x03C6, 0x0000 },
+        { L"phiv", 4, 0x03D5, 0x0000 },
+        { L"phmmat", 6, 0x2133, 0x0000 },
+        { L"phone", 5, 0x260E, 0x0000 },
+        { L"pi", 2, 0x03C0, 0x0000 },
+        { L"pitchfork", 9, 0x22D4, 0x0000 },
+        { L"piv", 3, 0x03D6, 0x0000 },
+        { L"planck", 6, 0x210F, 0x0000 },
+        { L"planckh", 7, 0x210E, 0x0000 },
+        { L"plankv", 6, 0x210F, 0x0000 },
+        { L"plus", 4, 0x002B, 0x0000 },
+        { L"plusacir", 8, 0x2A23, 0x0000 },
+        { L"plusb", 5, 0x229E, 0x0000 },
+        { L"pluscir", 7, 0x2A22, 0x0000 },
+        { L"plusdo", 6, 0x2214, 0x0000 },
+        { L"plusdu", 6, 0x2A25, 0x0000 },
+        { L"pluse", 5, 0x2A72, 0x0000 },
+        { L"plusmn", 6, 0x00B1, 0x0000 },
+        { L"plussim", 7, 0x2A26, 0x0000 },
+        { L"plustwo", 7, 0x2A27, 0x0000 },
+        { L"pm", 2, 0x00B1, 0x0000 },
+        { L"pointint", 8, 0x2A15, 0x0000 },
+        { L"popf", 4, 0x1D561, 0x0000 },
+        { L"pound", 5, 0x00A3, 0x0000 },
+        { L"pr", 2, 0x227A, 0x0000 },
+        { L"prE", 3, 0x2AB3, 0x0000 },
+        { L"prap", 4, 0x2AB7, 0x0000 },
+        { L"prcue", 5, 0x227C, 0x0000 },
+        { L"pre", 3, 0x2AAF, 0x0000 },
+        { L"prec", 4, 0x227A, 0x0000 },
+        { L"precapprox", 10, 0x2AB7, 0x0000 },
+        { L"preccurlyeq", 11, 0x227C, 0x0000 },
+        { L"preceq", 6, 0x2AAF, 0x0000 },
+        { L"precnapprox", 11, 0x2AB9, 0x0000 },
+        { L"precneqq", 8, 0x2AB5, 0x0000 },
+        { L"precnsim", 8, 0x22E8, 0x0000 },
+        { L"precsim", 7, 0x227E, 0x0000 },
+        { L"prime", 5, 0x2032, 0x0000 },
+        { L"primes", 6, 0x2119, 0x0000 },
+        { L"prnE", 4, 0x2AB5, 0x0000 },
+        { L"prnap", 5, 0x2AB9, 0x0000 },
+        { L"prnsim", 6, 0x22E8, 0x0000 },
+        { L"prod", 4, 0x220F, 0x0000 },
+        { L"profalar", 8, 0x232E, 0x0000 },
+        { L"profline", 8, 0x2312, 0x0000 },
+        { L"profsurf", 8, 0x2313, 0x0000 },
+        { L"prop", 4, 0x221D, 0x0000 },
+        { L"propto", 6, 0x221D, 0x0000 },
+        { L"prsim", 5, 0x227E, 0x0000 },
+        { L"prurel", 6, 0x22B0, 0x0000 },
+        { L"pscr", 4, 0x1D4C5, 0x0000 },
+        { L"psi", 3, 0x03C8, 0x0000 },
+        { L"puncsp", 6, 0x2008, 0x0000 },
+        { L"qfr", 3, 0x1D52E, 0x0000 },
+        { L"qint", 4, 0x2A0C, 0x0000 },
+        { L"qopf", 4, 0x1D562, 0x0000 },
+        { L"qprime", 6, 0x2057, 0x0000 },
+        { L"qscr", 4, 0x1D4C6, 0x0000 },
+        { L"quaternions", 11, 0x210D, 0x0000 },
+        { L"quatint", 7, 0x2A16, 0x0000 },
+        { L"quest", 5, 0x003F, 0x0000 },
+        { L"questeq", 7, 0x225F, 0x0000 },
+        { L"quot", 4, 0x0022, 0x0000 },
+        { L"rAarr", 5, 0x21DB, 0x0000 },
+        { L"rArr", 4, 0x21D2, 0x0000 },
+        { L"rAtail", 6, 0x291C, 0x0000 },
+        { L"rBarr", 5, 0x290F, 0x0000 },
+        { L"rHar", 4, 0x2964, 0x0000 },
+        { L"race", 4, 0x223D, 0x0331 },
+        { L"racute", 6, 0x0155, 0x0000 },
+        { L"radic", 5, 0x221A, 0x0000 },
+        { L"raemptyv", 8, 0x29B3, 0x0000 },
+        { L"rang", 4, 0x27E9, 0x0000 },
+        { L"rangd", 5, 0x2992, 0x0000 },
+        { L"range", 5, 0x29A5, 0x0000 },
+        { L"rangle", 6, 0x27E9, 0x0000 },
+        { L"raquo", 5, 0x00BB, 0x0000 },
+        { L"rarr", 4, 0x2192, 0x0000 },
+        { L"rarrap", 6, 0x2975, 0x0000 },
+        { L"rarrb", 5, 0x21E5, 0x0000 },
+        { L"rarrbfs", 7, 0x2920, 0x0000 },
+        { L"rarrc", 5, 0x2933, 0x0000 },
+        { L"rarrfs", 6, 0x291E, 0x0000 },
+        { L"rarrhk", 6, 0x21AA, 0x0000 },
+        { L"rarrlp", 6, 0x21AC, 0x0000 },
+        { L"rarrpl", 6, 0x2945, 0x0000 },
+        { L"rarrsim", 7, 0x2974, 0x0000 },
+        { L"rarrtl", 6, 0x21A3, 0x0000 },
+        { L"rarrw", 5, 0x219D, 0x0000 },
+        { L"ratail", 6, 0x291A, 0x0000 },
+        { L"ratio", 5, 0x2236, 0x0000 },
+        { L"rationals", 9, 0x211A, 0x0000 },
+        { L"rbarr", 5, 0x290D, 0x0000 },
+        { L"rbbrk", 5, 0x2773, 0x0000 },
+        { L"rbrace", 6, 0x007D, 0x0000 },
+        { L"rbrack", 6, 0x005D, 0x0000 },
+        { L"rbrke", 5, 0x298C, 0x0000 },
+        { L"rbrksld", 7, 0x298E, 0x0000 },
+        { L"rbrkslu", 7, 0x2990, 0x0000 },
+        { L"rcaron", 6, 0x0159, 0x0000 },
+        { L"rcedil", 6, 0x0157, 0x0000 },
+        { L"rceil", 5, 0x2309, 0x0000 },
+        { L"rcub", 4, 0x007D, 0x0000 },
+        { L"rcy", 3, 0x0440, 0x0000 },
+        { L"rdca", 4, 0x2937, 0x0000 },
+        { L"rdldhar", 7, 0x2969, 0x0000 },
+        { L"rdquo", 5, 0x201D, 0x0000 },
+        { L"rdquor", 6, 0x201D, 0x0000 },
+        { L"rdsh", 4, 0x21B3, 0x0000 },
+        { L"real", 4, 0x211C, 0x0000 },
+        { L"realine", 7, 0x211B, 0x0000 },
+        { L"realpart", 8, 0x211C, 0x0000 },
+        { L"reals", 5, 0x211D, 0x0000 },
+        { L"rect", 4, 0x25AD, 0x0000 },
+        { L"reg", 3, 0x00AE, 0x0000 },
+        { L"rfisht", 6, 0x297D, 0x0000 },
+        { L"rfloor", 6, 0x230B, 0x0000 },
+        { L"rfr", 3, 0x1D52F, 0x0000 },
+        { L"rhard", 5, 0x21C1, 0x0000 },
+        { L"rharu", 5, 0x21C0, 0x0000 },
+        { L"rharul", 6, 0x296C, 0x0000 },
+        { L"rho", 3, 0x03C1, 0x0000 },
+        { L"rhov", 4, 0x03F1, 0x0000 },
+        { L"rightarrow", 10, 0x2192, 0x0000 },
+        { L"rightarrowtail", 14, 0x21A3, 0x0000 },
+        { L"rightharpoondown", 16, 0x21C1, 0x0000 },
+        { L"rightharpoonup", 14, 0x21C0, 0x0000 },
+        { L"rightleftarrows", 15, 0x21C4, 0x0000 },
+        { L"rightleftharpoons", 17, 0x21CC, 0x0000 },
+        { L"rightrightarrows", 16, 0x21C9, 0x0000 },
+        { L"rightsquigarrow", 15, 0x219D, 0x0000 },
+        { L"rightthreetimes", 15, 0x22CC, 0x0000 },
+        { L"ring", 4, 0x02DA, 0x0000 },
+        { L"risingdotseq", 12, 0x2253, 0x0000 },
+        { L"rlarr", 5, 0x21C4, 0x0000 },
+        { L"rlhar", 5, 0x21CC, 0x0000 },
+        { L"rlm", 3, 0x200F, 0x0000 },
+        { L"rmoust", 6, 0x23B1, 0x0000 },
+        { L"rmoustache", 10, 0x23B1, 0x0000 },
+        { L"rnmid", 5, 0x2AEE, 0x0000 },
+        { L"roang", 5, 0x27ED, 0x0000 },
+        { L"roarr", 5, 0x21FE, 0x0000 },
+        { L"robrk", 5, 0x27E7, 0x0000 },
+        { L"ropar", 5, 0x2986, 0x0000 },
+        { L"ropf", 4, 0x1D563, 0x0000 },
+        { L"roplus", 6, 0x2A2E, 0x0000 },
+        { L"rotimes", 7, 0x2A35, 0x0000 },
+        { L"rpar", 4, 0x0029, 0x0000 },
+        { L"rpargt", 6, 0x2994, 0x0000 },
+        { L"rppolint", 8, 0x2A12, 0x0000 },
+        { L"rrarr", 5, 0x21C9, 0x0000 },
+        { L"rsaquo", 6, 0x203A, 0x0000 },
+        { L"rscr", 4, 0x1D4C7, 0x0000 },
+        { L"rsh", 3, 0x21B1, 0x0000 },
+        { L"rsqb", 4, 0x005D, 0x0000 },
+        { L"rsquo", 5, 0x2019, 0x0000 },
+        { L"rsquor", 6, 0x2019, 0x0000 },
+        { L"rthree", 6, 0x22CC, 0x0000 },
+        { L"rtimes", 6, 0x22CA, 0x0000 },
+        { L"rtri", 4, 0x25B9, 0x0000 },
+        { L"rtrie", 5, 0x22B5, 0x0000 },
+        { L"rtrif", 5, 0x25B8, 0x0000 },
+        { L"rtriltri", 8, 0x29CE, 0x0000 },
+        { L"ruluhar", 7, 0x2968, 0x0000 },
+        { L"rx", 2, 0x211E, 0x0000 },
+        { L"sacute", 6, 0x015B, 0x0000 },
+        { L"sbquo", 5, 0x201A, 0x0000 },
+        { L"sc", 2, 0x227B, 0x0000 },
+        { L"scE", 3, 0x2AB4, 0x0000 },
+        { L"scap", 4, 0x2AB8, 0x0000 },
+        { L"scaron", 6, 0x0161, 0x0000 },
+        { L"sccue", 5, 0x227D, 0x0000 },
+        { L"sce", 3, 0x2AB0, 0x0000 },
+        { L"scedil", 6, 0x015F, 0x0000 },
+        { L"scirc", 5, 0x015D, 0x0000 },
+        { L"scnE", 4, 0x2AB6, 0x0000 },
+        { L"scnap", 5, 0x2ABA, 0x0000 },
+        { L"scnsim", 6, 0x22E9, 0x0000 },
+        { L"scpolint", 8, 0x2A13, 0x0000 },
+        { L"scsim", 5, 0x227F, 0x0000 },
+        { L"scy", 3, 0x0441, 0x0000 },
+        { L"sdot", 4, 0x22C5, 0x0000 },
+        { L"sdotb", 5, 0x22A1, 0x0000 },
+        { L"sdote", 5, 0x2A66, 0x0000 },
+        { L"seArr", 5, 0x21D8, 0x0000 },
+        { L"searhk", 6, 0x2925, 0x0000 },
+        { L"searr", 5, 0x2198, 0x0000 },
+        { L"searrow", 7, 0x2198, 0x0000 },
+        { L"sect", 4, 0x00A7, 0x0000 },
+        { L"semi", 4, 0x003B, 0x0000 },
+        { L"seswar", 6, 0x2929, 0x0000 },
+        { L"setminus", 8, 0x2216, 0x0000 },
+        { L"setmn", 5, 0x2216, 0x0000 },
+        { L"sext", 4, 0x2736, 0x0000 },
+        { L"sfr", 3, 0x1D530, 0x0000 },
+        { L"sfrown", 6, 0x2322, 0x0000 },
+        { L"sharp", 5, 0x266F, 0x0000 },
+        { L"shchcy", 6, 0x0449, 0x0000 },
+        { L"shcy", 4, 0x0448, 0x0000 },
+        { L"shortmid", 8, 0x2223, 0x0000 },
+        { L"shortparallel", 13, 0x2225, 0x0000 },
+        { L"shy", 3, 0x00AD, 0x0000 },
+        { L"sigma", 5, 0x03C3, 0x0000 },
+        { L"sigmaf", 6, 0x03C2, 0x0000 },
+        { L"sigmav", 6, 0x03C2, 0x0000 },
+        { L"sim", 3, 0x223C, 0x0000 },
+        { L"simdot", 6, 0x2A6A, 0x0000 },
+        { L"sime", 4, 0x2243, 0x0000 },
+        { L"simeq", 5, 0x2243, 0x0000 },
+        { L"simg", 4, 0x2A9E, 0x0000 },
+        { L"simgE", 5, 0x2AA0, 0x0000 },
+        { L"siml", 4, 0x2A9D, 0x0000 },
+        { L"simlE", 5, 0x2A9F, 0x0000 },
+        { L"simne", 5, 0x2246, 0x0000 },
+        { L"simplus", 7, 0x2A24, 0x0000 },
+        { L"simrarr", 7, 0x2972, 0x0000 },
+        { L"slarr", 5, 0x2190, 0x0000 },
+        { L"smallsetminus", 13, 0x2216, 0x0000 },
+        { L"smashp", 6, 0x2A33, 0x0000 },
+        { L"smeparsl", 8, 0x29E4, 0x0000 },
+        { L"smid", 4, 0x2223, 0x0000 },
+        { L"smile", 5, 0x2323, 0x0000 },
+        { L"smt", 3, 0x2AAA, 0x0000 },
+        { L"smte", 4, 0x2AAC, 0x0000 },
+        { L"smtes", 5, 0x2AAC, 0xFE00 },
+        { L"softcy", 6, 0x044C, 0x0000 },
+        { L"sol", 3, 0x002F, 0x0000 },
+        { L"solb", 4, 0x29C4, 0x0000 },
+        { L"solbar", 6, 0x233F, 0x0000 },
+        { L"sopf", 4, 0x1D564, 0x0000 },
+        { L"spades", 6, 0x2660, 0x0000 },
+        { L"spadesuit", 9, 0x2660, 0x0000 },
+        { L"spar", 4, 0x2225, 0x0000 },
+        { L"sqcap", 5, 0x2293, 0x0000 },
+        { L"sqcaps", 6, 0x2293, 0xFE00 },
+        { L"sqcup", 5, 0x2294, 0x0000 },
+        { L"sqcups", 6, 0x2294, 0xFE00 },
+        { L"sqsub", 5, 0x228F, 0x0000 },
+        { L"sqsube", 6, 0x2291, 0x0000 },
+        { L"sqsubset", 8, 0x228F, 0x0000 },
+        { L"sqsubseteq", 10, 0x2291, 0x0000 },
+        { L"sqsup", 5, 0x2290, 0x0000 },
+        { L"sqsupe", 6, 0x2292, 0x0000 },
+        { L"sqsupset", 8, 0x2290, 0x0000 },
+        { L"sqsupseteq", 10, 0x2292, 0x0000 },
+        { L"squ", 3, 0x25A1, 0x0000 },
+        { L"square", 6, 0x25A1, 0x0000 },
+        { L"squarf", 6, 0x25AA, 0x0000 },
+        { L"squf", 4, 0x25AA, 0x0000 },
+        { L"srarr", 5, 0x2192, 0x0000 },
+        { L"sscr", 4, 0x1D4C8, 0x0000 },
+        { L"ssetmn", 6, 0x2216, 0x0000 },
+        { L"ssmile", 6, 0x2323, 0x0000 },
+        { L"sstarf", 6, 0x22C6, 0x0000 },
+        { L"star", 4, 0x2606, 0x0000 },
+        { L"starf", 5, 0x2605, 0x0000 },
+        { L"straightepsilon", 15, 0x03F5, 0x0000 },
+        { L"straightphi", 11, 0x03D5, 0x0000 },
+        { L"strns", 5, 0x00AF, 0x0000 },
+        { L"sub", 3, 0x2282, 0x0000 },
+        { L"subE", 4, 0x2AC5, 0x0000 },
+        { L"subdot", 6, 0x2ABD, 0x0000 },
+        { L"sube", 4, 0x2286, 0x0000 },
+        { L"subedot", 7, 0x2AC3, 0x0000 },
+        { L"submult", 7, 0x2AC1, 0x0000 },
+        { L"subnE", 5, 0x2ACB, 0x0000 },
+        { L"subne", 5, 0x228A, 0x0000 },
+        { L"subplus", 7, 0x2ABF, 0x0000 },
+        { L"subrarr", 7, 0x2979, 0x0000 },
+        { L"subset", 6, 0x2282, 0x0000 },
+        { L"subseteq", 8, 0x2286, 0x0000 },
+        { L"subseteqq", 9, 0x2AC5, 0x0000 },
+        { L"subsetneq", 9, 0x228A, 0x0000 },
+        { L"subsetneqq", 10, 0x2ACB, 0x0000 },
+        { L"subsim", 6, 0x2AC7, 0x0000 },
+        { L"subsub", 6, 0x2AD5, 0x0000 },
+        { L"subsup", 6, 0x2AD3, 0x0000 },
+        { L"succ", 4, 0x227B, 0x0000 },
+        { L"succapprox", 10, 0x2AB8, 0x0000 },
+        { L"succcurlyeq", 11, 0x227D, 0x0000 },
+        { L"succeq", 6, 0x2AB0, 0x0000 },
+        { L"succnapprox", 11, 0x2ABA, 0x0000 },
+        { L"succneqq", 8, 0x2AB6, 0x0000 },
+        { L"succnsim", 8, 0x22E9, 0x0000 },
+        { L"succsim", 7, 0x227F, 0x0000 },
+        { L"sum", 3, 0x2211, 0x0000 },
+        { L"sung", 4, 0x266A, 0x0000 },
+        { L"sup", 3, 0x2283, 0x0000 },
+        { L"sup1", 4, 0x00B9, 0x0000 },
+        { L"sup2", 4, 0x00B2, 0x0000 },
+        { L"sup3", 4, 0x00B3, 0x0000 },
+        { L"supE", 4, 0x2AC6, 0x0000 },
+        { L"supdot", 6, 0x2ABE, 0x0000 },
+        { L"supdsub", 7, 0x2AD8, 0x0000 },
+        { L"supe", 4, 0x2287, 0x0000 },
+        { L"supedot", 7, 0x2AC4, 0x0000 },
+        { L"suphsol", 7, 0x27C9, 0x0000 },
+        { L"suphsub", 7, 0x2AD7, 0x0000 },
+        { L"suplarr", 7, 0x297B, 0x0000 },
+        { L"supmult", 7, 0x2AC2, 0x0000 },
+        { L"supnE", 5, 0x2ACC, 0x0000 },
+        { L"supne", 5, 0x228B, 0x0000 },
+        { L"supplus", 7, 0x2AC0, 0x0000 },
+        { L"supset", 6, 0x2283, 0x0000 },
+        { L"supseteq", 8, 0x2287, 0x0000 },
+        { L"supseteqq", 9, 0x2AC6, 0x0000 },
+        { L"supsetneq", 9, 0x228B, 0x0000 },
+        { L"supsetneqq", 10, 0x2ACC, 0x0000 },
+        { L"supsim", 6, 0x2AC8, 0x0000 },
+        { L"supsub", 6, 0x2AD4, 0x0000 },
+        { L"supsup", 6, 0x2AD6, 0x0000 },
+        { L"swArr", 5, 0x21D9, 0x0000 },
+        { L"swarhk", 6, 0x2926, 0x0000 },
+        { L"swarr", 5, 0x2199, 0x0000 },
+        { L"swarrow", 7, 0x2199, 0x0000 },
+        { L"swnwar", 6, 0x292A, 0x0000 },
+        { L"szlig", 5, 0x00DF, 0x0000 },
+        { L"target", 6, 0x2316, 0x0000 },
+        { L"tau", 3, 0x03C4, 0x0000 },
+        { L"tbrk", 4, 0x23B4, 0x0000 },
+        { L"tcaron", 6, 0x0165, 0x0000 },
+        { L"tcedil", 6, 0x0163, 0x0000 },
+        { L"tcy", 3, 0x0442, 0x0000 },
+        { L"tdot", 4, 0x20DB, 0x0000 },
+        { L"telrec", 6, 0x2315, 0x0000 },
+        { L"tfr", 3, 0x1D531, 0x0000 },
+        { L"there4", 6, 0x2234, 0x0000 },
+        { L"therefore", 9, 0x2234, 0x0000 },
+        { L"theta", 5, 0x03B8, 0x0000 },
+        { L"thetasym", 8, 0x03D1, 0x0000 },
+        { L"thetav", 6, 0x03D1, 0x0000 },
+        { L"thickapprox", 11, 0x2248, 0x0000 },
+        { L"thicksim", 8, 0x223C, 0x0000 },
+        { L"thinsp", 6, 0x2009, 0x0000 },
+        { L"thkap", 5, 0x2248, 0x0000 },
+        { L"thksim", 6, 0x223C, 0x0000 },
+        { L"thorn", 5, 0x00FE, 0x0000 },
+        { L"tilde", 5, 0x02DC, 0x0000 },
+        { L"times", 5, 0x00D7, 0x0000 },
+        { L"timesb", 6, 0x22A0, 0x0000 },
+        { L"timesbar", 8, 0x2A31, 0x0000 },
+        { L"timesd", 6, 0x2A30, 0x0000 },
+        { L"tint", 4, 0x222D, 0x0000 },
+        { L"toea", 4, 0x2928, 0x0000 },
+        { L"top", 3, 0x22A4, 0x0000 },
+        { L"topbot", 6, 0x2336, 0x0000 },
+        { L"topcir", 6, 0x2AF1, 0x0000 },
+        { L"topf", 4, 0x1D565, 0x0000 },
+        { L"topfork", 7, 0x2ADA, 0x0000 },
+        { L"tosa", 4, 0x2929, 0x0000 },
+        { L"tprime", 6, 0x2034, 0x0000 },
+        { L"trade", 5, 0x2122, 0x0000 },
+        { L"triangle", 8, 0x25B5, 0x0000 },
+        { L"triangledown", 12, 0x25BF, 0x0000 },
+        { L"triangleleft", 12, 0x25C3, 0x0000 },
+        { L"trianglelefteq", 14, 0x22B4, 0x0000 },
+        { L"triangleq", 9, 0x225C, 0x0000 },
+        { L"triangleright", 13, 0x25B9, 0x0000 },
+        { L"trianglerighteq", 15, 0x22B5, 0x0000 },
+        { L"tridot", 6, 0x25EC, 0x0000 },
+        { L"trie", 4, 0x225C, 0x0000 },
+        { L"triminus", 8, 0x2A3A, 0x0000 },
+        { L"triplus", 7, 0x2A39, 0x0000 },
+        { L"trisb", 5, 0x29CD, 0x0000 },
+        { L"tritime", 7, 0x2A3B, 0x0000 },
+        { L"trpezium", 8, 0x23E2, 0x0000 },
+        { L"tscr", 4, 0x1D4C9, 0x0000 },
+        { L"tscy", 4, 0x0446, 0x0000 },
+        { L"tshcy", 5, 0x045B, 0x0000 },
+        { L"tstrok", 6, 0x0167, 0x0000 },
+        { L"twixt", 5, 0x226C, 0x0000 },
+        { L"twoheadleftarrow", 16, 0x219E, 0x0000 },
+        { L"twoheadrightarrow", 17, 0x21A0, 0x0000 },
+        { L"uArr", 4, 0x21D1, 0x0000 },
+        { L"uHar", 4, 0x2963, 0x0000 },
+        { L"uacute", 6, 0x00FA, 0x0000 },
+        { L"uarr", 4, 0x2191, 0x0000 },
+        { L"ubrcy", 5, 0x045E, 0x0000 },
+        { L"ubreve", 6, 0x016D, 0x0000 },
+        { L"ucirc", 5, 0x00FB, 0x0000 },
+        { L"ucy", 3, 0x0443, 0x0000 },
+        { L"udarr", 5, 0x21C5, 0x0000 },
+        { L"udblac", 6, 0x0171, 0x0000 },
+        { L"udhar", 5, 0x296E, 0x0000 },
+        { L"ufisht", 6, 0x297E, 0x0000 },
+        { L"ufr", 3, 0x1D532, 0x0000 },
+        { L"ugrave", 6, 0x00F9, 0x0000 },
+        { L"uharl", 5, 0x21BF, 0x0000 },
+        { L"uharr", 5, 0x21BE, 0x0000 },
+        { L"uhblk", 5, 0x2580, 0x0000 },
+        { L"ulcorn", 6, 0x231C, 0x0000 },
+        { L"ulcorner", 8, 0x231C, 0x0000 },
+        { L"ulcrop", 6, 0x230F, 0x0000 },
+        { L"ultri", 5, 0x25F8, 0x0000 },
+        { L"umacr", 5, 0x016B, 0x0000 },
+        { L"uml", 3, 0x00A8, 0x0000 },
+        { L"uogon", 5, 0x0173, 0x0000 },
+        { L"uopf", 4, 0x1D566, 0x0000 },
+        { L"uparrow", 7, 0x2191, 0x0000 },
+        { L"updownarrow", 11, 0x2195, 0x0000 },
+        { L"upharpoonleft", 13, 0x21BF, 0x0000 },
+        { L"upharpoonright", 14, 0x21BE, 0x0000 },
+        { L"uplus", 5, 0x228E, 0x0000 },
+        { L"upsi", 4, 0x03C5, 0x0000 },
+        { L"upsih", 5, 0x03D2, 0x0000 },
+        { L"upsilon", 7, 0x03C5, 0x0000 },
+        { L"upuparrows", 10, 0x21C8, 0x0000 },
+        { L"urcorn", 6, 0x231D, 0x0000 },
+        { L"urcorner", 8, 0x231D, 0x0000 },
+        { L"urcrop", 6, 0x230E, 0x0000 },
+        { L"uring", 5, 0x016F, 0x0000 },
+        { L"urtri", 5, 0x25F9, 0x0000 },
+        { L"uscr", 4, 0x1D4CA, 0x0000 },
+        { L"utdot", 5, 0x22F0, 0x0000 },
+        { L"utilde", 6, 0x0169, 0x0000 },
+        { L"utri", 4, 0x25B5, 0x0000 },
+        { L"utrif", 5, 0x25B4, 0x0000 },
+        { L"uuarr", 5, 0x21C8, 0x0000 },
+        { L"uuml", 4, 0x00FC, 0x0000 },
+        { L"uwangle", 7, 0x29A7, 0x0000 },
+        { L"vArr", 4, 0x21D5, 0x0000 },
+        { L"vBar", 4, 0x2AE8, 0x0000 },
+        { L"vBarv", 5, 0x2AE9, 0x0000 },
+        { L"vDash", 5, 0x22A8, 0x0000 },
+        { L"vangrt", 6, 0x299C, 0x0000 },
+        { L"varepsilon", 10, 0x03F5, 0x0000 },
+        { L"varkappa", 8, 0x03F0, 0x0000 },
+        { L"varnothing", 10, 0x2205, 0x0000 },
+        { L"varphi", 6, 0x03D5, 0x0000 },
+        { L"varpi", 5, 0x03D6, 0x0000 },
+        { L"varpropto", 9, 0x221D, 0x0000 },
+        { L"varr", 4, 0x2195, 0x0000 },
+        { L"varrho", 6, 0x03F1, 0x0000 },
+        { L"varsigma", 8, 0x03C2, 0x0000 },
+        { L"varsubsetneq", 12, 0x228A, 0xFE00 },
+        { L"varsubsetneqq", 13, 0x2ACB, 0xFE00 },
+        { L"varsupsetneq", 12, 0x228B, 0xFE00 },
+        { L"varsupsetneqq", 13, 0x2ACC, 0xFE00 },
+        { L"vartheta", 8, 0x03D1, 0x0000 },
+        { L"vartriangleleft", 15, 0x22B2, 0x0000 },
+        { L"vartriangleright", 16, 0x22B3, 0x0000 },
+        { L"vcy", 3, 0x0432, 0x0000 },
+        { L"vdash", 5, 0x22A2, 0x0000 },
+        { L"vee", 3, 0x2228, 0x0000 },
+        { L"veebar", 6, 0x22BB, 0x0000 },
+        { L"veeeq", 5, 0x225A, 0x0000 },
+        { L"vellip", 6, 0x22EE, 0x0000 },
+        { L"verbar", 6, 0x007C, 0x0000 },
+        { L"vert", 4, 0x007C, 0x0000 },
+        { L"vfr", 3, 0x1D533, 0x0000 },
+        { L"vltri", 5, 0x22B2, 0x0000 },
+        { L"vnsub", 5, 0x2282, 0x20D2 },
+        { L"vnsup", 5, 0x2283, 0x20D2 },
+        { L"vopf", 4, 0x1D567, 0x0000 },
+        { L"vprop", 5, 0x221D, 0x0000 },
+        { L"vrtri", 5, 0x22B3, 0x0000 },
+        { L"vscr", 4, 0x1D4CB, 0x0000 },
+        { L"vsubnE", 6, 0x2ACB, 0xFE00 },
+        { L"vsubne", 6, 0x228A, 0xFE00 },
+        { L"vsupnE", 6, 0x2ACC, 0xFE00 },
+        { L"vsupne", 6, 0x228B, 0xFE00 },
+        { L"vzigzag", 7, 0x299A, 0x0000 },
+        { L"wcirc", 5, 0x0175, 0x0000 },
+        { L"wedbar", 6, 0x2A5F, 0x0000 },
+        { L"wedge", 5, 0x2227, 0x0000 },
+        { L"wedgeq", 6, 0x2259, 0x0000 },
+        { L"weierp", 6, 0x2118, 0x0000 },
+        { L"wfr", 3, 0x1D534, 0x0000 },
+        { L"wopf", 4, 0x1D568, 0x0000 },
+        { L"wp", 2, 0x2118, 0x0000 },
+        { L"wr", 2, 0x2240, 0x0000 },
+        { L"wreath", 6, 0x2240, 0x0000 },
+        { L"wscr", 4, 0x1D4CC, 0x0000 },
+        { L"xcap", 4, 0x22C2, 0x0000 },
+        { L"xcirc", 5, 0x25EF, 0x0000 },
+        { L"xcup", 4, 0x22C3, 0x0000 },
+        { L"xdtri", 5, 0x25BD, 0x0000 },
+        { L"xfr", 3, 0x1D535, 0x0000 },
+        { L"xhArr", 5, 0x27FA, 0x0000 },
+        { L"xharr", 5, 0x27F7, 0x0000 },
+        { L"xi", 2, 0x03BE, 0x0000 },
+        { L"xlArr", 5, 0x27F8, 0x0000 },
+        { L"xlarr", 5, 0x27F5, 0x0000 },
+        { L"xmap", 4, 0x27FC, 0x0000 },
+        { L"xnis", 4, 0x22FB, 0x0000 },
+        { L"xodot", 5, 0x2A00, 0x0000 },
+        { L"xopf", 4, 0x1D569, 0x0000 },
+        { L"xoplus", 6, 0x2A01, 0x0000 },
+        { L"xotime", 6, 0x2A02, 0x0000 },
+        { L"xrArr", 5, 0x27F9, 0x0000 },
+        { L"xrarr", 5, 0x27F6, 0x0000 },
+        { L"xscr", 4, 0x1D4CD, 0x0000 },
+        { L"xsqcup", 6, 0x2A06, 0x0000 },
+        { L"xuplus", 6, 0x2A04, 0x0000 },
+        { L"xutri", 5, 0x25B3, 0x0000 },
+        { L"xvee", 4, 0x22C1, 0x0000 },
+        { L"xwedge", 6, 0x22C0, 0x0000 },
+        { L"yacute", 6, 0x00FD, 0x0000 },
+        { L"yacy", 4, 0x044F, 0x0000 },
+        { L"ycirc", 5, 0x0177, 0x0000 },
+        { L"ycy", 3, 0x044B, 0x0000 },
+        { L"yen", 3, 0x00A5, 0x0000 },
+        { L"yfr", 3, 0x1D536, 0x0000 },
+        { L"yicy", 4, 0x0457, 0x0000 },
+        { L"yopf", 4, 0x1D56A, 0x0000 },
+        { L"yscr", 4, 0x1D4CE, 0x0000 },
+        { L"yucy", 4, 0x044E, 0x0000 },
+        { L"yuml", 4, 0x00FF, 0x0000 },
+        { L"zacute", 6, 0x017A, 0x0000 },
+        { L"zcaron", 6, 0x017E, 0x0000 },
+        { L"zcy", 3, 0x0437, 0x0000 },
+        { L"zdot", 4, 0x017C, 0x0000 },
+        { L"zeetrf", 6, 0x2128, 0x0000 },
+        { L"zeta", 4, 0x03B6, 0x0000 },
+        { L"zfr", 3, 0x1D537, 0x0000 },
+        { L"zhcy", 4, 0x0436, 0x0000 },
+        { L"zigrarr", 7, 0x21DD, 0x0000 },
+        { L"zopf", 4, 0x1D56B, 0x0000 },
+        { L"zscr", 4, 0x1D4CF, 0x0000 },
+        { L"zwj", 3, 0x200D, 0x0000 },
+        { L"zwnj", 4, 0x200C, 0x0000 }
+        };
+    //the longest entity name ("CounterClockwiseContourIntegral")
+    static const size_t HTML_ENTITY_MAX_LENGTH = 31;
+
+    /*Ordinal comparison of a (non-NULL terminated) entity name against a table entry,
+    following the same ordering that the table is sorted by.*/
+    static inline int compare_entity_name(const wchar_t* name, const size_t length, const html_entity& entry)
+        {
+        const size_t compareLength = std::min(length, entry.m_name_length);
+        for (size_t i = 0; i < compareLength; ++i)
+            {
+            if (name[i] != entry.m_name[i])
+                { return (name[i] < entry.m_name[i]) ? -1 : 1; }
+            }
+        return (length < entry.m_name_length) ? -1 : (length > entry.m_name_length) ? 1 : 0;
         }
-    wchar_t html_entity_table::find(const wchar_t* html_entity, const size_t length) const
+
+    static const html_entity* binary_search_entity(const wchar_t* name, const size_t length)
         {
-        std::wstring cmpKey(html_entity, length);
-        std::map<std::wstring, wchar_t>::const_iterator pos =
-            m_table.find(cmpKey);
-        //if not found case sensitively...
-        if (pos == m_table.end() )
+        size_t lower = 0, upper = size_of_array(HTML_ENTITIES);
+        while (lower < upper)
             {
-            //...do a case insensitive search.
-            std::transform(cmpKey.begin(), cmpKey.end(), cmpKey.begin(), string_util::tolower_western);
-            pos = m_table.find(cmpKey);
-            //if the character can't be converted, then return a question mark
-            if (pos == m_table.end() )
-                { return common_lang_constants::QUESTION_MARK; }
+            const size_t middle = lower+((upper-lower)/2);
+            const int result = compare_entity_name(name, length, HTML_ENTITIES[middle]);
+            if (result == 0)
+                { return &HTML_ENTITIES[middle]; }
+            else if (result < 0)
+                { upper = middle; }
+            else
+                { lower = middle+1; }
             }
-        return pos->second;
+        return NULL;
+        }
+
+    const html_entity* html_entity_table::find_entity(const wchar_t* html_entity, const size_t length) const
+        {
+        if (html_entity == NULL || length == 0 || length > HTML_ENTITY_MAX_LENGTH)
+            { return NULL; }
+        const html_utilities::html_entity* entry = binary_search_entity(html_entity, length);
+        //if not found case sensitively, then do a case insensitive search
+        if (entry == NULL)
+            {
+            wchar_t lowerKey[HTML_ENTITY_MAX_LENGTH];
+            for (size_t i = 0; i < length; ++i)
+                { lowerKey[i] = string_util::tolower_western(html_entity[i]); }
+            entry = binary_search_entity(lowerKey, length);
+            }
+        return entry;
+        }
+
+    const html_entity* html_entity_table::find_entity(const char* html_entity, const size_t length) const
+        {
+        if (html_entity == NULL || length == 0 || length > HTML_ENTITY_MAX_LENGTH)
+            { return NULL; }
+        //entity names are ASCII, so any non-ASCII byte will simply not match anything
+        wchar_t wideKey[HTML_ENTITY_MAX_LENGTH];
+        for (size_t i = 0; i < length; ++i)
+            { wideKey[i] = static_cast<unsigned char>(html_entity[i]); }
+        return find_entity(wideKey, length);
+        }
+
+    wchar_t html_entity_table::find(const wchar_t* html_entity, const size_t length) const
+        {
+        const html_utilities::html_entity* entry = find_entity(html_entity, length);
+        //if the character can't be converted, then return a question mark
+        return (entry == NULL) ? common_lang_constants::QUESTION_MARK : static_cast<wchar_t>(entry->m_code_point);
         }
 
     const wchar_t* javascript_hyperlink_parse::operator()()
         {
         //if the end is NULL (should not happen) or if the current position is NULL or at the terminator then we are done
-        if (!m_js_text_end || !m_js_text_start || m_js_text_start[0] == 0)
+        if (!m_js_text_end || !m_js_text_start || m_js_text_start >= m_js_text_end || m_js_text_start[0] == 0)
             { return NULL; }
 
         //jump over the previous link (and its trailing quote)
@@ -1445,11 +4196,13 @@ namespace html_utilities
 
         for (;;)
             {
-            m_js_text_start = string_util::strchr(m_js_text_start, common_lang_constants::DOUBLE_QUOTE);
-            if (m_js_text_start && m_js_text_start < m_js_text_end)
+            m_js_text_start = (m_js_text_start < m_js_text_end) ?
+                string_util::strnchr(m_js_text_start, common_lang_constants::DOUBLE_QUOTE, m_js_text_end-m_js_text_start) : NULL;
+            if (m_js_text_start)
                 {
-                const wchar_t* endQuote = string_util::strchr(++m_js_text_start, common_lang_constants::DOUBLE_QUOTE);
-                if (endQuote && endQuote < m_js_text_end)
+                ++m_js_text_start;
+                const wchar_t* endQuote = string_util::strnchr(m_js_text_start, common_lang_constants::DOUBLE_QUOTE, m_js_text_end-m_js_text_start);
+                if (endQuote)
                     {
                     m_current_hyperlink_length = (endQuote-m_js_text_start);
                     //see if the current link has a 3 or 4 character file extension on it--if not, this is not a link
@@ -1491,7 +4244,7 @@ namespace html_utilities
         //reset
         m_current_hyperlink_length = 0;
 
-        if (!m_html_text || m_html_text[0] == 0)
+        if (!m_html_text || m_html_text >= m_html_text_end || m_html_text[0] == 0)
             { return NULL; }
 
         while (m_html_text)
@@ -1499,7 +4252,7 @@ namespace html_utilities
             m_html_text = lily_of_the_valley::html_extract_text::find_element(m_html_text, m_html_text_end, HTML_IMAGE.c_str(), HTML_IMAGE.length());
             if (m_html_text)
                 {
-                std::pair<const wchar_t*,size_t> imageSrc = lily_of_the_valley::html_extract_text::read_tag(m_html_text, L"src", 3, false, true);
+                std::pair<const wchar_t*,size_t> imageSrc = lily_of_the_valley::html_extract_text::read_tag(m_html_text, L"src", 3, false, true, m_html_text_end);
                 if (imageSrc.first)
                     {
                     m_html_text = imageSrc.first;
@@ -1519,46 +4272,122 @@ namespace html_utilities
         return m_html_text = NULL;
         }
 
+    /*Counts the href and src attributes in HTML text (i.e., about how many links it has), by looking at
+    what is in front of each '='. This is cheap next to parsing the links, and is only used as a size hint.*/
+    static size_t count_link_attributes(const wchar_t* text, const wchar_t* const textEnd)
+        {
+        const wchar_t* const textStart = text;
+        size_t count = 0;
+        while ((text = std::find(text, textEnd, L'=')) != textEnd)
+            {
+            const wchar_t* nameEnd = text++;
+            while (nameEnd > textStart && lily_of_the_valley::is_markup_space(nameEnd[-1]))
+                { --nameEnd; }
+            if (((nameEnd-textStart) >= 4 && string_util::strnicmp<wchar_t>(nameEnd-4, L"href", 4) == 0) ||
+                ((nameEnd-textStart) >= 3 && string_util::strnicmp<wchar_t>(nameEnd-3, L"src", 3) == 0))
+                { ++count; }
+            }
+        return count;
+        }
+
+    void hyperlink_list::reserve(const size_t capacity)
+        {
+        if (capacity <= m_capacity)
+            { return; }
+        //the flags are bytes, so they are packed into as few values as they fit in
+        const size_t flagValues = (capacity+sizeof(size_t)-1)/sizeof(size_t);
+        std::vector<size_t> arena((2*capacity)+flagValues);
+        if (m_size > 0)
+            {
+            std::copy(get_offsets(), get_offsets()+m_size, &arena[0]);
+            std::copy(get_lengths(), get_lengths()+m_size, &arena[0]+capacity);
+            std::copy(get_flags(), get_flags()+m_size, reinterpret_cast<unsigned char*>(&arena[0]+(2*capacity)));
+            }
+        m_arena.swap(arena);
+        m_capacity = capacity;
+        }
+
+    html_hyperlink_parse::html_hyperlink_parse() :
+                m_html_text(NULL), m_html_text_end(NULL), m_current_hyperlink_length(0),
+                m_base(NULL), m_base_length(0), m_include_image_links(true), m_current_link_is_image(false),
+                m_current_link_is_javascript(false), m_current_link_is_frame(false),
+                m_current_link_is_meta_refresh(false), m_inside_of_script_section(false)
+        {}
+
     html_hyperlink_parse::html_hyperlink_parse(const wchar_t* html_text, const size_t length) :
-                m_html_text(html_text), m_html_text_end(html_text+length), m_current_hyperlink_length(0),
+                m_html_text(NULL), m_html_text_end(NULL), m_current_hyperlink_length(0),
                 m_base(NULL), m_base_length(0), m_include_image_links(true), m_current_link_is_image(false),
-                m_current_link_is_javascript(false), m_inside_of_script_section(false)
+                m_current_link_is_javascript(false), m_current_link_is_frame(false),
+                m_current_link_is_meta_refresh(false), m_inside_of_script_section(false)
+        { set(html_text, length); }
+
+    const hyperlink_list& html_hyperlink_parse::extract_all_links(const wchar_t* html_text, const size_t length)
+        {
+        set(html_text, length);
+        m_links.clear();
+        /*make room for the links that the page appears to have up front, so that it is usually only allocated once
+          (links that aren't in an href or src, such as JavaScript and meta refresh links, may still make add() grow it)*/
+        m_links.reserve(count_link_attributes(html_text, html_text+length));
+        const wchar_t* link = NULL;
+        while ((link = (*this)()) != NULL)
+            {
+            m_links.add(link-html_text, get_current_hyperlink_length(),
+                static_cast<unsigned char>((is_current_link_an_image() ? hyperlink_list::image_hyperlink : 0) |
+                    (is_current_link_a_javascript() ? hyperlink_list::javascript_hyperlink : 0) |
+                    (is_current_link_a_frame() ? hyperlink_list::frame_hyperlink : 0) |
+                    (is_current_link_a_meta_refresh() ? hyperlink_list::meta_refresh_hyperlink : 0)));
+            }
+        return m_links;
+        }
+
+    void html_hyperlink_parse::set(const wchar_t* html_text, const size_t length)
         {
+        m_html_text = html_text;
+        m_html_text_end = html_text+length;
+        m_current_hyperlink_length = 0;
+        m_base = NULL;
+        m_base_length = 0;
+        m_current_link_is_image = m_current_link_is_javascript = false;
+        m_current_link_is_frame = m_current_link_is_meta_refresh = false;
+        m_inside_of_script_section = false;
+        m_javascript_hyperlink_parse.set(NULL, 0);
         //see if there is a base url that should be used as an alternative that the client should use instead
-        const wchar_t* headStart = string_util::stristr<wchar_t>(m_html_text, L"<head");
+        if (!m_html_text || length == 0)
+            { return; }
+        const wchar_t* headStart = string_util::strnistr<wchar_t>(m_html_text, L"<head", length);
         if (!headStart)
             { return; }
-        const wchar_t* base = string_util::stristr<wchar_t>(headStart, L"<base");
+        const wchar_t* base = string_util::strnistr<wchar_t>(headStart, L"<base", m_html_text_end-headStart);
         if (!base)
             { return; }
-        base = string_util::stristr<wchar_t>(base, L"href=");
-        if (!base)
+        base = string_util::strnistr<wchar_t>(base, L"href=", m_html_text_end-base);
+        if (!base || base+6 >= m_html_text_end)
             { return; }
         const wchar_t firstLinkChar = base[5];
         base += 6;
         //eat any whitespace after href=
         for (;;)
             {
-            if (!std::iswspace(base[0]) || base[0] == 0)
+            if (base >= m_html_text_end || !std::iswspace(base[0]) || base[0] == 0)
                 { break; }
             ++base;
             }
-        if (base[0] == 0)
+        if (base >= m_html_text_end || base[0] == 0)
             { return; }
         //look for actual link
         const wchar_t* endQuote = NULL;
         if (firstLinkChar == common_lang_constants::DOUBLE_QUOTE ||
             firstLinkChar == common_lang_constants::APOSTROPHE)
-            { endQuote = string_util::strcspn_pointer<wchar_t>(base, L"\"\'", 2); }
+            { endQuote = base+string_util::strncspn<wchar_t>(base, m_html_text_end-base, L"\"\'", 2); }
         //if hackish author forgot to quote the link then look for matching space
         else
             {
             --base;
-            endQuote = string_util::strcspn_pointer<wchar_t>(base, L" \r\n\t>", 5);
+            endQuote = base+string_util::strncspn<wchar_t>(base, m_html_text_end-base, L" \r\n\t>", 5);
             }
 
         //if src is malformed then go to next one
-        if (!endQuote)
+        if (endQuote >= m_html_text_end)
             { return; }
         m_base = base;
         m_base_length = (endQuote-base);
@@ -1580,6 +4409,7 @@ namespace html_utilities
                 {
                 m_current_link_is_image = false;
                 m_current_link_is_javascript = false;
+                m_current_link_is_frame = false;
                 m_current_hyperlink_length = m_javascript_hyperlink_parse.get_current_hyperlink_length();
                 return currentLink;
                 }
@@ -1590,14 +4420,17 @@ namespace html_utilities
         m_current_hyperlink_length = 0;
         m_current_link_is_image = false;
         m_current_link_is_javascript = false;
+        m_current_link_is_frame = false;
+        m_current_link_is_meta_refresh = false;
         m_inside_of_script_section = false;
 
-        if (!m_html_text || m_html_text[0] == 0)
+        if (!m_html_text || m_html_text >= m_html_text_end || m_html_text[0] == 0)
             { return NULL; }
 
         for (;;)
             {
-            m_html_text = string_util::strchr(m_html_text, common_lang_constants::LESS_THAN);
+            m_html_text = (m_html_text < m_html_text_end) ?
+                string_util::strnchr(m_html_text, common_lang_constants::LESS_THAN, m_html_text_end-m_html_text) : NULL;
             if (m_html_text && m_html_text+1 < m_html_text_end)
                 {
                 //don't bother with termination element
@@ -1606,25 +4439,27 @@ namespace html_utilities
                     ++m_html_text;
                     continue;
                     }
-                m_current_link_is_image = lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_IMAGE.c_str(), HTML_IMAGE.length(), false);
-                m_inside_of_script_section = m_current_link_is_javascript = lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_SCRIPT.c_str(), HTML_SCRIPT.length(), false);
+                m_current_link_is_image = lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_IMAGE.c_str(), HTML_IMAGE.length(), false, m_html_text_end);
+                m_inside_of_script_section = m_current_link_is_javascript = lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_SCRIPT.c_str(), HTML_SCRIPT.length(), false, m_html_text_end);
                 if (m_inside_of_script_section)
                     {
-                    const wchar_t* endAngle = lily_of_the_valley::html_extract_text::find_close_tag(m_html_text);
-                    const wchar_t* endOfScriptSection = string_util::stristr<wchar_t>(m_html_text, HTML_SCRIPT_END.c_str());
-                    if (endAngle && (endAngle < m_html_text_end) &&
-                        endOfScriptSection && (endOfScriptSection < m_html_text_end))
+                    const wchar_t* endAngle = lily_of_the_valley::html_extract_text::find_close_tag(m_html_text, false, m_html_text_end);
+                    const wchar_t* endOfScriptSection = string_util::strnistr<wchar_t>(m_html_text, HTML_SCRIPT_END.c_str(), m_html_text_end-m_html_text);
+                    if (endAngle && endOfScriptSection)
                         { m_javascript_hyperlink_parse.set(endAngle, endOfScriptSection-endAngle); }
                     }
 
+                m_current_link_is_frame = !m_current_link_is_image && !m_current_link_is_javascript &&
+                    (lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_FRAME.c_str(), HTML_FRAME.length(), false, m_html_text_end)  ||
+                     lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_IFRAME.c_str(), HTML_IFRAME.length(), false, m_html_text_end));
+
                 //see if it is an IMG, Frame (sometimes they have a SRC to another HTML page), or JS link
                 if ((m_include_image_links && m_current_link_is_image) ||
                     m_current_link_is_javascript  ||
-                    lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_FRAME.c_str(), HTML_FRAME.length(), false)  ||
-                    lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_IFRAME.c_str(), HTML_IFRAME.length(), false))
+                    m_current_link_is_frame)
                     {
                     m_html_text += 4;
-                    std::pair<const wchar_t*,size_t> imageSrc = lily_of_the_valley::html_extract_text::read_tag(m_html_text, L"src", 3, false, true);
+                    std::pair<const wchar_t*,size_t> imageSrc = lily_of_the_valley::html_extract_text::read_tag(m_html_text, L"src", 3, false, true, m_html_text_end);
                     if (imageSrc.first)
                         {
                         m_html_text = imageSrc.first;
@@ -1639,6 +4474,7 @@ namespace html_utilities
                             {
                             m_current_link_is_image = false;
                             m_current_link_is_javascript = false;
+                            m_current_link_is_frame = false;
                             m_current_hyperlink_length = m_javascript_hyperlink_parse.get_current_hyperlink_length();
                             return currentLink;
                             }
@@ -1653,12 +4489,12 @@ namespace html_utilities
                         { continue; }
                     }
                 //...or it is an anchor link
-                else if (lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, L"a", 1, false) ||
-                    lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, L"link", 4, false) ||
-                    lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, L"area", 4, false) )
+                else if (lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, L"a", 1, false, m_html_text_end) ||
+                    lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, L"link", 4, false, m_html_text_end) ||
+                    lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, L"area", 4, false, m_html_text_end) )
                     {
                     ++m_html_text;//skip the <
-                    std::pair<const wchar_t*,size_t> href = lily_of_the_valley::html_extract_text::read_tag(m_html_text, L"href", 4, false, true);
+                    std::pair<const wchar_t*,size_t> href = lily_of_the_valley::html_extract_text::read_tag(m_html_text, L"href", 4, false, true, m_html_text_end);
                     if (href.first)
                         {
                         m_html_text = href.first;
@@ -1670,35 +4506,37 @@ namespace html_utilities
                         { continue; }
                     }
                 //...or a redirect in the HTTP meta section
-                else if (lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_META.c_str(), HTML_META.size(), false) )
+                else if (lily_of_the_valley::html_extract_text::compare_element(m_html_text+1, HTML_META.c_str(), HTML_META.size(), false, m_html_text_end) )
                     {
                     m_html_text += HTML_META.size() + 1;
                     std::wstring httpEquiv = lily_of_the_valley::html_extract_text::read_tag_as_string(m_html_text,
-                        L"http-equiv", 10, false);
+                        L"http-equiv", 10, false, false, m_html_text_end);
                     if (string_util::stricmp(httpEquiv.c_str(), L"refresh") == 0)
                         {
-                        const wchar_t* url = lily_of_the_valley::html_extract_text::find_tag(m_html_text, L"url=", 4, true);
-                        if (url && (url < m_html_text_end))
+                        const wchar_t* url = lily_of_the_valley::html_extract_text::find_tag(m_html_text, L"url=", 4, true, m_html_text_end);
+                        if (url)
                             {
                             m_html_text = url+4;
-                            if (m_html_text[0] == 0)
+                            if (m_html_text >= m_html_text_end || m_html_text[0] == 0)
                                 { return NULL; }
                             //eat up any whitespace or single quotes
                             for (;;)
                                 {
-                                if (m_html_text[0] == 0 ||
+                                if (m_html_text >= m_html_text_end || m_html_text[0] == 0 ||
                                     (!std::iswspace(m_html_text[0]) &&
                                     m_html_text[0] != common_lang_constants::APOSTROPHE))
                                     { break; }
                                 ++m_html_text;
                                 }
-                            if (m_html_text[0] == 0)
+                            if (m_html_text >= m_html_text_end || m_html_text[0] == 0)
                                 { return NULL; }
-                            const wchar_t* endOfTag = string_util::strcspn_pointer<wchar_t>(m_html_text, L"'\">", 3);
+                            const wchar_t* endOfTag = m_html_text+
+                                string_util::strncspn<wchar_t>(m_html_text, m_html_text_end-m_html_text, L"'\">", 3);
                             //if link is malformed then go to next one
-                            if (endOfTag == NULL || (endOfTag > m_html_text_end))
+                            if (endOfTag >= m_html_text_end)
                                 { continue; }
                             m_current_hyperlink_length = endOfTag - m_html_text;
+                            m_current_link_is_meta_refresh = true;
                             return m_html_text;
                             }
                         }
@@ -1871,11 +4709,9 @@ namespace html_utilities
         start = string_util::strchr(start, common_lang_constants::PERIOD);
         if (start == NULL || start[1] == 0)
             { return tld; }
-        const wchar_t* end = string_util::strcspn_pointer(++start, L"/?", 2);
-        if (end == NULL)
-            { tld.assign(start); }
-        else
-            { tld.assign(start, end-start); }
+        ++start;
+        //the length is known, so the search for the end of the domain can be vectorized
+        tld.assign(start, string_util::strncspn(start, string_util::strlen(start), L"/?", 2));
         return tld;
         }
 
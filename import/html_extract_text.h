@@ -32,11 +32,24 @@ namespace html_utilities
         std::map<wchar_t, wchar_t> m_symbol_table;
         };
 
-    /**@brief Class to convert an HTML entity (e.g., "&amp;") to its literal value.*/
+    /**@brief An HTML entity's name and the unicode value(s) that it maps to.
+    @details A handful of HTML5 entities (e.g., "&acE;") map to two code points,
+    in which case m_second_code_point will be non-zero.*/
+    struct html_entity
+        {
+        const wchar_t* m_name;
+        size_t m_name_length;
+        unsigned int m_code_point;
+        unsigned int m_second_code_point;
+        };
+
+    /**@brief Class to convert an HTML entity (e.g., "&amp;") to its literal value.
+    @details The full HTML5 set of named entities is stored in a constant, sorted array
+    (so there is no start-up cost), and lookups are binary searches that do not allocate anything.*/
     class html_entity_table
         {
     public:
-        html_entity_table();
+        html_entity_table() {}
         /**@returns The unicode value of an entity, or '?' if not valid.
         @param html_entity The entity to look up.*/
         wchar_t operator[](const wchar_t* html_entity) const
@@ -50,10 +63,20 @@ namespace html_utilities
         before XHTML, most HTML was very liberal with casing, so if a case sensitve search fails,
         then a case insensitive search is performed. In this case, whatever the HTML author's
         intention for something like "&SIGMA;" may be misinterpretted (should it be a lowercase or
-        uppercase sigma symbol?)--the price you pay for sloppy HTML.*/
+        uppercase sigma symbol?)--the price you pay for sloppy HTML.
+        @warning Only the first code point of the entity is returned, so call find_entity() for
+        entities that map to two code points or to characters outside of the Basic Multilingual Plane.*/
         wchar_t find(const wchar_t* html_entity, const size_t length) const;
-    private:
-        std::map<std::wstring, wchar_t> m_table;
+        /**Searches for an entity (using the same casing rules as find()).
+        @returns The entity's entry in the table, or NULL if not found.
+        @param html_entity The entity to look up.
+        @param length The length of the entity string.*/
+        const html_entity* find_entity(const wchar_t* html_entity, const size_t length) const;
+        /**Searches for an entity in UTF-8 text (using the same casing rules as find()).
+        @returns The entity's entry in the table, or NULL if not found.
+        @param html_entity The entity to look up.
+        @param length The length of the entity string.*/
+        const html_entity* find_entity(const char* html_entity, const size_t length) const;
         };
 
     /**@brief Functor that accepts a block of script text and returns the links in it, one-by-one.
@@ -114,15 +137,120 @@ namespace html_utilities
         size_t m_current_hyperlink_length;
         };
 
+    /**@brief The links found by html_hyperlink_parse::extract_all_links(), stored as parallel arrays
+        (offsets, lengths, and flags) in one block of memory.
+    @details The links are not copied; each one is an offset (and length) into the HTML text that was parsed,
+        so they are only valid while that text is. The block is kept when the list is cleared, so reusing
+        the same list for each page only allocates again when a page has more links than the ones before it.*/
+    class hyperlink_list
+        {
+    public:
+        ///@brief Flags describing where a link came from (a link from an anchor, link, or area element has none).
+        enum hyperlink_flags
+            {
+            ///No flags.
+            no_hyperlink_flags = 0,
+            ///The source of an image.
+            image_hyperlink = 1,
+            ///The source of a script.
+            javascript_hyperlink = 2,
+            ///The source of a frame or iframe.
+            frame_hyperlink = 4,
+            ///A redirect from a meta refresh.
+            meta_refresh_hyperlink = 8
+            };
+        ///Constructor.
+        hyperlink_list() : m_size(0), m_capacity(0)
+            {}
+        ///@returns The number of links.
+        size_t size() const
+            { return m_size; }
+        ///@returns Whether there are no links.
+        bool empty() const
+            { return (m_size == 0); }
+        ///@returns The number of links that fit in the block without it being reallocated.
+        size_t capacity() const
+            { return m_capacity; }
+        ///@returns Where each link starts in the HTML text (an array of size() values).
+        const size_t* get_offsets() const
+            { return (m_capacity > 0) ? &m_arena[0] : NULL; }
+        ///@returns The length of each link (an array of size() values).
+        const size_t* get_lengths() const
+            { return (m_capacity > 0) ? &m_arena[0]+m_capacity : NULL; }
+        ///@returns Each link's flags, a combination of hyperlink_flags values (an array of size() values).
+        const unsigned char* get_flags() const
+            { return (m_capacity > 0) ? reinterpret_cast<const unsigned char*>(&m_arena[0]+(2*m_capacity)) : NULL; }
+        /**@returns A link's offset into the HTML text.
+           @param index The link's index.*/
+        size_t get_offset(const size_t index) const
+            {
+            assert(index < m_size && "Invalid index passed to hyperlink_list::get_offset().");
+            return get_offsets()[index];
+            }
+        /**@returns A link's length.
+           @param index The link's index.*/
+        size_t get_length(const size_t index) const
+            {
+            assert(index < m_size && "Invalid index passed to hyperlink_list::get_length().");
+            return get_lengths()[index];
+            }
+        /**@returns Whether a link has a flag.
+           @param index The link's index.
+           @param flag The flag to check for.*/
+        bool has_flag(const size_t index, const hyperlink_flags flag) const
+            {
+            assert(index < m_size && "Invalid index passed to hyperlink_list::has_flag().");
+            return (get_flags()[index] & flag) != 0;
+            }
+        ///Removes the links, but keeps the block that they were stored in.
+        void clear()
+            { m_size = 0; }
+        /**Makes sure that the block can hold a number of links (keeping the ones already in it).
+           @param capacity The number of links to make room for.*/
+        void reserve(const size_t capacity);
+        /**Adds a link.
+           @param offset Where the link starts in the HTML text.
+           @param length The length of the link.
+           @param flags The link's flags (a combination of hyperlink_flags values).*/
+        void add(const size_t offset, const size_t length, const unsigned char flags)
+            {
+            if (m_size == m_capacity)
+                { reserve(std::max<size_t>(m_capacity*2, 16)); }
+            size_t* const offsets = &m_arena[0];
+            offsets[m_size] = offset;
+            offsets[m_capacity+m_size] = length;
+            reinterpret_cast<unsigned char*>(offsets+(2*m_capacity))[m_size] = flags;
+            ++m_size;
+            }
+    private:
+        //the offsets, then the lengths, and then the flags (packed into as many values as they need)
+        std::vector<size_t> m_arena;
+        size_t m_size;
+        size_t m_capacity;
+        };
+
     /**@brief Functor that accepts a block of HTML text and returns the links in it, one-by-one.
     Links will include base hrefs, link hrefs, anchor hrefs, image map hrefs, image links, javascript links, and HTTP redirects.*/
     class html_hyperlink_parse
         {
     public:
+        ///Empty constructor.
+        html_hyperlink_parse();
         /**Constructor.
            @param html_text The HTML text to analyze.
            @param length The length of html_text.*/
         html_hyperlink_parse(const wchar_t* html_text, const size_t length);
+        /**Sets the HTML text to analyze, starting over from the beginning of it.
+           @param html_text The HTML text to analyze.
+           @param length The length of html_text.*/
+        void set(const wchar_t* html_text, const size_t length);
+        /**Reads all of the links from an HTML buffer in one pass (the same links, in the same order,
+           that calling operator() until it returns NULL would).
+           @param html_text The HTML text to analyze. This is also set as the text to analyze (see set()).
+           @param length The length of html_text.
+           @returns The links, as offsets into @c html_text. This list is reused by the next call
+            (its memory is kept), so it is only valid until then.*/
+        const hyperlink_list& extract_all_links(const wchar_t* html_text, const size_t length);
         ///@returns The base web directory.
         const wchar_t* get_base_url() const
             { return m_base; }
@@ -145,6 +273,12 @@ namespace html_utilities
         /**@returns True if the current hyperlink is pointing to a javascript.*/
         inline bool is_current_link_a_javascript() const
             { return m_current_link_is_javascript; }
+        /**@returns True if the current hyperlink is the source of a frame or iframe.*/
+        inline bool is_current_link_a_frame() const
+            { return m_current_link_is_frame; }
+        /**@returns True if the current hyperlink is a redirect from a meta refresh.*/
+        inline bool is_current_link_a_meta_refresh() const
+            { return m_current_link_is_meta_refresh; }
         /**Finds the end of an url by searching for the first illegal character.
            @param text the HTML text to analyze.
            @returns The valid end of the URL (i.e., the first illegal character).*/
@@ -185,8 +319,11 @@ namespace html_utilities
         bool m_include_image_links;
         bool m_current_link_is_image;
         bool m_current_link_is_javascript;
+        bool m_current_link_is_frame;
+        bool m_current_link_is_meta_refresh;
         bool m_inside_of_script_section;
         javascript_hyperlink_parse m_javascript_hyperlink_parse;
+        hyperlink_list m_links;
         };
 
     /**@brief Wrapper class to generically handle hyperlink parsing for either javascript or HTML files.*/
@@ -212,10 +349,10 @@ namespace html_utilities
             return (get_parse_method() == html) ? m_html_hyperlink_parse() : m_javascript_hyperlink_parse();
             }
         /**@returns The HTML parser.*/
-        html_hyperlink_parse get_html_parser() const
+        const html_hyperlink_parse& get_html_parser() const
             { return m_html_hyperlink_parse; }
         /**@return The Javascript parser.*/
-        javascript_hyperlink_parse get_script_parser() const
+        const javascript_hyperlink_parse& get_script_parser() const
             { return m_javascript_hyperlink_parse; }
         /**@return The parsing method, either html or script.*/
         hyperlink_parse_method get_parse_method() const
@@ -342,8 +479,338 @@ namespace html_utilities
         { return (character > 127 /*extended ASCII*/ || character < 33 /*control characters and space*/); }
     }
 
+/**Selects the narrow or wide version of a string literal, based on a character type.
+   This lets the same parsing code run over either wchar_t or UTF-8 (char) markup.
+   @param T The character type (char or wchar_t).
+   @param str The (narrow) string literal.*/
+#define MARKUP_LITERAL(T, str) lily_of_the_valley::select_literal<T>(str, L##str)
+
 namespace lily_of_the_valley
     {
+    ///@returns The version of a string literal matching the character type. Use MARKUP_LITERAL() instead of calling this directly.
+    template<typename T>
+    inline const T* select_literal(const char* narrow, const wchar_t* wide);
+    template<>
+    inline const char* select_literal<char>(const char* narrow, const wchar_t*)
+        { return narrow; }
+    template<>
+    inline const wchar_t* select_literal<wchar_t>(const char*, const wchar_t* wide)
+        { return wide; }
+
+    ///@returns Whether a character in a markup stream is whitespace.
+    inline bool is_markup_space(const wchar_t ch)
+        { return std::iswspace(ch) != 0; }
+    /**@returns Whether a byte in a UTF-8 markup stream is whitespace.
+       @note Only ASCII whitespace is considered, bytes from multibyte sequences never are.*/
+    inline bool is_markup_space(const char ch)
+        {
+        return (static_cast<unsigned char>(ch) < 0x80 &&
+                std::isspace(static_cast<unsigned char>(ch)) != 0);
+        }
+
+    /**@brief IDs of the elements that the extractors give special treatment to.
+    @details Call html_extract_text::classify_element() to look up an element's ID.
+    HTML elements are matched case insensitively and XML elements (e.g., WordprocessingML)
+    are matched case sensitively. Closing HTML elements (e.g., "/p") have their own IDs,
+    as do the closing XML elements that an extractor needs to track.*/
+    enum markup_element
+        {
+        unknown_element,
+        //HTML sections whose content is skipped
+        html_script,
+        html_noscript,
+        html_style,
+        html_title,
+        //HTML formatting
+        html_pre,
+        html_font,
+        html_br,
+        html_p,
+        html_table,
+        html_hr,
+        html_div,
+        html_ol,
+        html_ul,
+        html_dl,
+        html_h1,
+        html_h2,
+        html_h3,
+        html_h4,
+        html_h5,
+        html_h6,
+        html_select,
+        html_option,
+        html_dt,
+        html_tr,
+        html_li,
+        html_dd,
+        html_td,
+        //HTML elements that link to other files
+        html_a,
+        html_img,
+        html_link,
+        html_area,
+        html_frame,
+        html_iframe,
+        html_base,
+        html_meta,
+        //closing HTML elements
+        html_p_end,
+        html_table_end,
+        html_h1_end,
+        html_h2_end,
+        html_h3_end,
+        html_h4_end,
+        html_h5_end,
+        html_h6_end,
+        html_div_end,
+        html_dl_end,
+        html_select_end,
+        html_ol_end,
+        html_ul_end,
+        /*"</pre>" is found while reading the text in front of it, so this is not returned
+          from classify_element(). It is only sent to html_event_handler::on_block_end().*/
+        html_pre_end,
+        //XML comment ("!--")
+        xml_comment,
+        //XML CDATA section ("![CDATA["). This is not returned from classify_element(),
+        //it is only used to track a section that is still being read from a stream.
+        xml_cdata,
+        //WordprocessingML
+        docx_instr_text,
+        docx_pos_offset,
+        docx_p,
+        docx_p_style,
+        docx_tab,
+        docx_br,
+        docx_cr,
+        docx_jc,
+        docx_ind,
+        docx_tr,
+        docx_tc,
+        docx_tc_end,
+        docx_t,
+        //DrawingML (PowerPoint slides)
+        pptx_p,
+        pptx_p_end,
+        pptx_p_pr,
+        pptx_p_pr_end,
+        pptx_bu_none,
+        pptx_r,
+        pptx_r_end,
+        pptx_t,
+        pptx_t_end,
+        pptx_br
+        };
+
+    /**@brief Non-owning view of an element's name and attribute section inside of a markup buffer.
+    @details This is returned from html_extract_text::read_element() and only points into the buffer
+    being parsed, so reading an element this way does not copy or allocate anything. The view is only
+    valid for as long as the buffer that it was read from. The buffer can either be wchar_t or UTF-8 (char) text.*/
+    template<typename T>
+    class basic_html_element_view
+        {
+    public:
+        ///Default constructor.
+        basic_html_element_view() : m_name(NULL), m_name_length(0),
+                                    m_attributes(NULL), m_attributes_length(0), m_close_tag(NULL)
+            {}
+        /**Constructor.
+           @param name The start of the element's name.
+           @param name_length The length of the element's name.
+           @param attributes The start of the element's attribute section.
+           @param attributes_length The length of the attribute section.
+           @param close_tag The '>' terminating the element, or NULL if it isn't properly terminated.*/
+        basic_html_element_view(const T* name, const size_t name_length,
+                                const T* attributes, const size_t attributes_length,
+                                const T* close_tag) :
+            m_name(name), m_name_length(name_length),
+            m_attributes(attributes), m_attributes_length(attributes_length), m_close_tag(close_tag)
+            {}
+        ///@returns The start of the element's name (not NULL terminated).
+        const T* get_name() const
+            { return m_name; }
+        ///@returns The length of the element's name.
+        size_t get_name_length() const
+            { return m_name_length; }
+        ///@returns The length of the element's name (same as get_name_length()).
+        size_t length() const
+            { return m_name_length; }
+        ///@returns Whether the element has no name.
+        bool empty() const
+            { return m_name_length == 0; }
+        /**@returns The character from the element's name at the specified position.
+           @param position The index into the name. Must be less than length().*/
+        T operator[](const size_t position) const
+            {
+            assert(position < m_name_length);
+            return m_name[position];
+            }
+        /**@returns The start of the attribute section (i.e., the text after the element's name
+           up to the terminating '>'), or NULL if there is no name.*/
+        const T* get_attributes() const
+            { return m_attributes; }
+        ///@returns The length of the attribute section.
+        size_t get_attributes_length() const
+            { return m_attributes_length; }
+        /**@returns The '>' terminating the element, or NULL if another '<' (or the end of the buffer)
+           was encountered first.*/
+        const T* get_close_tag() const
+            { return m_close_tag; }
+        /**@returns Whether the element closes itself (e.g., "<br />"), meaning that the
+           last non-space character in front of the terminating '>' is a '/'.
+           Returns false if the element isn't properly terminated.*/
+        bool is_self_terminating() const
+            {
+            if (m_close_tag == NULL)
+                { return false; }
+            const T* lastCharacter = m_attributes+m_attributes_length;
+            while (lastCharacter > m_attributes)
+                {
+                --lastCharacter;
+                if (!is_markup_space(*lastCharacter))
+                    { return (*lastCharacter == common_lang_constants::FORWARD_SLASH); }
+                }
+            return false;
+            }
+        /**Compares (case sensitively) the element's name with a string constant.
+           @param element The element name to compare against.
+           @param element_size The length of element.
+           @returns True if the names are the same.*/
+        bool compare(const wchar_t* element, const size_t element_size) const
+            {
+            if (m_name_length != element_size)
+                { return false; }
+            //element names are ASCII, so they can be compared against either wide or UTF-8 text
+            for (size_t i = 0; i < element_size; ++i)
+                {
+                if (static_cast<wchar_t>(m_name[i]) != element[i])
+                    { return false; }
+                }
+            return true;
+            }
+        /**Compares (case insensitively) the element's name with a string constant.
+           @param element The element name to compare against.
+           @param element_size The length of element.
+           @returns True if the names are the same.*/
+        bool comparei(const wchar_t* element, const size_t element_size) const
+            {
+            if (m_name_length != element_size)
+                { return false; }
+            for (size_t i = 0; i < element_size; ++i)
+                {
+                if (string_util::tolower(static_cast<wchar_t>(m_name[i])) != string_util::tolower(element[i]))
+                    { return false; }
+                }
+            return true;
+            }
+        /**Compares (case sensitively) the element's name with a string literal.
+           @param element The element name to compare against.
+           @returns True if the names are the same.*/
+        template<size_t N>
+        bool operator==(const wchar_t (&element)[N]) const
+            { return compare(element, N-1); }
+        /**Compares (case sensitively) the element's name with a string literal.
+           @param element The element name to compare against.
+           @returns True if the names are not the same.*/
+        template<size_t N>
+        bool operator!=(const wchar_t (&element)[N]) const
+            { return !compare(element, N-1); }
+    private:
+        const T* m_name;
+        size_t m_name_length;
+        const T* m_attributes;
+        size_t m_attributes_length;
+        const T* m_close_tag;
+        };
+
+    ///View of an element in a wide markup buffer.
+    typedef basic_html_element_view<wchar_t> html_element_view;
+
+    /**@brief Interface for receiving the structure of an HTML document as html_extract_text parses it
+        (e.g., to build an outline of its headings, or to index its fields, while its text is extracted).
+    @details Override the events that you need (they all do nothing by default) and pass the handler to
+        html_extract_text::set_event_handler(). The events are sent in the order that the parser reads
+        the document, from the same pass that extracts the text.
+
+        The text runs (along with the decoded entities) are the extracted text, minus the newlines and tabs
+        that the parser adds for paragraphs and table cells (which are sent as the structural events instead).
+        A run's text points into the extractor's output buffer and is only valid during the call,
+        so a handler can follow the document without the whole text being kept.
+    @par Example:
+    @code
+        class outline_builder : public lily_of_the_valley::html_event_handler
+            {
+        public:
+            void on_heading_start(const size_t level)
+                { m_current_heading.clear(); m_current_level = level; }
+            void on_text(const wchar_t* text, const size_t length)
+                { m_current_heading.append(text, length); }
+            //...
+            };
+
+        outline_builder outline;
+        lily_of_the_valley::html_extract_text htmlExtract;
+        htmlExtract.set_event_handler(&outline);
+        htmlExtract(page, pageLength, true, false);
+    @endcode*/
+    class html_event_handler
+        {
+    public:
+        ///Destructor.
+        virtual ~html_event_handler() {}
+        /**Called when a block (e.g., a paragraph, div, table, list, or preformatted section) starts.
+           @param element The element starting the block (e.g., html_p or html_ul).
+           @note Only blocks that have a closing ID (e.g., html_p and html_p_end) are reported here.
+            Elements without an end (e.g., @c hr, @c dt, and @c option) are sent to their own events.*/
+        virtual void on_block_start(const markup_element /*element*/)
+            {}
+        /**Called when a block ends.
+           @param element The closing element (e.g., html_p_end, html_pre_end, or html_ul_end).
+           @note This is sent for each closing element that is read, so HTML that leaves a block
+            unclosed (e.g., a @c p followed by another @c p) will have a start without an end.*/
+        virtual void on_block_end(const markup_element /*element*/)
+            {}
+        /**Called when a heading starts.
+           @param level The heading's level (1-6).*/
+        virtual void on_heading_start(const size_t /*level*/)
+            {}
+        /**Called when a heading ends.
+           @param level The heading's level (1-6).*/
+        virtual void on_heading_end(const size_t /*level*/)
+            {}
+        ///Called when a list item (or a definition term, a definition, or a select list's option) starts.
+        virtual void on_list_item()
+            {}
+        ///Called for a horizontal rule (@c hr).
+        virtual void on_horizontal_rule()
+            {}
+        ///Called when a table row starts.
+        virtual void on_table_row()
+            {}
+        ///Called when a table cell starts.
+        virtual void on_table_cell()
+            {}
+        ///Called for a line break.
+        virtual void on_line_break()
+            {}
+        /**Called for each run of text (adjacent runs may be sent in separate calls, such as when streaming).
+           @param text The text, which is only valid during this call.
+           @param length The length of @c text.*/
+        virtual void on_text(const wchar_t* /*text*/, const size_t /*length*/)
+            {}
+        /**Called for the text that an entity (e.g., <tt>&amp;amp;</tt>) was decoded to.
+           @param text The decoded text, which is only valid during this call.
+           @param length The length of @c text.*/
+        virtual void on_entity(const wchar_t* /*text*/, const size_t /*length*/)
+            {}
+        /**Called for each link (i.e., the @c href of an @c a element).
+           @param url The link, as it appears in the document (which is only valid during this call).
+           @param length The length of @c url.*/
+        virtual void on_link(const wchar_t* /*url*/, const size_t /*length*/)
+            {}
+        };
+
     /**@brief Class to extract text from an <b>HTML</b> stream.
     @par Example:
     @code
@@ -359,21 +826,14 @@ namespace lily_of_the_valley
         fs.seekg(0, std::ios::beg);
         fs.read(fileContents, fileSize);
 
-        //...then convert it to a Unicode buffer.
-        //Note that you should use the specified character set
-        //in the HTML file (usually UTF-8) when loading this file into a wchar_t buffer.
-        //Here we are using the standard mbstowcs() function which assumes the current
-        //system's character set; however, it is recommended to parse the character set
-        //from the HTML file (with parse_charset()) and use a
-        //system-dependent function (e.g., MultiByteToWideChar() on Win32)
-        //to properly convert the char buffer to Unicode using that character set.
-        wchar_t* convertedFileContents = new wchar_t[fileSize+1];
-        std::auto_ptr<wchar_t> deleteConvertedBuffer(convertedFileContents);
-        const size_t convertedFileSize = std::mbstowcs(convertedFileContents, fileContents, fileSize);
+        //...UTF-8 (the most common encoding for HTML) can be passed in as-is.
+        //For other character sets (see parse_charset()), use a system-dependent
+        //function (e.g., MultiByteToWideChar() on Win32) to convert the char buffer
+        //to Unicode and pass in that wchar_t buffer instead.
 
-        //convert the Unicode HTML data into raw text
+        //convert the UTF-8 HTML data into raw text
         lily_of_the_valley::html_extract_text htmlExtract;
-        htmlExtract(convertedFileContents, convertedFileSize, true, false);
+        htmlExtract(fileContents, fileSize, true, false);
         //The raw text from the file is now in a Unicode buffer.
         //This buffer can be accessed from get_filtered_text() and its length
         //from get_filtered_text_length(). Call these to copy the text into
@@ -383,7 +843,26 @@ namespace lily_of_the_valley
     @endcode*/
     class html_extract_text : public extract_text
         {
+        /*where the parser is in the markup when it stops at the end of the text that it was given
+          (declared up here, because segment_state holds one)*/
+        enum markup_parse_state
+            {
+            //at the start of an element
+            element_parse_state,
+            //in the text after an element
+            text_parse_state,
+            //in text that is outside of (or not really) an element, such as a stray '<'
+            plain_text_parse_state,
+            //in a comment, script, noscript, style, title, or CDATA section
+            section_parse_state
+            };
     public:
+        ///Constructor.
+        html_extract_text() : m_is_in_preformatted_text_block_stack(0),
+            m_parse_state(element_parse_state), m_open_section(unknown_element),
+            m_is_symbol_font_section(false), m_element_scan_length(0), m_is_streaming(false), m_streamed_length(0),
+            m_event_handler(NULL), m_is_holding_text_events(false)
+            {}
         /**Main interface for extracting plain text from an HTML buffer.
         @param html_text The HTML text to strip.
         @param text_length The length of the HTML text.
@@ -395,6 +874,120 @@ namespace lily_of_the_valley
                                   const size_t text_length,
                                   const bool include_outer_text,
                                   const bool preserve_spaces);
+        /**Main interface for extracting plain text from a UTF-8 HTML buffer.
+        @details The markup is parsed directly from the UTF-8 bytes, only the text between the elements
+        is decoded. This avoids having to convert the entire file into a wchar_t buffer first.
+        @param html_text The UTF-8 HTML text to strip.
+        @param text_length The length (in bytes) of the HTML text.
+        @param include_outer_text Whether text outside of the first and last <> should be included. Recommended true.
+        @param preserve_spaces Whether embedded newlines should be included in the output. If false,
+        then they will be replaced with spaces, which is the default for HTML renderers. Recommended false.
+        @returns The plain text from the HTML stream.*/
+        const wchar_t* operator()(const char* html_text,
+                                  const size_t text_length,
+                                  const bool include_outer_text,
+                                  const bool preserve_spaces);
+        /**Starts extracting text from an HTML stream that will be passed in as a series of chunks
+        (e.g., as they are read from a socket), instead of as one buffer. Pass each chunk to feed()
+        and then call finish() once the stream is complete.
+        @param preserve_spaces Whether embedded newlines should be included in the output. If false,
+        then they will be replaced with spaces, which is the default for HTML renderers. Recommended false.
+        @note Calling this is optional when not preserving spaces, the first call to feed() will start the stream.*/
+        void begin_stream(const bool preserve_spaces = false);
+        /**Sets a handler to send the document's structure (paragraphs, headings, links, runs of text, etc.)
+           to as it is parsed (see html_event_handler).
+           @param handler The handler to send the events to, or NULL to stop sending them (which is the default).
+            The caller owns the handler, which must outlive this object (or until another handler is set).*/
+        void set_event_handler(html_event_handler* handler)
+            { m_event_handler = handler; }
+        ///@returns The handler that the document's structure is being sent to, or NULL if there isn't one.
+        html_event_handler* get_event_handler() const
+            { return m_event_handler; }
+        /**Extracts the text from the next chunk of an HTML stream.
+        @details Parsing picks up where the previous chunk left off, so a chunk may end anywhere
+        (e.g., inside of an element, comment, script, or CDATA section, or in the middle of an entity).
+        Only the unfinished construct at the end of a chunk is held onto until the next chunk,
+        so memory use depends on the size of the chunks (and of the longest element), not of the document.
+        An unfinished element (e.g., an @c img with a long @c data: URI) is held onto until its end is read,
+        since its attributes are needed; for a comment, script, style, or CDATA section,
+        only the few characters that may be the start of its terminator are held onto.
+        To keep the output from growing with the document as well, have the text handed off
+        as it is parsed with a callback_text_sink (see set_text_sink()).
+        Otherwise, the text is accumulated and available after calling finish().
+        @param html_chunk The next chunk of HTML text. This does not need to be NULL terminated.
+        @param chunk_length The length of the chunk.
+        @note Text outside of the first and last element is always included when streaming,
+        as there is no way to know which element will be the last one until the stream is finished.*/
+        void feed(const wchar_t* html_chunk, const size_t chunk_length);
+        /**Extracts the text from the next chunk of a UTF-8 HTML stream.
+        @details This is the same as the wchar_t version of feed(), and a chunk may also end in the
+        middle of a multibyte character. A stream must be fed either all wchar_t or all UTF-8 chunks.
+        @param html_chunk The next chunk of UTF-8 HTML text. This does not need to be NULL terminated.
+        @param chunk_length The length (in bytes) of the chunk.*/
+        void feed(const char* html_chunk, const size_t chunk_length);
+        /**Finishes extracting text from an HTML stream, parsing anything that was waiting on the rest of the stream.
+        @returns The plain text from the HTML stream (or, if using a callback_text_sink, whatever had not been handed off yet).*/
+        const wchar_t* finish();
+        ///@brief The state that is carried from one segment of an HTML document to the next (see extract_segment()).
+        struct segment_state
+            {
+            /**Constructor.
+               @param is_document_start Whether this is the state at the start of a document (the default).
+                If false, then this is the state right after an element that isn't inside of a preformatted,
+                script, style, comment, etc. section.
+               @param preserve_spaces Whether embedded newlines should be included in the output.*/
+            explicit segment_state(const bool is_document_start = true, const bool preserve_spaces = false) :
+                m_parse_state(is_document_start ? element_parse_state : text_parse_state),
+                m_open_section(unknown_element), m_is_symbol_font_section(false),
+                m_preformatted_depth(preserve_spaces ? 1 : 0), m_is_document_start(is_document_start)
+                {}
+            ///@returns Whether two states are the same.
+            bool operator==(const segment_state& that) const
+                {
+                return (m_parse_state == that.m_parse_state &&
+                        m_open_section == that.m_open_section &&
+                        m_is_symbol_font_section == that.m_is_symbol_font_section &&
+                        m_preformatted_depth == that.m_preformatted_depth &&
+                        m_is_document_start == that.m_is_document_start);
+                }
+        private:
+            friend class html_extract_text;
+            markup_parse_state m_parse_state;
+            markup_element m_open_section;
+            bool m_is_symbol_font_section;
+            size_t m_preformatted_depth;
+            bool m_is_document_start;
+            };
+        /**Extracts the text from a segment of an HTML document, as if the text in front of it
+           had already been read. Extracting the segments of a document one after another (passing each one's
+           end state to the next) gives the same text as operator(); this is how html_parallel_extract_text
+           splits up a large document.
+        @param html_text The start of the segment.
+        @param text_length The length of the segment.
+        @param include_outer_text Whether text outside of the first and last <> should be included
+            (only used by the first and last segments).
+        @param start_state The state at the start of the segment (i.e., the end state of the segment before it).
+        @param is_final Whether the segment is the end of the document. If false, then whatever is cut off
+            at the end of the segment (e.g., half of an element, or the end of a comment) is not read.
+        @param[out] end_state The state at the end of the segment.
+        @returns The number of characters (from @c html_text) that were read. If less than @c text_length, then
+            the segment was cut off in the middle of something and the rest of it should be extracted
+            along with the next segment.
+        @note The segment's text is available from get_filtered_text() afterwards.
+            Budgets (see set_budget()) are not applied to segments.*/
+        size_t extract_segment(const wchar_t* html_text, const size_t text_length, const bool include_outer_text,
+                               const segment_state& start_state, const bool is_final, segment_state& end_state);
+        /**Extracts the text from a segment of a UTF-8 HTML document, as if the text in front of it
+           had already been read.
+        @param html_text The start of the segment.
+        @param text_length The length (in bytes) of the segment.
+        @param include_outer_text Whether text outside of the first and last <> should be included.
+        @param start_state The state at the start of the segment.
+        @param is_final Whether the segment is the end of the document.
+        @param[out] end_state The state at the end of the segment.
+        @returns The number of bytes (from @c html_text) that were read.*/
+        size_t extract_segment(const char* html_text, const size_t text_length, const bool include_outer_text,
+                               const segment_state& start_state, const bool is_final, segment_state& end_state);
         /**Compares (case insensitively) raw HTML text with an element constant to see if the current element that
         we are on is the one we are looking for.
         @param text The current position in the HTML buffer that we are examining.
@@ -404,11 +997,14 @@ namespace lily_of_the_valley
         (i.e., don't have a matching </[element]>, but rather end where it is declared). For example,
         "<br />" is a self-terminating element. You would set this to false if you only want to read
         text inbetween opening an closing tags.
+        @param endSentinel The end of the HTML stream. If NULL, then the stream is read until its NULL terminator.
         @returns True if the current position matches the element.
         @note Be sure to skip the starting '<' first.*/
-        static bool compare_element(const wchar_t* text, const wchar_t* element,
+        template<typename T>
+        static bool compare_element(const T* text, const T* element,
                                    const size_t element_size,
-                                   const bool accept_self_terminating_elements = false);
+                                   const bool accept_self_terminating_elements = false,
+                                   const T* endSentinel = NULL);
         /**Compares (case sensitively) raw HTML text with an element constant to see if the current element that
         we are on is the one we are looking for. Be sure to skip the starting '<' first.
         @param text The current position in the HTML buffer that we are examining.
@@ -418,22 +1014,60 @@ namespace lily_of_the_valley
         (i.e., don't have a matching </[element]>, but rather end where it is declared). For example,
         "<br />" is a self-terminating element. You would set this to false if you only want to read
         text inbetween opening an closing tags.
+        @param endSentinel The end of the HTML stream. If NULL, then the stream is read until its NULL terminator.
         @returns True if the current position matches the element.
         @note This function is case sensitive, so it should only be used for XML or strict HTML 4.0.*/
-        static bool compare_element_case_sensitive(const wchar_t* text, const wchar_t* element,
+        template<typename T>
+        static bool compare_element_case_sensitive(const T* text, const T* element,
                                    const size_t element_size,
-                                   const bool accept_self_terminating_elements = false);
+                                   const bool accept_self_terminating_elements = false,
+                                   const T* endSentinel = NULL);
         /**@returns The current element that the stream is on. This assumes that you have
            already skipped the leading < symbol.
            @param text The HTML stream to analyze.
-           @param accept_self_terminating_elements Whether to analyze element such as "<br />.*/
+           @param accept_self_terminating_elements Whether to analyze element such as "<br />.
+           @param endSentinel The end of the HTML stream. If NULL, then the stream is read until its NULL terminator.*/
         static std::wstring get_element_name(const wchar_t* text,
-                                             const bool accept_self_terminating_elements = true);
+                                             const bool accept_self_terminating_elements = true,
+                                             const wchar_t* endSentinel = NULL);
+        /**Reads the element that the stream is on, without copying anything. This assumes that you have
+           already skipped the leading < symbol.
+           @param text The HTML stream to analyze.
+           @param endSentinel The end of the HTML stream. If NULL, then the stream is read until its NULL terminator.
+           @param accept_self_terminating_elements Whether to analyze element such as "<br />.
+            If true, then the "/" will not be included in the element's name.
+           @returns A view of the element's name, its attribute section, and its terminating '>'.
+            The terminating '>' will be NULL if another '<' is found before it (the same as calling
+            find_close_tag() with <i>fail_on_overlapping_open_symbol</i> set to true).*/
+        template<typename T>
+        static basic_html_element_view<T> read_element(const T* text,
+                                                       const T* endSentinel,
+                                                       const bool accept_self_terminating_elements = true);
+        /**Looks up the ID of an element by name. This is a switch on the name's length and
+           first character, so it only performs (at most) a couple of string comparisons.
+           @param name The element's name (does not need to be NULL terminated).
+           @param length The length of the name.
+           @returns The element's ID, or unknown_element if it is not an element that
+            the extractors give special treatment to.
+           @note "br" followed by a '/' (e.g., "br/") is also seen as html_br, even though
+            it is technically a different element name.*/
+        template<typename T>
+        static markup_element classify_element(const T* name, const size_t length);
+        /**Looks up the ID of an element by name.
+           @param element The element (e.g., the return from read_element()) to look up.
+           @returns The element's ID, or unknown_element if it is not an element that
+            the extractors give special treatment to.*/
+        template<typename T>
+        static markup_element classify_element(const basic_html_element_view<T>& element)
+            { return classify_element(element.get_name(), element.get_name_length()); }
         /**@returns The matching > to a <, or NULL if not found.
            @param text The HTML stream to analyze.
            @param fail_on_overlapping_open_symbol Whether it should immediately return failure if the next
-            '<' is found before a closing '>' is found.*/
-        static const wchar_t* find_close_tag(const wchar_t* text, const bool fail_on_overlapping_open_symbol = false);
+            '<' is found before a closing '>' is found.
+           @param endSentinel The end of the HTML stream. If NULL, then the stream is read until its NULL terminator.*/
+        template<typename T>
+        static const T* find_close_tag(const T* text, const bool fail_on_overlapping_open_symbol = false,
+                                       const T* endSentinel = NULL);
         /**Searches for a tag inside of an element and returns its value (or empty string if not found).
         @param text The start of the element section.
         @param tag The inner tag to search for (e.g., \"bgcolor\").
@@ -443,11 +1077,14 @@ namespace lily_of_the_valley
                this should be set to true.
         @param allowSpacesInValue Whether there can be a spaces in the tag's value.
                Usually you would only see that with complex strings values, such as a font name.
+        @param endSentinel The end of the HTML stream. If NULL, then the stream is read until its NULL terminator.
         @returns The pointer to the tag value and its length. Returns NULL and length of zero on failure.*/
-        static std::pair<const wchar_t*, size_t> read_tag(const wchar_t* text,
-            const wchar_t* tag, const size_t tagSize,
+        template<typename T>
+        static std::pair<const T*, size_t> read_tag(const T* text,
+            const T* tag, const size_t tagSize,
             const bool allowQuotedTags,
-            const bool allowSpacesInValue = false);
+            const bool allowSpacesInValue = false,
+            const T* endSentinel = NULL);
         /**Same as read_tag(), except it return a standard string object instead of a raw pointer.
         @param text The start of the element section.
         @param tag The inner tag to search for (e.g., \"bgcolor\").
@@ -457,11 +1094,14 @@ namespace lily_of_the_valley
                to be true. Usually this would be false.
         @param allowSpacesInValue Whether there can be a spaces in the tag's value.
                Usually you would only see that with complex strings values, such as a font name.
+        @param endSentinel The end of the HTML stream. If NULL, then the stream is read until its NULL terminator.
         @returns The tag value as a string, or empty string on failure.*/
-        static std::wstring read_tag_as_string(const wchar_t* text,
-            const wchar_t* tag, const size_t tagSize,
+        template<typename T>
+        static std::basic_string<T> read_tag_as_string(const T* text,
+            const T* tag, const size_t tagSize,
             const bool allowQuotedTags,
-            const bool allowSpacesInValue = false);
+            const bool allowSpacesInValue = false,
+            const T* endSentinel = NULL);
         /**Searches a buffer range for an element (e.g., "<h1>").
            @returns The pointer to the next element, or NULL if not found.
            @param sectionStart The start of the HTML buffer.
@@ -470,9 +1110,10 @@ namespace lily_of_the_valley
            @param elementTagLength The length of elementTag.
            @param accept_self_terminating_elements True to accept tags such as "<br />". Usually should be true,
             use false here if searching for opening and closing elements with content in them.*/
-        static const wchar_t* find_element(const wchar_t* sectionStart,
-                                           const wchar_t* sectionEnd,
-                                           const wchar_t* elementTag,
+        template<typename T>
+        static const T* find_element(const T* sectionStart,
+                                           const T* sectionEnd,
+                                           const T* elementTag,
                                            const size_t elementTagLength,
                                            const bool accept_self_terminating_elements = true);
         /**Searches a buffer range for an element's matching close (e.g., "</h1>").
@@ -484,9 +1125,10 @@ namespace lily_of_the_valley
            @param sectionEnd The end of the buffer.
            @param elementTag The element (e.g., "h1") whose respective ending element that we are looking for.
            @param elementTagLength The length of elementTag.*/
-        static const wchar_t* find_closing_element(const wchar_t* sectionStart,
-                                           const wchar_t* sectionEnd,
-                                           const wchar_t* elementTag,
+        template<typename T>
+        static const T* find_closing_element(const T* sectionStart,
+                                           const T* sectionEnd,
+                                           const T* elementTag,
                                            const size_t elementTagLength);
         /**Searches for an attribute inside of an element.
            @returns The position of the attribute (or NULL if not found).
@@ -495,10 +1137,13 @@ namespace lily_of_the_valley
            @param tagSize The length of the attribute to search for.
            @param allowQuotedTags Set this parameter to true for tags that are inside of quotes
                (e.g., style values like \"font-weight\", as in <span style=\"font-weight: bold;\">).
-               To find \"font-weight\" inside of the style tag, this parameter should be true. Usually this would be false.*/
-        static const wchar_t* find_tag(const wchar_t* text,
-            const wchar_t* tag, const size_t tagSize,
-            const bool allowQuotedTags);
+               To find \"font-weight\" inside of the style tag, this parameter should be true. Usually this would be false.
+           @param endSentinel The end of the HTML stream. If NULL, then the stream is read until its NULL terminator.*/
+        template<typename T>
+        static const T* find_tag(const T* text,
+            const T* tag, const size_t tagSize,
+            const bool allowQuotedTags,
+            const T* endSentinel = NULL);
         /**Searches a buffer range for a bookmark (e.g., "<a name="citation" />").
            @param sectionStart The start of the HTML buffer.
            @param sectionEnd The end of the HTML buffer.
@@ -520,20 +1165,149 @@ namespace lily_of_the_valley
            @param strSearch The substring to search for.
            @param strSearchSize The length of strSearch.
            @returns The (pointer) position of where the character is, or NULL if not found.*/
-        static const wchar_t* stristr_not_quoted(
-            const wchar_t* string, const size_t stringSize,
-            const wchar_t* strSearch, const size_t strSearchSize);
+        template<typename T>
+        static const T* stristr_not_quoted(
+            const T* string, const size_t stringSize,
+            const T* strSearch, const size_t strSearchSize);
         /**@returns The charset from the meta section of an HTML buffer.
            @param pageContent The meta section to analyze.
            @param length The length of pageContent.*/
         static std::string parse_charset(const char* pageContent, const size_t length);
     protected:
         static std::wstring convert_symbol_font_section(const std::wstring& symbolFontText);
-        void parse_raw_text(const wchar_t* text, size_t textSize);
+        /**Decodes a section of text (i.e., text between elements), converting entities and
+           collapsing newlines (unless inside of a preformatted section).
+           @param text The text to decode. This can either be wchar_t or UTF-8 char text.
+           @param textSize The length of the text.*/
+        template<typename T>
+        void parse_raw_text(const T* text, size_t textSize);
+        /**Called for each element that the parser reads (other than comments and CDATA sections),
+           so that a derived class can collect information from the elements (e.g., links) in the same pass
+           that the text is extracted in. This does nothing by default.
+           @param element_id The element's ID (see classify_element()).
+           @param element The element, which is only valid during this call.*/
+        virtual void on_element(const markup_element /*element_id*/, const basic_html_element_view<wchar_t>& /*element*/)
+            {}
+        /**The UTF-8 version of on_element().
+           @param element_id The element's ID (see classify_element()).
+           @param element The element, which is only valid during this call.*/
+        virtual void on_element(const markup_element /*element_id*/, const basic_html_element_view<char>& /*element*/)
+            {}
+        /**Called with the content of a script, noscript, style, or title section (which is not included in the text).
+           This does nothing by default.
+           @param section The section's ID (e.g., html_title).
+           @param text The content of the section, which is only valid during this call.
+           @param length The length of @c text.
+           @param is_complete Whether this is the end of the section. When streaming, a section can be passed
+            in multiple calls (one for each chunk that it is in).*/
+        virtual void on_section_text(const markup_element /*section*/, const wchar_t* /*text*/, const size_t /*length*/,
+                                     const bool /*is_complete*/)
+            {}
+        /**The UTF-8 version of on_section_text().
+           @param section The section's ID (e.g., html_title).
+           @param text The content of the section, which is only valid during this call.
+           @param length The length (in bytes) of @c text.
+           @param is_complete Whether this is the end of the section.*/
+        virtual void on_section_text(const markup_element /*section*/, const char* /*text*/, const size_t /*length*/,
+                                     const bool /*is_complete*/)
+            {}
+        /**Resets whatever state the parser carries from one chunk of a stream to the next (called by begin_stream()).
+           A derived class that parses its own markup (e.g., docx_extract_text) overrides this, along with
+           parse_stream_chunk(), so that its format can be streamed with feed() and finish() as well.
+           @param preserve_spaces Whether embedded newlines should be included in the output.*/
+        virtual void reset_stream_state(const bool preserve_spaces);
+        /**Parses the streamed text that hasn't been parsed yet (whatever was held onto from the previous chunks, followed by the new chunk).
+           @param start The start of the text to parse.
+           @param endSentinel The end of the text.
+           @param is_final Whether this is the end of the stream. If false, then whatever is unfinished at
+            @c endSentinel (e.g., half of an element) should be left unparsed.
+           @returns Where parsing stopped, or NULL if everything was parsed. The text from there on is held onto
+            and passed in again (followed by the next chunk). This is ignored if @c is_final is true.*/
+        virtual const wchar_t* parse_stream_chunk(const wchar_t* start, const wchar_t* endSentinel, const bool is_final);
+        /**The UTF-8 version of parse_stream_chunk().
+           @param start The start of the text to parse.
+           @param endSentinel The end of the text.
+           @param is_final Whether this is the end of the stream.
+           @returns Where parsing stopped, or NULL if everything was parsed.*/
+        virtual const char* parse_stream_chunk(const char* start, const char* endSentinel, const bool is_final);
 
         size_t m_is_in_preformatted_text_block_stack;
         static const html_utilities::symbol_font_table SYMBOL_FONT_TABLE;
         static const html_utilities::html_entity_table HTML_TABLE_LOOKUP;
+    private:
+        //extracts a segment of a document, for either wchar_t or UTF-8 (char) text
+        template<typename T>
+        size_t extract_segment_text(const T* html_text, const size_t text_length, const bool include_outer_text,
+                                    const segment_state& start_state, const bool is_final, segment_state& end_state);
+        //the main parser, for either wchar_t or UTF-8 (char) text
+        template<typename T>
+        const wchar_t* extract(const T* html_text,
+                               const size_t text_length,
+                               const bool include_outer_text,
+                               const bool preserve_spaces);
+        /*Parses the elements (and the text between them) from start, picking up at m_parse_state.
+        If is_final is false, then the text may be continued in another chunk, so any unfinished
+        construct at endSentinel is not parsed. Returns where parsing stopped (i.e., where the caller
+        should start from next time, or the start of the text after the last element if is_final is true)
+        or NULL if there is nothing left to parse.*/
+        template<typename T>
+        const T* parse_markup(const T* start, const T* const endSentinel, const bool is_final);
+        //adds a chunk to the stream buffer and parses as much of it as possible
+        template<typename T>
+        void feed_stream(std::basic_string<T>& stream_buffer,
+                         const T* html_chunk, const size_t chunk_length);
+        //parses whatever is left in the stream buffer
+        template<typename T>
+        void finish_stream(std::basic_string<T>& stream_buffer);
+        //parses a chunk of an HTML stream (the default for parse_stream_chunk())
+        template<typename T>
+        const T* parse_html_stream_chunk(const T* start, const T* const endSentinel, const bool is_final);
+        /*Returns where to stop reading the text from start to end so that it won't go over the output budget
+        (i.e., end, unless the budget is about to run out).*/
+        template<typename T>
+        const T* limit_to_output_budget(const T* start, const T* end);
+        //sends an element's structural event (if it has one) to the event handler
+        template<typename T>
+        void report_element(const markup_element element_id, const basic_html_element_view<T>& element);
+        //sends the text written between two points (if there is any) to the event handler
+        void report_text(const size_t output_start, const size_t output_end)
+            {
+            if (m_event_handler != NULL && !m_is_holding_text_events && output_end > output_start)
+                { m_event_handler->on_text(get_filtered_text()+output_start, output_end-output_start); }
+            }
+        //copies text over as it is (e.g., a CDATA section) and sends it to the event handler as a run of text
+        template<typename T>
+        void add_reported_characters(const T* text, const size_t length)
+            {
+            //make room first, so that the sink won't hand off the text before it is sent
+            if (!reserve_text(length))
+                { return; }
+            const size_t previousLength = get_filtered_text_length();
+            add_characters(text, length);
+            report_text(previousLength, get_filtered_text_length());
+            }
+        //sends the text that an entity was decoded to (from output_start to the end of the text) to the event handler
+        void report_entity(const size_t output_start)
+            {
+            if (m_event_handler != NULL && !m_is_holding_text_events && get_filtered_text_length() > output_start)
+                { m_event_handler->on_entity(get_filtered_text()+output_start, get_filtered_text_length()-output_start); }
+            }
+
+        markup_parse_state m_parse_state;
+        markup_element m_open_section;
+        bool m_is_symbol_font_section;
+        //how much of the element at the start of the stream's buffer has been looked through for its end
+        size_t m_element_scan_length;
+        bool m_is_streaming;
+        //how much of the stream has been read (for the input budget)
+        size_t m_streamed_length;
+        //the unparsed end of the stream (only one of these is used, depending on the stream's character type)
+        std::wstring m_stream_buffer;
+        std::string m_utf8_stream_buffer;
+        //where the document's structure is sent to
+        html_event_handler* m_event_handler;
+        //whether text events are being held until a Symbol font section has been converted
+        bool m_is_holding_text_events;
         };
     }
 
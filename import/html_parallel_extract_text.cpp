@@ -0,0 +1,282 @@
+#include "html_parallel_extract_text.h"
+
+namespace lily_of_the_valley
+    {
+    //how far back to look for a section (e.g., a script) in front of a place to split at
+    static const size_t SECTION_LOOKBEHIND = 64*1024;
+    //how many segments to make for each thread, so that a thread that finishes early can take on more
+    static const size_t SEGMENTS_PER_THREAD = 4;
+
+    /*Whether an element name (from name to end) is a section that the parser skips or preserves the spaces in
+      (script, noscript, style, title, or pre). The name must be followed by a '>', '/', or a space.*/
+    template<typename T>
+    static bool is_section_element(const T* name, const T* const end)
+        {
+        static const T* const SECTION_NAMES[] =
+            {
+            MARKUP_LITERAL(T, "script"), MARKUP_LITERAL(T, "noscript"), MARKUP_LITERAL(T, "style"),
+            MARKUP_LITERAL(T, "title"), MARKUP_LITERAL(T, "pre")
+            };
+        for (size_t i = 0; i < sizeof(SECTION_NAMES)/sizeof(SECTION_NAMES[0]); ++i)
+            {
+            const size_t nameLength = string_util::strlen(SECTION_NAMES[i]);
+            if (static_cast<size_t>(end-name) > nameLength &&
+                string_util::strnicmp<T>(name, SECTION_NAMES[i], nameLength) == 0 &&
+                (name[nameLength] == common_lang_constants::GREATER_THAN ||
+                 name[nameLength] == common_lang_constants::FORWARD_SLASH || is_markup_space(name[nameLength])))
+                { return true; }
+            }
+        return false;
+        }
+
+    /*Whether a place to split a document at is (probably) inside of a script, noscript, style, title, comment,
+      CDATA, or preformatted section, going by whether the last section marker in front of it is a start or an end.
+      If this is wrong, then the segment is extracted again, so this only needs to be right for well-formed documents.*/
+    template<typename T>
+    static bool is_inside_of_section(const T* text, const T* const split_position)
+        {
+        const T* const lookBehindStart = (static_cast<size_t>(split_position-text) > SECTION_LOOKBEHIND) ?
+            split_position-SECTION_LOOKBEHIND : text;
+        const T* position = split_position;
+        while (position > lookBehindStart)
+            {
+            --position;
+            //the end of a comment or CDATA section
+            if (*position == common_lang_constants::GREATER_THAN)
+                {
+                if (position-text >= 2 &&
+                    ((position[-1] == common_lang_constants::HYPHEN && position[-2] == common_lang_constants::HYPHEN) ||
+                     (position[-1] == common_lang_constants::RIGHT_BRACKET && position[-2] == common_lang_constants::RIGHT_BRACKET)))
+                    { return false; }
+                continue;
+                }
+            else if (*position != common_lang_constants::LESS_THAN)
+                { continue; }
+            //only elements that are entirely in front of the split are looked at
+            const size_t available = split_position-position;
+            if ((available >= 4 && string_util::strncmp(position, MARKUP_LITERAL(T, "<!--"), 4) == 0) ||
+                (available >= 9 && string_util::strnicmp(position, MARKUP_LITERAL(T, "<![CDATA["), 9) == 0))
+                { return true; }
+            else if (available >= 2 && position[1] == common_lang_constants::FORWARD_SLASH &&
+                     is_section_element(position+2, split_position))
+                { return false; }
+            else if (is_section_element(position+1, split_position))
+                { return true; }
+            }
+        return false;
+        }
+
+    /*Finds the first closing element (e.g., "</p>") from position to end that isn't inside of a section,
+      and returns where the text after it starts (or NULL if there isn't one).*/
+    template<typename T>
+    static const T* find_segment_boundary(const T* text, const T* position, const T* end)
+        {
+        while (position < end)
+            {
+            position = string_util::strnstr<T>(position, MARKUP_LITERAL(T, "</"), end-position);
+            if (position == NULL)
+                { return NULL; }
+            position += 2;
+            if (position < end && (is_within<T>(*position, common_lang_constants::LOWER_A, common_lang_constants::LOWER_Z) ||
+                                   is_within<T>(*position, common_lang_constants::UPPER_A, common_lang_constants::UPPER_Z)))
+                {
+                static const string_util::char_set_matcher<T> ELEMENT_END_SET(MARKUP_LITERAL(T, "<>"), 2);
+                const size_t nameLength = string_util::strncspn<T>(position, end-position, ELEMENT_END_SET);
+                const T* const boundary = position+nameLength+1;
+                if (boundary <= end && position[nameLength] == common_lang_constants::GREATER_THAN &&
+                    !is_inside_of_section(text, boundary))
+                    { return boundary; }
+                }
+            }
+        return NULL;
+        }
+
+    ///@brief A thread's segment extractor, whose buffer is reused for each segment that thread extracts.
+    class html_parallel_extract_text::worker
+        {
+    public:
+        /**Extracts the text from a segment.
+           @param text The start of the document.
+           @param seg The segment to extract (its state and length are read from it, and its results are written to it).
+           @param include_outer_text Whether text outside of the first and last <> should be included.
+           @param is_final Whether the segment is the end of the document.
+           @param copy_text Whether to copy the text into the segment. If false, then the text is left in
+            the extractor (see get_text()) until the next segment is extracted.*/
+        template<typename T>
+        void extract(const T* text, segment& seg, const bool include_outer_text, const bool is_final,
+                     const bool copy_text = true)
+            {
+            seg.m_text.clear();
+            seg.m_log.clear();
+            seg.m_end_state = seg.m_start_state;
+            seg.m_read_length = 0;
+            try
+                {
+                seg.m_read_length = m_html.extract_segment(text+seg.m_start, seg.m_length, include_outer_text,
+                                                           seg.m_start_state, is_final, seg.m_end_state);
+                //copy the text (rather than taking the extractor's buffer), so that the buffer is reused for the next segment
+                if (copy_text && m_html.get_filtered_text() != NULL)
+                    { seg.m_text.assign(m_html.get_filtered_text(), m_html.get_filtered_text_length()); }
+                seg.m_log = m_html.get_log();
+                }
+            catch (const std::exception&)
+                {
+                seg.m_text.clear();
+                seg.m_log = L"Unable to extract text from segment.";
+                }
+            }
+        ///@returns The extractor that the last segment was extracted with.
+        const html_extract_text& get_text() const
+            { return m_html; }
+    private:
+        html_extract_text m_html;
+        };
+
+    html_parallel_extract_text::html_parallel_extract_text(const size_t thread_count /*= 0*/) :
+        m_workers(thread_count), m_min_segment_size(1024*1024), m_segment_count(0), m_reextracted_segment_count(0)
+        {}
+
+    html_parallel_extract_text::~html_parallel_extract_text()
+        {}
+
+    const wchar_t* html_parallel_extract_text::operator()(const wchar_t* html_text,
+                                                          const size_t text_length,
+                                                          const bool include_outer_text,
+                                                          const bool preserve_spaces)
+        { return extract(html_text, text_length, include_outer_text, preserve_spaces); }
+
+    const wchar_t* html_parallel_extract_text::operator()(const char* html_text,
+                                                          const size_t text_length,
+                                                          const bool include_outer_text,
+                                                          const bool preserve_spaces)
+        { return extract(html_text, text_length, include_outer_text, preserve_spaces); }
+
+    template<typename T>
+    void html_parallel_extract_text::split(const T* html_text, const size_t text_length, const bool preserve_spaces)
+        {
+        m_segments.clear();
+        //with only one thread, splitting the document up would only add work
+        const size_t segmentCount = (get_thread_count() == 1) ? 1 : std::max<size_t>(1,
+            std::min(get_thread_count()*SEGMENTS_PER_THREAD, text_length/m_min_segment_size));
+        const size_t segmentSize = text_length/segmentCount;
+        const T* const textEnd = html_text+text_length;
+        const T* segmentStart = html_text;
+        for (size_t i = 1; i < segmentCount; ++i)
+            {
+            //split after the first closing element after the target, as long as it is before the next target
+            const T* const target = std::max(html_text+(i*segmentSize), segmentStart);
+            const T* const boundary = find_segment_boundary(html_text, target,
+                std::min(html_text+((i+1)*segmentSize), textEnd));
+            if (boundary == NULL || boundary >= textEnd)
+                { continue; }
+            segment seg;
+            seg.m_start = segmentStart-html_text;
+            seg.m_length = boundary-segmentStart;
+            seg.m_start_state = html_extract_text::segment_state(false, preserve_spaces);
+            m_segments.push_back(seg);
+            segmentStart = boundary;
+            }
+        segment seg;
+        seg.m_start = segmentStart-html_text;
+        seg.m_length = textEnd-segmentStart;
+        seg.m_start_state = html_extract_text::segment_state(false, preserve_spaces);
+        m_segments.push_back(seg);
+        //the start of the document is known for sure
+        m_segments.front().m_start_state = html_extract_text::segment_state(true, preserve_spaces);
+        }
+
+    template<typename T>
+    const wchar_t* html_parallel_extract_text::extract(const T* html_text, const size_t text_length,
+                                                       const bool include_outer_text, const bool preserve_spaces)
+        {
+        clear_log();
+        log_unsupported_budget();
+        m_segment_count = m_reextracted_segment_count = 0;
+        if (html_text == NULL || html_text[0] == 0 || text_length == 0)
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+
+        split(html_text, text_length, preserve_spaces);
+        m_segment_count = m_segments.size();
+        const size_t lastSegment = m_segments.size()-1;
+        //a document that isn't split up is copied straight out of the extractor, rather than through a segment
+        if (m_segments.size() == 1)
+            {
+            m_workers.get_worker(0).extract(html_text, m_segments[0], include_outer_text, true, false);
+            const html_extract_text& html = m_workers.get_worker(0).get_text();
+            if (!begin_text() || !reserve_text(html.get_filtered_text_length()))
+                {
+                set_filtered_text_length(0);
+                return NULL;
+                }
+            if (html.get_filtered_text() != NULL)
+                { add_characters(html.get_filtered_text(), html.get_filtered_text_length()); }
+            add_segment(m_segments[0]);
+            return finalize_text();
+            }
+
+        //extract the segments (largest first) into their own strings
+        std::vector<size_t> costs(m_segments.size());
+        for (size_t i = 0; i < m_segments.size(); ++i)
+            { costs[i] = m_segments[i].m_length; }
+        m_workers.run(costs, [&](worker& segmentWorker, const size_t segmentIndex)
+            {
+            segmentWorker.extract(html_text, m_segments[segmentIndex], include_outer_text,
+                                            (segmentIndex == lastSegment));
+            });
+
+        /*then put them together in order, making sure that each segment started with the state that the
+          one in front of it ended with (and ended where the next one starts)*/
+        if (!begin_text())
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+        size_t textLength = 0;
+        for (size_t i = 0; i < m_segments.size(); ++i)
+            { textLength += m_segments[i].m_text.length(); }
+        //make room for all of the text up front (this is only a guess if segments need to be extracted again)
+        if (!reserve_text(textLength))
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+        html_extract_text::segment_state state(true, preserve_spaces);
+        for (size_t i = 0; i < m_segments.size(); /*in loop*/)
+            {
+            segment& seg = m_segments[i];
+            size_t last = i;
+            if (!(seg.m_start_state == state))
+                {
+                seg.m_start_state = state;
+                m_workers.get_worker(0).extract(html_text, seg, include_outer_text, (last == lastSegment));
+                ++m_reextracted_segment_count;
+                }
+            /*if the segment was cut off in the middle of something (e.g., a comment), then read it along with
+              the segments after it. Twice as many are added each time, so that something running through
+              a lot of segments doesn't make the same text get read over and over.*/
+            size_t mergeCount = 1;
+            while (seg.m_read_length < seg.m_length && last < lastSegment)
+                {
+                last = std::min(last+mergeCount, lastSegment);
+                mergeCount *= 2;
+                seg.m_length = (m_segments[last].m_start+m_segments[last].m_length)-seg.m_start;
+                m_workers.get_worker(0).extract(html_text, seg, include_outer_text, (last == lastSegment));
+                ++m_reextracted_segment_count;
+                }
+            add_segment(seg);
+            state = seg.m_end_state;
+            i = last+1;
+            }
+        return finalize_text();
+        }
+
+    void html_parallel_extract_text::add_segment(const segment& seg)
+        {
+        add_characters(seg.m_text.c_str(), seg.m_text.length());
+        if (!seg.m_log.empty())
+            { log_message(seg.m_log); }
+        }
+    }
@@ -0,0 +1,130 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __HTML_PARALLEL_EXTRACT_TEXT_H__
+#define __HTML_PARALLEL_EXTRACT_TEXT_H__
+
+#include <string>
+#include <vector>
+#include "html_extract_text.h"
+#include "../utilities/work_stealing_pool.h"
+
+namespace lily_of_the_valley
+    {
+    /**@brief Class to extract text from a very large HTML document (e.g., a mailing list archive or
+        a generated report) across multiple threads.
+    @details The document is split into segments right after closing elements (e.g., <em>&lt;/p&gt;</em>
+        or <em>&lt;/div&gt;</em>) that are not inside of a script, noscript, style, title, comment, CDATA,
+        or preformatted section. The segments are extracted across multiple threads with
+        html_extract_text::extract_segment(), and then their text is put together in order.
+
+        The text is the same as what html_extract_text::operator() returns for the whole document. Each segment
+        is extracted assuming the state that it starts with (i.e., right after an element, outside of any section);
+        after the segments are extracted, each one's assumed state is checked against where the segment in front
+        of it actually ended. A segment that was split in the wrong place (e.g., inside of a long comment that
+        began too far back to be seen when splitting) or that assumed the wrong state is extracted again on the
+        calling thread, so the text is always the same (it is only slower in that case).
+
+        Documents smaller than two segments (see set_min_segment_size()) are extracted on the calling thread.
+    @note Requires C++11 (for @c std::thread). Each call overwrites the object's segments, so an object should
+        only be extracting one page at a time. Offsets (see set_offset_map()), budgets (see set_budget()), and
+        event handlers (see html_extract_text::set_event_handler()) are not supported by this class;
+        use html_extract_text for those.
+    @par Example:
+    @code
+        //Assuming that the contents of an HTML file is in a UTF-8 char* buffer
+        //named "fileContents" and "fileSize" is set to the size of the file.
+        lily_of_the_valley::html_parallel_extract_text htmlExtract;
+        htmlExtract(fileContents, fileSize, true, false);
+        std::wstring fileText(htmlExtract.get_filtered_text(), htmlExtract.get_filtered_text_length());
+    @endcode*/
+    class html_parallel_extract_text : public extract_text
+        {
+    public:
+        /**Constructor.
+           @param thread_count The number of threads to use. If zero, then the number of cores on the system is used.*/
+        explicit html_parallel_extract_text(const size_t thread_count = 0);
+        ///Destructor.
+        ~html_parallel_extract_text();
+        /**Main interface for extracting plain text from an HTML buffer.
+        @param html_text The HTML text to strip.
+        @param text_length The length of the HTML text.
+        @param include_outer_text Whether text outside of the first and last <> should be included. Recommended true.
+        @param preserve_spaces Whether embedded newlines should be included in the output. If false,
+        then they will be replaced with spaces, which is the default for HTML renderers. Recommended false.
+        @returns The plain text from the HTML stream.*/
+        const wchar_t* operator()(const wchar_t* html_text,
+                                  const size_t text_length,
+                                  const bool include_outer_text,
+                                  const bool preserve_spaces);
+        /**Main interface for extracting plain text from a UTF-8 HTML buffer.
+        @param html_text The UTF-8 HTML text to strip.
+        @param text_length The length (in bytes) of the HTML text.
+        @param include_outer_text Whether text outside of the first and last <> should be included. Recommended true.
+        @param preserve_spaces Whether embedded newlines should be included in the output. If false,
+        then they will be replaced with spaces, which is the default for HTML renderers. Recommended false.
+        @returns The plain text from the HTML stream.*/
+        const wchar_t* operator()(const char* html_text,
+                                  const size_t text_length,
+                                  const bool include_outer_text,
+                                  const bool preserve_spaces);
+        /**Sets the smallest segment that a document is split into (the default is 1MB).
+           @param length The segment size (in characters, or bytes for UTF-8 text).*/
+        void set_min_segment_size(const size_t length)
+            { m_min_segment_size = std::max<size_t>(length, 1); }
+        ///@returns The smallest segment that a document is split into.
+        size_t get_min_segment_size() const
+            { return m_min_segment_size; }
+        ///@returns The number of segments that the last document was split into.
+        size_t get_segment_count() const
+            { return m_segment_count; }
+        /**@returns The number of segments from the last document that had to be extracted again
+            (because they were split in the wrong place or assumed the wrong state).*/
+        size_t get_reextracted_segment_count() const
+            { return m_reextracted_segment_count; }
+        ///@returns The number of threads that segments are extracted on.
+        size_t get_thread_count() const
+            { return m_workers.get_thread_count(); }
+    private:
+        class worker;
+        ///@brief A segment's assumed state and its results.
+        struct segment
+            {
+            segment() : m_start(0), m_length(0), m_read_length(0) {}
+            size_t m_start;
+            size_t m_length;
+            html_extract_text::segment_state m_start_state;
+            html_extract_text::segment_state m_end_state;
+            size_t m_read_length;
+            std::wstring m_text;
+            std::wstring m_log;
+            };
+        template<typename T>
+        const wchar_t* extract(const T* html_text, const size_t text_length,
+                               const bool include_outer_text, const bool preserve_spaces);
+        template<typename T>
+        void split(const T* html_text, const size_t text_length, const bool preserve_spaces);
+        //puts a segment's (or a range of segments') results into the text
+        void add_segment(const segment& seg);
+
+        //each thread's segment extractor, which is kept between documents (the first one also re-extracts segments)
+        worker_pool<worker> m_workers;
+        std::vector<segment> m_segments;
+        size_t m_min_segment_size;
+        size_t m_segment_count;
+        size_t m_reextracted_segment_count;
+        //disable copy construction
+        html_parallel_extract_text(const html_parallel_extract_text&);
+        void operator=(const html_parallel_extract_text&);
+        };
+    }
+
+/** @}*/
+
+#endif //__HTML_PARALLEL_EXTRACT_TEXT_H__
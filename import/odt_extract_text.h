@@ -10,17 +10,124 @@ it under the terms of the BSD License.
 #ifndef __ODF_TEXT_EXTRACT_H__
 #define __ODF_TEXT_EXTRACT_H__
 
+#include <vector>
+#include <algorithm>
 #include "html_extract_text.h"
+#include "style_table_cache.h"
 
 namespace lily_of_the_valley
     {
+    /**@brief A set of style names, hashed so that looking up a paragraph's style costs the same
+        no matter how many styles a document has.
+    @details Names are stored as wide strings, but can be looked up with either wide or ASCII text
+        without having to copy (or convert) them first.*/
+    class style_name_set
+        {
+    public:
+        ///Constructor.
+        style_name_set() : m_slots(INITIAL_SLOT_COUNT, 0) {}
+        ///Removes all of the names (the memory for them is kept for the next set of names).
+        void clear()
+            {
+            m_names.clear();
+            std::fill(m_slots.begin(), m_slots.end(), 0);
+            }
+        ///@returns The number of names in the set.
+        size_t size() const
+            { return m_names.size(); }
+        ///@returns Whether the set is empty.
+        bool empty() const
+            { return m_names.empty(); }
+        ///@returns The names in the set, in the order that they were added.
+        const std::vector<std::wstring>& get_names() const
+            { return m_names; }
+        /**Adds a name to the set (if it isn't already in it).
+           @param name The name to add.*/
+        void insert(const std::wstring& name)
+            {
+            if (contains(name.c_str(), name.length()))
+                { return; }
+            //keep the table at most half full, so that probing stays short
+            if ((m_names.size()+1)*2 > m_slots.size())
+                { rehash(m_slots.size()*2); }
+            m_names.push_back(name);
+            place(m_names.size()-1);
+            }
+        /**@returns Whether a name is in the set.
+           @param name The name (does not need to be NULL terminated). If char text, then it must be ASCII
+            (convert UTF-8 text with non-ASCII characters to a wide string first).
+           @param length The length of the name.*/
+        template<typename T>
+        bool contains(const T* name, const size_t length) const
+            {
+            if (m_names.empty())
+                { return false; }
+            const size_t mask = m_slots.size()-1;
+            for (size_t slot = hash_name(name, length) & mask; m_slots[slot] != 0; slot = (slot+1) & mask)
+                {
+                const std::wstring& storedName = m_names[m_slots[slot]-1];
+                if (storedName.length() == length && is_same_name(storedName.c_str(), name, length))
+                    { return true; }
+                }
+            return false;
+            }
+    private:
+        //must be a power of two
+        static const size_t INITIAL_SLOT_COUNT = 32;
+        //FNV-1a hash of the name's characters (so that ASCII char and wchar_t names hash the same)
+        template<typename T>
+        static size_t hash_name(const T* name, const size_t length)
+            {
+            size_t hashValue = 2166136261U;
+            for (size_t i = 0; i < length; ++i)
+                {
+                hashValue ^= static_cast<size_t>(to_code_point(name[i]));
+                hashValue *= 16777619U;
+                }
+            return hashValue;
+            }
+        template<typename T>
+        static bool is_same_name(const wchar_t* storedName, const T* name, const size_t length)
+            {
+            for (size_t i = 0; i < length; ++i)
+                {
+                if (static_cast<unsigned long>(storedName[i]) != to_code_point(name[i]))
+                    { return false; }
+                }
+            return true;
+            }
+        static unsigned long to_code_point(const wchar_t ch)
+            { return static_cast<unsigned long>(ch); }
+        static unsigned long to_code_point(const char ch)
+            { return static_cast<unsigned char>(ch); }
+        //puts a name (by its index) into the first open slot for it
+        void place(const size_t index)
+            {
+            const size_t mask = m_slots.size()-1;
+            size_t slot = hash_name(m_names[index].c_str(), m_names[index].length()) & mask;
+            while (m_slots[slot] != 0)
+                { slot = (slot+1) & mask; }
+            m_slots[slot] = index+1;
+            }
+        void rehash(const size_t slotCount)
+            {
+            m_slots.assign(slotCount, 0);
+            for (size_t i = 0; i < m_names.size(); ++i)
+                { place(i); }
+            }
+
+        std::vector<std::wstring> m_names;
+        //the (one-based) index of the name in each slot, or zero if the slot is open
+        std::vector<size_t> m_slots;
+        };
+
     /**@brief Class to extract text from a <b>Open Document Text</b> stream (specifically, the <em>content.xml</em> file).
     @par Example:
     @code
         //Assuming that the contents of "content.xml" from an ODT file is in a
-        //wchar_t* buffer named "fileContents" and "fileSize" is set to the size
-        //of this content.xml. Note that you should use the specified character set
-        //in the XML file (usually UTF-8) when loading this file into the wchar_t buffer.
+        //char* buffer named "fileContents" and "fileSize" is set to the size
+        //of this content.xml. content.xml is UTF-8, so it can be passed in as-is
+        //(a wchar_t* buffer that it has already been converted to is also accepted).
         lily_of_the_valley::odt_extract_text odtExtract;
         odtExtract(fileContents, fileSize);
 
@@ -33,89 +140,222 @@ namespace lily_of_the_valley
     class odt_extract_text : public html_extract_text
         {
     public:
-        odt_extract_text() : m_preserve_text_table_layout(false) {}
+        odt_extract_text() : m_preserve_text_table_layout(false), m_text_section_depth(0),
+            m_inside_of_list_item_or_table_cell(false), m_is_in_text_section(false),
+            m_is_in_automatic_styles(false), m_is_current_style_read(true),
+            m_style_cache(NULL), m_is_style_section_cacheable(false) {}
         /**Specifies how to import tables.
         @param preserve Set to true to not import text cells as separate paragraphs, but instead as cells of text with tabs
         between them. Set to false to simply import each cell as a separate paragraph, the tabbed structure of the rows will be lost.*/
         void preserve_text_table_layout(const bool preserve)
             { m_preserve_text_table_layout = preserve; }
+        /**Sets a cache of the styles read from earlier documents, so that a document that has the same
+           automatic styles as one of them (e.g., because they were made from the same template) doesn't
+           need to have its styles read again.
+        @param cache The cache to use (which can be shared with other extractors and threads), or NULL to not
+            use a cache. The caller owns the cache and it must outlive the extraction.*/
+        void set_style_cache(style_table_cache* cache)
+            { m_style_cache = cache; }
+        ///@returns The cache of styles read from earlier documents, or NULL if one isn't being used.
+        style_table_cache* get_style_cache() const
+            { return m_style_cache; }
         /**Main interface for extracting plain text from a content.xml buffer.
-        @param html_text The <em>content.xml</em> text to extract text from. <em>content.xml</em> is extracted from an ODT file. ODT files are zip files, which can be opened by a library such as <em>zlib</em>
+        @param html_text The <em>content.xml</em> text to extract text from. <em>content.xml</em> is extracted from an ODT file. ODT files are zip files, whose parts can be read with zip_package (or streamed straight into this extractor with extract_package_part()).
         @param text_length The length of the <em>content.xml</em> stream.
         @returns The plain text from the ODT stream.*/
         const wchar_t* operator()(const wchar_t* html_text,
                                   const size_t text_length)
+            { return extract(html_text, text_length); }
+        /**Main interface for extracting plain text from a UTF-8 content.xml buffer.
+        @param html_text The UTF-8 <em>content.xml</em> text to extract text from.
+        @param text_length The length (in bytes) of the <em>content.xml</em> stream.
+        @returns The plain text from the ODT stream.*/
+        const wchar_t* operator()(const char* html_text,
+                                  const size_t text_length)
+            { return extract(html_text, text_length); }
+    protected:
+        /**Resets the list, table, and text section state at the start of a stream.
+           @param preserve_spaces Not used, spaces are always preserved in this XML.*/
+        virtual void reset_stream_state(const bool /*preserve_spaces*/)
+            {
+            html_extract_text::reset_stream_state(true);
+            m_is_in_preformatted_text_block_stack = 1;//use "preserve spaces" logic in this XML
+            m_text_section_depth = 0;
+            m_inside_of_list_item_or_table_cell = false;
+            m_is_in_text_section = false;
+            //styles are only for the document that defines them
+            m_indented_paragraph_styles.clear();
+            m_is_in_automatic_styles = false;
+            m_current_style_name.clear();
+            m_is_current_style_read = true;
+            m_is_style_section_cacheable = false;
+            }
+        /**Parses the next part of a streamed <em>content.xml</em>.
+           @param start The start of the text to parse.
+           @param endSentinel The end of the text.
+           @param is_final Whether this is the end of the stream.
+           @returns Where parsing stopped.*/
+        virtual const wchar_t* parse_stream_chunk(const wchar_t* start, const wchar_t* endSentinel, const bool is_final)
+            { return parse(start, endSentinel, is_final); }
+        /**Parses the next part of a streamed UTF-8 <em>content.xml</em>.
+           @param start The start of the text to parse.
+           @param endSentinel The end of the text.
+           @param is_final Whether this is the end of the stream.
+           @returns Where parsing stopped.*/
+        virtual const char* parse_stream_chunk(const char* start, const char* endSentinel, const bool is_final)
+            { return parse(start, endSentinel, is_final); }
+    private:
+        template<typename T>
+        const wchar_t* extract(const T* html_text,
+                               const size_t text_length)
             {
-            static const std::wstring OFFICE_ANNOTATION(L"office:annotation");
-            static const std::wstring OFFICE_ANNOTATION_END(L"</office:annotation>");
-            //text section tags
-            const std::wstring TEXT_P(L"text:p");
-            const std::wstring TEXT_P_END(L"</text:p>");
-            const std::wstring TEXT_H(L"text:h");
-            const std::wstring TEXT_H_END(L"</text:h>");
-            //tables
-            const std::wstring TABLE_ROW(L"table:table-row");
-            //paragraph info
-            const std::wstring TEXT_STYLE_NAME(L"text:style-name");
-
             clear_log();
             if (html_text == NULL || html_text[0] == 0 || text_length == 0)
                 {
                 set_filtered_text_length(0);
                 return NULL;
                 }
-            assert(text_length <= string_util::strlen(html_text) );
 
-            if (!allocate_text_buffer(text_length))
+            if (!begin_text())
                 {
                 set_filtered_text_length(0);
                 return NULL;
                 }
+            set_offset_source(html_text, text_length);
 
-            m_is_in_preformatted_text_block_stack = 1;//use "preserve spaces" logic in this XML
-
-            //find the first < and set up where we halt our searching
-            const wchar_t* start = string_util::strchr(html_text, common_lang_constants::LESS_THAN);
-            const wchar_t* end = NULL;
-            const wchar_t* const endSentinel = html_text+text_length;
+            reset_stream_state(true);
+            /*only read up to the input budget, parsing it like a chunk of a stream
+              so that whatever is cut off at the end (e.g., half of an element) is left unread*/
+            const size_t readLength = get_input_budget_length(text_length);
+            parse(html_text, html_text+readLength, readLength == text_length);
+            if (readLength < text_length)
+                { exceed_budget(L"Input limit reached; the rest of the document was not read."); }
+            trim_to_budget_boundary();
 
-            read_paragraph_styles(html_text, endSentinel);
+            return finalize_text();
+            }
+        /*Parses the elements (and the text between them) from text to endSentinel, picking up where the
+        last call left off. If is_final is false, then the text may be continued in another chunk, so an element
+        (or a comment, annotation, or text) that is cut off at endSentinel is not parsed. The automatic styles
+        (which come before the body) are read as they are passed, so the file is only read once.
+        Returns where parsing stopped.*/
+        template<typename T>
+        const T* parse(const T* text, const T* const endSentinel, const bool is_final)
+            {
+            //text that was continued from the previous chunk
+            const T* start = string_util::strnchr<T>(text, common_lang_constants::LESS_THAN, endSentinel-text);
+            if (start != text)
+                {
+                if (!start)
+                    { return is_final ? endSentinel : text; }
+                if (m_is_in_text_section)
+                    { parse_raw_text(text, start-text); }
+                }
+            const T* end = NULL;
+            //where to pick up from in the next chunk
+            const T* resumePosition = endSentinel;
 
-            int textSectionDepth = 0;
-            bool insideOfListItemOrTableCell = false;
             while (start && (start < endSentinel))
                 {
+                //stop (and leave the rest of the text unread) if a budget has run out
+                if (!take_budget_step())
+                    { break; }
+                //make room for the newlines and tabs that an element can add
+                if (!reserve_text(3))
+                    { break; }
+                //when streaming, an element that is cut off is read once the rest of it is in
+                if (!is_final && !string_util::strnchr<T>(start+1, common_lang_constants::GREATER_THAN, endSentinel-(start+1)))
+                    {
+                    resumePosition = start;
+                    break;
+                    }
                 bool textSectionFound = true;
                 //if it's a comment then look for matching comment ending sequence
                 if ((endSentinel-start) >= 4 && start[0] == common_lang_constants::LESS_THAN &&
                     start[1] == L'!' && start[2] == L'-' && start[3] == L'-')
                     {
-                    end = string_util::strstr(start, L"-->");
+                    end = string_util::strnstr<T>(start, MARKUP_LITERAL(T, "-->"), endSentinel-start);
                     if (!end)
-                        { break; }
+                        {
+                        resumePosition = start;
+                        break;
+                        }
                     end += 3;//-->
                     }
                 //if it's an annotation (e.g., a note) then skip it
-                else if (compare_element_case_sensitive(start+1, OFFICE_ANNOTATION.c_str(), OFFICE_ANNOTATION.length() ) )
+                else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "office:annotation"), 17, false, endSentinel) )
                     {
-                    end = string_util::strstr(start, OFFICE_ANNOTATION_END.c_str());
+                    end = string_util::strnstr<T>(start, MARKUP_LITERAL(T, "</office:annotation>"), endSentinel-start);
                     if (!end)
-                        { break; }
-                    end += OFFICE_ANNOTATION_END.length();
+                        {
+                        resumePosition = start;
+                        break;
+                        }
+                    end += 20;
                     }
                 else
                     {
+                    /*the body (or its text) means that the styles section was never closed,
+                      so leave it and read the rest of the document as usual*/
+                    if (m_is_in_automatic_styles &&
+                        (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "office:body"), 11, false, endSentinel) ||
+                         compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "text:p"), 6, true, endSentinel) ||
+                         compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "text:h"), 6, true, endSentinel)))
+                        {
+                        m_is_in_automatic_styles = false;
+                        m_is_current_style_read = true;
+                        m_is_style_section_cacheable = false;
+                        }
+                    //read the paragraph styles, looking for any styles that involve text alignment
+                    if (m_is_in_automatic_styles)
+                        {
+                        read_style_element(start, endSentinel);
+                        textSectionFound = false;
+                        }
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "office:automatic-styles"), 23, false, endSentinel))
+                        {
+                        /*if no styles have been read yet, then see if another document already had these styles.
+                          The section's styles are all that is needed from it, so if they are in the cache then
+                          skip ahead to the end of the section.*/
+                        if (m_style_cache != NULL && m_text_section_depth == 0 &&
+                            m_indented_paragraph_styles.empty() && m_is_current_style_read)
+                            {
+                            const T* sectionEnd = string_util::strnstr<T>(start, MARKUP_LITERAL(T, "</office:automatic-styles>"), endSentinel-start);
+                            //when streaming, wait for the whole section so that it can be looked up
+                            if (!sectionEnd && !is_final)
+                                {
+                                resumePosition = start;
+                                break;
+                                }
+                            if (sectionEnd)
+                                {
+                                m_style_section_key = style_section_key::fingerprint(start, sectionEnd);
+                                if (m_style_cache->find(m_style_section_key, m_indented_paragraph_styles))
+                                    {
+                                    //the closing element is read as usual
+                                    m_is_in_automatic_styles = true;
+                                    start = sectionEnd;
+                                    continue;
+                                    }
+                                //the section is cached after it is read, by which time a stream's chunk may be gone
+                                m_style_section_key.keep_section();
+                                m_is_style_section_cacheable = true;
+                                }
+                            }
+                        m_is_in_automatic_styles = true;
+                        textSectionFound = (m_text_section_depth > 0);
+                        }
                     //see if this should be treated as a new paragraph
-                    if (compare_element_case_sensitive(start+1, TEXT_P.c_str(), TEXT_P.length(), true) ||
-                        compare_element_case_sensitive(start+1, TEXT_H.c_str(), TEXT_H.length(), true))                    
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "text:p"), 6, true, endSentinel) ||
+                        compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "text:h"), 6, true, endSentinel))                    
                         {
                         if (!m_preserve_text_table_layout ||
-                            (m_preserve_text_table_layout && !insideOfListItemOrTableCell))
+                            (m_preserve_text_table_layout && !m_inside_of_list_item_or_table_cell))
                             {
                             //read the style to see if this paragraph is indented
-                            std::wstring styleName = read_tag_as_string(start+1, TEXT_STYLE_NAME.c_str(), TEXT_STYLE_NAME.length(), false);
+                            const std::pair<const T*, size_t> styleName = read_tag(start+1, MARKUP_LITERAL(T, "text:style-name"), 15, false, false, endSentinel);
                             //if this paragraph's style is indented then include a tab in front of it
-                            if (std::find(m_indented_paragraph_styles.begin(), m_indented_paragraph_styles.end(), styleName) != m_indented_paragraph_styles.end())
+                            if (is_indented_paragraph_style(styleName.first, styleName.second))
                                 {
                                 add_character(L'\n');
                                 add_character(L'\n');
@@ -127,56 +367,61 @@ namespace lily_of_the_valley
                                 add_character(L'\n');
                                 }
                             }
-                        ++textSectionDepth;
+                        ++m_text_section_depth;
                         }
-                    else if (compare_element_case_sensitive(start+1, L"text:span", 9, true))
-                        { ++textSectionDepth; }
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "text:span"), 9, true, endSentinel))
+                        { ++m_text_section_depth; }
                     //or end of a section
-                    else if (string_util::strncmp(start, TEXT_P_END.c_str(), TEXT_P_END.length() ) == 0 ||
-                        string_util::strncmp(start, TEXT_H_END.c_str(), TEXT_H_END.length() ) == 0 ||
-                        string_util::strncmp(start, L"</text:span>", 12) == 0)                    
-                        { --textSectionDepth; }
+                    else if (((endSentinel-start) >= 9 &&
+                            (string_util::strncmp(start, MARKUP_LITERAL(T, "</text:p>"), 9) == 0 ||
+                             string_util::strncmp(start, MARKUP_LITERAL(T, "</text:h>"), 9) == 0)) ||
+                        ((endSentinel-start) >= 12 &&
+                            string_util::strncmp(start, MARKUP_LITERAL(T, "</text:span>"), 12) == 0))                    
+                        { --m_text_section_depth; }
                     //beginning of a list item
-                    else if (compare_element_case_sensitive(start+1, L"text:list-item", 14) )
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "text:list-item"), 14, false, endSentinel) )
                         {
                         add_character(L'\n');
                         add_character(L'\t');
-                        insideOfListItemOrTableCell = true;
+                        m_inside_of_list_item_or_table_cell = true;
                         }
                     //end of a list item
-                    else if (compare_element_case_sensitive(start+1, L"/text:list-item", 15) )                    
-                        { insideOfListItemOrTableCell = false; }
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "/text:list-item"), 15, false, endSentinel) )                    
+                        { m_inside_of_list_item_or_table_cell = false; }
                     //tab over table cell and newline for table rows
-                    else if (compare_element_case_sensitive(start+1, TABLE_ROW.c_str(), TABLE_ROW.length() ) )                    
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "table:table-row"), 15, false, endSentinel) )                    
                         {
                         add_character(L'\n');
                         add_character(L'\n');
                         }
                     //tab over for a cell
-                    else if (compare_element_case_sensitive(start+1, L"table:table-cell", 16) )                    
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "table:table-cell"), 16, false, endSentinel) )                    
                         {
                         add_character(L'\t');
-                        insideOfListItemOrTableCell = true;
+                        m_inside_of_list_item_or_table_cell = true;
                         }
-                    else if (compare_element_case_sensitive(start+1, L"/table:table-cell", 17) )                    
-                        { insideOfListItemOrTableCell = false; }
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "/table:table-cell"), 17, false, endSentinel) )                    
+                        { m_inside_of_list_item_or_table_cell = false; }
                     //or a tab
-                    else if (compare_element_case_sensitive(start+1, L"text:tab", 8, true) )                    
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "text:tab"), 8, true, endSentinel) )                    
                         { add_character(L'\t'); }
                     //hard breaks
-                    else if (compare_element_case_sensitive(start+1, L"text:line-break", 15, true) )                    
+                    else if (compare_element_case_sensitive(start+1, MARKUP_LITERAL(T, "text:line-break"), 15, true, endSentinel) )                    
                         { add_character(L'\n'); }
                     else
-                        { textSectionFound = (textSectionDepth > 0) ? true : false; }
+                        { textSectionFound = (m_text_section_depth > 0) ? true : false; }
                     /*find the matching >, but watch out for an errant < also in case
                     the previous < wasn't terminated properly*/
-                    end = string_util::strcspn_pointer<wchar_t>(start+1, L"<>", 2);
-                    if (!end)
+                    end = start+1+string_util::strncspn<T>(start+1, endSentinel-(start+1), MARKUP_LITERAL(T, "<>"), 2);
+                    if (end >= endSentinel)
                         { break; }
                     /*if the < tag that we started from is not terminated then feed that in as
                     text instead of treating it like a valid HTML tag.  Not common, but it happens.*/
                     else if (end[0] == common_lang_constants::LESS_THAN)
                         {
+                        //skipping this section later wouldn't include this text, so don't cache it
+                        if (m_is_in_automatic_styles)
+                            { m_is_style_section_cacheable = false; }
                         /*copy over the text from the unterminated < to the currently found
                         < (that we will start from in the next loop*/
                         parse_raw_text(start, end-start);
@@ -189,82 +434,120 @@ namespace lily_of_the_valley
                         { ++end; }
                     }
                 //find the next starting tag
-                start = string_util::strchr(end, common_lang_constants::LESS_THAN);
+                m_is_in_text_section = textSectionFound;
+                start = string_util::strnchr<T>(end, common_lang_constants::LESS_THAN, endSentinel-end);
                 if (!start)
-                    { break; }
+                    {
+                    //the text after the last element may be continued in the next chunk
+                    resumePosition = end;
+                    break;
+                    }
                 //copy over the text between the tags
                 if (textSectionFound)
-                    { parse_raw_text(end, start-end); }
+                    {
+                    if (m_is_in_automatic_styles)
+                        { m_is_style_section_cacheable = false; }
+                    parse_raw_text(end, start-end);
+                    }
                 }
 
-            return get_filtered_text();
+            return resumePosition;
             }
-    private:
-        ///Reads in all of the paragraph styles, looking for any styles that involve text alignment.
-        void read_paragraph_styles(const wchar_t* text, const wchar_t* textEnd)
+        /**@returns Whether a style name is one of the indented paragraph styles.
+           @param styleName The style name (does not need to be NULL terminated).
+           @param length The length of the style name.*/
+        bool is_indented_paragraph_style(const wchar_t* styleName, const size_t length) const
             {
-            //items for reading in general style information
-            const std::wstring STYLE_STYLE_END(L"</style:style>");
-            const std::wstring STYLE_NAME(L"style:name");
-            const std::wstring ALIGNMENT(L"fo:text-align");
-            const std::wstring MARGIN_ALIGNMENT(L"fo:margin-left");
-
-            const wchar_t* const officeStyleStart = find_element(text, textEnd, L"office:automatic-styles", 23);
-            if (!officeStyleStart)
-                { return; }
-            const wchar_t* const officeStyleEnd = find_closing_element(officeStyleStart, textEnd, L"office:automatic-styles", 23);
-            if (officeStyleEnd)
+            if (styleName == NULL || length == 0)
+                { return false; }
+            return m_indented_paragraph_styles.contains(styleName, length);
+            }
+        /**@returns Whether a UTF-8 style name is one of the indented paragraph styles.
+           @param styleName The style name (does not need to be NULL terminated).
+           @param length The length (in bytes) of the style name.*/
+        bool is_indented_paragraph_style(const char* styleName, const size_t length) const
+            {
+            if (styleName == NULL || length == 0)
+                { return false; }
+            //style names are nearly always ASCII, which can be looked up as-is
+            for (size_t i = 0; i < length; ++i)
+                {
+                if (static_cast<unsigned char>(styleName[i]) >= 0x80)
+                    {
+                    const std::wstring wideStyleName = to_wide_string(styleName, length);
+                    return m_indented_paragraph_styles.contains(wideStyleName.c_str(), wideStyleName.length());
+                    }
+                }
+            return m_indented_paragraph_styles.contains(styleName, length);
+            }
+        /*Reads an element from the automatic styles section, adding the current style to the indented
+        paragraph styles if its paragraph properties are centered, right aligned, or indented.*/
+        template<typename T>
+        void read_style_element(const T* element, const T* endSentinel)
+            {
+            if (compare_element_case_sensitive(element+1, MARKUP_LITERAL(T, "style:style"), 11, false, endSentinel))
+                {
+                //read in the name of the current style
+                const std::pair<const T*, size_t> styleName = read_tag(element+1,
+                    MARKUP_LITERAL(T, "style:name"), 10, false, true, endSentinel);
+                if (styleName.first == NULL || styleName.second == 0)
+                    { m_current_style_name.clear(); }
+                else
+                    { m_current_style_name = to_wide_string(styleName.first, styleName.second); }
+                //an unnamed style can't be used, so there is nothing to read for it
+                m_is_current_style_read = m_current_style_name.empty();
+                }
+            //only the style's first paragraph properties are read
+            else if (!m_is_current_style_read &&
+                compare_element_case_sensitive(element+1, MARKUP_LITERAL(T, "style:paragraph-properties"), 26, true, endSentinel))
                 {
-                //go through all of the styles in the office styles section
-                const wchar_t* currentStyleStart = find_element(officeStyleStart, textEnd, L"style:style", 11);
-                while (currentStyleStart)
+                m_is_current_style_read = true;
+                //read in the paragraph alignment and if it's indented then add it to our collection of indented styles
+                const std::pair<const T*, size_t> alignment = read_tag(element+1,
+                    MARKUP_LITERAL(T, "fo:text-align"), 13, false, true, endSentinel);
+                if ((alignment.second == 6 && string_util::strncmp(alignment.first, MARKUP_LITERAL(T, "center"), 6) == 0) ||
+                    (alignment.second == 3 && string_util::strncmp(alignment.first, MARKUP_LITERAL(T, "end"), 3) == 0))
+                    { m_indented_paragraph_styles.insert(m_current_style_name); }
+                else
                     {
-                    const wchar_t* currentStyleEnd = find_closing_element(currentStyleStart, textEnd, L"style:style", 11);
-                    if (currentStyleStart && currentStyleEnd && (currentStyleStart < currentStyleEnd))
+                    const std::pair<const T*, size_t> marginAlignment = read_tag(element+1,
+                        MARKUP_LITERAL(T, "fo:margin-left"), 14, false, true, endSentinel);
+                    if (marginAlignment.first && marginAlignment.second > 0)
                         {
-                        //read in the name of the current style
-                        const std::wstring styleName = read_tag_as_string(currentStyleStart,
-                            STYLE_NAME.c_str(), STYLE_NAME.length(), false, true);
-                        if (styleName.empty())
-                            {
-                            currentStyleStart = currentStyleEnd + STYLE_STYLE_END.length();
-                            continue;
-                            }
-                        currentStyleStart = find_element(currentStyleStart, currentStyleEnd, L"style:paragraph-properties", 26);
-                        if (!currentStyleStart)
-                            { break; }
-                        else if (currentStyleStart > currentStyleEnd)
-                            {
-                            currentStyleStart = currentStyleEnd + STYLE_STYLE_END.length();
-                            continue;
-                            }
-                        //read in the paragraph alignment and if it's indented then add it to our collection of indented styles
-                        const std::wstring alignment = read_tag_as_string(currentStyleStart,
-                            ALIGNMENT.c_str(), ALIGNMENT.length(), false, true);
-                        if (alignment == L"center" || alignment == L"end")
-                            {m_indented_paragraph_styles.push_back(styleName); }
-                        else
-                            {
-                            const std::wstring marginAlignment = read_tag_as_string(currentStyleStart,
-                                MARGIN_ALIGNMENT.c_str(), MARGIN_ALIGNMENT.length(), false, true);
-                            if (!marginAlignment.empty())
-                                {
-                                wchar_t* dummy = NULL;
-                                const double alignmentValue = std::wcstod(marginAlignment.c_str(), &dummy);
-                                if (alignmentValue > 0.0f)
-                                    { m_indented_paragraph_styles.push_back(styleName); }
-                                }
-                            }
+                        //the value is terminated by a quote, so it can be read from the stream directly
+                        T* dummy = NULL;
+                        const double alignmentValue = string_util::strtod(marginAlignment.first, &dummy);
+                        if (alignmentValue > 0.0f)
+                            { m_indented_paragraph_styles.insert(m_current_style_name); }
                         }
-                    else
-                        { break; }
-                    currentStyleStart = currentStyleEnd + STYLE_STYLE_END.length();
                     }
                 }
+            else if (compare_element_case_sensitive(element+1, MARKUP_LITERAL(T, "/style:style"), 12, false, endSentinel))
+                { m_is_current_style_read = true; }
+            else if (compare_element_case_sensitive(element+1, MARKUP_LITERAL(T, "/office:automatic-styles"), 24, false, endSentinel))
+                {
+                m_is_in_automatic_styles = false;
+                //share these styles with other documents that have the same section
+                if (m_is_style_section_cacheable && m_is_current_style_read)
+                    { m_style_cache->insert(m_style_section_key, m_indented_paragraph_styles); }
+                m_is_style_section_cacheable = false;
+                }
             }
-        std::vector<std::wstring> m_indented_paragraph_styles;
+        style_name_set m_indented_paragraph_styles;
 
         bool m_preserve_text_table_layout;
+        //the state that is carried from one chunk of a stream to the next
+        int m_text_section_depth;
+        bool m_inside_of_list_item_or_table_cell;
+        bool m_is_in_text_section;
+        bool m_is_in_automatic_styles;
+        //the style (in the automatic styles section) being read, and whether its paragraph properties have been read yet
+        std::wstring m_current_style_name;
+        bool m_is_current_style_read;
+        //the cache of styles from other documents (not owned), and the fingerprint of this document's styles section
+        style_table_cache* m_style_cache;
+        style_section_key m_style_section_key;
+        bool m_is_style_section_cacheable;
         };
     }
 
@@ -0,0 +1,68 @@
+#include "package_extract_text.h"
+#include <algorithm>
+#include <utility>
+
+namespace lily_of_the_valley
+    {
+    const wchar_t* extract_package_part(const zip_package& package, const std::string& part_name,
+                                        html_extract_text& extractor, zip_entry_stream& stream)
+        {
+        const zip_entry* const entry = package.find_entry(part_name);
+        if (entry == NULL || !stream.open(package, *entry))
+            { return NULL; }
+        //the package's XML files always preserve their spaces (the extractors for them ignore this)
+        extractor.begin_stream(true);
+        const char* chunk = NULL;
+        size_t chunkLength = 0;
+        while ((chunkLength = stream.read(chunk)) > 0)
+            { extractor.feed(chunk, chunkLength); }
+        const wchar_t* const text = extractor.finish();
+        return stream.has_error() ? NULL : text;
+        }
+
+    const wchar_t* extract_package_part(const zip_package& package, const std::string& part_name,
+                                        html_extract_text& extractor)
+        {
+        zip_entry_stream stream;
+        return extract_package_part(package, part_name, extractor, stream);
+        }
+
+    std::vector<std::string> get_numbered_part_names(const zip_package& package,
+                                                     const std::string& prefix, const std::string& suffix)
+        {
+        std::vector<std::pair<size_t, std::string> > numberedParts;
+        for (std::vector<zip_entry>::const_iterator pos = package.get_entries().begin();
+            pos != package.get_entries().end();
+            ++pos)
+            {
+            const std::string& name = pos->m_name;
+            if (name.length() <= prefix.length()+suffix.length() ||
+                name.compare(0, prefix.length(), prefix) != 0 ||
+                name.compare(name.length()-suffix.length(), suffix.length(), suffix) != 0)
+                { continue; }
+            //the rest of the name must be the part's number (e.g., not "_rels/slide1.xml.rels")
+            size_t partNumber = 0;
+            bool isNumbered = true;
+            for (size_t i = prefix.length(); i < name.length()-suffix.length(); ++i)
+                {
+                if (name[i] < '0' || name[i] > '9')
+                    {
+                    isNumbered = false;
+                    break;
+                    }
+                partNumber = (partNumber*10)+(name[i]-'0');
+                }
+            if (isNumbered)
+                { numberedParts.push_back(std::make_pair(partNumber, name)); }
+            }
+        std::sort(numberedParts.begin(), numberedParts.end());
+        std::vector<std::string> partNames;
+        partNames.reserve(numberedParts.size());
+        for (size_t i = 0; i < numberedParts.size(); ++i)
+            { partNames.push_back(numberedParts[i].second); }
+        return partNames;
+        }
+
+    std::vector<std::string> get_pptx_slide_names(const zip_package& package)
+        { return get_numbered_part_names(package, "ppt/slides/slide", ".xml"); }
+    }
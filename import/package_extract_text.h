@@ -0,0 +1,72 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __PACKAGE_EXTRACT_TEXT_H__
+#define __PACKAGE_EXTRACT_TEXT_H__
+
+#include <string>
+#include <vector>
+#include "zip_package.h"
+#include "html_extract_text.h"
+
+namespace lily_of_the_valley
+    {
+    /**Extracts the text from a part of a package (e.g., <em>word/document.xml</em> from a DOCX file),
+       streaming the part into the extractor as it is inflated.
+    @details The part is inflated a chunk at a time and each chunk is passed to the extractor's feed(), so
+        the part's uncompressed XML is never held in full. Along with a callback_text_sink (see
+        extract_text::set_text_sink()), neither is the part's text.
+    @param package The open package that the part is in.
+    @param part_name The path of the part inside of the package.
+    @param extractor The extractor to stream the part into. This would be docx_extract_text for
+        <em>word/document.xml</em>, odt_extract_text for <em>content.xml</em>, or pptx_extract_text for
+        <em>ppt/slides/slide[<b>PAGENUMBER</b>].xml</em> (see get_pptx_slide_names()).
+        Its options (e.g., its text sink and budget) are used as they are.
+    @param stream The stream to inflate the part with. Reusing the same stream for many parts reuses its buffer.
+    @returns The plain text from the part (see html_extract_text::finish()), or NULL if the part isn't in the
+        package, can't be read (e.g., it is encrypted), or is corrupt.
+    @par Example:
+    @code
+        //Assuming that a DOCX file has been memory-mapped (or read) into a char* buffer
+        //named "fileContents" and "fileSize" is set to the size of the file.
+        lily_of_the_valley::zip_package package;
+        lily_of_the_valley::docx_extract_text docxExtract;
+        if (package.open(fileContents, fileSize) &&
+            lily_of_the_valley::extract_package_part(package, "word/document.xml", docxExtract) != NULL)
+            {
+            std::wstring fileText(docxExtract.get_filtered_text(), docxExtract.get_filtered_text_length());
+            }
+    @endcode*/
+    const wchar_t* extract_package_part(const zip_package& package, const std::string& part_name,
+                                        html_extract_text& extractor, zip_entry_stream& stream);
+    /**Extracts the text from a part of a package, streaming the part into the extractor as it is inflated.
+    @param package The open package that the part is in.
+    @param part_name The path of the part inside of the package.
+    @param extractor The extractor to stream the part into.
+    @returns The plain text from the part, or NULL if the part isn't in the package, can't be read, or is corrupt.*/
+    const wchar_t* extract_package_part(const zip_package& package, const std::string& part_name,
+                                        html_extract_text& extractor);
+    /**@returns The paths of the parts in a package that are numbered (e.g., <em>word/header[<b>NUMBER</b>].xml</em>),
+        ordered by their numbers (so that "header10.xml" comes after "header9.xml").
+       @param package The open package.
+       @param prefix The path in front of the number (e.g., "word/header").
+       @param suffix The text after the number (e.g., ".xml").*/
+    std::vector<std::string> get_numbered_part_names(const zip_package& package,
+                                                     const std::string& prefix, const std::string& suffix);
+    /**@returns The paths of a PPTX file's slides (<em>ppt/slides/slide[<b>PAGENUMBER</b>].xml</em>),
+        ordered by their numbers (so that "slide10.xml" comes after "slide9.xml").
+       @param package The open PPTX file.
+       @note This is the order of the slide files, which is the order that the slides are shown in
+        unless they have been rearranged (that order is in <em>ppt/presentation.xml</em>).*/
+    std::vector<std::string> get_pptx_slide_names(const zip_package& package);
+    }
+
+/** @}*/
+
+#endif //__PACKAGE_EXTRACT_TEXT_H__
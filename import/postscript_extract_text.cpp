@@ -52,7 +52,9 @@ const wchar_t* lily_of_the_valley::postscript_extract_text::operator()(const cha
     bool graveMode = false;
     bool acuteMode = false;
     bool inNegativeBMode = false;
-    for (/*counter already initialized*/; i < text_length; ++i)
+    //only read up to the input budget
+    const size_t readLength = get_input_budget_length(text_length);
+    for (/*counter already initialized*/; i < readLength && !is_budget_exceeded(); ++i)
         {
         switch (ps_buffer[i])
             {
@@ -69,7 +71,7 @@ const wchar_t* lily_of_the_valley::postscript_extract_text::operator()(const cha
                         {
                         //file is messed up--just return what we got
                         log_message(L"\"%%EndDocument\" element missing in Postscript file.");
-                        return get_filtered_text();
+                        return finalize_text();
                         }
                     else
                         { ps_buffer = end+13/*the length of "%%EndDocument"*/; }
@@ -77,7 +79,7 @@ const wchar_t* lily_of_the_valley::postscript_extract_text::operator()(const cha
                 //it's a comment--move to the end of the line
                 else
                     {
-                    while (++i < text_length)
+                    while (++i < readLength)
                         {
                         if (std::isspace(ps_buffer[i] ) )
                             { break; }
@@ -96,17 +98,20 @@ const wchar_t* lily_of_the_valley::postscript_extract_text::operator()(const cha
             of the next () set and see the command*/
             else
                 {
+                //each text section is a parsing step (and the loop stops once a budget has run out)
+                if (!take_budget_step())
+                    { break; }
                 char command_char = L' ';
                 bool inHyphenJoinMode = false;
                 bool newLineCommandFound = false;
                 inHyphenJoinMode = (ps_buffer[i-1] == '-');
                 //skip over any newlines in the file between the ')' and the first command of the next text section
-                while (i < (text_length-1) && isspace(static_cast<const int>(ps_buffer[i+1])))
+                while (i < (readLength-1) && isspace(static_cast<const int>(ps_buffer[i+1])))
                     { ++i; }
                 long horizontalPosition = 10;
                 if (ps_buffer[i+1] == '-' || isdigit(static_cast<const int>(ps_buffer[i+1])))
                     { horizontalPosition = std::strtol(ps_buffer+i+1, NULL, 10); }
-                while (i < (text_length-1) && ps_buffer[i+1] != '(')
+                while (i < (readLength-1) && ps_buffer[i+1] != '(')
                     {
                     ++i;
                     if (ps_buffer[i] == '%')
@@ -118,7 +123,7 @@ const wchar_t* lily_of_the_valley::postscript_extract_text::operator()(const cha
                                 {
                                 //file is messed up--just return what we got
                                 log_message(L"\"%%EndDocument\" element missing in Postscript file.");
-                                return get_filtered_text();
+                                return finalize_text();
                                 }
                             else
                                 {
@@ -362,7 +367,10 @@ const wchar_t* lily_of_the_valley::postscript_extract_text::operator()(const cha
                 }
             }
         }
+    if (readLength < text_length && !is_budget_exceeded())
+        { exceed_budget(L"Input limit reached; the rest of the document was not read."); }
     trim();
+    trim_to_budget_boundary();
     //returns the raw text buffer
-    return get_filtered_text();
+    return finalize_text();
     }
@@ -0,0 +1,82 @@
+#include "pptx_deck_extract_text.h"
+
+namespace lily_of_the_valley
+    {
+    ///@brief A thread's slide extractor, whose buffer is reused for each slide that thread extracts.
+    class pptx_deck_extract_text::worker
+        {
+    public:
+        /**Extracts the text from a slide and its notes.
+           @param slide The slide to extract the text from.
+           @param[out] text The slide's text, followed by its notes' text.
+           @param[out] log The slide's (and its notes') log.*/
+        void extract(const pptx_slide& slide, std::wstring& text, std::wstring& log)
+            {
+            text.clear();
+            log.clear();
+            if (m_pptx(slide.m_slide, slide.m_slide_length) != NULL)
+                { text.assign(m_pptx.get_filtered_text(), m_pptx.get_filtered_text_length()); }
+            log = m_pptx.get_log();
+            if (slide.m_notes != NULL && slide.m_notes_length > 0)
+                {
+                if (m_pptx(slide.m_notes, slide.m_notes_length) != NULL)
+                    { text.append(m_pptx.get_filtered_text(), m_pptx.get_filtered_text_length()); }
+                if (!m_pptx.get_log().empty())
+                    { log += (log.empty() ? L"" : L"\n")+m_pptx.get_log(); }
+                }
+            }
+    private:
+        pptx_extract_text m_pptx;
+        };
+
+    pptx_deck_extract_text::pptx_deck_extract_text(const size_t thread_count /*= 0*/) :
+        m_workers(thread_count), m_slide_separator(L"\f")
+        {}
+
+    pptx_deck_extract_text::~pptx_deck_extract_text()
+        {}
+
+    const wchar_t* pptx_deck_extract_text::operator()(const std::vector<pptx_slide>& slides)
+        {
+        clear_log();
+        log_unsupported_budget();
+        m_slide_offsets.clear();
+        if (slides.empty())
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+
+        //extract the slides (largest first) into their own strings
+        m_slide_text.resize(slides.size());
+        m_slide_log.resize(slides.size());
+        std::vector<size_t> costs(slides.size());
+        for (size_t i = 0; i < slides.size(); ++i)
+            { costs[i] = slides[i].m_slide_length+slides[i].m_notes_length; }
+        m_workers.run(costs, [&](worker& slideWorker, const size_t slideIndex)
+            { slideWorker.extract(slides[slideIndex], m_slide_text[slideIndex], m_slide_log[slideIndex]); },
+            [&](const size_t slideIndex)
+            {
+            m_slide_text[slideIndex].clear();
+            m_slide_log[slideIndex] = L"Unable to extract text from slide.";
+            });
+
+        //then put them together in order
+        if (!begin_text())
+            {
+            set_filtered_text_length(0);
+            return NULL;
+            }
+        m_slide_offsets.reserve(slides.size());
+        for (size_t i = 0; i < slides.size(); ++i)
+            {
+            if (i > 0)
+                { add_characters(m_slide_separator.c_str(), m_slide_separator.length()); }
+            m_slide_offsets.push_back(get_filtered_text_length());
+            add_characters(m_slide_text[i].c_str(), m_slide_text[i].length());
+            if (!m_slide_log[i].empty())
+                { log_message(L"Slide "+std::to_wstring(i+1)+L": "+m_slide_log[i]); }
+            }
+        return finalize_text();
+        }
+    }
@@ -0,0 +1,105 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __PPTX_DECK_EXTRACT_TEXT_H__
+#define __PPTX_DECK_EXTRACT_TEXT_H__
+
+#include <string>
+#include <vector>
+#include "pptx_extract_text.h"
+#include "../utilities/work_stealing_pool.h"
+
+namespace lily_of_the_valley
+    {
+    ///@brief A slide (and optionally, its notes) from a PPTX file, for pptx_deck_extract_text.
+    struct pptx_slide
+        {
+        ///Constructor.
+        pptx_slide() : m_slide(NULL), m_slide_length(0), m_notes(NULL), m_notes_length(0) {}
+        /**Constructor.
+           @param slide The UTF-8 content of the slide's <em>slide[<b>PAGENUMBER</b>].xml</em> file.
+            This does not need to be NULL terminated, and the caller must keep it alive until the deck is finished.
+           @param slide_length The length (in bytes) of the slide.
+           @param notes The UTF-8 content of the slide's <em>notesSlide[<b>PAGENUMBER</b>].xml</em> file (or NULL if it has no notes).
+           @param notes_length The length (in bytes) of the notes.*/
+        pptx_slide(const char* slide, const size_t slide_length,
+                   const char* notes = NULL, const size_t notes_length = 0) :
+            m_slide(slide), m_slide_length(slide_length), m_notes(notes), m_notes_length(notes_length) {}
+        const char* m_slide;
+        size_t m_slide_length;
+        const char* m_notes;
+        size_t m_notes_length;
+        };
+
+    /**@brief Class to extract text from all of the slides in a <b>Microsoft&reg; PowerPoint (2007+)</b> deck.
+    @details The slides (and their notes) are extracted across multiple threads with pptx_extract_text, and then
+        their text is put together in slide order. Each slide's text is followed by its notes' text (if any),
+        and the slides are separated by a page break (a form feed, by default; see set_slide_separator()).
+        Where each slide starts in the text is available from get_slide_offsets(). A slide that can't be
+        extracted is left empty (so that the offsets still line up with the slides) and noted in the log.
+    @note Requires C++11 (for @c std::thread). The slides' buffers must stay alive until operator() returns,
+        and a deck object should only be given one deck at a time. Budgets (see set_budget()) are not supported by
+        this class; give each slide to a pptx_extract_text for those.
+    @par Example:
+    @code
+        //Assuming that the slides (and notes) from a PPTX file have been unzipped
+        //into char* buffers, in the order that the slides are shown.
+        std::vector<lily_of_the_valley::pptx_slide> slides;
+        slides.push_back(lily_of_the_valley::pptx_slide(slide1, slide1Size, notes1, notes1Size));
+        slides.push_back(lily_of_the_valley::pptx_slide(slide2, slide2Size));
+
+        lily_of_the_valley::pptx_deck_extract_text deckExtract;
+        deckExtract(slides);
+        std::wstring deckText(deckExtract.get_filtered_text(), deckExtract.get_filtered_text_length());
+        //the second slide's text starts at deckExtract.get_slide_offsets()[1]
+    @endcode*/
+    class pptx_deck_extract_text : public extract_text
+        {
+    public:
+        /**Constructor.
+           @param thread_count The number of threads to use. If zero, then the number of cores on the system is used.*/
+        explicit pptx_deck_extract_text(const size_t thread_count = 0);
+        ///Destructor.
+        ~pptx_deck_extract_text();
+        /**Main interface for extracting plain text from a deck of slides.
+           @param slides The slides (in the order that they are shown).
+           @returns The text from the slides, or NULL if there aren't any slides.*/
+        const wchar_t* operator()(const std::vector<pptx_slide>& slides);
+        /**Sets the text written between slides.
+           @param separator The text to separate slides with. The default is a form feed ('\\f').*/
+        void set_slide_separator(const std::wstring& separator)
+            { m_slide_separator = separator; }
+        ///@returns The text written between slides.
+        const std::wstring& get_slide_separator() const
+            { return m_slide_separator; }
+        /**@returns Where each slide's text starts in the extracted text (after the separator in front of it).
+            There is one offset for each slide passed to the last call to operator().*/
+        const std::vector<size_t>& get_slide_offsets() const
+            { return m_slide_offsets; }
+        ///@returns The number of threads that slides are extracted on.
+        size_t get_thread_count() const
+            { return m_workers.get_thread_count(); }
+    private:
+        class worker;
+        //each thread's slide extractor, which is kept between decks
+        worker_pool<worker> m_workers;
+        //each slide's text (and log), before it is put together
+        std::vector<std::wstring> m_slide_text;
+        std::vector<std::wstring> m_slide_log;
+        std::vector<size_t> m_slide_offsets;
+        std::wstring m_slide_separator;
+        //disable copy construction
+        pptx_deck_extract_text(const pptx_deck_extract_text&);
+        void operator=(const pptx_deck_extract_text&);
+        };
+    }
+
+/** @}*/
+
+#endif //__PPTX_DECK_EXTRACT_TEXT_H__
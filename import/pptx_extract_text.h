@@ -18,10 +18,10 @@ namespace lily_of_the_valley
     @par Example:
     @code
         //Assuming that the contents of "slide[PAGENUMBER].xml" from a PPTX
-        //file is in a wchar_t* buffer named "fileContents" and
+        //file is in a char* buffer named "fileContents" and
         //"fileSize" is set to the size of this xml file.
-        //Note that you should use the specified character set
-        //in the XML file (usually UTF-8) when loading this file into the wchar_t buffer.
+        //The slide is UTF-8, so it can be passed in as-is
+        //(a wchar_t* buffer that it has already been converted to is also accepted).
         lily_of_the_valley::pptx_extract_text pptxExtract;
         pptxExtract(fileContents, fileSize);
 
@@ -30,16 +30,52 @@ namespace lily_of_the_valley
         //from get_filtered_text_length(). Call these to copy the text into
         //a wide string.
         std::wstring fileText(pptxExtract.get_filtered_text(), pptxExtract.get_filtered_text_length());
-    @endcode*/
+    @endcode
+    @sa pptx_deck_extract_text, to extract all of the slides in a deck (across multiple threads).*/
     class pptx_extract_text : public html_extract_text
         {
     public:
         /**Main interface for extracting plain text from a PowerPoint (2007+) slide.
-        @param html_text The slide text to parse. Pass in the text from a <em>slide[<b>PAGENUMBER</b>].xml</em> file from a PPTX file. PPTX files are zip files, which can be opened by a library such as <em>zlib</em>
+        @param html_text The slide text to parse. Pass in the text from a <em>slide[<b>PAGENUMBER</b>].xml</em> file from a PPTX file. PPTX files are zip files, whose parts can be read with zip_package (or streamed straight into this extractor with extract_package_part()).
         @param text_length The length of the text.
         @returns The parsed text from the slide.*/
         const wchar_t* operator()(const wchar_t* html_text,
                                   const size_t text_length)
+            { return extract(html_text, text_length); }
+        /**Main interface for extracting plain text from a UTF-8 PowerPoint (2007+) slide.
+        @param html_text The UTF-8 slide text to parse.
+        @param text_length The length (in bytes) of the text.
+        @returns The parsed text from the slide.*/
+        const wchar_t* operator()(const char* html_text,
+                                  const size_t text_length)
+            { return extract(html_text, text_length); }
+    protected:
+        /**Resets the paragraph and run state at the start of a stream.
+           @param preserve_spaces Not used, spaces are always preserved in this XML.*/
+        virtual void reset_stream_state(const bool /*preserve_spaces*/)
+            {
+            html_extract_text::reset_stream_state(true);
+            m_is_in_preformatted_text_block_stack = 1;//use "preserve spaces" logic in this XML
+            m_state = slide_state();
+            }
+        /**Parses the next part of a streamed slide.
+           @param start The start of the text to parse.
+           @param endSentinel The end of the text.
+           @param is_final Whether this is the end of the stream.
+           @returns Where parsing stopped.*/
+        virtual const wchar_t* parse_stream_chunk(const wchar_t* start, const wchar_t* endSentinel, const bool is_final)
+            { return parse(start, endSentinel, is_final); }
+        /**Parses the next part of a streamed UTF-8 slide.
+           @param start The start of the text to parse.
+           @param endSentinel The end of the text.
+           @param is_final Whether this is the end of the stream.
+           @returns Where parsing stopped.*/
+        virtual const char* parse_stream_chunk(const char* start, const char* endSentinel, const bool is_final)
+            { return parse(start, endSentinel, is_final); }
+    private:
+        template<typename T>
+        const wchar_t* extract(const T* html_text,
+                               const size_t text_length)
             {
             clear_log();
             if (html_text == NULL || html_text[0] == 0 || text_length == 0)
@@ -47,117 +83,246 @@ namespace lily_of_the_valley
                 set_filtered_text_length(0);
                 return NULL;
                 }
-            assert(text_length <= string_util::strlen(html_text) );
 
-            if (!allocate_text_buffer(text_length))
+            if (!begin_text())
                 {
                 set_filtered_text_length(0);
                 return NULL;
                 }
+            set_offset_source(html_text, text_length);
 
-            m_is_in_preformatted_text_block_stack = 1;//use "preserve spaces" logic in this XML
+            reset_stream_state(true);
+            /*only read up to the input budget, parsing it like a chunk of a stream
+              so that whatever is cut off at the end (e.g., half of an element) is left unread*/
+            const size_t readLength = get_input_budget_length(text_length);
+            parse(html_text, html_text+readLength, readLength == text_length);
+            if (readLength < text_length)
+                { exceed_budget(L"Input limit reached; the rest of the document was not read."); }
+            trim_to_budget_boundary();
 
-            //find the first paragraph and set up where we halt our searching
-            const wchar_t* const endSentinel = html_text+text_length;
-            const wchar_t* start = find_element(html_text, endSentinel, L"a:p", 3, false);
-            const wchar_t* paragraphEnd = NULL;
-            const wchar_t* rowEnd = NULL;
-            const wchar_t* paragraphProperties = NULL;
-            const wchar_t* paragraphPropertiesEnd = NULL;
-            const wchar_t* textEnd = NULL;
-            const wchar_t* nextBreak = NULL;
-            bool isBulletedParagraph = true;
-            bool isBulletedPreviousParagraph = true;
+            return finalize_text();
+            }
+        /*Walks through the elements once, keeping track of which paragraph, paragraph properties,
+        run, and text section we are in. Nested elements of the same name are counted so that the
+        right closing element ends each of them.
+
+        Parsing picks up where the last call left off. If is_final is false, then the slide may be continued
+        in another chunk, so an element that is cut off at endSentinel is not parsed (nor is a run's text that
+        isn't finished yet). Returns where parsing stopped.*/
+        template<typename T>
+        const T* parse(const T* text, const T* const endSentinel, const bool is_final)
+            {
+            slide_state& state = m_state;
+            //the start of the current run's text (or NULL if not inside of one), which may have started in the previous chunk
+            const T* textStart = state.m_is_in_run_text ? text : NULL;
+            const T* start = string_util::strnchr<T>(text, common_lang_constants::LESS_THAN, endSentinel-text);
+            //where to pick up from in the next chunk
+            const T* resumePosition = endSentinel;
 
             while (start && (start < endSentinel))
                 {
-                isBulletedPreviousParagraph = isBulletedParagraph;
-                isBulletedParagraph = true;
-                paragraphEnd = find_closing_element(start, endSentinel, L"a:p", 3);
-                if (!paragraphEnd)
+                //stop (and leave the rest of the text unread) if a budget has run out
+                if (!take_budget_step())
                     { break; }
-                paragraphProperties = find_element(start, paragraphEnd, L"a:pPr", 5, true);
-                if (paragraphProperties)
+                const basic_html_element_view<T> currentTag = read_element(start+1, endSentinel);
+                //when streaming, an element that is cut off is read once the rest of it is in
+                if (!is_final && currentTag.get_close_tag() == NULL)
+                    {
+                    resumePosition = start;
+                    break;
+                    }
+                const markup_element currentTagId = classify_element(currentTag);
+                if (state.m_paragraph_depth == 0)
                     {
-                    paragraphPropertiesEnd = find_closing_element(paragraphProperties, paragraphEnd, L"a:pPr", 5); 
-                    if (paragraphPropertiesEnd)
+                    //look for the next paragraph (an empty, self-terminated one has nothing to read)
+                    if (currentTagId == pptx_p && currentTag.get_close_tag() != NULL && !currentTag.is_self_terminating())
                         {
-                        //see if the paragraphs in here are bullet points or real lines of text.
-                        const wchar_t* bulletNoneTag = find_element(paragraphProperties, paragraphPropertiesEnd, L"a:buNone", 8, true);
-                        if (bulletNoneTag)
-                            { isBulletedParagraph = false; }
+                        state.m_paragraph_depth = 1;
+                        state.m_paragraph_output_start = get_filtered_text_length();
+                        state.m_paragraph_properties_depth = state.m_run_depth = state.m_text_depth = 0;
+                        textStart = NULL;
+                        state.m_paragraph_properties_found = state.m_is_paragraph_started = state.m_is_indented_paragraph = state.m_break_found = false;
+                        state.m_is_bulleted_previous_paragraph = state.m_is_bulleted_paragraph;
+                        state.m_is_bulleted_paragraph = true;
                         }
-                    //if the paragraph is indented, then put a tab in front of it.
-                    const std::wstring levelDepth = read_tag_as_string(paragraphProperties, L"lvl", 3, false);
-                    if (!levelDepth.empty())
+                    }
+                else if (currentTagId == pptx_p)
+                    { ++state.m_paragraph_depth; }
+                else if (currentTagId == pptx_p_end && --state.m_paragraph_depth == 0)
+                    {
+                    //make room for the paragraph's start, a trailing break, and the newlines ending the paragraph
+                    if (!reserve_text(5))
+                        { break; }
+                    if (!state.m_is_paragraph_started)
+                        { start_paragraph(state.m_is_indented_paragraph, state.m_is_bulleted_paragraph, state.m_is_bulleted_previous_paragraph); }
+                    if (state.m_break_found)
+                        { add_character(L'\n'); }
+                    //force bullet points to have two lines between them to show they are independent of each other
+                    if (state.m_is_bulleted_paragraph)
                         {
-                        wchar_t* dummy = NULL;
-                        const double levelDepthValue = std::wcstod(levelDepth.c_str(), &dummy);
-                        if (levelDepthValue >= 1)
-                            { add_character(L'\t'); }
+                        add_character(L'\n');
+                        add_character(L'\n');
                         }
+                    //otherwise, lines might actually be paragraphs split to fit inside of a box
+                    else
+                        { add_character(L'\n'); }
                     }
-                //if last paragraph as not a bullet point, but this one is then add an extra newline between them to differeniate them
-                if (isBulletedParagraph && !isBulletedPreviousParagraph)
-                    { add_character(L'\n'); }
-                for (;;)
+                //inside of a run's text, so just look for where it ends
+                else if (textStart != NULL)
                     {
-                    //go to the next row
-                    nextBreak = find_element(start, paragraphEnd, L"a:br", 4, true);
-                    start = find_element(start, paragraphEnd, L"a:r", 3, false);
-                    if (!start || start > endSentinel)
+                    if (currentTagId == pptx_t)
+                        { ++state.m_text_depth; }
+                    else if (currentTagId == pptx_t_end && --state.m_text_depth == 0)
                         {
-                        //if no more runs in this paragraph, just see if there are any trailing breaks
-                        if (nextBreak)
-                            { add_character(L'\n'); }
-                        break;
+                        parse_raw_text(textStart, start-textStart);
+                        textStart = NULL;
                         }
-                    rowEnd = find_closing_element(++start, paragraphEnd, L"a:r", 3);
-                    if (!rowEnd || rowEnd > endSentinel)
-                        { break; }
-                    //see if there is a break before this row. If so, then add some newlines to the output first.
-                    if (nextBreak && nextBreak < start)
-                        { add_character(L'\n'); }
-                    //read the text section inside of it. If no valid text section, then
-                    //just add a space (which an empty run implies) and skip to the next run.
-                    start = find_element(start, rowEnd, L"a:t", 3, false);
-                    if (!start || start > endSentinel)
+                    else if (currentTagId == pptx_r_end && --state.m_run_depth == 0)
+                        { textStart = NULL; }
+                    }
+                else if (state.m_run_depth > 0)
+                    {
+                    if (currentTagId == pptx_r)
+                        { ++state.m_run_depth; }
+                    else if (currentTagId == pptx_r_end && --state.m_run_depth == 0)
                         {
-                        if (get_filtered_text_length() > 0 &&
+                        //an empty run implies a space
+                        if (!state.m_run_text_found && get_filtered_text_length() > 0 &&
                             !std::iswspace(get_filtered_text()[get_filtered_text_length()-1]))
-                            { add_character(common_lang_constants::SPACE); }
-                        start = rowEnd;
-                        continue;
+                            {
+                            if (!reserve_text(1))
+                                { break; }
+                            add_character(common_lang_constants::SPACE);
+                            }
                         }
-                    start = string_util::strchr(start, common_lang_constants::GREATER_THAN);
-                    if (!start || start > endSentinel)
+                    //only the run's first text section is read
+                    else if (currentTagId == pptx_t && !state.m_run_text_found &&
+                        currentTag.get_close_tag() != NULL && !currentTag.is_self_terminating())
                         {
-                        start = rowEnd;
-                        continue;
+                        state.m_run_text_found = true;
+                        textStart = currentTag.get_close_tag()+1;
+                        state.m_text_depth = 1;
+                        if (!is_final)
+                            { m_text_start_state = state; }
                         }
-                    textEnd = find_closing_element(++start, rowEnd, L"a:t", 3);
-                    if (!textEnd || textEnd > endSentinel)
+                    else if (currentTagId == pptx_br)
+                        { state.m_break_found = true; }
+                    }
+                else if (state.m_paragraph_properties_depth > 0)
+                    {
+                    if (currentTagId == pptx_p_pr)
+                        { ++state.m_paragraph_properties_depth; }
+                    else if (currentTagId == pptx_p_pr_end)
+                        { --state.m_paragraph_properties_depth; }
+                    //see if the paragraphs in here are bullet points or real lines of text.
+                    else if (currentTagId == pptx_bu_none)
+                        { state.m_is_bulleted_paragraph = false; }
+                    else if (currentTagId == pptx_br)
+                        { state.m_break_found = true; }
+                    }
+                else if (currentTagId == pptx_p_pr && !state.m_paragraph_properties_found)
+                    {
+                    state.m_paragraph_properties_found = true;
+                    if (!currentTag.is_self_terminating())
+                        { state.m_paragraph_properties_depth = 1; }
+                    //if the paragraph is indented, then put a tab in front of it.
+                    const std::pair<const T*, size_t> levelDepth = read_tag(start, MARKUP_LITERAL(T, "lvl"), 3, false, false, endSentinel);
+                    if (levelDepth.first && levelDepth.second > 0)
                         {
-                        start = rowEnd;
-                        continue;
+                        //the value is terminated by a quote or space, so it can be read from the stream directly
+                        T* dummy = NULL;
+                        state.m_is_indented_paragraph = (string_util::strtod(levelDepth.first, &dummy) >= 1);
                         }
-                    parse_raw_text(start, textEnd-start);
                     }
-                //force bullet points to have two lines between them to show they are independent of each other
-                if (isBulletedParagraph)
+                else if (currentTagId == pptx_br)
+                    { state.m_break_found = true; }
+                //the next run (an empty, self-terminated one has nothing to read)
+                else if (currentTagId == pptx_r && currentTag.get_close_tag() != NULL && !currentTag.is_self_terminating())
                     {
-                    add_character(L'\n');
-                    add_character(L'\n');
+                    //make room for the paragraph's start and a break in front of the run
+                    if (!reserve_text(3))
+                        { break; }
+                    if (!state.m_is_paragraph_started)
+                        {
+                        start_paragraph(state.m_is_indented_paragraph, state.m_is_bulleted_paragraph, state.m_is_bulleted_previous_paragraph);
+                        state.m_is_paragraph_started = true;
+                        }
+                    //see if there is a break before this run. If so, then add a newline to the output first.
+                    if (state.m_break_found)
+                        {
+                        add_character(L'\n');
+                        state.m_break_found = false;
+                        }
+                    state.m_run_depth = 1;
+                    state.m_run_text_found = false;
+                    }
+                //go to the next element (XML doesn't allow a '<' inside of an element or text, so it can be searched for directly)
+                const T* const nextStart = (currentTag.get_close_tag() != NULL) ? currentTag.get_close_tag()+1 : start+1;
+                start = (nextStart < endSentinel) ?
+                    string_util::strnchr<T>(nextStart, common_lang_constants::LESS_THAN, endSentinel-nextStart) : NULL;
+                }
+            if (!is_final)
+                {
+                /*A run's text that isn't finished is read again (once the rest of it is in), so go back to how
+                things were at the start of it. Nothing is written while inside of it unless its paragraph is closed,
+                which ends the text without reading it.*/
+                if (textStart != NULL && state.m_paragraph_depth > 0)
+                    {
+                    state = m_text_start_state;
+                    state.m_is_in_run_text = true;
+                    return textStart;
                     }
-                //otherwise, lines might actually be paragraphs split to fit inside of a box
-                else
-                    { add_character(L'\n'); }
-                //go to the next paragraph
-                start = find_element(paragraphEnd, endSentinel, L"a:p", 3, false);
+                state.m_is_in_run_text = false;
+                return resumePosition;
                 }
+            //a paragraph that isn't closed is incomplete, so don't include it
+            if (state.m_paragraph_depth > 0 && state.m_paragraph_output_start < get_filtered_text_length())
+                { set_filtered_text_length(state.m_paragraph_output_start); }
 
-            return get_filtered_text();
+            return endSentinel;
             }
+        /**Writes what goes in front of a paragraph's text, once its properties are known.
+           Room for two characters must have already been made with reserve_text().
+           @param isIndented Whether the paragraph is indented.
+           @param isBulleted Whether the paragraph is a bullet point.
+           @param isBulletedPrevious Whether the previous paragraph was a bullet point.*/
+        void start_paragraph(const bool isIndented, const bool isBulleted, const bool isBulletedPrevious)
+            {
+            if (isIndented)
+                { add_character(L'\t'); }
+            //if last paragraph as not a bullet point, but this one is then add an extra newline between them to differeniate them
+            if (isBulleted && !isBulletedPrevious)
+                { add_character(L'\n'); }
+            }
+
+        ///@brief Where the parser is in the slide, which is carried from one chunk of a stream to the next.
+        struct slide_state
+            {
+            slide_state() : m_paragraph_output_start(0), m_paragraph_depth(0), m_paragraph_properties_depth(0),
+                m_run_depth(0), m_text_depth(0), m_is_in_run_text(false),
+                m_paragraph_properties_found(false), m_is_paragraph_started(false), m_is_indented_paragraph(false),
+                m_run_text_found(false), m_break_found(false), m_is_bulleted_paragraph(true),
+                m_is_bulleted_previous_paragraph(true)
+                {}
+            //where the paragraph's output starts (it is thrown away if the paragraph is never closed)
+            size_t m_paragraph_output_start;
+            size_t m_paragraph_depth;
+            size_t m_paragraph_properties_depth;
+            size_t m_run_depth;
+            size_t m_text_depth;
+            //whether a run's text was cut off at the end of the last chunk
+            bool m_is_in_run_text;
+            bool m_paragraph_properties_found;
+            bool m_is_paragraph_started;
+            bool m_is_indented_paragraph;
+            bool m_run_text_found;
+            bool m_break_found;
+            bool m_is_bulleted_paragraph;
+            bool m_is_bulleted_previous_paragraph;
+            };
+        slide_state m_state;
+        //the state when the current run's text started (when streaming)
+        slide_state m_text_start_state;
         };
     }
 
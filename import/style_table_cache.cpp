@@ -0,0 +1,153 @@
+#include "style_table_cache.h"
+#include "odt_extract_text.h"
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <utility>
+
+namespace lily_of_the_valley
+    {
+    ///@brief Hashes a styles section's fingerprint (which is already a hash) for the cache's lookup table.
+    struct style_section_key_hash
+        {
+        size_t operator()(const style_section_key& key) const
+            { return static_cast<size_t>(key.m_hash ^ (key.m_hash >> 32) ^ key.m_length); }
+        };
+
+    ///@brief The cache's lookup table and recently used list (kept out of the header so that it compiles as C++03).
+    class style_table_cache::impl
+        {
+    public:
+        impl(const size_t max_size, const size_t max_bytes) :
+            m_max_size(max_size), m_max_bytes(max_bytes), m_byte_count(0), m_hit_count(0), m_miss_count(0)
+            {}
+        //the memory that a section's copy and its styles take up
+        static size_t get_byte_count(const style_section_key& key, const style_name_set& styles)
+            {
+            size_t byteCount = key.get_kept_size();
+            const std::vector<std::wstring>& names = styles.get_names();
+            for (size_t i = 0; i < names.size(); ++i)
+                { byteCount += (names[i].length()+1)*sizeof(wchar_t); }
+            return byteCount;
+            }
+        //drops the least recently used section
+        void erase_oldest()
+            {
+            const auto pos = m_lookup.find(*m_usage.back());
+            m_byte_count -= pos->second.m_byte_count;
+            m_lookup.erase(pos);
+            m_usage.pop_back();
+            }
+        //the styles sections' keys (which are in m_lookup), most recently used first
+        typedef std::list<const style_section_key*> usage_list;
+        ///@brief A styles section's styles and where it is in the recently used list.
+        struct entry
+            {
+            style_name_set m_styles;
+            usage_list::iterator m_usage;
+            size_t m_byte_count;
+            };
+        usage_list m_usage;
+        //the sections' keys are only stored here (which holds a copy of each section, to compare against on a hit)
+        std::unordered_map<style_section_key, entry, style_section_key_hash> m_lookup;
+        size_t m_max_size;
+        size_t m_max_bytes;
+        size_t m_byte_count;
+        size_t m_hit_count;
+        size_t m_miss_count;
+        mutable std::mutex m_mutex;
+        };
+
+    style_table_cache::style_table_cache(const size_t max_size /*= 256*/, const size_t max_bytes /*= 16*1024*1024*/) :
+        m_impl(new impl(std::max<size_t>(max_size, 1), max_bytes))
+        {}
+
+    style_table_cache::~style_table_cache()
+        { delete m_impl; }
+
+    bool style_table_cache::find(const style_section_key& key, style_name_set& styles)
+        {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        const auto pos = m_impl->m_lookup.find(key);
+        if (pos == m_impl->m_lookup.end())
+            {
+            ++m_impl->m_miss_count;
+            return false;
+            }
+        ++m_impl->m_hit_count;
+        //move it to the front of the recently used list
+        m_impl->m_usage.splice(m_impl->m_usage.begin(), m_impl->m_usage, pos->second.m_usage);
+        const std::vector<std::wstring>& names = pos->second.m_styles.get_names();
+        for (size_t i = 0; i < names.size(); ++i)
+            { styles.insert(names[i]); }
+        return true;
+        }
+
+    void style_table_cache::insert(const style_section_key& key, const style_name_set& styles)
+        {
+        //the stored key holds its own copy of the section, since the caller's section will go away
+        style_section_key storedKey(key);
+        storedKey.keep_section();
+        const size_t byteCount = impl::get_byte_count(storedKey, styles);
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        const auto pos = m_impl->m_lookup.find(storedKey);
+        if (pos != m_impl->m_lookup.end())
+            {
+            m_impl->m_byte_count -= pos->second.m_byte_count;
+            m_impl->m_usage.erase(pos->second.m_usage);
+            m_impl->m_lookup.erase(pos);
+            }
+        if (byteCount > m_impl->m_max_bytes)
+            { return; }
+        //make room by dropping the least recently used sections
+        while (!m_impl->m_usage.empty() &&
+               (m_impl->m_usage.size() >= m_impl->m_max_size || m_impl->m_byte_count+byteCount > m_impl->m_max_bytes))
+            { m_impl->erase_oldest(); }
+        //(a key in the lookup table stays where it is as the table grows, so the recently used list can point to it)
+        const auto newEntry = m_impl->m_lookup.insert(std::make_pair(std::move(storedKey), impl::entry())).first;
+        newEntry->second.m_styles = styles;
+        newEntry->second.m_byte_count = byteCount;
+        m_impl->m_byte_count += byteCount;
+        m_impl->m_usage.push_front(&newEntry->first);
+        newEntry->second.m_usage = m_impl->m_usage.begin();
+        }
+
+    void style_table_cache::clear()
+        {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        m_impl->m_usage.clear();
+        m_impl->m_lookup.clear();
+        m_impl->m_byte_count = 0;
+        }
+
+    size_t style_table_cache::size() const
+        {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        return m_impl->m_usage.size();
+        }
+
+    size_t style_table_cache::get_max_size() const
+        { return m_impl->m_max_size; }
+
+    size_t style_table_cache::get_byte_count() const
+        {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        return m_impl->m_byte_count;
+        }
+
+    size_t style_table_cache::get_max_byte_count() const
+        { return m_impl->m_max_bytes; }
+
+    size_t style_table_cache::get_hit_count() const
+        {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        return m_impl->m_hit_count;
+        }
+
+    size_t style_table_cache::get_miss_count() const
+        {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        return m_impl->m_miss_count;
+        }
+    }
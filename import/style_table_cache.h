@@ -0,0 +1,163 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __STYLE_TABLE_CACHE_H__
+#define __STYLE_TABLE_CACHE_H__
+
+#include <cstddef>
+#include <string>
+
+namespace lily_of_the_valley
+    {
+    class style_name_set;
+
+    /**@brief A fingerprint of a document's styles section, used to recognize the same styles in another document.
+    @details This is a 64-bit hash of the section's characters and the section's length, along with where the section is.
+        The hash and length are what the section is looked up by, and the section is only compared (character by character)
+        against a stored section whose hash and length match, so that two different sections are never mistaken for each other.
+        Characters are hashed (and compared) by their values, so an ASCII section matches the same section as UTF-8 or as wide text.
+
+        Fingerprinting a section doesn't copy it; the key points to the section, so the section must stay in memory
+        until either the key is done with or keep_section() is called (which the cache does when it stores a key).*/
+    struct style_section_key
+        {
+        ///Constructor.
+        style_section_key() : m_length(0), m_hash(0), m_section(NULL), m_character_size(sizeof(char)) {}
+        /**Fingerprints a styles section.
+           @param start The start of the section.
+           @param end The end of the section.
+           @returns The section's fingerprint.*/
+        template<typename T>
+        static style_section_key fingerprint(const T* start, const T* end)
+            {
+            style_section_key key;
+            key.m_length = end-start;
+            key.m_section = reinterpret_cast<const char*>(start);
+            key.m_character_size = sizeof(T);
+            //64-bit FNV-1a, with its bits mixed at the end so that similar sections don't end up in neighboring buckets
+            unsigned long long hash = 14695981039346656037ULL;
+            for (const T* position = start; position < end; ++position)
+                { hash = (hash ^ to_code_point(*position)) * 1099511628211ULL; }
+            hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCDULL;
+            hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+            key.m_hash = hash ^ (hash >> 33);
+            return key;
+            }
+        /**Copies the section into the key, so that the key can be kept after the section is gone
+           (e.g., a streamed document's earlier chunks).*/
+        void keep_section()
+            {
+            if (m_copy.empty())
+                { m_copy.assign(m_section, m_length*m_character_size); }
+            m_section = NULL;
+            }
+        ///@returns Whether two fingerprints are of the same section.
+        bool operator==(const style_section_key& that) const
+            {
+            if (m_length != that.m_length || m_hash != that.m_hash)
+                { return false; }
+            const char* section = get_section();
+            const char* thatSection = that.get_section();
+            for (size_t i = 0; i < m_length; ++i)
+                {
+                if (get_code_point(section, i) != that.get_code_point(thatSection, i))
+                    { return false; }
+                }
+            return true;
+            }
+        ///@returns The number of bytes of the section that the key holds a copy of (see keep_section()).
+        size_t get_kept_size() const
+            { return m_copy.length(); }
+        size_t m_length;
+        unsigned long long m_hash;
+    private:
+        const char* get_section() const
+            { return (m_section != NULL) ? m_section : m_copy.data(); }
+        unsigned long get_code_point(const char* section, const size_t position) const
+            {
+            return (m_character_size == sizeof(wchar_t)) ?
+                to_code_point(reinterpret_cast<const wchar_t*>(section)[position]) :
+                to_code_point(section[position]);
+            }
+        static unsigned long to_code_point(const wchar_t ch)
+            { return static_cast<unsigned long>(ch); }
+        static unsigned long to_code_point(const char ch)
+            { return static_cast<unsigned char>(ch); }
+        //the section that was fingerprinted (NULL once it is copied into m_copy)
+        const char* m_section;
+        size_t m_character_size;
+        //the section's bytes, once keep_section() is called
+        std::string m_copy;
+        };
+
+    /**@brief A cache of the styles that have been read from documents' styles sections, shared between extractors
+        (and threads), so that documents made from the same template don't need to have their styles read again.
+    @details Styles are looked up by a fingerprint of their section (see style_section_key). The cache holds a copy
+        of each section that it stores (to compare against on a lookup), so it is bounded both by how many sections
+        it holds and by how many bytes those sections (and their styles) take up. Once either is reached,
+        the least recently used styles are dropped to make room, and a section larger than the byte limit is never stored.
+
+        To use it, pass the cache to each extractor's set_style_cache() (e.g., odt_extract_text::set_style_cache()).
+        The cache is thread safe, so one cache can be shared by all of the extractors on all of the threads.
+    @note This is implemented with C++11 (for @c std::mutex), but its header can be included in C++03 code.
+        Extractors only call it through its virtual functions, so <em>style_table_cache.cpp</em> only needs to
+        be built into programs that create a cache.
+    @par Example:
+    @code
+        //shared by all of the threads' extractors (up to 512 sections, using up to 32MB)
+        lily_of_the_valley::style_table_cache styleCache(512, 32*1024*1024);
+
+        lily_of_the_valley::odt_extract_text odtExtract;
+        odtExtract.set_style_cache(&styleCache);
+        odtExtract(fileContents, fileSize);
+    @endcode*/
+    class style_table_cache
+        {
+    public:
+        /**Constructor.
+           @param max_size The most styles sections to hold onto.
+           @param max_bytes The most memory (in bytes) that the held styles sections and their styles may take up.*/
+        explicit style_table_cache(const size_t max_size = 256, const size_t max_bytes = 16*1024*1024);
+        ///Destructor.
+        virtual ~style_table_cache();
+        /**Looks up the styles from a styles section that was read before.
+           @param key The fingerprint of the styles section.
+           @param[out] styles The set to add the section's styles to.
+           @returns Whether the section was in the cache.*/
+        virtual bool find(const style_section_key& key, style_name_set& styles);
+        /**Adds (or replaces) the styles read from a styles section.
+           @param key The fingerprint of the styles section (the cache keeps its own copy of the section).
+           @param styles The styles read from the section.*/
+        virtual void insert(const style_section_key& key, const style_name_set& styles);
+        ///Empties the cache (the hit and miss counts are kept).
+        void clear();
+        ///@returns The number of styles sections in the cache.
+        size_t size() const;
+        ///@returns The most styles sections that the cache holds onto.
+        size_t get_max_size() const;
+        ///@returns The number of bytes that the held styles sections and their styles take up.
+        size_t get_byte_count() const;
+        ///@returns The most bytes that the held styles sections and their styles may take up.
+        size_t get_max_byte_count() const;
+        ///@returns The number of lookups that found their section.
+        size_t get_hit_count() const;
+        ///@returns The number of lookups that didn't find their section.
+        size_t get_miss_count() const;
+    private:
+        class impl;
+        impl* m_impl;
+        //disable copy construction
+        style_table_cache(const style_table_cache&);
+        void operator=(const style_table_cache&);
+        };
+    }
+
+/** @}*/
+
+#endif //__STYLE_TABLE_CACHE_H__
@@ -86,27 +86,43 @@ namespace lily_of_the_valley
                 log_message(L"Invalid Unicode stream, uneven number of bytes.");
                 return NULL;
                 }
+            /*only convert as much as the input and output budgets allow (the whole stream is converted in one step,
+              so there are no parsing steps to count). The BoM is always read, and a character is never split.*/
+            size_t readLength = std::max<size_t>(get_input_budget_length(length) & ~static_cast<size_t>(1), 2);
+            const size_t maxOutputLength = get_budget().m_max_output_length;
+            if (maxOutputLength > 0 && (readLength-2)/2 > maxOutputLength)
+                { readLength = 2+(maxOutputLength*2); }
             //prepare the wide buffer
-            if (!allocate_text_buffer((length/2)+1/*Null terminator*/))
+            //the text is converted straight into the buffer, so all of the room is needed up front
+            if (!begin_text() || !require_text((readLength/2)+1/*Null terminator*/))
                 {
                 set_filtered_text_length(0);
                 return NULL;
                 }
             /*If unicode stream is the native endian format, then just copy it over into the wide buffer.*/
             if (std::strncmp(systemIsLittleEndian ? get_bom_utf16le() : get_bom_utf16be(), unicodeText, 2) == 0)
-                { convert_unicode_char_stream(get_writable_buffer(), unicodeText+2, length-2); }//note that we skip over the BoM
+                { convert_unicode_char_stream(get_writable_buffer(), unicodeText+2, readLength-2); }//note that we skip over the BoM
             //Otherwise, start flipping the bytes around to make it the native endian type
             else if (std::strncmp(systemIsLittleEndian ? get_bom_utf16be() : get_bom_utf16le(), unicodeText, 2) == 0)
-                { get_flipped_buffer(get_writable_buffer(), unicodeText+2, length-2); }
+                { get_flipped_buffer(get_writable_buffer(), unicodeText+2, readLength-2); }
             else
                 { return NULL; }
+            //the buffer isn't zeroed out beforehand, so terminate the converted text
+            get_writable_buffer()[(readLength-2)/2] = 0;
             set_filtered_text_length(std::wcslen(get_filtered_text()));
+            if (readLength < length)
+                {
+                exceed_budget((readLength < get_input_budget_length(length)) ?
+                    L"Output limit reached; the rest of the document was not read." :
+                    L"Input limit reached; the rest of the document was not read.");
+                }
+            trim_to_budget_boundary();
 
-            return get_filtered_text();
+            return finalize_text();
             }
     private:
         /**Flip the bytes of unicodeText and copy them into destination. Destination should be
-            length+1 and zeroed out beforehand.
+            (length/2)+1 characters long; the caller will NULL terminate it.
            @param[out] destination wchar buffer to write the flipped text.
            @param unicodeText The raw char* unicode stream.
            @param length The length of the raw char* stream.*/
@@ -126,7 +142,7 @@ namespace lily_of_the_valley
             convert_unicode_char_stream(destination,flippedBuffer,length);
             }
         /**Copies the bytes of unicodeText into destination. Destination should be
-            length+1 and zeroed out beforehand.
+            (length/2)+1 characters long; the caller will NULL terminate it.
            @param[out] destination wchar buffer to write the flipped text.
            @param unicodeText The raw char* unicode stream.
            @param length The length of the raw char* stream.*/
@@ -0,0 +1,714 @@
+#include "zip_package.h"
+#include <cstring>
+#include <algorithm>
+
+namespace lily_of_the_valley
+    {
+    //the signatures of the zip records that are read
+    static const unsigned long LOCAL_HEADER_SIGNATURE = 0x04034b50;
+    static const unsigned long CENTRAL_DIRECTORY_SIGNATURE = 0x02014b50;
+    static const unsigned long END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+    static const unsigned long ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06064b50;
+    static const unsigned long ZIP64_END_OF_CENTRAL_DIRECTORY_LOCATOR_SIGNATURE = 0x07064b50;
+    //the fixed lengths of the zip records (not including their variable-length fields)
+    static const size_t LOCAL_HEADER_LENGTH = 30;
+    static const size_t CENTRAL_DIRECTORY_ENTRY_LENGTH = 46;
+    static const size_t END_OF_CENTRAL_DIRECTORY_LENGTH = 22;
+    static const size_t ZIP64_END_OF_CENTRAL_DIRECTORY_LENGTH = 56;
+    static const size_t ZIP64_END_OF_CENTRAL_DIRECTORY_LOCATOR_LENGTH = 20;
+    //the most that a zip file's comment (at the very end of the file) can be
+    static const size_t MAX_COMMENT_LENGTH = 0xFFFF;
+
+    //how far back (at most) a DEFLATE match can refer to
+    static const size_t DEFLATE_WINDOW_SIZE = 32*1024;
+    //how much is inflated at once
+    static const size_t DEFLATE_CHUNK_SIZE = 64*1024;
+    //the longest match that DEFLATE can have
+    static const size_t DEFLATE_MAX_MATCH_LENGTH = 258;
+    //the most that is returned at once from a stored part
+    static const size_t STORED_CHUNK_SIZE = 64*1024;
+
+    //the lengths and distances of DEFLATE's length and distance symbols, and how many extra bits each one has
+    static const unsigned short LENGTH_BASES[29] =
+        { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+          35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const unsigned char LENGTH_EXTRA_BITS[29] =
+        { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+          3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    static const unsigned short DISTANCE_BASES[30] =
+        { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+          257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+    static const unsigned char DISTANCE_EXTRA_BITS[30] =
+        { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+          7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    //the order that a dynamic block's code length code lengths are listed in
+    static const unsigned char CODE_LENGTH_ORDER[19] =
+        { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    //reads little-endian values from a zip file's records
+    static inline unsigned int read_uint16(const unsigned char* data)
+        { return static_cast<unsigned int>(data[0]) | (static_cast<unsigned int>(data[1]) << 8); }
+    static inline unsigned long read_uint32(const unsigned char* data)
+        {
+        return static_cast<unsigned long>(data[0]) | (static_cast<unsigned long>(data[1]) << 8) |
+               (static_cast<unsigned long>(data[2]) << 16) | (static_cast<unsigned long>(data[3]) << 24);
+        }
+    /*Reads a 64-bit value, returning false if it is too big for a size_t
+    (i.e., a ZIP64 file that is bigger than what can be addressed).*/
+    static bool read_uint64(const unsigned char* data, size_t& value)
+        {
+        const unsigned long high = read_uint32(data+4);
+        if (high != 0 && sizeof(size_t) < 8)
+            { return false; }
+        value = static_cast<size_t>(read_uint32(data));
+        if (high != 0)
+            {
+            //shifted in two steps so that this compiles (as dead code) where size_t is 32-bit
+            value |= (static_cast<size_t>(high) << 16) << 16;
+            }
+        return true;
+        }
+
+    //the CRC-32 lookup table (for the reversed polynomial that zip files use)
+    class crc32_table
+        {
+    public:
+        crc32_table()
+            {
+            for (unsigned long i = 0; i < 256; ++i)
+                {
+                unsigned long value = i;
+                for (size_t bit = 0; bit < 8; ++bit)
+                    { value = (value & 1) ? (0xEDB88320UL ^ (value >> 1)) : (value >> 1); }
+                m_table[i] = value;
+                }
+            }
+        unsigned long operator[](const size_t index) const
+            { return m_table[index]; }
+    private:
+        unsigned long m_table[256];
+        };
+    static const crc32_table CRC32_TABLE;
+
+    unsigned long update_crc32(unsigned long crc, const char* data, const size_t length)
+        {
+        crc = (~crc) & 0xFFFFFFFFUL;
+        const unsigned char* position = reinterpret_cast<const unsigned char*>(data);
+        const unsigned char* const end = position+length;
+        for (; position < end; ++position)
+            { crc = CRC32_TABLE[(crc ^ *position) & 0xFF] ^ (crc >> 8); }
+        return (~crc) & 0xFFFFFFFFUL;
+        }
+
+    //------------------------------------------------
+    bool zip_package::open(const char* data, const size_t data_length)
+        {
+        close();
+        if (data == NULL || data_length < END_OF_CENTRAL_DIRECTORY_LENGTH)
+            {
+            m_log = L"File is too small to be a zip file.";
+            return false;
+            }
+        m_data = data;
+        m_data_length = data_length;
+
+        size_t entryCount = 0, directoryOffset = 0, directoryLength = 0;
+        if (!read_end_of_central_directory(entryCount, directoryOffset, directoryLength))
+            {
+            close();
+            return false;
+            }
+        if (directoryOffset > m_data_length || directoryLength > m_data_length-directoryOffset)
+            {
+            close();
+            m_log = L"Central directory is outside of the file.";
+            return false;
+            }
+
+        //each entry is at least the length of its fixed fields, so the count can't be bogus enough to reserve too much
+        m_entries.reserve(std::min(entryCount, directoryLength/CENTRAL_DIRECTORY_ENTRY_LENGTH));
+        const unsigned char* position = reinterpret_cast<const unsigned char*>(m_data)+directoryOffset;
+        const unsigned char* const directoryEnd = position+directoryLength;
+        for (size_t i = 0; i < entryCount; ++i)
+            {
+            if (static_cast<size_t>(directoryEnd-position) < CENTRAL_DIRECTORY_ENTRY_LENGTH ||
+                read_uint32(position) != CENTRAL_DIRECTORY_SIGNATURE)
+                {
+                close();
+                m_log = L"Central directory is corrupt.";
+                return false;
+                }
+            const size_t nameLength = read_uint16(position+28);
+            const size_t extraLength = read_uint16(position+30);
+            const size_t commentLength = read_uint16(position+32);
+            if (static_cast<size_t>(directoryEnd-position) < CENTRAL_DIRECTORY_ENTRY_LENGTH+nameLength+extraLength+commentLength)
+                {
+                close();
+                m_log = L"Central directory is corrupt.";
+                return false;
+                }
+            zip_entry entry;
+            entry.m_flags = read_uint16(position+8);
+            entry.m_compression_method = read_uint16(position+10);
+            entry.m_crc32 = read_uint32(position+16);
+            entry.m_compressed_size = static_cast<size_t>(read_uint32(position+20));
+            entry.m_uncompressed_size = static_cast<size_t>(read_uint32(position+24));
+            entry.m_local_header_offset = static_cast<size_t>(read_uint32(position+42));
+            entry.m_name.assign(reinterpret_cast<const char*>(position+CENTRAL_DIRECTORY_ENTRY_LENGTH), nameLength);
+            if (!read_zip64_extra_field(position+CENTRAL_DIRECTORY_ENTRY_LENGTH+nameLength, extraLength, entry))
+                {
+                close();
+                m_log = L"Part is too large to be read: "+std::wstring(entry.m_name.begin(), entry.m_name.end());
+                return false;
+                }
+            //if a name is listed more than once, then the first one is used
+            m_entry_index.insert(std::make_pair(entry.m_name, m_entries.size()));
+            m_entries.push_back(entry);
+            position += CENTRAL_DIRECTORY_ENTRY_LENGTH+nameLength+extraLength+commentLength;
+            }
+        return true;
+        }
+
+    void zip_package::close()
+        {
+        m_data = NULL;
+        m_data_length = 0;
+        m_entries.clear();
+        m_entry_index.clear();
+        m_log.clear();
+        }
+
+    const zip_entry* zip_package::find_entry(const std::string& name) const
+        {
+        const std::map<std::string, size_t>::const_iterator pos = m_entry_index.find(name);
+        return (pos == m_entry_index.end()) ? NULL : &m_entries[pos->second];
+        }
+
+    bool zip_package::read_entry(const zip_entry& entry, std::string& content) const
+        {
+        content.clear();
+        zip_entry_stream stream;
+        if (!stream.open(*this, entry))
+            { return false; }
+        content.reserve(entry.m_uncompressed_size);
+        const char* chunk = NULL;
+        size_t chunkLength = 0;
+        while ((chunkLength = stream.read(chunk)) > 0)
+            { content.append(chunk, chunkLength); }
+        return !stream.has_error();
+        }
+
+    bool zip_package::read_end_of_central_directory(size_t& entry_count, size_t& directory_offset, size_t& directory_length)
+        {
+        const unsigned char* const data = reinterpret_cast<const unsigned char*>(m_data);
+        //the record is at the end of the file, followed by the file's comment (if there is one)
+        const size_t searchStart = (m_data_length > END_OF_CENTRAL_DIRECTORY_LENGTH+MAX_COMMENT_LENGTH) ?
+            m_data_length-(END_OF_CENTRAL_DIRECTORY_LENGTH+MAX_COMMENT_LENGTH) : 0;
+        size_t recordOffset = m_data_length-END_OF_CENTRAL_DIRECTORY_LENGTH;
+        for (;;)
+            {
+            if (read_uint32(data+recordOffset) == END_OF_CENTRAL_DIRECTORY_SIGNATURE &&
+                //the comment should fit in the rest of the file
+                recordOffset+END_OF_CENTRAL_DIRECTORY_LENGTH+read_uint16(data+recordOffset+20) <= m_data_length)
+                { break; }
+            if (recordOffset == searchStart)
+                {
+                m_log = L"End of central directory not found; file is not a zip file.";
+                return false;
+                }
+            --recordOffset;
+            }
+        entry_count = read_uint16(data+recordOffset+10);
+        directory_length = static_cast<size_t>(read_uint32(data+recordOffset+12));
+        directory_offset = static_cast<size_t>(read_uint32(data+recordOffset+16));
+
+        //a ZIP64 file has a locator right in front of the record, pointing to the ZIP64 version of the record
+        if (recordOffset >= ZIP64_END_OF_CENTRAL_DIRECTORY_LOCATOR_LENGTH &&
+            read_uint32(data+recordOffset-ZIP64_END_OF_CENTRAL_DIRECTORY_LOCATOR_LENGTH) == ZIP64_END_OF_CENTRAL_DIRECTORY_LOCATOR_SIGNATURE)
+            {
+            size_t zip64RecordOffset = 0;
+            if (!read_uint64(data+recordOffset-ZIP64_END_OF_CENTRAL_DIRECTORY_LOCATOR_LENGTH+8, zip64RecordOffset))
+                {
+                m_log = L"File is too large to be read.";
+                return false;
+                }
+            if (zip64RecordOffset > m_data_length ||
+                m_data_length-zip64RecordOffset < ZIP64_END_OF_CENTRAL_DIRECTORY_LENGTH ||
+                read_uint32(data+zip64RecordOffset) != ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+                {
+                m_log = L"ZIP64 end of central directory is corrupt.";
+                return false;
+                }
+            if (!read_uint64(data+zip64RecordOffset+32, entry_count) ||
+                !read_uint64(data+zip64RecordOffset+40, directory_length) ||
+                !read_uint64(data+zip64RecordOffset+48, directory_offset))
+                {
+                m_log = L"File is too large to be read.";
+                return false;
+                }
+            }
+        return true;
+        }
+
+    bool zip_package::read_zip64_extra_field(const unsigned char* extra, const size_t extra_length, zip_entry& entry) const
+        {
+        const size_t ZIP64_MARKER = 0xFFFFFFFF;
+        if (entry.m_uncompressed_size != ZIP64_MARKER && entry.m_compressed_size != ZIP64_MARKER &&
+            entry.m_local_header_offset != ZIP64_MARKER)
+            { return true; }
+        //the extra field is a series of (ID, length, data) blocks, and the ZIP64 one has ID 1
+        const unsigned char* position = extra;
+        const unsigned char* const extraEnd = extra+extra_length;
+        while (extraEnd-position >= 4)
+            {
+            const unsigned int blockId = read_uint16(position);
+            const size_t blockLength = read_uint16(position+2);
+            position += 4;
+            if (static_cast<size_t>(extraEnd-position) < blockLength)
+                { break; }
+            if (blockId == 1)
+                {
+                //only the values that are maxed out in the entry are in here, in this order
+                const unsigned char* value = position;
+                const unsigned char* const blockEnd = position+blockLength;
+                size_t* const values[3] = { &entry.m_uncompressed_size, &entry.m_compressed_size, &entry.m_local_header_offset };
+                for (size_t i = 0; i < 3; ++i)
+                    {
+                    if (*values[i] != ZIP64_MARKER)
+                        { continue; }
+                    if (blockEnd-value < 8 || !read_uint64(value, *values[i]))
+                        { return false; }
+                    value += 8;
+                    }
+                return true;
+                }
+            position += blockLength;
+            }
+        //the sizes really could be 4GB-1, so if there is no ZIP64 field then use them as-is
+        return true;
+        }
+
+    //------------------------------------------------
+    deflate_inflater::deflate_inflater() :
+        m_input(NULL), m_input_end(NULL), m_bit_buffer(0), m_bit_count(0),
+        m_block_type(no_block), m_is_last_block(false), m_stored_remaining(0),
+        m_current_length_table(NULL), m_current_distance_table(NULL), m_are_fixed_tables_built(false),
+        m_window_position(0), m_is_finished(true), m_has_error(false)
+        {}
+
+    void deflate_inflater::reset(const unsigned char* compressed, const size_t compressed_length)
+        {
+        m_input = compressed;
+        m_input_end = compressed+compressed_length;
+        m_bit_buffer = 0;
+        m_bit_count = 0;
+        m_block_type = no_block;
+        m_is_last_block = false;
+        m_stored_remaining = 0;
+        m_current_length_table = m_current_distance_table = NULL;
+        if (m_window.empty())
+            { m_window.resize(DEFLATE_WINDOW_SIZE+DEFLATE_CHUNK_SIZE); }
+        m_window_position = 0;
+        m_is_finished = false;
+        m_has_error = (compressed == NULL);
+        }
+
+    inline bool deflate_inflater::need_bits(const size_t count)
+        {
+        while (m_bit_count < count)
+            {
+            if (m_input == m_input_end)
+                {
+                m_has_error = true;
+                return false;
+                }
+            m_bit_buffer |= static_cast<unsigned long>(*m_input++) << m_bit_count;
+            m_bit_count += 8;
+            }
+        return true;
+        }
+
+    inline unsigned int deflate_inflater::read_bits(const size_t count)
+        {
+        if (!need_bits(count))
+            { return 0; }
+        const unsigned int value = static_cast<unsigned int>(m_bit_buffer & ((1UL << count)-1));
+        m_bit_buffer >>= count;
+        m_bit_count -= count;
+        return value;
+        }
+
+    bool deflate_inflater::build_table(huffman_table& table, const unsigned char* lengths, const size_t symbol_count)
+        {
+        std::memset(table.m_counts, 0, sizeof(table.m_counts));
+        for (size_t symbol = 0; symbol < symbol_count; ++symbol)
+            { ++table.m_counts[lengths[symbol]]; }
+        //make sure that there aren't more codes of a length than there is room for (incomplete codes are allowed)
+        long codesLeft = 1;
+        for (size_t length = 1; length < 16; ++length)
+            {
+            codesLeft <<= 1;
+            codesLeft -= table.m_counts[length];
+            if (codesLeft < 0)
+                { return false; }
+            }
+        //sort the symbols by code length (and then by symbol, which is the order of their codes)
+        unsigned short offsets[16];
+        offsets[1] = 0;
+        for (size_t length = 1; length < 15; ++length)
+            { offsets[length+1] = offsets[length]+table.m_counts[length]; }
+        for (size_t symbol = 0; symbol < symbol_count; ++symbol)
+            {
+            if (lengths[symbol] != 0)
+                { table.m_symbols[offsets[lengths[symbol]]++] = static_cast<unsigned short>(symbol); }
+            }
+        //codes are read a bit at a time from the first bit of the code, so the lookup is by their reversed bits
+        std::memset(table.m_fast, 0, sizeof(table.m_fast));
+        unsigned int code = 0;
+        size_t symbolIndex = 0;
+        for (size_t length = 1; length <= FAST_BITS; ++length)
+            {
+            for (size_t i = 0; i < table.m_counts[length]; ++i, ++code)
+                {
+                unsigned int reversedCode = 0;
+                for (size_t bit = 0; bit < length; ++bit)
+                    { reversedCode |= ((code >> bit) & 1) << (length-1-bit); }
+                const unsigned short entry = static_cast<unsigned short>((table.m_symbols[symbolIndex+i] << 4) | length);
+                for (size_t fill = reversedCode; fill < (1U << FAST_BITS); fill += (1U << length))
+                    { table.m_fast[fill] = entry; }
+                }
+            symbolIndex += table.m_counts[length];
+            code <<= 1;
+            }
+        return true;
+        }
+
+    inline int deflate_inflater::decode(const huffman_table& table)
+        {
+        //look up short codes all at once (the end of the stream might not have a full lookup's worth of bits)
+        while (m_bit_count < FAST_BITS && m_input < m_input_end)
+            {
+            m_bit_buffer |= static_cast<unsigned long>(*m_input++) << m_bit_count;
+            m_bit_count += 8;
+            }
+        const unsigned short entry = table.m_fast[m_bit_buffer & ((1UL << FAST_BITS)-1)];
+        if (entry != 0 && static_cast<size_t>(entry & 0xF) <= m_bit_count)
+            {
+            m_bit_buffer >>= (entry & 0xF);
+            m_bit_count -= (entry & 0xF);
+            return (entry >> 4);
+            }
+        //otherwise, walk the code a bit at a time
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (size_t length = 1; length < 16; ++length)
+            {
+            code |= static_cast<int>(read_bits(1));
+            if (m_has_error)
+                { return -1; }
+            const int count = table.m_counts[length];
+            if (code-count < first)
+                { return table.m_symbols[index+(code-first)]; }
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+            }
+        return -1;
+        }
+
+    bool deflate_inflater::read_block_header()
+        {
+        m_is_last_block = (read_bits(1) == 1);
+        const unsigned int type = read_bits(2);
+        if (m_has_error)
+            { return false; }
+        if (type == 0)
+            {
+            //a stored block starts at the next byte, with its length and the one's complement of its length
+            read_bits(m_bit_count%8);
+            const unsigned int length = read_bits(16);
+            const unsigned int lengthComplement = read_bits(16);
+            if (m_has_error || length != (~lengthComplement & 0xFFFF))
+                { return false; }
+            m_stored_remaining = length;
+            m_block_type = stored_block;
+            return true;
+            }
+        else if (type == 1)
+            {
+            if (!m_are_fixed_tables_built)
+                {
+                unsigned char lengths[288];
+                std::memset(lengths, 8, 144);
+                std::memset(lengths+144, 9, 256-144);
+                std::memset(lengths+256, 7, 280-256);
+                std::memset(lengths+280, 8, 288-280);
+                build_table(m_fixed_length_table, lengths, 288);
+                std::memset(lengths, 5, 30);
+                build_table(m_fixed_distance_table, lengths, 30);
+                m_are_fixed_tables_built = true;
+                }
+            m_current_length_table = &m_fixed_length_table;
+            m_current_distance_table = &m_fixed_distance_table;
+            m_block_type = huffman_block;
+            return true;
+            }
+        else if (type == 2 && read_dynamic_tables())
+            {
+            m_current_length_table = &m_length_table;
+            m_current_distance_table = &m_distance_table;
+            m_block_type = huffman_block;
+            return true;
+            }
+        return false;
+        }
+
+    bool deflate_inflater::read_dynamic_tables()
+        {
+        const size_t lengthCount = read_bits(5)+257;
+        const size_t distanceCount = read_bits(5)+1;
+        const size_t codeLengthCount = read_bits(4)+4;
+        if (m_has_error || lengthCount > 286 || distanceCount > 30)
+            { return false; }
+        //the code lengths are themselves Huffman coded, so read that code first
+        unsigned char lengths[286+30];
+        std::memset(lengths, 0, sizeof(lengths));
+        for (size_t i = 0; i < codeLengthCount; ++i)
+            { lengths[CODE_LENGTH_ORDER[i]] = static_cast<unsigned char>(read_bits(3)); }
+        for (size_t i = codeLengthCount; i < 19; ++i)
+            { lengths[CODE_LENGTH_ORDER[i]] = 0; }
+        if (m_has_error || !build_table(m_length_table, lengths, 19))
+            { return false; }
+        //then read the length and distance code lengths (as one list, runs can cross from one to the other)
+        size_t index = 0;
+        while (index < lengthCount+distanceCount)
+            {
+            int symbol = decode(m_length_table);
+            if (symbol < 0)
+                { return false; }
+            if (symbol < 16)
+                {
+                lengths[index++] = static_cast<unsigned char>(symbol);
+                continue;
+                }
+            unsigned char repeatedLength = 0;
+            size_t repeatCount = 0;
+            if (symbol == 16)
+                {
+                if (index == 0)
+                    { return false; }
+                repeatedLength = lengths[index-1];
+                repeatCount = 3+read_bits(2);
+                }
+            else if (symbol == 17)
+                { repeatCount = 3+read_bits(3); }
+            else
+                { repeatCount = 11+read_bits(7); }
+            if (m_has_error || index+repeatCount > lengthCount+distanceCount)
+                { return false; }
+            std::memset(lengths+index, repeatedLength, repeatCount);
+            index += repeatCount;
+            }
+        //a block without an end-of-block code could never end
+        if (lengths[256] == 0)
+            { return false; }
+        return build_table(m_length_table, lengths, lengthCount) &&
+               build_table(m_distance_table, lengths+lengthCount, distanceCount);
+        }
+
+    size_t deflate_inflater::inflate(const char*& chunk)
+        {
+        chunk = NULL;
+        if (m_is_finished || m_has_error)
+            { return 0; }
+        unsigned char* const window = &m_window[0];
+        const size_t windowCapacity = m_window.size();
+        //only the last window's worth of output needs to be kept for the matches in the next chunk to refer back to
+        if (m_window_position > DEFLATE_WINDOW_SIZE)
+            {
+            std::memmove(window, window+m_window_position-DEFLATE_WINDOW_SIZE, DEFLATE_WINDOW_SIZE);
+            m_window_position = DEFLATE_WINDOW_SIZE;
+            }
+        const size_t chunkStart = m_window_position;
+        size_t position = m_window_position;
+        while (!m_has_error)
+            {
+            if (m_block_type == no_block)
+                {
+                if (m_is_last_block)
+                    {
+                    m_is_finished = true;
+                    break;
+                    }
+                if (!read_block_header())
+                    { m_has_error = true; }
+                continue;
+                }
+            else if (m_block_type == stored_block)
+                {
+                if (m_stored_remaining == 0)
+                    {
+                    m_block_type = no_block;
+                    continue;
+                    }
+                if (position == windowCapacity)
+                    { break; }
+                //whatever was already read into the bit buffer comes first (it is byte aligned at this point)
+                if (m_bit_count >= 8)
+                    {
+                    window[position++] = static_cast<unsigned char>(read_bits(8));
+                    --m_stored_remaining;
+                    continue;
+                    }
+                const size_t copyLength = std::min(std::min(m_stored_remaining, windowCapacity-position),
+                                                   static_cast<size_t>(m_input_end-m_input));
+                if (copyLength == 0)
+                    {
+                    m_has_error = true;
+                    break;
+                    }
+                std::memcpy(window+position, m_input, copyLength);
+                m_input += copyLength;
+                position += copyLength;
+                m_stored_remaining -= copyLength;
+                continue;
+                }
+            //stop once there might not be room for another match
+            if (position+DEFLATE_MAX_MATCH_LENGTH > windowCapacity)
+                { break; }
+            const int symbol = decode(*m_current_length_table);
+            if (symbol < 0)
+                {
+                m_has_error = true;
+                break;
+                }
+            else if (symbol < 256)
+                { window[position++] = static_cast<unsigned char>(symbol); }
+            else if (symbol == 256)
+                { m_block_type = no_block; }
+            else
+                {
+                const size_t lengthSymbol = static_cast<size_t>(symbol-257);
+                if (lengthSymbol >= 29)
+                    {
+                    m_has_error = true;
+                    break;
+                    }
+                const size_t matchLength = LENGTH_BASES[lengthSymbol]+read_bits(LENGTH_EXTRA_BITS[lengthSymbol]);
+                const int distanceSymbol = decode(*m_current_distance_table);
+                if (distanceSymbol < 0 || distanceSymbol >= 30)
+                    {
+                    m_has_error = true;
+                    break;
+                    }
+                const size_t distance = DISTANCE_BASES[distanceSymbol]+read_bits(DISTANCE_EXTRA_BITS[distanceSymbol]);
+                //the window holds the whole output so far (or at least the last window's worth of it)
+                if (m_has_error || distance > position)
+                    {
+                    m_has_error = true;
+                    break;
+                    }
+                const unsigned char* source = window+position-distance;
+                unsigned char* destination = window+position;
+                if (distance >= matchLength)
+                    { std::memcpy(destination, source, matchLength); }
+                //an overlapping match repeats what it is copying, so it has to be copied a byte at a time
+                else
+                    {
+                    for (size_t i = 0; i < matchLength; ++i)
+                        { destination[i] = source[i]; }
+                    }
+                position += matchLength;
+                }
+            }
+        m_window_position = position;
+        chunk = reinterpret_cast<const char*>(window+chunkStart);
+        return position-chunkStart;
+        }
+
+    //------------------------------------------------
+    zip_entry_stream::zip_entry_stream() :
+        m_is_deflated(false), m_stored_data(NULL), m_stored_remaining(0),
+        m_expected_crc32(0), m_expected_length(0), m_crc32(0), m_length(0),
+        m_is_open(false), m_is_finished(false), m_has_error(false)
+        {}
+
+    bool zip_entry_stream::open(const zip_package& package, const zip_entry& entry)
+        {
+        m_is_open = m_is_finished = m_has_error = false;
+        m_crc32 = 0;
+        m_length = 0;
+        //encrypted parts can't be read
+        if (!package.is_open() || (entry.m_flags & 1) != 0 ||
+            (entry.m_compression_method != 0 && entry.m_compression_method != 8))
+            { return false; }
+        //the data is after the local header, whose name and extra field can differ in length from the central directory's
+        const unsigned char* const data = reinterpret_cast<const unsigned char*>(package.get_data());
+        const size_t dataLength = package.get_data_length();
+        if (entry.m_local_header_offset > dataLength ||
+            dataLength-entry.m_local_header_offset < LOCAL_HEADER_LENGTH ||
+            read_uint32(data+entry.m_local_header_offset) != LOCAL_HEADER_SIGNATURE)
+            { return false; }
+        const size_t dataOffset = entry.m_local_header_offset+LOCAL_HEADER_LENGTH+
+            read_uint16(data+entry.m_local_header_offset+26)+read_uint16(data+entry.m_local_header_offset+28);
+        if (dataOffset > dataLength || dataLength-dataOffset < entry.m_compressed_size)
+            { return false; }
+
+        m_is_deflated = (entry.m_compression_method == 8);
+        if (m_is_deflated)
+            { m_inflater.reset(data+dataOffset, entry.m_compressed_size); }
+        else
+            {
+            m_stored_data = package.get_data()+dataOffset;
+            m_stored_remaining = entry.m_compressed_size;
+            }
+        m_expected_crc32 = entry.m_crc32;
+        m_expected_length = entry.m_uncompressed_size;
+        m_is_open = true;
+        return true;
+        }
+
+    size_t zip_entry_stream::read(const char*& chunk)
+        {
+        chunk = NULL;
+        if (!m_is_open || m_is_finished || m_has_error)
+            { return 0; }
+        size_t chunkLength = 0;
+        if (m_is_deflated)
+            {
+            chunkLength = m_inflater.inflate(chunk);
+            if (chunkLength == 0)
+                {
+                if (m_inflater.has_error())
+                    { m_has_error = true; }
+                else
+                    { finish(); }
+                return 0;
+                }
+            }
+        else
+            {
+            chunkLength = std::min(m_stored_remaining, STORED_CHUNK_SIZE);
+            if (chunkLength == 0)
+                {
+                finish();
+                return 0;
+                }
+            chunk = m_stored_data;
+            m_stored_data += chunkLength;
+            m_stored_remaining -= chunkLength;
+            }
+        m_crc32 = update_crc32(m_crc32, chunk, chunkLength);
+        m_length += chunkLength;
+        return chunkLength;
+        }
+
+    void zip_entry_stream::finish()
+        {
+        m_is_finished = true;
+        if (m_crc32 != m_expected_crc32 || m_length != m_expected_length)
+            { m_has_error = true; }
+        }
+    }
@@ -0,0 +1,260 @@
+/**@addtogroup Importing
+@brief Classes for importing and parsing text.
+@date 2005-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __ZIP_PACKAGE_H__
+#define __ZIP_PACKAGE_H__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace lily_of_the_valley
+    {
+    ///@brief A file (i.e., a part) inside of a zip_package, as described by the package's central directory.
+    struct zip_entry
+        {
+        ///Constructor.
+        zip_entry() : m_compression_method(0), m_flags(0), m_crc32(0),
+            m_compressed_size(0), m_uncompressed_size(0), m_local_header_offset(0) {}
+        ///The path of the part inside of the package (e.g., "word/document.xml").
+        std::string m_name;
+        ///How the part is compressed (0 is stored and 8 is deflated, which are the only ones that can be read).
+        unsigned int m_compression_method;
+        ///The part's general purpose flags.
+        unsigned int m_flags;
+        ///The CRC-32 of the part's uncompressed content.
+        unsigned long m_crc32;
+        ///The length of the part's data inside of the package.
+        size_t m_compressed_size;
+        ///The length of the part once it is uncompressed.
+        size_t m_uncompressed_size;
+        ///Where the part's local header is in the package.
+        size_t m_local_header_offset;
+        };
+
+    /**@brief Reads the parts of a zip file (e.g., a DOCX, ODT, or PPTX file) straight from a buffer
+        holding the whole file, such as a memory-mapped file.
+    @details open() only reads the package's central directory (at the end of the file), so opening
+        a package costs the same no matter how big its parts are. Parts are then read one at a time with
+        zip_entry_stream, which inflates a part a chunk at a time, so a part never has to be uncompressed
+        in full. Stored and deflated parts (which is what office documents use) are supported, as are ZIP64 packages;
+        encrypted parts are not.
+
+        Once a package is open, it is not changed by reading its parts, so multiple threads can read
+        (different or the same) parts of it at the same time, each with its own zip_entry_stream.
+    @par Example:
+    @code
+        //Assuming that a DOCX file has been memory-mapped (or read) into a char* buffer
+        //named "fileContents" and "fileSize" is set to the size of the file.
+        lily_of_the_valley::zip_package package;
+        if (package.open(fileContents, fileSize))
+            {
+            const lily_of_the_valley::zip_entry* document = package.find_entry("word/document.xml");
+            lily_of_the_valley::zip_entry_stream documentStream;
+            if (document != NULL && documentStream.open(package, *document))
+                {
+                const char* chunk = NULL;
+                size_t chunkLength = 0;
+                while ((chunkLength = documentStream.read(chunk)) > 0)
+                    {
+                    //do something with the chunk (e.g., pass it to an extractor's feed())
+                    }
+                }
+            }
+    @endcode
+    @sa extract_package_part(), which streams a part directly into an extractor.*/
+    class zip_package
+        {
+    public:
+        ///Constructor.
+        zip_package() : m_data(NULL), m_data_length(0) {}
+        /**Opens a zip file by reading its central directory.
+           @param data The whole zip file. This is not copied, so it must stay alive (and unchanged)
+            as long as the package is open.
+           @param data_length The length (in bytes) of the zip file.
+           @returns Whether the file's central directory could be read. If not, then the reason is in get_log().*/
+        bool open(const char* data, const size_t data_length);
+        ///Closes the package (the buffer that it was opened with is not needed anymore after this).
+        void close();
+        ///@returns Whether a package is open.
+        bool is_open() const
+            { return (m_data != NULL); }
+        ///@returns The parts in the package, in the order that they are listed in its central directory.
+        const std::vector<zip_entry>& get_entries() const
+            { return m_entries; }
+        /**@returns The part with a given path, or NULL if the package doesn't have it.
+           @param name The path of the part (e.g., "content.xml"). Paths are case sensitive.*/
+        const zip_entry* find_entry(const std::string& name) const;
+        /**Inflates an entire part into a string. This is meant for small parts (e.g., a manifest);
+           stream larger parts with zip_entry_stream instead.
+           @param entry The part to read (from get_entries() or find_entry()).
+           @param[out] content The part's uncompressed content.
+           @returns Whether the part was read (and its content matched its checksum).*/
+        bool read_entry(const zip_entry& entry, std::string& content) const;
+        ///@returns The reason that the last call to open() failed.
+        const std::wstring& get_log() const
+            { return m_log; }
+        ///@returns The zip file's data.
+        const char* get_data() const
+            { return m_data; }
+        ///@returns The length of the zip file's data.
+        size_t get_data_length() const
+            { return m_data_length; }
+    private:
+        //reads the end of central directory record (or its ZIP64 version) and returns whether it was found
+        bool read_end_of_central_directory(size_t& entry_count, size_t& directory_offset, size_t& directory_length);
+        //reads the ZIP64 sizes and offset for a central directory entry (whichever ones are maxed out in the entry)
+        bool read_zip64_extra_field(const unsigned char* extra, const size_t extra_length, zip_entry& entry) const;
+
+        const char* m_data;
+        size_t m_data_length;
+        std::vector<zip_entry> m_entries;
+        //the parts' indices in m_entries, by path
+        std::map<std::string, size_t> m_entry_index;
+        std::wstring m_log;
+        };
+
+    /**@brief Inflates a raw DEFLATE (RFC 1951) stream that is entirely in memory, a chunk at a time.
+    @details Only the last 32KB of output (the most that DEFLATE can refer back to) plus the chunk being
+        returned are held, no matter how big the uncompressed data is.*/
+    class deflate_inflater
+        {
+    public:
+        ///Constructor.
+        deflate_inflater();
+        /**Starts inflating a compressed stream.
+           @param compressed The compressed data. This is not copied, so it must stay alive while it is being inflated.
+           @param compressed_length The length of the compressed data.*/
+        void reset(const unsigned char* compressed, const size_t compressed_length);
+        /**Inflates the next chunk of the stream.
+           @param[out] chunk Set to the inflated chunk, which is only valid until the next call.
+           @returns The length of the chunk, or zero once the stream is finished (or if it is corrupt, see has_error()).*/
+        size_t inflate(const char*& chunk);
+        ///@returns Whether the end of the stream has been reached.
+        bool is_finished() const
+            { return m_is_finished; }
+        ///@returns Whether the stream is corrupt (or ended early).
+        bool has_error() const
+            { return m_has_error; }
+    private:
+        deflate_inflater(const deflate_inflater&);
+        deflate_inflater& operator=(const deflate_inflater&);
+
+        //how many bits are looked up at once when decoding a Huffman code (longer codes are decoded a bit at a time)
+        static const size_t FAST_BITS = 9;
+        //a canonical Huffman code
+        struct huffman_table
+            {
+            //how many codes there are of each length
+            unsigned short m_counts[16];
+            //the symbols, ordered by their codes
+            unsigned short m_symbols[288];
+            //the symbol and length (symbol << 4 | length) of each code that is FAST_BITS or shorter, by its next FAST_BITS bits
+            unsigned short m_fast[1 << FAST_BITS];
+            };
+        //whether enough bits (up to 16) are buffered (reading more if needed), flagging an error if the stream ran out
+        bool need_bits(const size_t count);
+        //removes and returns the next (up to 16) bits
+        unsigned int read_bits(const size_t count);
+        //builds a table from each symbol's code length (zero for unused), returning false if the lengths are invalid
+        static bool build_table(huffman_table& table, const unsigned char* lengths, const size_t symbol_count);
+        //decodes the next symbol, returning -1 if the stream is corrupt
+        int decode(const huffman_table& table);
+        //reads the next block's header (and its code tables, if it has its own)
+        bool read_block_header();
+        //reads the code tables of a block that has its own
+        bool read_dynamic_tables();
+
+        const unsigned char* m_input;
+        const unsigned char* m_input_end;
+        unsigned long m_bit_buffer;
+        size_t m_bit_count;
+
+        enum block_type
+            {
+            no_block,
+            stored_block,
+            huffman_block
+            };
+        block_type m_block_type;
+        bool m_is_last_block;
+        size_t m_stored_remaining;
+        huffman_table m_length_table;
+        huffman_table m_distance_table;
+        //the current block's tables (either the fixed ones or m_length_table and m_distance_table)
+        const huffman_table* m_current_length_table;
+        const huffman_table* m_current_distance_table;
+        huffman_table m_fixed_length_table;
+        huffman_table m_fixed_distance_table;
+        bool m_are_fixed_tables_built;
+
+        //the recent output (that later matches can refer back to), followed by the chunk being inflated
+        std::vector<unsigned char> m_window;
+        size_t m_window_position;
+        bool m_is_finished;
+        bool m_has_error;
+        };
+
+    /**@brief Reads a part from a zip_package a chunk at a time (inflating it if it is compressed).
+    @details A stored part is returned straight from the package's buffer; a deflated part
+        is inflated into a small, reused buffer (see deflate_inflater). The part's CRC-32 and length are checked
+        once it has all been read, see has_error().
+    @note A stream holds a reusable buffer, so keep and reuse the same stream when reading many parts.*/
+    class zip_entry_stream
+        {
+    public:
+        ///Constructor.
+        zip_entry_stream();
+        /**Starts reading a part.
+           @param package The package that the part is in, which must stay open while the part is being read.
+           @param entry The part to read (from the package's get_entries() or find_entry()).
+           @returns Whether the part can be read. Parts that are encrypted or use a compression method
+            other than store or deflate cannot be.*/
+        bool open(const zip_package& package, const zip_entry& entry);
+        /**Reads the next chunk of the part.
+           @param[out] chunk Set to the chunk, which is only valid until the next call (or until the stream is reopened).
+           @returns The length of the chunk, or zero once the part is finished (or if it is corrupt, see has_error()).*/
+        size_t read(const char*& chunk);
+        ///@returns Whether the part is corrupt, which includes its content not matching its CRC-32 or length.
+        bool has_error() const
+            { return m_has_error; }
+        ///@returns Whether the whole part has been read.
+        bool is_finished() const
+            { return m_is_finished; }
+    private:
+        zip_entry_stream(const zip_entry_stream&);
+        zip_entry_stream& operator=(const zip_entry_stream&);
+        //checks the part's length and CRC-32 once it has all been read
+        void finish();
+
+        deflate_inflater m_inflater;
+        bool m_is_deflated;
+        //the rest of a stored part
+        const char* m_stored_data;
+        size_t m_stored_remaining;
+        unsigned long m_expected_crc32;
+        size_t m_expected_length;
+        unsigned long m_crc32;
+        size_t m_length;
+        bool m_is_open;
+        bool m_is_finished;
+        bool m_has_error;
+        };
+
+    /**@returns The CRC-32 (as used by zip files) of a buffer, continued from a previous CRC-32.
+       @param crc The CRC-32 of the data before this buffer (zero to start a new checksum).
+       @param data The data to checksum.
+       @param length The length of the data.*/
+    unsigned long update_crc32(unsigned long crc, const char* data, const size_t length);
+    }
+
+/** @}*/
+
+#endif //__ZIP_PACKAGE_H__
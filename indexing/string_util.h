@@ -27,6 +27,19 @@ it under the terms of the BSD License.
 #include "../utilities/utilities.h"
 #include "../utilities/debug_logic.h"
 
+//vectorized scanning (used by char_set_matcher) is available on x86 with SSE2
+#if !defined(STRING_UTIL_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define STRING_UTIL_X86_SIMD
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define STRING_UTIL_TARGET_AVX2
+    #else
+        //AVX2 code is compiled for the functions that need it and only called if the CPU supports it
+        #define STRING_UTIL_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
 namespace string_util
     {
     ///lowercases any Western European alphabetic characters
@@ -396,6 +409,31 @@ namespace string_util
         return NULL;
         }
 
+    /**Searches for substring in a larger string (case-sensitively), limiting the search
+    to a specified number of characters. Unlike strstr(), the string does not need to be NULL terminated.
+    @param string The string to search in.
+    @param strSearch The substring to search for.
+    @param string_len The number of characters in the string to search through.
+    @returns A pointer in the string where the substring was found, or NULL if not found.*/
+    template<typename T>
+    inline const T* strnstr(const T* string, const T* strSearch, const size_t string_len)
+        {
+        if (!string || !strSearch || string_len == 0 || *strSearch == 0)
+            { return NULL; }
+        const size_t searchLength = string_util::strlen(strSearch);
+        if (searchLength > string_len)
+            { return NULL; }
+        const T* const lastStart = string+(string_len-searchLength);
+        for (const T* current = string; current <= lastStart; ++current)
+            {
+            //check the first character before doing a full comparison
+            if (current[0] == strSearch[0] &&
+                string_util::strncmp(current, strSearch, searchLength) == 0)
+                { return current; }
+            }
+        return NULL;
+        }
+
     /**Search string in reverse for substring.
     "offset" is how far we are in the source string already and how far
     to go back.*/
@@ -579,20 +617,23 @@ namespace string_util
         return (string_util::strnicmp(text+(text_length-suffix_length), suffix, suffix_length) == 0);
         }
 
-    /**Searches for a matching tag, skipping an extra open/close pairs of symbols in between.
+    /**Searches for a matching tag (up to the end of the string), skipping an extra open/close pairs of symbols in between.
+    @param stringToSearch The string to search in.
+    @param stringEnd The end of the string. If NULL, then the string is searched until its NULL terminator.
     @param openSymbol The opening symbol.
     @param closeSymbol The closing symbol that we are looking for.
     @param fail_on_overlapping_open_symbol Whether it should immediately return failure if an open
     symbol is found before a matching close symbol.
     @returns A pointer to where the closing tag is, or NULL if one can't be found.*/
     template<typename T>
-    inline const T* find_matching_close_tag(const T* stringToSearch, const T openSymbol, const T closeSymbol,
+    inline const T* find_matching_close_tag(const T* stringToSearch, const T* stringEnd,
+                                            const T openSymbol, const T closeSymbol,
                                             const bool fail_on_overlapping_open_symbol = false)
         {
         if (!stringToSearch)
             { return NULL; }
         long open_stack = 0;
-        while (*stringToSearch)
+        while ((!stringEnd || stringToSearch < stringEnd) && *stringToSearch)
             {
             if (stringToSearch[0] == openSymbol)
                 {
@@ -611,6 +652,17 @@ namespace string_util
         return NULL;
         }
 
+    /**Searches for a matching tag, skipping an extra open/close pairs of symbols in between.
+    @param openSymbol The opening symbol.
+    @param closeSymbol The closing symbol that we are looking for.
+    @param fail_on_overlapping_open_symbol Whether it should immediately return failure if an open
+    symbol is found before a matching close symbol.
+    @returns A pointer to where the closing tag is, or NULL if one can't be found.*/
+    template<typename T>
+    inline const T* find_matching_close_tag(const T* stringToSearch, const T openSymbol, const T closeSymbol,
+                                            const bool fail_on_overlapping_open_symbol = false)
+        { return find_matching_close_tag<T>(stringToSearch, NULL, openSymbol, closeSymbol, fail_on_overlapping_open_symbol); }
+
     ///Searches for a matching tag, skipping an extra open/close pairs of symbols in between.
     template<typename T>
     inline const T* find_matching_close_tag(const T* stringToSearch, const T* openSymbol,
@@ -674,30 +726,229 @@ namespace string_util
         return NULL;
         }
 
+    /**@brief A precompiled set of characters to search for (e.g., the L"\r\n&" passed to strncspn()).
+    @details Build one of these once and reuse it when the same set of characters is scanned for
+        repeatedly. On x86 CPUs the scanning is vectorized, comparing 16 bytes of text at a time with SSE2
+        (or 32 bytes with AVX2, if the CPU supports it at runtime); otherwise, a scalar loop is used.
+        Define STRING_UTIL_NO_SIMD to always use the scalar loop.
+
+        The scalar loop is still used for:
+        - The NULL-terminated find() (and strcspn_pointer(), which calls it). Without a length, a vector load
+          could read past the terminator (and off the end of the string's memory), so these scan one character
+          at a time. The library itself always passes a length (see strncspn()); do the same when the length is known.
+        - Sets larger than max_size().
+        - The last few characters of a length-bounded find() that don't fill a whole vector.
+        - Builds for CPUs other than x86 (or with STRING_UTIL_NO_SIMD defined).
+    @note A NULL terminator in the text is always treated as a match, so that scanning stops at the end of the string.
+        The set can hold up to max_size() characters; larger sets are still supported, but are scanned with the scalar loop.*/
+    template<typename T>
+    class char_set_matcher
+        {
+    public:
+        /**Constructor.
+        @param searchSequence The sequence of characters to search for.
+        @param searchSeqLength The length of the search sequence.*/
+        char_set_matcher(const T* searchSequence, const size_t searchSeqLength) :
+            m_search_sequence(searchSequence), m_length(searchSeqLength)
+            {
+            assert(searchSequence && "NULL search sequence passed to char_set_matcher.");
+            for (size_t i = 0; i < max_size(); ++i)
+                {
+                //pad unused slots with the first character so that the vector compares can always check all slots
+                m_set[i] = (i < m_length) ? searchSequence[i] :
+                           (m_length > 0) ? searchSequence[0] : 0;
+                }
+            }
+        ///@returns The most characters that can be scanned for with the vectorized kernels.
+        static size_t max_size()
+            { return 8; }
+        ///@returns The number of characters in the set.
+        size_t size() const
+            { return m_length; }
+        ///@returns Whether @c ch is in the set (not counting the NULL terminator).
+        bool is_match(const T ch) const
+            {
+            for (size_t i = 0; i < m_length; ++i)
+                {
+                if (ch == m_search_sequence[i])
+                    { return true; }
+                }
+            return false;
+            }
+        /**Finds the first character in a string that is either in the set or a NULL terminator.
+        @param text The string to search.
+        @param length The number of characters to search through.
+        @returns The index of the character, or @c length if not found.*/
+        size_t find(const T* text, const size_t length) const
+            {
+        #ifdef STRING_UTIL_X86_SIMD
+            if (m_length <= max_size())
+                {
+                if (has_avx2())
+                    { return find_avx2(text, length); }
+                return find_sse2(text, length);
+                }
+        #endif
+            return find_scalar(text, 0, length);
+            }
+        /**Finds the first character in a NULL-terminated string that is either in the set or the terminator.
+        @param text The string to search.
+        @returns A pointer to the character (which will be the terminator if nothing from the set was found).
+        @note This always uses the scalar loop; call the length-bounded find() instead if the length is known.*/
+        const T* find(const T* text) const
+            {
+            //the length isn't known, so this can't use the vector loads (they could read past the terminator)
+            while (*text != 0 && !is_match(*text))
+                { ++text; }
+            return text;
+            }
+    private:
+        size_t find_scalar(const T* text, size_t i, const size_t length) const
+            {
+            for (/*i is passed in*/; i < length; ++i)
+                {
+                if (text[i] == 0 || is_match(text[i]))
+                    { return i; }
+                }
+            return length;
+            }
+    #ifdef STRING_UTIL_X86_SIMD
+        static bool has_avx2()
+            {
+        #ifdef STRING_UTIL_NO_AVX2
+            return false;
+        #elif defined(_MSC_VER)
+            static const bool avx2 = detect_avx2();
+            return avx2;
+        #else
+            static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+            return avx2;
+        #endif
+            }
+    #ifdef _MSC_VER
+        static bool detect_avx2()
+            {
+            int info[4] = { 0 };
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                { return false; }
+            __cpuid(info, 1);
+            //the OS must be saving the YMM registers (OSXSAVE, then the XCR0 flags)
+            if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)
+                { return false; }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+            }
+    #endif
+        //lane-width specific compares, chosen by the size of T
+        static __m128i broadcast_sse2(const T ch)
+            {
+            return (sizeof(T) == 1) ? _mm_set1_epi8(static_cast<char>(ch)) :
+                   (sizeof(T) == 2) ? _mm_set1_epi16(static_cast<short>(ch)) :
+                                      _mm_set1_epi32(static_cast<int>(ch));
+            }
+        static __m128i compare_sse2(const __m128i a, const __m128i b)
+            {
+            return (sizeof(T) == 1) ? _mm_cmpeq_epi8(a, b) :
+                   (sizeof(T) == 2) ? _mm_cmpeq_epi16(a, b) :
+                                      _mm_cmpeq_epi32(a, b);
+            }
+        size_t find_sse2(const T* text, const size_t length) const
+            {
+            const size_t lanes = 16/sizeof(T);
+            const __m128i zero = _mm_setzero_si128();
+            __m128i set[8];
+            for (size_t j = 0; j < max_size(); ++j)
+                { set[j] = broadcast_sse2(m_set[j]); }
+            size_t i = 0;
+            for (/*i is initialized*/; i+lanes <= length; i += lanes)
+                {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text+i));
+                __m128i matches = compare_sse2(block, zero);
+                for (size_t j = 0; j < max_size(); ++j)
+                    { matches = _mm_or_si128(matches, compare_sse2(block, set[j])); }
+                const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+                if (mask != 0)
+                    { return i+(count_trailing_zeros(mask)/sizeof(T)); }
+                }
+            return find_scalar(text, i, length);
+            }
+        STRING_UTIL_TARGET_AVX2 static __m256i broadcast_avx2(const T ch)
+            {
+            return (sizeof(T) == 1) ? _mm256_set1_epi8(static_cast<char>(ch)) :
+                   (sizeof(T) == 2) ? _mm256_set1_epi16(static_cast<short>(ch)) :
+                                      _mm256_set1_epi32(static_cast<int>(ch));
+            }
+        STRING_UTIL_TARGET_AVX2 static __m256i compare_avx2(const __m256i a, const __m256i b)
+            {
+            return (sizeof(T) == 1) ? _mm256_cmpeq_epi8(a, b) :
+                   (sizeof(T) == 2) ? _mm256_cmpeq_epi16(a, b) :
+                                      _mm256_cmpeq_epi32(a, b);
+            }
+        STRING_UTIL_TARGET_AVX2 size_t find_avx2(const T* text, const size_t length) const
+            {
+            const size_t lanes = 32/sizeof(T);
+            const __m256i zero = _mm256_setzero_si256();
+            __m256i set[8];
+            for (size_t j = 0; j < max_size(); ++j)
+                { set[j] = broadcast_avx2(m_set[j]); }
+            size_t i = 0;
+            for (/*i is initialized*/; i+lanes <= length; i += lanes)
+                {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text+i));
+                __m256i matches = compare_avx2(block, zero);
+                for (size_t j = 0; j < max_size(); ++j)
+                    { matches = _mm256_or_si256(matches, compare_avx2(block, set[j])); }
+                const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(matches));
+                if (mask != 0)
+                    { return i+(count_trailing_zeros(mask)/sizeof(T)); }
+                }
+            //finish the remainder with SSE2 (which will fall back to scalar for the last few characters)
+            return i+find_sse2(text+i, length-i);
+            }
+        static unsigned int count_trailing_zeros(const unsigned int mask)
+            {
+        #ifdef _MSC_VER
+            unsigned long index = 0;
+            _BitScanForward(&index, mask);
+            return static_cast<unsigned int>(index);
+        #else
+            return static_cast<unsigned int>(__builtin_ctz(mask));
+        #endif
+            }
+    #endif
+        const T* m_search_sequence;
+        size_t m_length;
+        T m_set[8];
+        };
+
     /**Searches for a single character from a sequence in a string and returns a pointer if found.
         @param stringToSearch The string to search in.
         @param searchSequence The sequence of characters to search for.
         @param searchSeqLength The length of the search sequence.
-        @returns A pointer to the pointer to where the character was found, or null if not found.*/
+        @returns A pointer to the pointer to where the character was found, or null if not found.
+        @note This isn't vectorized (see char_set_matcher); call strncspn() instead if the string's length is known.*/
     template<typename T>
     inline const T* strcspn_pointer(const T* stringToSearch, const T* searchSequence, const size_t searchSeqLength)
         {
         if (!stringToSearch || !searchSequence || searchSeqLength == 0)
             { return NULL; }
         assert((string_util::strlen(searchSequence) == searchSeqLength) && "Invalid length passed to strcspn_pointer().");
-        size_t i = 0;
-        while (stringToSearch)
-            {
-            if (stringToSearch[0] == 0)
-                { return NULL; }
-            for (i = 0; i < searchSeqLength; ++i)
-                {
-                if (stringToSearch[0] == searchSequence[i])
-                    { return stringToSearch; }
-                }
-            ++stringToSearch;
-            }
-        return NULL;
+        return strcspn_pointer(stringToSearch, char_set_matcher<T>(searchSequence, searchSeqLength));
+        }
+
+    /**Searches for a single character from a precompiled set in a string and returns a pointer if found.
+        @param stringToSearch The string to search in.
+        @param searchSet The characters to search for.
+        @returns A pointer to the pointer to where the character was found, or null if not found.
+        @note This isn't vectorized (see char_set_matcher); call strncspn() instead if the string's length is known.*/
+    template<typename T>
+    inline const T* strcspn_pointer(const T* stringToSearch, const char_set_matcher<T>& searchSet)
+        {
+        if (!stringToSearch)
+            { return NULL; }
+        const T* found = searchSet.find(stringToSearch);
+        return (*found == 0) ? NULL : found;
         }
 
     /**Searches for a single character from a sequence in a string for n number of characters.
@@ -713,25 +964,31 @@ namespace string_util
         if (!stringToSearch || !searchString || stringToSearchLength == 0 || searchStringLength == 0)
             { return stringToSearchLength; }
         assert((string_util::strlen(searchString) == searchStringLength) && "Invalid length passed to strncspn().");
-        size_t i = 0, j = 0;
-        for (i = 0; i < stringToSearchLength; ++i)
+        return strncspn(stringToSearch, stringToSearchLength, char_set_matcher<T>(searchString, searchStringLength));
+        }
+
+    /**Searches for a single character from a precompiled set in a string for n number of characters.
+        @param stringToSearch The string to search.
+        @param stringToSearchLength The length of the string being searched.
+        @param searchSet The characters to search for.
+        @returns The index into the string that the character was found. Returns the length of the string if not found.*/
+    template<typename T>
+    inline size_t strncspn(const T* stringToSearch, const size_t stringToSearchLength,
+        const char_set_matcher<T>& searchSet)
+        {
+        if (!stringToSearch || stringToSearchLength == 0)
+            { return stringToSearchLength; }
+        const size_t index = searchSet.find(stringToSearch, stringToSearchLength);
+        /*If string being searched is shorter than the size argument then fail.
+        Note that we should pass back the length of the string that the caller passed in
+        so that they know that it failed, not the actual position that we stopped on which would
+        be a NULL termintor.*/
+        if (index < stringToSearchLength && stringToSearch[index] == 0)
             {
-            /*If string being searched is shorter than the size argument then fail.
-            Note that we should pass back the length of the string that the caller passed in
-            so that they know that it failed, not the actual position that we stopped on which would
-            be a NULL termintor.*/
-            if (stringToSearch[i] == 0)
-                {
-                NON_UNIT_TEST_ASSERT(0 && "strncspn: string shorter than size parameter.");
-                return stringToSearchLength;
-                }
-            for (j = 0; j < searchStringLength; ++j)
-                {
-                if (stringToSearch[i] == searchString[j])
-                    { return i; }
-                }
+            NON_UNIT_TEST_ASSERT(0 && "strncspn: string shorter than size parameter.");
+            return stringToSearchLength;
             }
-        return i;
+        return index;
         }
 
     /**Searches for a single character not from a sequence in a string in reverse.
@@ -1080,10 +1337,11 @@ namespace string_util
         ///@param val The string to parse.
         ///@param delim The set of delimiters to separate the string.
         string_tokenize(const T& val, const T& delim) :
-            m_value(val), m_start(NULL), m_next_delim(NULL), m_delim(delim), m_has_more_tokens(true)
+            m_value(val), m_start(NULL), m_end(NULL), m_next_delim(NULL), m_delim(delim), m_has_more_tokens(true)
             {
             m_start = m_value.c_str();
-            m_next_delim = string_util::strcspn_pointer(m_start, m_delim.c_str(), m_delim.length());
+            m_end = m_start+m_value.length();
+            m_next_delim = find_next_delimiter();
             }
         ///@returns Whether or not there are more tokens in the string.
         inline bool has_more_tokens() const
@@ -1103,7 +1361,7 @@ namespace string_util
                 const wchar_t* current_next_delim = m_next_delim;
                 //move the pointers to the next token
                 m_start = ++m_next_delim;
-                m_next_delim = string_util::strcspn_pointer(m_start, m_delim.c_str(), m_delim.length());
+                m_next_delim = find_next_delimiter();
                 return T(current_start, current_next_delim-current_start);
                 }
             //no more delims means that we are on the last token
@@ -1124,9 +1382,18 @@ namespace string_util
     private:
         string_tokenize() {}
         string_tokenize(const string_tokenize&) {}
+        //finds the next delimiter from m_start, or NULL if there are no more
+        //(the length of what is left is known, so the search can be vectorized)
+        const wchar_t* find_next_delimiter() const
+            {
+            const size_t remainingLength = m_end-m_start;
+            const size_t index = string_util::strncspn(m_start, remainingLength, m_delim.c_str(), m_delim.length());
+            return (index < remainingLength) ? m_start+index : NULL;
+            }
 
         T m_value;
         const wchar_t* m_start;
+        const wchar_t* m_end;
         const wchar_t* m_next_delim;
         T m_delim;
         bool m_has_more_tokens;
@@ -1290,7 +1557,9 @@ namespace string_util
             return 0.0f;
             }
         wchar_t sepStr[3] = { 0x2D, 0x3A, 0 };
-        const Tchar_type* separator = string_util::strcspn_pointer<Tchar_type>(nptr, sepStr, 2);
+        const size_t length = string_util::strlen(nptr);
+        const size_t separatorIndex = string_util::strncspn<Tchar_type>(nptr, length, sepStr, 2);
+        const Tchar_type* separator = (separatorIndex < length) ? nptr+separatorIndex : NULL;
         //if there is no hyphen or there is one but it is at the end then just call strtod
         if (separator == NULL || *(separator+1) == 0)
             { return string_util::strtod(nptr, endptr); }
@@ -0,0 +1,189 @@
+/*Regression tests for the extractors. There is no build script for these; compile this file along with
+  the library's source files and run it (it returns the number of failed checks). For example, from this folder:
+
+    g++ -std=c++11 -I.. extract_text_tests.cpp ../import/*.cpp -pthread -o extract_text_tests*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../import/html_extract_text.h"
+#include "../import/docx_extract_text.h"
+#include "../import/pptx_extract_text.h"
+
+using namespace lily_of_the_valley;
+
+static int failedChecks = 0;
+
+#define CHECK(expression) \
+    if (!(expression)) \
+        { \
+        std::cerr << __FILE__ << "(" << __LINE__ << "): check failed: " << #expression << std::endl; \
+        ++failedChecks; \
+        }
+
+//extracts a page into a fixed buffer of a given size
+static std::wstring extract_into_fixed_buffer(const std::wstring& page, const size_t buffer_size, std::wstring& log)
+    {
+    std::vector<wchar_t> buffer(buffer_size);
+    fixed_text_sink sink(&buffer[0], buffer.size());
+    html_extract_text htmlExtract;
+    htmlExtract.set_text_sink(&sink);
+    htmlExtract(page.c_str(), page.length(), true, false);
+    log = htmlExtract.get_log();
+    return std::wstring(htmlExtract.get_filtered_text(), htmlExtract.get_filtered_text_length());
+    }
+
+//a fixed buffer that is only as large as the text (plus its NULL terminator) must hold all of it
+static void test_fixed_sink_sized_to_text()
+    {
+    std::wstring log;
+    //the entity makes the text shorter than the run that it is in
+    CHECK(extract_into_fixed_buffer(L"a &amp; b", 6, log) == L"a & b");
+    CHECK(log.empty());
+    CHECK(extract_into_fixed_buffer(L"a &amp; b", 5, log) == L"a & ");
+    CHECK(!log.empty());
+
+    std::wstring page;
+    for (size_t i = 0; i < 500; ++i)
+        { page += L"<p>Paragraph &amp; number "+std::to_wstring(i)+L" with &lt;text&gt;.</p>\n"; }
+    html_extract_text htmlExtract;
+    htmlExtract(page.c_str(), page.length(), true, false);
+    const std::wstring expected(htmlExtract.get_filtered_text(), htmlExtract.get_filtered_text_length());
+    CHECK(extract_into_fixed_buffer(page, expected.length()+1, log) == expected);
+    CHECK(log.empty());
+    //one character short, the text is cut off (but what is there is still right)
+    const std::wstring truncated = extract_into_fixed_buffer(page, expected.length(), log);
+    CHECK(truncated == expected.substr(0, expected.length()-1));
+    CHECK(!log.empty());
+    }
+
+static void append_text(const wchar_t* text, const size_t length, void* user_data)
+    { static_cast<std::wstring*>(user_data)->append(text, length); }
+
+//the offsets must be into the whole text, even when a callback sink has handed earlier chunks of it off
+static void test_offset_map_with_callback_sink()
+    {
+    std::wstring page;
+    for (size_t i = 0; i < 500; ++i)
+        { page += L"<p>Paragraph &amp; number "+std::to_wstring(i)+L"\r\n with &lt;text&gt;.</p>\n"; }
+    text_offset_map expectedOffsets;
+    html_extract_text htmlExtract;
+    htmlExtract.set_offset_map(&expectedOffsets);
+    htmlExtract(page.c_str(), page.length(), true, false);
+
+    std::wstring text;
+    text_offset_map offsets;
+    callback_text_sink sink(append_text, &text, 256);
+    html_extract_text callbackExtract;
+    callbackExtract.set_text_sink(&sink);
+    callbackExtract.set_offset_map(&offsets);
+    callbackExtract(page.c_str(), page.length(), true, false);
+    CHECK(text == std::wstring(htmlExtract.get_filtered_text(), htmlExtract.get_filtered_text_length()));
+    CHECK(offsets.get_runs().size() == expectedOffsets.get_runs().size());
+    for (size_t i = 0; i < text.length(); ++i)
+        {
+        if (offsets.find_input_offset(i) != expectedOffsets.find_input_offset(i))
+            {
+            CHECK(offsets.find_input_offset(i) == expectedOffsets.find_input_offset(i));
+            break;
+            }
+        }
+    }
+
+//the extractors derived from html_extract_text must stop at their budgets too, whether given the whole document or streamed
+static void test_budget_in_derived_extractor()
+    {
+    std::string document = "<w:document><w:body>";
+    for (size_t i = 0; i < 300; ++i)
+        { document += "<w:p><w:r><w:t>Paragraph number "+std::to_string(i)+" text.</w:t></w:r></w:p>"; }
+    document += "</w:body></w:document>";
+    docx_extract_text fullExtract;
+    fullExtract(document.c_str(), document.length());
+    const std::wstring fullText(fullExtract.get_filtered_text(), fullExtract.get_filtered_text_length());
+
+    extraction_budget budget;
+    budget.m_max_output_length = 500;
+    docx_extract_text docxExtract;
+    docxExtract.set_budget(budget);
+    docxExtract(document.c_str(), document.length());
+    const std::wstring text(docxExtract.get_filtered_text(), docxExtract.get_filtered_text_length());
+    CHECK(docxExtract.is_budget_exceeded());
+    CHECK(text.length() > 0 && text.length() <= budget.m_max_output_length);
+    CHECK(fullText.compare(0, text.length(), text) == 0);
+
+    docx_extract_text streamExtract;
+    streamExtract.set_budget(budget);
+    for (size_t i = 0; i < document.length(); i += 100)
+        { streamExtract.feed(document.c_str()+i, std::min<size_t>(100, document.length()-i)); }
+    streamExtract.finish();
+    CHECK(streamExtract.is_budget_exceeded());
+    CHECK(std::wstring(streamExtract.get_filtered_text(), streamExtract.get_filtered_text_length()) == text);
+
+    budget = extraction_budget();
+    budget.m_max_steps = 100;
+    docxExtract.set_budget(budget);
+    docxExtract(document.c_str(), document.length());
+    const std::wstring steppedText(docxExtract.get_filtered_text(), docxExtract.get_filtered_text_length());
+    CHECK(docxExtract.is_budget_exceeded());
+    CHECK(steppedText.length() > 0 && steppedText.length() < fullText.length());
+    CHECK(fullText.compare(0, steppedText.length(), steppedText) == 0);
+    }
+
+//builds a slide whose first paragraph has thousands of runs (with a break after every thousandth one)
+static std::string make_slide_with_runs(const size_t run_count, std::wstring& expected)
+    {
+    std::string slide = "<p:sld><p:cSld><p:spTree><p:sp><p:txBody><a:p><a:pPr lvl=\"0\"/>";
+    expected.clear();
+    for (size_t i = 0; i < run_count; ++i)
+        {
+        slide += "<a:r><a:rPr lang=\"en-US\"/><a:t>word"+std::to_string(i)+" </a:t></a:r>";
+        expected += L"word"+std::to_wstring(i)+L" ";
+        if (i%1000 == 999)
+            {
+            slide += "<a:br/>";
+            expected += L"\n";
+            }
+        }
+    slide += "</a:p><a:p><a:r><a:t>Next</a:t></a:r></a:p></p:txBody></p:sp></p:spTree></p:cSld></p:sld>";
+    expected += L"\n\nNext\n\n";
+    return slide;
+    }
+
+/*a paragraph with thousands of runs must be read in one pass (the old extractor searched the rest of the
+  paragraph again for each run, which took seconds for a paragraph like this), and give the same text as before*/
+static void test_pptx_paragraph_with_many_runs()
+    {
+    std::wstring expected;
+    const std::string slide = make_slide_with_runs(5000, expected);
+    pptx_extract_text pptxExtract;
+    pptxExtract(slide.c_str(), slide.length());
+    CHECK(std::wstring(pptxExtract.get_filtered_text(), pptxExtract.get_filtered_text_length()) == expected);
+
+    //streamed in small chunks, runs are cut off in the middle and read again once the rest of them are in
+    pptx_extract_text streamExtract;
+    for (size_t i = 0; i < slide.length(); i += 64)
+        { streamExtract.feed(slide.c_str()+i, std::min<size_t>(64, slide.length()-i)); }
+    streamExtract.finish();
+    CHECK(std::wstring(streamExtract.get_filtered_text(), streamExtract.get_filtered_text_length()) == expected);
+
+    //a linear walk takes a few milliseconds for this (the quadratic one took well over ten seconds)
+    const std::string largeSlide = make_slide_with_runs(20000, expected);
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    pptxExtract(largeSlide.c_str(), largeSlide.length());
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-startTime).count();
+    CHECK(std::wstring(pptxExtract.get_filtered_text(), pptxExtract.get_filtered_text_length()) == expected);
+    CHECK(seconds < 2.0);
+    }
+
+int main()
+    {
+    test_fixed_sink_sized_to_text();
+    test_offset_map_with_callback_sink();
+    test_budget_in_derived_extractor();
+    test_pptx_paragraph_with_many_runs();
+    if (failedChecks == 0)
+        { std::cout << "All tests passed." << std::endl; }
+    return failedChecks;
+    }
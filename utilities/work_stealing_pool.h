@@ -0,0 +1,283 @@
+/**@addtogroup Utilities
+@brief Utility classes.
+@date 2003-2016
+@copyright Oleander Software, Ltd.
+@author Oleander Software, Ltd.
+@details This program is free software; you can redistribute it and/or modify
+it under the terms of the BSD License.
+* @{*/
+
+#ifndef __WORK_STEALING_POOL_H__
+#define __WORK_STEALING_POOL_H__
+
+#include <vector>
+#include <memory>
+#include <deque>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <exception>
+
+/**@brief A queue of task indices that its owner takes from the front of and other workers steal from the back of.*/
+class work_stealing_queue
+    {
+public:
+    ///Adds a task to the back of the queue.
+    void push(const size_t task)
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(task);
+        }
+    /**Takes the next task from the front of the queue (called by the queue's owner).
+       @param[out] task The task that was taken.
+       @returns False if the queue is empty.*/
+    bool pop(size_t& task)
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tasks.empty())
+            { return false; }
+        task = m_tasks.front();
+        m_tasks.pop_front();
+        return true;
+        }
+    /**Takes a task from the back of the queue (called by other workers when their own queues are empty).
+       @param[out] task The task that was taken.
+       @returns False if the queue is empty.*/
+    bool steal(size_t& task)
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tasks.empty())
+            { return false; }
+        task = m_tasks.back();
+        m_tasks.pop_back();
+        return true;
+        }
+private:
+    std::mutex m_mutex;
+    std::deque<size_t> m_tasks;
+    };
+
+/**@brief Runs a set of tasks across a number of threads, with idle threads stealing work from busy ones.
+@details Each worker has its own queue of tasks. Tasks are dealt out to the queues from the most costly to
+    the least (so that every worker starts on the largest tasks), and a worker that runs out of tasks takes
+    the remaining ones from the other workers' queues. This keeps all of the threads busy until the end,
+    even when the tasks' costs vary widely.
+
+    The calling thread is used as the first worker, and the other threads are started by run() and
+    joined before it returns. Because the threads are started for every call to run() (which costs tens
+    of microseconds per thread), each call should be given a batch of tasks that are worth that (e.g., a
+    set of documents or large segments of one), rather than being called for each small task. Because a
+    task is always told which worker is running it, anything that should be reused between tasks (e.g., a
+    parser and its buffer) can be kept per worker.
+@note Requires C++11 (for @c std::thread).
+@par Example:
+@code
+    std::vector<size_t> costs; //the size of each file
+    work_stealing_pool pool;
+    std::vector<my_parser> parsers(pool.get_thread_count());
+    pool.run(costs, [&](const size_t worker, const size_t task)
+        { parsers[worker].parse(files[task]); });
+@endcode*/
+class work_stealing_pool
+    {
+public:
+    /**Constructor.
+       @param thread_count The number of threads to run tasks on. If zero, then the number of cores on the system is used.*/
+    explicit work_stealing_pool(const size_t thread_count = 0) :
+        m_thread_count((thread_count > 0) ? thread_count : get_hardware_thread_count())
+        {}
+    ///@returns The number of threads that tasks are run on (i.e., the number of workers).
+    size_t get_thread_count() const
+        { return m_thread_count; }
+    ///@returns The number of threads that the system can run concurrently (at least one).
+    static size_t get_hardware_thread_count()
+        {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        return (cores > 0) ? cores : 1;
+        }
+    /**Runs a set of tasks (all assumed to cost the same).
+       @param task_count The number of tasks.
+       @param task The function to run for each task. It is called as @c task(worker_index, task_index).
+       @note If a task throws an exception, then the remaining tasks are still run and the first exception is rethrown.*/
+    template<typename Function>
+    void run(const size_t task_count, Function task)
+        { run(std::vector<size_t>(task_count, 1), task); }
+    /**Runs a set of tasks, scheduling the most costly ones first.
+       @param task_costs The (relative) cost of each task (e.g., the size of each document).
+       @param task The function to run for each task. It is called as @c task(worker_index, task_index),
+        where @c worker_index is less than the number of workers that run() uses (which is never more than get_thread_count()).
+       @note If a task throws an exception, then the remaining tasks are still run and the first exception is rethrown.
+        If a thread can't be started, then the threads that were started finish the tasks
+        (and are joined) before the exception from starting it (e.g., @c std::system_error) is rethrown.*/
+    template<typename Function>
+    void run(const std::vector<size_t>& task_costs, Function task)
+        {
+        if (task_costs.empty())
+            { return; }
+        const size_t workerCount = std::min(m_thread_count, task_costs.size());
+        //with only one worker, there is nothing to schedule
+        if (workerCount == 1)
+            {
+            std::exception_ptr firstException;
+            for (size_t i = 0; i < task_costs.size(); ++i)
+                {
+                try
+                    { task(0, i); }
+                catch (...)
+                    {
+                    if (!firstException)
+                        { firstException = std::current_exception(); }
+                    }
+                }
+            if (firstException)
+                { std::rethrow_exception(firstException); }
+            return;
+            }
+        //deal the tasks out from the most to least costly
+        std::vector<size_t> order(task_costs.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            { order[i] = i; }
+        std::stable_sort(order.begin(), order.end(), more_costly(task_costs));
+        std::vector<work_stealing_queue> queues(workerCount);
+        for (size_t i = 0; i < order.size(); ++i)
+            { queues[i%workerCount].push(order[i]); }
+
+        std::mutex exceptionMutex;
+        std::exception_ptr firstException;
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount-1);
+        try
+            {
+            for (size_t i = 1; i < workerCount; ++i)
+                {
+                threads.push_back(std::thread(&work_stealing_pool::work<Function>, i,
+                    std::ref(queues), std::ref(task), std::ref(exceptionMutex), std::ref(firstException)));
+                }
+            }
+        catch (...)
+            {
+            /*if a thread couldn't be started, then the ones that were need to be joined before they go out of scope
+              (they will steal whatever tasks the other workers would have run)*/
+            for (size_t i = 0; i < threads.size(); ++i)
+                { threads[i].join(); }
+            throw;
+            }
+        work<Function>(0, queues, task, exceptionMutex, firstException);
+        for (size_t i = 0; i < threads.size(); ++i)
+            { threads[i].join(); }
+        if (firstException)
+            { std::rethrow_exception(firstException); }
+        }
+private:
+    ///Sorts task indices by descending cost.
+    class more_costly
+        {
+    public:
+        explicit more_costly(const std::vector<size_t>& costs) : m_costs(costs) {}
+        bool operator()(const size_t first, const size_t second) const
+            { return m_costs[first] > m_costs[second]; }
+    private:
+        const std::vector<size_t>& m_costs;
+        };
+    ///A worker's loop: runs its own tasks, then steals from the others until every queue is empty.
+    template<typename Function>
+    static void work(const size_t worker, std::vector<work_stealing_queue>& queues, Function& task,
+                     std::mutex& exceptionMutex, std::exception_ptr& firstException)
+        {
+        size_t currentTask = 0;
+        for (;;)
+            {
+            //tasks are never added while running, so once every queue is empty we are done
+            bool found = queues[worker].pop(currentTask);
+            for (size_t i = 1; !found && i < queues.size(); ++i)
+                { found = queues[(worker+i)%queues.size()].steal(currentTask); }
+            if (!found)
+                { return; }
+            try
+                { task(worker, currentTask); }
+            catch (...)
+                {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!firstException)
+                    { firstException = std::current_exception(); }
+                }
+            }
+        }
+    size_t m_thread_count;
+    };
+
+/**@brief A work_stealing_pool that gives each of its workers its own object (e.g., a parser) to run tasks with.
+@details The objects are created the first time that a run needs that many workers and are kept until the pool
+    is destroyed, so anything that they hold onto (e.g., a parser's buffer) is reused by later runs.
+    The objects are created on the calling thread, which can also use them outside of a run (see get_worker()).
+@note Requires C++11 (for @c std::thread). Only one run should be going at a time.
+    @c worker_type only needs to be complete where the pool's members (including its destructor) are used,
+    so it can be a class that is only declared in a header.
+@par Example:
+@code
+    std::vector<size_t> costs; //the size of each file
+    worker_pool<my_parser> parsers;
+    parsers.run(costs, [&](my_parser& parser, const size_t task)
+        { parser.parse(files[task]); });
+@endcode*/
+template<typename worker_type>
+class worker_pool
+    {
+public:
+    /**Constructor.
+       @param thread_count The number of threads to run tasks on. If zero, then the number of cores on the system is used.*/
+    explicit worker_pool(const size_t thread_count = 0) : m_pool(thread_count)
+        {}
+    ///@returns The number of threads that tasks are run on.
+    size_t get_thread_count() const
+        { return m_pool.get_thread_count(); }
+    /**@returns A worker's object (creating it if needed).
+       @param worker The index of the worker (0 is the calling thread's).*/
+    worker_type& get_worker(const size_t worker)
+        {
+        add_workers(worker+1);
+        return *m_workers[worker];
+        }
+    /**Runs a set of tasks, scheduling the most costly ones first (see work_stealing_pool::run()).
+       @param task_costs The (relative) cost of each task.
+       @param task The function to run for each task. It is called as @c task(worker, task_index),
+        where @c worker is the object of the worker that is running it.*/
+    template<typename Function>
+    void run(const std::vector<size_t>& task_costs, Function task)
+        {
+        add_workers(std::min(get_thread_count(), task_costs.size()));
+        m_pool.run(task_costs, [&](const size_t worker, const size_t taskIndex)
+            { task(*m_workers[worker], taskIndex); });
+        }
+    /**Runs a set of tasks, passing the ones that fail to an error handler.
+       @param task_costs The (relative) cost of each task.
+       @param task The function to run for each task. It is called as @c task(worker, task_index).
+       @param on_error The function to call (as @c on_error(task_index)) if a task throws a @c std::exception.
+        The other tasks are still run, and nothing is rethrown.*/
+    template<typename Function, typename ErrorHandler>
+    void run(const std::vector<size_t>& task_costs, Function task, ErrorHandler on_error)
+        {
+        run(task_costs, [&](worker_type& worker, const size_t taskIndex)
+            {
+            try
+                { task(worker, taskIndex); }
+            catch (const std::exception&)
+                { on_error(taskIndex); }
+            });
+        }
+private:
+    void add_workers(const size_t count)
+        {
+        while (m_workers.size() < count)
+            { m_workers.push_back(std::unique_ptr<worker_type>(new worker_type)); }
+        }
+    work_stealing_pool m_pool;
+    std::vector<std::unique_ptr<worker_type> > m_workers;
+    //disable copy construction
+    worker_pool(const worker_pool&);
+    void operator=(const worker_pool&);
+    };
+
+/** @}*/
+
+#endif //__WORK_STEALING_POOL_H__